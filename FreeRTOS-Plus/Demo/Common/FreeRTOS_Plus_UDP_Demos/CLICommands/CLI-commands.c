@@ -83,6 +83,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* FreeRTOS+CLI includes. */
 #include "FreeRTOS_CLI.h"
@@ -96,6 +97,20 @@ commands. */
 	#define configINCLUDE_TRACE_RELATED_CLI_COMMANDS 0
 #endif
 
+#ifndef configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND
+	#define configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND 0
+#endif
+
+#if configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND == 1
+	/* The checksum routines are private to the IP stack. */
+	#include "FreeRTOS_IP_Private.h"
+
+	/* The largest block of data checksummed by the "checksum-benchmark"
+	command, and the number of bytes processed by each timed loop. */
+	#define cliBENCHMARK_MAX_BYTES			( 1472 )
+	#define cliBENCHMARK_BYTES_PER_TEST		( 2000000UL )
+#endif
+
 
 /*
  * Implements the run-time-stats command.
@@ -139,6 +154,15 @@ static BaseType_t prvPingCommand( char *pcWriteBuffer, size_t xWriteBufferLen, c
 	static BaseType_t prvStartStopTraceCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
 #endif
 
+/*
+ * Implements the "checksum-benchmark" command, and the original 16-bit checksum
+ * loop that the IP stack's checksum routines are timed against.
+ */
+#if configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND == 1
+	static BaseType_t prvChecksumBenchmarkCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString );
+	static uint16_t prvReferenceChecksum( const uint8_t * const pucNextData, const uint16_t usDataLengthBytes );
+#endif
+
 /* Structure that defines the "ip-config" command line command. */
 static const CLI_Command_Definition_t xIPConfig =
 {
@@ -228,6 +252,17 @@ static const CLI_Command_Definition_t xParameterEcho =
 	};
 #endif /* configINCLUDE_TRACE_RELATED_CLI_COMMANDS */
 
+#if configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND == 1
+	/* Structure that defines the "checksum-benchmark" command line command. */
+	static const CLI_Command_Definition_t xChecksumBenchmark =
+	{
+		"checksum-benchmark",
+		"checksum-benchmark:\r\n Times the IP stack's checksum routines against the original 16-bit checksum loop\r\n\r\n",
+		prvChecksumBenchmarkCommand, /* The function to run. */
+		0 /* No parameters are expected. */
+	};
+#endif /* configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND */
+
 /*-----------------------------------------------------------*/
 
 void vRegisterCLICommands( void )
@@ -249,6 +284,10 @@ void vRegisterCLICommands( void )
 	#if configINCLUDE_TRACE_RELATED_CLI_COMMANDS == 1
 		FreeRTOS_CLIRegisterCommand( & xStartStopTrace );
 	#endif
+
+	#if configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND == 1
+		FreeRTOS_CLIRegisterCommand( &xChecksumBenchmark );
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -704,3 +743,138 @@ uint32_t ulAddress;
 	}
 
 #endif /* configINCLUDE_TRACE_RELATED_CLI_COMMANDS */
+
+#if configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND == 1
+
+	static BaseType_t prvChecksumBenchmarkCommand( char *pcWriteBuffer, size_t xWriteBufferLen, const char *pcCommandString )
+	{
+	static BaseType_t xIndex = 0;
+	static uint32_t ulSource[ ( cliBENCHMARK_MAX_BYTES / sizeof( uint32_t ) ) + 1 ], ulDestination[ ( cliBENCHMARK_MAX_BYTES / sizeof( uint32_t ) ) + 2 ];
+	static const uint16_t usBlockSizes[] = { 64, 512, cliBENCHMARK_MAX_BYTES };
+	const uint8_t *pucSource = ( const uint8_t * ) ulSource;
+	uint8_t *pucDestination;
+	uint32_t ul, ulIterations;
+	uint16_t usBytes, usReference = 0, usSum = 0, usCopySum = 0;
+	TickType_t xTimes[ 4 ], xStartTime;
+	BaseType_t xReturn;
+
+		/* Remove compile time warnings about unused parameters, and check the
+		write buffer is not NULL.  NOTE - for simplicity, this example assumes the
+		write buffer length is adequate, so does not check for buffer overflows. */
+		( void ) pcCommandString;
+		( void ) xWriteBufferLen;
+		configASSERT( pcWriteBuffer );
+
+		if( xIndex == 0 )
+		{
+			for( ul = 0; ul < cliBENCHMARK_MAX_BYTES; ul++ )
+			{
+				( ( uint8_t * ) ulSource )[ ul ] = ( uint8_t ) ( ul * 7UL );
+			}
+		}
+
+		/* Copies are made to a destination that is 2 bytes past a 4 byte
+		boundary, which is where a UDP payload starts within a network buffer. */
+		pucDestination = ( ( uint8_t * ) ulDestination ) + 2;
+		usBytes = usBlockSizes[ xIndex ];
+		ulIterations = cliBENCHMARK_BYTES_PER_TEST / ( uint32_t ) usBytes;
+
+		/* The first word of the data is changed on each iteration so the
+		compiler cannot move the calculations out of the timed loops. */
+		xStartTime = xTaskGetTickCount();
+		for( ul = 0; ul < ulIterations; ul++ )
+		{
+			ulSource[ 0 ] = ul;
+			usReference = prvReferenceChecksum( pucSource, usBytes );
+		}
+		xTimes[ 0 ] = xTaskGetTickCount() - xStartTime;
+
+		xStartTime = xTaskGetTickCount();
+		for( ul = 0; ul < ulIterations; ul++ )
+		{
+			ulSource[ 0 ] = ul;
+			usSum = usGenerateChecksum( 0UL, pucSource, ( size_t ) usBytes );
+		}
+		xTimes[ 1 ] = xTaskGetTickCount() - xStartTime;
+
+		xStartTime = xTaskGetTickCount();
+		for( ul = 0; ul < ulIterations; ul++ )
+		{
+			ulSource[ 0 ] = ul;
+			memcpy( ( void * ) pucDestination, ( const void * ) pucSource, usBytes );
+			usReference = prvReferenceChecksum( pucDestination, usBytes );
+		}
+		xTimes[ 2 ] = xTaskGetTickCount() - xStartTime;
+
+		xStartTime = xTaskGetTickCount();
+		for( ul = 0; ul < ulIterations; ul++ )
+		{
+			ulSource[ 0 ] = ul;
+			usCopySum = usGenerateChecksumAndCopy( pucDestination, pucSource, ( size_t ) usBytes );
+		}
+		xTimes[ 3 ] = xTaskGetTickCount() - xStartTime;
+
+		sprintf( pcWriteBuffer, "%u bytes x %u: 16-bit loop %u ticks, usGenerateChecksum() %u ticks, memcpy() + 16-bit loop %u ticks, usGenerateChecksumAndCopy() %u ticks%s\r\n",
+			( unsigned int ) usBytes,
+			( unsigned int ) ulIterations,
+			( unsigned int ) xTimes[ 0 ],
+			( unsigned int ) xTimes[ 1 ],
+			( unsigned int ) xTimes[ 2 ],
+			( unsigned int ) xTimes[ 3 ],
+			( ( usSum == usReference ) && ( usCopySum == usReference ) ) ? "" : " - checksum mismatch" );
+
+		xIndex++;
+
+		if( xIndex < ( BaseType_t ) ( sizeof( usBlockSizes ) / sizeof( usBlockSizes[ 0 ] ) ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			/* Reset the index for the next time it is called. */
+			xIndex = 0;
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint16_t prvReferenceChecksum( const uint8_t * const pucNextData, const uint16_t usDataLengthBytes )
+	{
+	uint32_t ulChecksum = 0;
+	uint16_t us, usDataLength16BitWords, *pusNextData;
+
+		/* This is the checksum loop the IP stack used before it summed whole
+		words, less the final inversion. */
+		usDataLength16BitWords = ( usDataLengthBytes >> 1U );
+		pusNextData = ( uint16_t * ) pucNextData;
+
+		for( us = 0U; us < usDataLength16BitWords; us++ )
+		{
+			ulChecksum += ( uint32_t ) pusNextData[ us ];
+		}
+
+		if( ( usDataLengthBytes & 0x01U ) != 0x00 )
+		{
+			#if ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN
+			{
+				ulChecksum += ( uint32_t ) pucNextData[ usDataLengthBytes - 1 ];
+			}
+			#else
+			{
+				us = ( uint16_t ) pucNextData[ usDataLengthBytes - 1 ];
+				ulChecksum += ( uint32_t ) ( us << 8 );
+			}
+			#endif
+		}
+
+		while( ( ulChecksum >> 16UL ) != 0x00UL )
+		{
+			ulChecksum = ( ulChecksum & 0xffffUL ) + ( ulChecksum >> 16UL );
+		}
+
+		return ( uint16_t ) ulChecksum;
+	}
+
+#endif /* configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND */
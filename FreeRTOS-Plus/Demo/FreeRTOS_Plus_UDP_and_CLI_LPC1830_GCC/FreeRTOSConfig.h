@@ -191,6 +191,10 @@ standard names. */
 commands start and stop the FreeRTOS+Trace recording. */
 #define configINCLUDE_TRACE_RELATED_CLI_COMMANDS 1
 
+/* Set to 1 to include the "checksum-benchmark" CLI command, which times the IP
+stack's checksum routines against the original 16-bit checksum loop. */
+#define configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND 1
+
 /* Dimensions a buffer that can be used by the FreeRTOS+CLI command
 interpreter.  See the FreeRTOS+CLI documentation for more information:
 http://www.FreeRTOS.org/FreeRTOS-Plus/FreeRTOS_Plus_CLI/ */
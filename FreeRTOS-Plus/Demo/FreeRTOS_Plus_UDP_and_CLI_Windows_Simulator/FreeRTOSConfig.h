@@ -161,6 +161,10 @@ macros are defined to gather some UDP stack statistics that can then be viewed
 through the CLI interface. */
 #define configINCLUDE_DEMO_DEBUG_STATS 1
 
+/* Set to 1 to include the "checksum-benchmark" CLI command, which times the IP
+stack's checksum routines against the original 16-bit checksum loop. */
+#define configINCLUDE_CHECKSUM_BENCHMARK_CLI_COMMAND 1
+
 /* The size of the global output buffer that is available for use when there
 are multiple command interpreters running at once (for example, one on a UART
 and one on TCP/IP).  This is done to prevent an output buffer being defined by
@@ -187,6 +187,44 @@ be divisible by 8.  Setting ipconfigCAN_FRAGMENT_OUTGOING_PACKETS to 1 will
 increase both the code size and execution time. */
 #define ipconfigCAN_FRAGMENT_OUTGOING_PACKETS 0
 
+/* If ipconfigCAN_REASSEMBLE_INCOMING_PACKETS is set to 1 then UDP packets that
+are received fragmented across multiple IP packets are reassembled by the IP
+task, otherwise received fragments are dropped.  The fragments of a packet are
+held in their network buffers, linked together, until the whole packet has been
+received, and the packet is then passed to the socket as a chain of network
+buffers.  FreeRTOS_recvfrom() copies the whole packet when it is called without
+the FREERTOS_ZERO_COPY flag.  When the FREERTOS_ZERO_COPY flag is used only the
+data held in the first fragment is received, unless the
+FREERTOS_ZERO_COPY_SEGMENTS flag is also used, in which case the whole packet is
+received and its fragments are found by calling FreeRTOS_GetUDPPayloadSegment().
+Setting
+ipconfigCAN_REASSEMBLE_INCOMING_PACKETS to 1 will increase both the code size and
+RAM usage. */
+#define ipconfigCAN_REASSEMBLE_INCOMING_PACKETS 1
+
+/* The maximum number of fragmented packets that can be in the process of being
+reassembled at any one time.  If a fragment of a new packet is received when
+ipconfigREASSEMBLY_CONTEXTS packets are already being reassembled then the
+packet that was started first is dropped to make room for the new packet. */
+#define ipconfigREASSEMBLY_CONTEXTS					2
+
+/* The maximum number of UDP payload bytes a reassembled packet can contain.
+Fragments of larger packets are dropped. */
+#define ipconfigREASSEMBLY_MAX_PAYLOAD_BYTES		16384
+
+/* The maximum number of fragments a packet can be received in.  Each fragment
+holds a network buffer until the packet is complete, so
+ipconfigREASSEMBLY_CONTEXTS multiplied by ipconfigREASSEMBLY_MAX_FRAGMENTS must be
+less than ipconfigNUM_NETWORK_BUFFERS. */
+#define ipconfigREASSEMBLY_MAX_FRAGMENTS			12
+
+/* A packet that is not completely received within ipconfigREASSEMBLY_MAX_AGE
+periods of the ARP timer is dropped, and the network buffers holding its
+fragments are freed.  ipconfigREASSEMBLY_MAX_AGE is specified in the same units
+as ipconfigMAX_ARP_AGE, so a value of 2 is equal to between 10 and 20 seconds,
+depending on when the first fragment is received relative to the ARP timer. */
+#define ipconfigREASSEMBLY_MAX_AGE					2
+
 /* The MTU is the maximum number of bytes the payload of a network frame can
 contain.  For normal Ethernet V2 frames the maximum MTU is 1500.  Setting a
 lower value can save RAM, depending on the buffer management scheme used.  If
@@ -210,6 +248,38 @@ FreeRTOS_SendPingRequest() API function is available. */
 (and associated) API function is available. */
 #define ipconfigSUPPORT_SELECT_FUNCTION				1
 
+/* If ipconfigSUPPORT_MMSG_FUNCTIONS is set to 1 then the FreeRTOS_recvmmsg()
+and FreeRTOS_sendmmsg() API functions are available.  These receive, or send,
+several datagrams in one call. */
+#define ipconfigSUPPORT_MMSG_FUNCTIONS				1
+
+/* Bound sockets are held in ipconfigSOCKET_HASH_BUCKETS lists, selected by
+port number, so the time taken to find the socket a received packet is destined
+for depends on the number of sockets in one list, rather than the total number
+of bound sockets.  Must be a power of 2.  Set it to the number of sockets the
+application expects to have bound at any one time, rounded up to a power of 2,
+so most lists hold no more than one socket.  FreeRTOS_bind() searches one list
+with interrupts disabled, so keeping the lists short also keeps the time for
+which interrupts are disabled short.  Each list costs the RAM of one
+xList structure, so there is little to gain from making it larger, and an
+application that only ever binds one or two sockets can set it to 1. */
+#define ipconfigSOCKET_HASH_BUCKETS					8
+
+/* If ipconfigUSE_LINKED_RX_MESSAGES is set to 1 then a network interface driver
+can pass several received frames to the IP task in one event, by linking the
+network buffers through their pxNextBuffer members and calling
+FreeRTOS_ReceivedEthernetFrames().  Adds a pointer to each network buffer.  The
+WinPCap driver used by this demo passes the frames that WinPCap already has
+waiting to the IP task in this way. */
+#define ipconfigUSE_LINKED_RX_MESSAGES				1
+
+/* Once the IP task has been woken it processes up to ipconfigIP_TASK_BATCH_SIZE
+events that are already queued before tasks that are blocked on sockets are
+woken.  Each socket's receiving task is then woken once for all the packets
+queued on the socket during the batch, instead of once per packet.  Setting
+ipconfigIP_TASK_BATCH_SIZE to 1 wakes receiving tasks after every event. */
+#define ipconfigIP_TASK_BATCH_SIZE					8
+
 /* Used for stack testing only, and must be implemented in the network
 interface. */
 #define updconfigLOOPBACK_ETHERNET_PACKETS	0
@@ -76,6 +76,8 @@ typedef struct F_DRIVER  F_DRIVER;
 
 typedef int           ( *F_WRITESECTOR )( F_DRIVER * driver, void * data, unsigned long sector );
 typedef int           ( *F_READSECTOR )( F_DRIVER * driver, void * data, unsigned long sector );
+typedef int           ( *F_WRITEMULTIPLESECTOR )( F_DRIVER * driver, void * data, unsigned long sector, int cnt );
+typedef int           ( *F_READMULTIPLESECTOR )( F_DRIVER * driver, void * data, unsigned long sector, int cnt );
 typedef int           ( *F_GETPHY )( F_DRIVER * driver, F_PHY * phy );
 typedef long          ( *F_GETSTATUS )( F_DRIVER * driver );
 typedef void          ( *F_RELEASE )( F_DRIVER * driver );
@@ -91,6 +93,10 @@ typedef struct F_DRIVER
   F_GETPHY               getphy;
   F_GETSTATUS            getstatus;
   F_RELEASE              release;
+
+  /* optional, NULL if the driver transfers one sector at a time */
+  F_WRITEMULTIPLESECTOR  writemultiplesector;
+  F_READMULTIPLESECTOR   readmultiplesector;
 } _F_DRIVER;
 
 typedef F_DRIVER *( *F_DRIVERINIT )( unsigned long driver_param );
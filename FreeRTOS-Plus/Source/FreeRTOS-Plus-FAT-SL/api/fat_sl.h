@@ -52,6 +52,43 @@
 extern "C" {
 #endif
 
+/* defaults for configuration files which predate these settings */
+#ifndef F_FAT_CACHE_SECTORS
+ #define F_FAT_CACHE_SECTORS 1
+#endif
+
+#ifndef F_FILE_CLUSTER_RUNS
+ #define F_FILE_CLUSTER_RUNS 0
+#endif
+
+#ifndef F_FREE_CLUSTER_GROUPS
+ #define F_FREE_CLUSTER_GROUPS 0
+#endif
+
+#ifndef F_MAXFILES
+ #define F_MAXFILES 1
+#endif
+
+#ifndef F_LOCK_TRANSFER_SIZE
+ #define F_LOCK_TRANSFER_SIZE 0
+#endif
+
+#if F_FAT_CACHE_SECTORS < 1
+ #error F_FAT_CACHE_SECTORS must be at least 1
+#endif
+
+#if F_FILE_CLUSTER_RUNS > 255
+ #error F_FILE_CLUSTER_RUNS must not exceed 255
+#endif
+
+#if ( F_MAXFILES < 1 ) || ( F_MAXFILES > 255 )
+ #error F_MAXFILES must be between 1 and 255
+#endif
+
+#if F_LOCK_TRANSFER_SIZE % F_SECTOR_SIZE
+ #error F_LOCK_TRANSFER_SIZE must be a multiple of F_SECTOR_SIZE
+#endif
+
 #define F_MAXNAME 8                  /* 8 byte name */
 #define F_MAXEXT  3                  /* 3 byte extension */
 
@@ -70,6 +107,12 @@ typedef struct
   unsigned long  pos;
 } F_POS;
 
+typedef struct
+{
+  unsigned long  cluster;       /*first cluster of the run*/
+  unsigned long  count;         /*number of contiguous clusters*/
+} F_CLUSTERRUN;
+
 typedef struct
 {
   char            filename[F_MAXPATH]; /*file name+ext*/
@@ -110,11 +153,13 @@ typedef struct
   unsigned long  filesize;
   unsigned long  startcluster;
   unsigned long  relpos;
-  unsigned char  modified;
   unsigned char  mode;
-  unsigned char  _tdata[F_SECTOR_SIZE];
   F_POS          pos;
   F_POS          dirpos;
+#if F_FILE_CLUSTER_RUNS
+  F_CLUSTERRUN   runs[F_FILE_CLUSTER_RUNS]; /*known part of the cluster chain from startcluster*/
+  unsigned char  runcount;
+#endif
 #if F_FILE_CHANGED_EVENT
   char           filename[F_MAXPATH];   /* filename with full path */
 #endif
@@ -300,6 +345,8 @@ unsigned char fn_delete ( const char * filename );
 
 unsigned char fn_seteof ( F_FILE * );
 
+unsigned char fn_flush ( F_FILE * f );
+
 F_FILE * fn_truncate ( const char *, long );
 
 unsigned char fn_getcwd ( char * buffer, unsigned char maxlen, char root );
@@ -314,6 +361,19 @@ unsigned char fn_getserial ( unsigned long * );
 #include "FreeRTOS.h"
 #include "semphr.h"
 
+typedef struct
+{
+  unsigned long  locks;        /*number of times the lock was taken*/
+  unsigned long  waits;        /*number of times the lock was busy and a task had to wait*/
+  unsigned long  timeouts;     /*number of waits which gave up after F_MAX_LOCK_WAIT_TICKS*/
+  unsigned long  waitticks;    /*total ticks spent waiting*/
+  unsigned long  maxwaitticks; /*longest wait*/
+  unsigned long  maxholdticks; /*longest time the lock was held*/
+} F_LOCKSTAT;
+
+unsigned char fr_getlockstat ( F_LOCKSTAT * pstat, unsigned char reset );
+#define f_getlockstat( pstat, reset ) fr_getlockstat( pstat, reset )
+
 unsigned char fr_hardformat ( unsigned char fattype );
 #define f_hardformat( fattype ) fr_hardformat( fattype )
 #define f_format( fattype )    fr_hardformat( fattype )
@@ -408,7 +468,6 @@ unsigned char fn_findnext ( F_FIND * find );
 
 #define f_getserial( serial )  fn_getserial( serial )
 
-unsigned char fn_flush ( F_FILE * f );
 #define f_flush( filehandle ) fn_flush( filehandle )
 
 #define f_write( buf, size, _size_t, filehandle ) fn_write( buf, size, _size_t, filehandle )
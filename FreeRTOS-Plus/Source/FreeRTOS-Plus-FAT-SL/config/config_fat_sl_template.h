@@ -62,6 +62,11 @@ extern "C" {
 #define F_FS_THREAD_AWARE       1     /* Set to one if the file system will be access from more than one task. */
 #define F_MAXPATH               64    /* Maximum length a file name (including its full path) can be. */
 #define F_MAX_LOCK_WAIT_TICKS   20    /* The maximum number of RTOS ticks to wait when attempting to obtain a lock on the file system when F_FS_THREAD_AWARE is set to 1. */
+#define F_FAT_CACHE_SECTORS     4     /* The number of FAT sectors held in RAM.  Modified FAT sectors are written back when they are evicted or when a file is flushed or closed. */
+#define F_FILE_CLUSTER_RUNS     8     /* The number of contiguous cluster runs remembered for the open file so seeking does not have to follow the FAT chain.  Set to 0 to disable. */
+#define F_FREE_CLUSTER_GROUPS   128   /* The number of cluster groups whose free cluster count is kept in RAM (4 bytes each) so allocation skips full groups and f_getfreespace() does not scan the FAT.  Set to 0 to disable. */
+#define F_MAXFILES              4     /* The number of files that can be open at the same time.  A file can be open more than once for reading only. */
+#define F_LOCK_TRANSFER_SIZE    8192  /* When F_FS_THREAD_AWARE is 1, f_read() and f_write() give the lock back after this many bytes so other tasks are not held up by a long transfer.  Must be a multiple of F_SECTOR_SIZE.  Set to 0 to hold the lock for the whole call. */
 
 #ifdef __cplusplus
 }
@@ -213,7 +213,6 @@ unsigned char _f_findfilewc ( char * name, char * ext, F_POS * pos, F_DIRENTRY *
 
     {
       unsigned long  nextcluster;
-      gl_volume.fatsector = (unsigned long)-1;
       if ( _f_getclustervalue( pos->cluster, &nextcluster ) )
       {
         return 0;                                                          /*not found*/
@@ -832,8 +831,8 @@ unsigned char _f_addentry ( F_NAME * fsname, F_POS * pos, F_DIRENTRY * * pde )
 
     {
       unsigned long  cluster;
+      F_POS          clpos;
 
-      gl_volume.fatsector = (unsigned long)-1;
       ret = _f_getclustervalue( pos->cluster, &cluster );    /*try to get next cluster*/
       if ( ret )
       {
@@ -846,7 +845,7 @@ unsigned char _f_addentry ( F_NAME * fsname, F_POS * pos, F_DIRENTRY * * pde )
       }
       else
       {
-        ret = _f_alloccluster( &cluster );        /*get a new one*/
+        ret = _f_alloccluster( 1, &cluster );        /*get a new one*/
         if ( ret )
         {
           return ret;
@@ -854,20 +853,15 @@ unsigned char _f_addentry ( F_NAME * fsname, F_POS * pos, F_DIRENTRY * * pde )
 
         if ( cluster < F_CLUSTER_RESERVED )
         {
-          if ( gl_file.mode != F_FILE_CLOSE )
-          {
-            return F_ERR_NOMOREENTRY;
-          }
-
-          _f_clustertopos( cluster, &gl_file.pos );
+          _f_clustertopos( cluster, &clpos );
 
-          ret = _f_setclustervalue( gl_file.pos.cluster, F_CLUSTER_LAST );
+          ret = _f_setclustervalue( clpos.cluster, F_CLUSTER_LAST );
           if ( ret )
           {
             return ret;
           }
 
-          ret = _f_setclustervalue( pos->cluster, gl_file.pos.cluster );
+          ret = _f_setclustervalue( pos->cluster, clpos.cluster );
           if ( ret )
           {
             return ret;
@@ -879,20 +873,19 @@ unsigned char _f_addentry ( F_NAME * fsname, F_POS * pos, F_DIRENTRY * * pde )
             return ret;
           }
 
-          gl_volume.fatsector = (unsigned long)-1;
           psp_memset( gl_sector, 0, F_SECTOR_SIZE );
-          while ( gl_file.pos.sector < gl_file.pos.sectorend )
+          while ( clpos.sector < clpos.sectorend )
           {
-            ret = _f_writeglsector( gl_file.pos.sector );
+            ret = _f_writeglsector( clpos.sector );
             if ( ret )
             {
               return ret;
             }
 
-            gl_file.pos.sector++;
+            clpos.sector++;
           }
 
-          _f_clustertopos( gl_file.pos.cluster, pos );
+          _f_clustertopos( clpos.cluster, pos );
         }
         else
         {
@@ -926,6 +919,7 @@ unsigned char fn_mkdir ( const char * dirname )
 {
   F_POS          posdir;
   F_POS          pos;
+  F_POS          clpos;
   F_DIRENTRY   * de;
   F_NAME         fsname;
   unsigned long  cluster;
@@ -970,8 +964,7 @@ unsigned char fn_mkdir ( const char * dirname )
 
   pos = posdir;
 
-  gl_volume.fatsector = (unsigned long)-1;
-  ret = _f_alloccluster( &cluster );
+  ret = _f_alloccluster( 1, &cluster );
   if ( ret )
   {
     return ret;
@@ -998,12 +991,7 @@ unsigned char fn_mkdir ( const char * dirname )
 
  #endif
 
-  if ( gl_file.mode != F_FILE_CLOSE )
-  {
-    return F_ERR_LOCKED;
-  }
-
-  _f_clustertopos( cluster, &gl_file.pos );
+  _f_clustertopos( cluster, &clpos );
   _f_setdecluster( de, cluster ); /*new dir*/
 
   (void)_f_writeglsector( (unsigned long)-1 );  /*write actual directory sector*/
@@ -1024,27 +1012,26 @@ unsigned char fn_mkdir ( const char * dirname )
   psp_memset( de, 0, ( F_SECTOR_SIZE - 2 * sizeof( F_DIRENTRY ) ) );
 
 
-  ret = _f_writeglsector( gl_file.pos.sector );
+  ret = _f_writeglsector( clpos.sector );
   if ( ret )
   {
     return ret;
   }
 
-  gl_file.pos.sector++;
+  clpos.sector++;
   psp_memset( gl_sector, 0, ( 2 * sizeof( F_DIRENTRY ) ) );
-  while ( gl_file.pos.sector < gl_file.pos.sectorend )
+  while ( clpos.sector < clpos.sectorend )
   {
-    ret = _f_writeglsector( gl_file.pos.sector );
+    ret = _f_writeglsector( clpos.sector );
     if ( ret )
     {
       return ret;
     }
 
-    gl_file.pos.sector++;
+    clpos.sector++;
   }
 
-  gl_volume.fatsector = (unsigned long)-1;
-  ret = _f_setclustervalue( gl_file.pos.cluster, F_CLUSTER_LAST );
+  ret = _f_setclustervalue( clpos.cluster, F_CLUSTER_LAST );
   if ( ret )
   {
     return ret;
@@ -1089,6 +1076,7 @@ unsigned char fn_rmdir ( const char * dirname )
 {
   unsigned char  ret;
   F_POS          pos;
+  F_POS          clpos;
   F_DIRENTRY   * de;
   F_NAME         fsname;
   unsigned long  dirsector;
@@ -1132,24 +1120,32 @@ unsigned char fn_rmdir ( const char * dirname )
 
   dirsector = gl_volume.actsector;
 
-  if ( gl_file.mode != F_FILE_CLOSE )
-  {
-    return F_ERR_LOCKED;
-  }
-
-  _f_clustertopos( _f_getdecluster( de ), &gl_file.pos );
+  _f_clustertopos( _f_getdecluster( de ), &clpos );
 
   for ( ; ; )
   {
     F_DIRENTRY * de2;
     char         ch = 0;
 
-    ret = _f_getcurrsector();
-    if ( ret == F_ERR_EOF )
+    if ( clpos.sector == clpos.sectorend )
     {
-      break;
+      unsigned long  cluster;
+
+      ret = _f_getclustervalue( clpos.cluster, &cluster );
+      if ( ret )
+      {
+        return ret;
+      }
+
+      if ( cluster >= F_CLUSTER_RESERVED )
+      {
+        break;
+      }
+
+      _f_clustertopos( cluster, &clpos );
     }
 
+    ret = _f_readglsector( clpos.sector );
     if ( ret )
     {
       return ret;
@@ -1182,7 +1178,7 @@ unsigned char fn_rmdir ( const char * dirname )
       break;
     }
 
-    gl_file.pos.sector++;
+    clpos.sector++;
   }
 
   ret = _f_readglsector( dirsector );
@@ -1199,7 +1195,6 @@ unsigned char fn_rmdir ( const char * dirname )
     return ret;
   }
 
-  gl_volume.fatsector = (unsigned long)-1;
   ret = _f_removechain( _f_getdecluster( de ) );
  #if F_FILE_CHANGED_EVENT
   if ( f_filechangedevent && !ret )
@@ -81,21 +81,25 @@ unsigned char _f_checkstatus ( void )
 
 /****************************************************************************
  *
- * _f_writesector
+ * _f_writemultiplesector
  *
- * write sector data on a volume, it calls low level driver function, it
- * writes a complete sector
+ * write consecutive sectors on a volume, it calls the multiple sector
+ * function of the low level driver if there is one, otherwise the sectors
+ * are written one by one
  *
  * INPUTS
- * sector - which physical sector
+ * data - sector data to be written
+ * sector - first physical sector
+ * cnt - number of sectors
  *
  * RETURNS
  * error code or zero if successful
  *
  ***************************************************************************/
-unsigned char _f_writeglsector ( unsigned long sector )
+unsigned char _f_writemultiplesector ( void * data, unsigned long sector, unsigned long cnt )
 {
-  unsigned char  retry;
+  unsigned char * d = (unsigned char *)data;
+  unsigned char   retry;
 
   if ( mdrv->writesector == NULL )
   {
@@ -103,49 +107,118 @@ unsigned char _f_writeglsector ( unsigned long sector )
     return F_ERR_ACCESSDENIED;
   }
 
-  if ( sector == (unsigned long)-1 )
+  if ( mdrv->getstatus != NULL )
   {
-    if ( gl_file.modified )
+    unsigned int  status;
+
+    status = mdrv->getstatus( mdrv );
+
+    if ( status & ( F_ST_MISSING | F_ST_CHANGED ) )
     {
-      sector = gl_file.pos.sector;
+      gl_volume.state = F_STATE_NEEDMOUNT; /*card has been removed;*/
+      return F_ERR_CARDREMOVED;
     }
-    else
+
+    if ( status & ( F_ST_WRPROTECT ) )
     {
-      sector = gl_volume.actsector;
+      gl_volume.state = F_STATE_NEEDMOUNT;  /*card has been removed;*/
+      return F_ERR_WRITEPROTECT;
     }
   }
 
-  if ( sector != (unsigned long)-1 )
+  while ( cnt )
   {
-    if ( mdrv->getstatus != NULL )
+    unsigned long  n = 1;
+
+    if ( ( cnt > 1 ) && ( mdrv->writemultiplesector != NULL ) )
+    {
+      n = cnt;
+    }
+
+    for ( retry = 3 ; retry ; retry-- )
     {
-      unsigned int  status;
+      int mdrv_ret;
+      if ( n > 1 )
+      {
+        mdrv_ret = mdrv->writemultiplesector( mdrv, d, sector, (int)n );
+      }
+      else
+      {
+        mdrv_ret = mdrv->writesector( mdrv, d, sector );
+      }
 
-      status = mdrv->getstatus( mdrv );
+      if ( !mdrv_ret )
+      {
+        break;
+      }
 
-      if ( status & ( F_ST_MISSING | F_ST_CHANGED ) )
+      if ( mdrv_ret == -1 )
       {
         gl_volume.state = F_STATE_NEEDMOUNT; /*card has been removed;*/
         return F_ERR_CARDREMOVED;
       }
+    }
 
-      if ( status & ( F_ST_WRPROTECT ) )
-      {
-        gl_volume.state = F_STATE_NEEDMOUNT;  /*card has been removed;*/
-        return F_ERR_WRITEPROTECT;
-      }
+    if ( !retry )
+    {
+      return F_ERR_ONDRIVE;
+    }
+
+    d += n * F_SECTOR_SIZE;
+    sector += n;
+    cnt -= n;
+  }
+
+  return F_NO_ERROR;
+} /* _f_writemultiplesector */
+
+
+/****************************************************************************
+ *
+ * _f_readmultiplesector
+ *
+ * read consecutive sectors from a volume, it calls the multiple sector
+ * function of the low level driver if there is one, otherwise the sectors
+ * are read one by one
+ *
+ * INPUTS
+ * data - where to store sector data
+ * sector - first physical sector
+ * cnt - number of sectors
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_readmultiplesector ( void * data, unsigned long sector, unsigned long cnt )
+{
+  unsigned char * d = (unsigned char *)data;
+  unsigned char   retry;
+
+  while ( cnt )
+  {
+    unsigned long  n = 1;
+
+    if ( ( cnt > 1 ) && ( mdrv->readmultiplesector != NULL ) )
+    {
+      n = cnt;
     }
 
-    gl_volume.modified = 0;
-    gl_file.modified = 0;
-    gl_volume.actsector = sector;
     for ( retry = 3 ; retry ; retry-- )
     {
       int mdrv_ret;
-      mdrv_ret = mdrv->writesector( mdrv, (unsigned char *)gl_sector, sector );
+      if ( n > 1 )
+      {
+        mdrv_ret = mdrv->readmultiplesector( mdrv, d, sector, (int)n );
+      }
+      else
+      {
+        mdrv_ret = mdrv->readsector( mdrv, d, sector );
+      }
+
       if ( !mdrv_ret )
       {
-        return F_NO_ERROR;
+        break;
       }
 
       if ( mdrv_ret == -1 )
@@ -154,11 +227,40 @@ unsigned char _f_writeglsector ( unsigned long sector )
         return F_ERR_CARDREMOVED;
       }
     }
+
+    if ( !retry )
+    {
+      return F_ERR_ONDRIVE;
+    }
+
+    d += n * F_SECTOR_SIZE;
+    sector += n;
+    cnt -= n;
   }
 
+  return F_NO_ERROR;
+} /* _f_readmultiplesector */
 
-  return F_ERR_ONDRIVE;
-} /* _f_writeglsector */
+
+/****************************************************************************
+ *
+ * _f_writesector
+ *
+ * write sector data on a volume, it calls low level driver function, it
+ * writes a complete sector
+ *
+ * INPUTS
+ * data - sector data to be written
+ * sector - which physical sector
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_writesector ( void * data, unsigned long sector )
+{
+  return _f_writemultiplesector( data, sector, 1 );
+} /* _f_writesector */
 
 
 /****************************************************************************
@@ -169,6 +271,65 @@ unsigned char _f_writeglsector ( unsigned long sector )
  * reads a complete sector
  *
  * INPUTS
+ * data - where to store sector data
+ * sector - which physical sector is read
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_readsector ( void * data, unsigned long sector )
+{
+  return _f_readmultiplesector( data, sector, 1 );
+} /* _f_readsector */
+
+
+/****************************************************************************
+ *
+ * _f_writeglsector
+ *
+ * write the actual sector buffer on a volume
+ *
+ * INPUTS
+ * sector - which physical sector, (unsigned long)-1 writes back the sector
+ *          the buffer was read from
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_writeglsector ( unsigned long sector )
+{
+  if ( mdrv->writesector == NULL )
+  {
+    gl_volume.state = F_STATE_NEEDMOUNT; /*no write function*/
+    return F_ERR_ACCESSDENIED;
+  }
+
+  if ( sector == (unsigned long)-1 )
+  {
+    sector = gl_volume.actsector;
+  }
+
+  if ( sector != (unsigned long)-1 )
+  {
+    gl_volume.modified = 0;
+    gl_volume.actsector = sector;
+    return _f_writesector( gl_sector, sector );
+  }
+
+
+  return F_ERR_ONDRIVE;
+} /* _f_writeglsector */
+
+
+/****************************************************************************
+ *
+ * _f_readglsector
+ *
+ * read a sector into the actual sector buffer
+ *
+ * INPUTS
  * sector - which physical sector is read
  *
  * RETURNS
@@ -177,7 +338,6 @@ unsigned char _f_writeglsector ( unsigned long sector )
  ***************************************************************************/
 unsigned char _f_readglsector ( unsigned long sector )
 {
-  unsigned char  retry;
   unsigned char  ret;
 
   if ( sector == gl_volume.actsector )
@@ -185,7 +345,7 @@ unsigned char _f_readglsector ( unsigned long sector )
     return F_NO_ERROR;
   }
 
-  if ( gl_volume.modified || gl_file.modified )
+  if ( gl_volume.modified )
   {
     ret = _f_writeglsector( (unsigned long)-1 );
     if ( ret )
@@ -194,25 +354,16 @@ unsigned char _f_readglsector ( unsigned long sector )
     }
   }
 
-
-  for ( retry = 3 ; retry ; retry-- )
+  ret = _f_readsector( gl_sector, sector );
+  if ( !ret )
   {
-    int mdrv_ret;
-    mdrv_ret = mdrv->readsector( mdrv, (unsigned char *)gl_sector, sector );
-    if ( !mdrv_ret )
-    {
-      gl_volume.actsector = sector;
-      return F_NO_ERROR;
-    }
-
-    if ( mdrv_ret == -1 )
-    {
-      gl_volume.state = F_STATE_NEEDMOUNT; /*card has been removed;*/
-      return F_ERR_CARDREMOVED;
-    }
+    gl_volume.actsector = sector;
+  }
+  else if ( ret == F_ERR_ONDRIVE )
+  {
+    gl_volume.actsector = (unsigned long)-1;
   }
 
-  gl_volume.actsector = (unsigned long)-1;
-  return F_ERR_ONDRIVE;
+  return ret;
 } /* _f_readglsector */
 
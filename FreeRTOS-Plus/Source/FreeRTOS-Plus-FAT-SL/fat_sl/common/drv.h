@@ -55,6 +55,10 @@ extern F_DRIVER * mdrv;  /* driver structure */
 unsigned char _f_checkstatus ( void );
 unsigned char _f_readglsector ( unsigned long );
 unsigned char _f_writeglsector ( unsigned long );
+unsigned char _f_readsector ( void *, unsigned long );
+unsigned char _f_writesector ( void *, unsigned long );
+unsigned char _f_readmultiplesector ( void *, unsigned long, unsigned long );
+unsigned char _f_writemultiplesector ( void *, unsigned long, unsigned long );
 
 #ifdef __cplusplus
 }
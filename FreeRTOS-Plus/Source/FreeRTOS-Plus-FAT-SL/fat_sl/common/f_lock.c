@@ -48,8 +48,143 @@
 
 #if F_FS_THREAD_AWARE == 1
 
+#include "task.h"
+
 xSemaphoreHandle fs_lock_semaphore;
 
+static F_LOCKSTAT    fs_lock_stat;     /*lock statistics, updated inside a critical section*/
+static portTickType  fs_lock_taketick; /*tick count when the current holder took the lock*/
+
+
+/*
+** _fr_lock
+**
+** Take the file system lock and account the time spent waiting for it.
+** An uncontended lock costs a single non-blocking take.
+**
+** RETURN: pdPASS if the lock is taken, pdFAIL on timeout
+*/
+static portBASE_TYPE _fr_lock ( void )
+{
+  portTickType   start;
+  portTickType   wait;
+  portBASE_TYPE  rc;
+
+  if( xSemaphoreTake( fs_lock_semaphore, 0 ) == pdPASS )
+  {
+    fs_lock_taketick = xTaskGetTickCount();
+    taskENTER_CRITICAL();
+    fs_lock_stat.locks++;
+    taskEXIT_CRITICAL();
+    return pdPASS;
+  }
+
+  start = xTaskGetTickCount();
+  rc = xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS );
+  fs_lock_taketick = xTaskGetTickCount();
+  wait = fs_lock_taketick - start;
+
+  taskENTER_CRITICAL();
+  fs_lock_stat.waits++;
+  fs_lock_stat.waitticks += wait;
+  if( wait > fs_lock_stat.maxwaitticks )
+  {
+    fs_lock_stat.maxwaitticks = wait;
+  }
+
+  if( rc == pdPASS )
+  {
+    fs_lock_stat.locks++;
+  }
+  else
+  {
+    fs_lock_stat.timeouts++;
+  }
+  taskEXIT_CRITICAL();
+
+  return rc;
+}
+
+
+/*
+** _fr_unlock
+**
+** Give back the file system lock and account how long it was held.
+*/
+static void _fr_unlock ( void )
+{
+  portTickType  hold = xTaskGetTickCount() - fs_lock_taketick;
+
+  taskENTER_CRITICAL();
+  if( hold > fs_lock_stat.maxholdticks )
+  {
+    fs_lock_stat.maxholdticks = hold;
+  }
+  taskEXIT_CRITICAL();
+
+  xSemaphoreGive( fs_lock_semaphore );
+}
+
+
+#if F_LOCK_TRANSFER_SIZE
+/*
+** _fr_transfer
+**
+** Read or write a large buffer in pieces of at most F_LOCK_TRANSFER_SIZE bytes,
+** giving the lock back between pieces so other tasks do not have to wait for the
+** whole transfer. Every piece after the first starts on a sector boundary, so
+** whole sectors still go straight to the driver.
+**
+** INPUT : buf - buffer to read into or write from
+**         size - number of bytes
+**         *filehandle - pointer to file descriptor
+**         wr - nonzero to write
+** RETURN: number of bytes transferred
+*/
+static long _fr_transfer ( char * buf, long size, F_FILE * filehandle, char wr )
+{
+  long  done = 0;
+  long  n;
+  long  rc;
+
+  while( done < size )
+  {
+    if( _fr_lock() != pdPASS )
+    {
+      break;
+    }
+
+    n = F_LOCK_TRANSFER_SIZE - ( fn_tell( filehandle ) % F_SECTOR_SIZE );
+    if( n > size - done )
+    {
+      n = size - done;
+    }
+
+    if( wr )
+    {
+      rc = fn_write( buf + done, 1, n, filehandle );
+    }
+    else
+    {
+      rc = fn_read( buf + done, 1, n, filehandle );
+    }
+
+    _fr_unlock();
+
+    done += rc;
+    if( rc != n )
+    {
+      break;
+    }
+
+    /* let a waiting task of the same priority in before taking the lock again */
+    taskYIELD();
+  }
+
+  return done;
+}
+#endif /* F_LOCK_TRANSFER_SIZE */
+
 
 /*
 ** fr_findfirst
@@ -65,10 +200,10 @@ unsigned char fr_findfirst ( const char * filename, F_FIND * find )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_findfirst( filename, find );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -92,10 +227,10 @@ unsigned char fr_findnext ( F_FIND * find )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_findnext( find );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -118,10 +253,10 @@ long fr_filelength ( const char * filename )
 {
   unsigned long  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_filelength( filename );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -145,10 +280,10 @@ F_FILE * fr_open ( const char * filename, const char * mode )
 {
   F_FILE * rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_open( filename, mode );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -171,10 +306,10 @@ unsigned char fr_close ( F_FILE * filehandle )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_close( filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -200,10 +335,17 @@ long fr_read ( void * bbuf, long size, long size_st, F_FILE * filehandle )
 {
   long  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+#if F_LOCK_TRANSFER_SIZE
+  if( ( size > 0 ) && ( size_st > 0 ) && ( size * size_st > F_LOCK_TRANSFER_SIZE ) )
+  {
+    return _fr_transfer( (char *)bbuf, size * size_st, filehandle, 0 ) / size;
+  }
+#endif
+
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_read( bbuf, size, size_st, filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -227,10 +369,17 @@ long fr_write ( const void * bbuf, long size, long size_st, F_FILE * filehandle
 {
   long  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+#if F_LOCK_TRANSFER_SIZE
+  if( ( size > 0 ) && ( size_st > 0 ) && ( size * size_st > F_LOCK_TRANSFER_SIZE ) )
+  {
+    return _fr_transfer( (char *)bbuf, size * size_st, filehandle, 1 ) / size;
+  }
+#endif
+
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_write( bbuf, size, size_st, filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -240,6 +389,31 @@ long fr_write ( const void * bbuf, long size, long size_st, F_FILE * filehandle
   return rc;
 }
 
+/*
+** fr_flush
+**
+** Flush the file buffer and the file's directory entry to the volume.
+**
+** INPUT : *filehandle - pointer to the file descriptor
+** RETURN: F_NOERR on success, other if error
+*/
+unsigned char fr_flush ( F_FILE * filehandle )
+{
+  unsigned char  rc;
+
+  if( _fr_lock() == pdPASS )
+  {
+    rc = fn_flush( filehandle );
+    _fr_unlock();
+  }
+  else
+  {
+    rc = F_ERR_OS;
+  }
+
+  return rc;
+}
+
 /*
 ** fr_seek
 **
@@ -256,10 +430,10 @@ unsigned char fr_seek ( F_FILE * filehandle, long offset, unsigned char whence )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_seek( filehandle, offset, whence );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -281,10 +455,10 @@ long fr_tell ( F_FILE * filehandle )
 {
   long  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_tell( filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -306,10 +480,10 @@ int fr_getc ( F_FILE * filehandle )
 {
   int  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_getc( filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -332,10 +506,10 @@ int fr_putc ( int ch, F_FILE * filehandle )
 {
   int  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_putc( ch, filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -357,10 +531,10 @@ unsigned char fr_rewind ( F_FILE * filehandle )
 {
   unsigned char rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_rewind( filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -384,10 +558,10 @@ unsigned char fr_eof ( F_FILE * filehandle )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_eof( filehandle );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -404,10 +578,10 @@ unsigned char fr_hardformat ( unsigned char fattype )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_hardformat( fattype );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -429,10 +603,10 @@ unsigned char fr_getserial ( unsigned long * serial )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_getserial( serial );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -456,10 +630,35 @@ unsigned char fr_delete ( const char * filename )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_delete( filename );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
+  }
+  else
+  {
+    rc = F_ERR_OS;
+  }
+
+  return rc;
+}
+
+/*
+** fr_seteof
+**
+** Set the end of the file to the current position
+**
+** INPUT : *filehandle - pointer to a file descriptor
+** RETURN: F_NOERR on succes, other if error.
+*/
+unsigned char fr_seteof ( F_FILE * filehandle )
+{
+  unsigned char  rc;
+
+  if( _fr_lock() == pdPASS )
+  {
+    rc = fn_seteof( filehandle );
+    _fr_unlock();
   }
   else
   {
@@ -482,10 +681,10 @@ F_FILE * fr_truncate ( const char * filename, long filesize )
 {
   F_FILE * f;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     f = fn_truncate( filename, filesize );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -509,10 +708,10 @@ unsigned char fr_getfreespace ( F_SPACE * sp )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_getfreespace( sp );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -535,10 +734,10 @@ unsigned char fr_chdir ( const char * path )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_chdir( path );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -561,10 +760,10 @@ unsigned char fr_mkdir ( const char * path )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_mkdir( path );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -587,10 +786,10 @@ unsigned char fr_rmdir ( const char * path )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_rmdir( path );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -614,10 +813,10 @@ unsigned char fr_getcwd ( char * path, unsigned char maxlen, char root )
 {
   unsigned char  rc;
 
-  if( xSemaphoreTake( fs_lock_semaphore, F_MAX_LOCK_WAIT_TICKS ) == pdPASS )
+  if( _fr_lock() == pdPASS )
   {
     rc = fn_getcwd( path, maxlen, root );
-    xSemaphoreGive( fs_lock_semaphore );
+    _fr_unlock();
   }
   else
   {
@@ -628,6 +827,36 @@ unsigned char fr_getcwd ( char * path, unsigned char maxlen, char root )
 }
 
 
+/*
+** fr_getlockstat
+**
+** Get the file system lock statistics. Wait and hold times are in RTOS ticks,
+** and the longest wait tells how long a task of the given priority may be
+** held up by file system use of other tasks.
+**
+** OUTPUT: *pstat - where to store the statistics
+** INPUT : reset - nonzero to clear the statistics after reading them
+** RETURN: F_NO_ERROR
+*/
+unsigned char fr_getlockstat ( F_LOCKSTAT * pstat, unsigned char reset )
+{
+  taskENTER_CRITICAL();
+  *pstat = fs_lock_stat;
+  if( reset )
+  {
+    fs_lock_stat.locks = 0;
+    fs_lock_stat.waits = 0;
+    fs_lock_stat.timeouts = 0;
+    fs_lock_stat.waitticks = 0;
+    fs_lock_stat.maxwaitticks = 0;
+    fs_lock_stat.maxholdticks = 0;
+  }
+  taskEXIT_CRITICAL();
+
+  return F_NO_ERROR;
+}
+
+
 /*
 ** fr_init
 **
@@ -38,6 +38,7 @@
  *
  */
 #include "../../api/fat_sl.h"
+#include "../../psp/include/psp_string.h"
 
 #include "fat.h"
 #include "util.h"
@@ -51,25 +52,29 @@
 
 /****************************************************************************
  *
- * _f_writefatsector
+ * _f_writefatcache
+ *
+ * writing a FAT cache entry into every FAT copy of the volume, this function
+ * check if the entry was modified and writes data
+ *
+ * INPUTS
  *
- * writing fat sector into volume, this function check if fat was modified
- * and writes data
+ * fc - FAT cache entry
  *
  * RETURNS
  *
  * error code or zero if successful
  *
  ***************************************************************************/
-unsigned char _f_writefatsector ( void )
+static unsigned char _f_writefatcache ( F_FATCACHE * fc )
 {
   unsigned char  a;
 
-  if ( gl_volume.modified )
+  if ( fc->modified )
   {
-    unsigned long  fatsector = gl_volume.firstfat.sector + gl_volume.fatsector;
+    unsigned long  fatsector = gl_volume.firstfat.sector + fc->sector;
 
-    if ( gl_volume.fatsector >= gl_volume.firstfat.num )
+    if ( fc->sector >= gl_volume.firstfat.num )
     {
       return F_ERR_INVALIDSECTOR;
     }
@@ -77,7 +82,7 @@ unsigned char _f_writefatsector ( void )
     for ( a = 0 ; a < gl_volume.bootrecord.number_of_FATs ; a++ )
     {
       unsigned char  ret;
-      ret = _f_writeglsector( fatsector );
+      ret = _f_writesector( fc->_tdata, fatsector );
       if ( ret )
       {
         return ret;
@@ -86,7 +91,37 @@ unsigned char _f_writefatsector ( void )
       fatsector += gl_volume.firstfat.num;
     }
 
-    gl_volume.modified = 0;
+    fc->modified = 0;
+  }
+
+  return F_NO_ERROR;
+} /* _f_writefatcache */
+
+
+
+/****************************************************************************
+ *
+ * _f_writefatsector
+ *
+ * writing every modified FAT sector of the FAT cache into volume
+ *
+ * RETURNS
+ *
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_writefatsector ( void )
+{
+  unsigned int  a;
+
+  for ( a = 0 ; a < F_FAT_CACHE_SECTORS ; a++ )
+  {
+    unsigned char  ret;
+    ret = _f_writefatcache( &gl_volume.fatcache[a] );
+    if ( ret )
+    {
+      return ret;
+    }
   }
 
   return F_NO_ERROR;
@@ -94,54 +129,303 @@ unsigned char _f_writefatsector ( void )
 
 
 
+/****************************************************************************
+ *
+ * _f_resetfatcache
+ *
+ * drop every FAT cache entry without writing, used when the volume is
+ * mounted or formatted, the free cluster counts are dropped as well
+ *
+ ***************************************************************************/
+void _f_resetfatcache ( void )
+{
+  unsigned int  a;
+
+  for ( a = 0 ; a < F_FAT_CACHE_SECTORS ; a++ )
+  {
+    gl_volume.fatcache[a].sector = (unsigned long)-1;
+    gl_volume.fatcache[a].used = 0;
+    gl_volume.fatcache[a].modified = 0;
+  }
+
+  gl_volume.fatcacheused = 0;
+
+#if F_FREE_CLUSTER_GROUPS
+  gl_volume.freegroupshift = 0;
+#endif
+} /* _f_resetfatcache */
+
+
+
 /****************************************************************************
  *
  * _f_getfatsector
  *
- * read a fat sector from media
+ * get a fat sector from the FAT cache, on a miss the least recently used
+ * entry is written back if it was modified and the sector is read from
+ * media
  *
  * INPUTS
  *
  * sector - which fat sector is needed, this sector number is zero based
+ * pfc - where to store the FAT cache entry holding the sector
  *
  * RETURNS
  *
  * error code or zero if successful
  *
  ***************************************************************************/
-unsigned char _f_getfatsector ( unsigned long sector )
+static unsigned char _f_getfatsector ( unsigned long sector, F_FATCACHE * * pfc )
 {
-  unsigned char  a;
+  F_FATCACHE   * fc = gl_volume.fatcache;
+  F_FATCACHE   * lru = fc;
+  unsigned long  fatsector;
+  unsigned int   a;
+  unsigned char  ret;
 
-  if ( gl_volume.fatsector != sector )
+  if ( sector >= gl_volume.firstfat.num )
   {
-    unsigned long  fatsector;
+    return F_ERR_INVALIDSECTOR;
+  }
 
-    gl_volume.fatsector = sector;
+  for ( a = 0 ; a < F_FAT_CACHE_SECTORS ; a++, fc++ )
+  {
+    if ( fc->sector == sector )
+    {
+      fc->used = ++gl_volume.fatcacheused;
+      *pfc = fc;
+      return F_NO_ERROR;
+    }
 
-    if ( gl_volume.fatsector >= gl_volume.firstfat.num )
+    if ( fc->used < lru->used )
     {
-      return F_ERR_INVALIDSECTOR;
+      lru = fc;
     }
+  }
 
-    fatsector = gl_volume.firstfat.sector + gl_volume.fatsector;
+  ret = _f_writefatcache( lru );
+  if ( ret )
+  {
+    return ret;
+  }
 
-    for ( a = 0 ; a < gl_volume.bootrecord.number_of_FATs ; a++ )
+  lru->sector = (unsigned long)-1;
+  fatsector = gl_volume.firstfat.sector + sector;
+
+  for ( a = 0 ; a < gl_volume.bootrecord.number_of_FATs ; a++ )
+  {
+    if ( !_f_readsector( lru->_tdata, fatsector ) )
+    {
+      lru->sector = sector;
+      lru->used = ++gl_volume.fatcacheused;
+      *pfc = lru;
+      return F_NO_ERROR;
+    }
+
+    fatsector += gl_volume.firstfat.num;
+  }
+
+  return F_ERR_READ;
+} /* _f_getfatsector */
+
+
+
+#if F_FREE_CLUSTER_GROUPS
+
+/****************************************************************************
+ *
+ * _f_countfreeclusters
+ *
+ * count the free clusters of every cluster group, it is done once after
+ * the volume is mounted when the counts are needed first
+ *
+ * RETURNS
+ *
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_countfreeclusters ( void )
+{
+  unsigned long  cluster;
+  unsigned char  shift = 7;
+  unsigned char  ret;
+
+  if ( gl_volume.freegroupshift )
+  {
+    return F_NO_ERROR;
+  }
+
+  while ( ( ( gl_volume.maxcluster + 1 ) >> shift ) >= F_FREE_CLUSTER_GROUPS )
+  {
+    shift++;
+  }
+
+  psp_memset( gl_volume.freegroups, 0, sizeof( gl_volume.freegroups ) );
+  gl_volume.freeclusters = 0;
+  gl_volume.badclusters = 0;
+
+  for ( cluster = 2 ; cluster < gl_volume.maxcluster + 2 ; cluster++ )
+  {
+    unsigned long  value;
+
+    ret = _f_getclustervalue( cluster, &value );
+    if ( ret )
+    {
+      return ret;
+    }
+
+    if ( !value )
     {
-      if ( !_f_readglsector( fatsector ) )
+      ++gl_volume.freegroups[cluster >> shift];
+      ++gl_volume.freeclusters;
+    }
+    else if ( value == F_CLUSTER_BAD )
+    {
+      ++gl_volume.badclusters;
+    }
+  }
+
+  gl_volume.freegroupshift = shift;
+
+  return F_NO_ERROR;
+} /* _f_countfreeclusters */
+
+
+
+/****************************************************************************
+ *
+ * _f_countcluster
+ *
+ * update the free cluster counts before a cluster value is changed
+ *
+ * INPUTS
+ *
+ * cluster - which cluster's value is going to be modified
+ * data - new value of the cluster
+ *
+ * RETURNS
+ *
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+static unsigned char _f_countcluster ( unsigned long cluster, unsigned long _tdata )
+{
+  unsigned long  oldv;
+  unsigned char  ret;
+
+  if ( ( gl_volume.freegroupshift == 0 ) || ( cluster < 2 ) || ( cluster >= gl_volume.maxcluster + 2 ) )
+  {
+    return F_NO_ERROR;
+  }
+
+  ret = _f_getclustervalue( cluster, &oldv );
+  if ( ret )
+  {
+    return ret;
+  }
+
+  if ( !oldv && _tdata )
+  {
+    --gl_volume.freegroups[cluster >> gl_volume.freegroupshift];
+    --gl_volume.freeclusters;
+  }
+  else if ( oldv && !_tdata )
+  {
+    ++gl_volume.freegroups[cluster >> gl_volume.freegroupshift];
+    ++gl_volume.freeclusters;
+  }
+
+  if ( oldv == F_CLUSTER_BAD )
+  {
+    --gl_volume.badclusters;
+  }
+
+  if ( _tdata == F_CLUSTER_BAD )
+  {
+    ++gl_volume.badclusters;
+  }
+
+  return F_NO_ERROR;
+} /* _f_countcluster */
+
+
+
+/****************************************************************************
+ *
+ * _f_findfreegroup
+ *
+ * check whether enough free clusters follow a free cluster, if not the
+ * first cluster of the next completely free cluster group is taken instead
+ *
+ * INPUTS
+ *
+ * count - number of clusters needed
+ * pcluster - free cluster, it is replaced if a better one is found
+ *
+ * RETURNS
+ *
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+static unsigned char _f_findfreegroup ( unsigned long count, unsigned long * pcluster )
+{
+  unsigned char  shift = gl_volume.freegroupshift;
+  unsigned long  groupsize = 1UL << shift;
+  unsigned long  groupnum = ( gl_volume.maxcluster >> shift ) + 1;
+  unsigned long  cluster = *pcluster;
+  unsigned long  group;
+  unsigned long  cou;
+  unsigned char  ret;
+
+  if ( count > groupsize )
+  {
+    count = groupsize;
+  }
+
+  for ( cou = 1 ; cou < count ; cou++ )
+  {
+    unsigned long  value;
+
+    if ( cluster + cou >= gl_volume.maxcluster )
+    {
+      break;
+    }
+
+    ret = _f_getclustervalue( cluster + cou, &value );
+    if ( ret )
+    {
+      return ret;
+    }
+
+    if ( value )
+    {
+      break;
+    }
+  }
+
+  if ( cou < count )
+  {
+    group = cluster >> shift;
+    for ( cou = 1 ; cou < groupnum ; cou++ )
+    {
+      if ( ++group >= groupnum )
       {
-        return F_NO_ERROR;
+        group = 0;
       }
 
-      fatsector += gl_volume.firstfat.num;
+      if ( ( gl_volume.freegroups[group] == groupsize )
+          && ( ( ( group + 1 ) << shift ) <= gl_volume.maxcluster ) )
+      {
+        *pcluster = group << shift;
+        break;
+      }
     }
-
-    return F_ERR_READ;
   }
 
   return F_NO_ERROR;
-} /* _f_getfatsector */
+} /* _f_findfreegroup */
 
+#endif /* if F_FREE_CLUSTER_GROUPS */
 
 
 /****************************************************************************
@@ -162,8 +446,17 @@ unsigned char _f_getfatsector ( unsigned long sector )
  ***************************************************************************/
 unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
 {
+  F_FATCACHE   * fc;
   unsigned char  ret;
 
+#if F_FREE_CLUSTER_GROUPS
+  ret = _f_countcluster( cluster, _tdata );
+  if ( ret )
+  {
+    return ret;
+  }
+#endif
+
   switch ( gl_volume.mediatype )
   {
     case F_FAT16_MEDIA:
@@ -174,16 +467,16 @@ unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
       sector /= ( F_SECTOR_SIZE / 2 );
       cluster -= sector * ( F_SECTOR_SIZE / 2 );
 
-      ret = _f_getfatsector( sector );
+      ret = _f_getfatsector( sector, &fc );
       if ( ret )
       {
         return ret;
       }
 
-      if ( _f_getword( &gl_sector[cluster << 1] ) != s_data )
+      if ( _f_getword( &fc->_tdata[cluster << 1] ) != s_data )
       {
-        _f_setword( &gl_sector[cluster << 1], s_data );
-        gl_volume.modified = 1;
+        _f_setword( &fc->_tdata[cluster << 1], s_data );
+        fc->modified = 1;
       }
     }
     break;
@@ -206,7 +499,7 @@ unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
       pos = (unsigned short)( sector % F_SECTOR_SIZE );
       sector /= F_SECTOR_SIZE;
 
-      ret = _f_getfatsector( sector );
+      ret = _f_getfatsector( sector, &fc );
       if ( ret )
       {
         return ret;
@@ -214,19 +507,19 @@ unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
 
       if ( cluster & 1 )
       {
-        f12new[0] |= gl_sector[pos] & 0x0f;
+        f12new[0] |= fc->_tdata[pos] & 0x0f;
       }
 
-      if ( gl_sector[pos] != f12new[0] )
+      if ( fc->_tdata[pos] != f12new[0] )
       {
-        gl_sector[pos] = f12new[0];
-        gl_volume.modified = 1;
+        fc->_tdata[pos] = f12new[0];
+        fc->modified = 1;
       }
 
       pos++;
       if ( pos >= 512 )
       {
-        ret = _f_getfatsector( sector + 1 );
+        ret = _f_getfatsector( sector + 1, &fc );
         if ( ret )
         {
           return ret;
@@ -237,13 +530,13 @@ unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
 
       if ( !( cluster & 1 ) )
       {
-        f12new[1] |= gl_sector[pos] & 0xf0;
+        f12new[1] |= fc->_tdata[pos] & 0xf0;
       }
 
-      if ( gl_sector[pos] != f12new[1] )
+      if ( fc->_tdata[pos] != f12new[1] )
       {
-        gl_sector[pos] = f12new[1];
-        gl_volume.modified = 1;
+        fc->_tdata[pos] = f12new[1];
+        fc->modified = 1;
       }
     }
     break;
@@ -256,21 +549,21 @@ unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
       sector /= ( F_SECTOR_SIZE / 4 );
       cluster -= sector * ( F_SECTOR_SIZE / 4 );
 
-      ret = _f_getfatsector( sector );
+      ret = _f_getfatsector( sector, &fc );
       if ( ret )
       {
         return ret;
       }
 
-      oldv = _f_getlong( &gl_sector[cluster << 2] );
+      oldv = _f_getlong( &fc->_tdata[cluster << 2] );
 
       _tdata &= 0x0fffffff;
       _tdata |= oldv & 0xf0000000; /*keep 4 top bits*/
 
       if ( _tdata != oldv )
       {
-        _f_setlong( &gl_sector[cluster << 2], _tdata );
-        gl_volume.modified = 1;
+        _f_setlong( &fc->_tdata[cluster << 2], _tdata );
+        fc->modified = 1;
       }
     }
     break;
@@ -301,6 +594,7 @@ unsigned char _f_setclustervalue ( unsigned long cluster, unsigned long _tdata )
  ***************************************************************************/
 unsigned char _f_getclustervalue ( unsigned long cluster, unsigned long * pvalue )
 {
+  F_FATCACHE   * fc;
   unsigned long  val;
   unsigned char  ret;
 
@@ -312,13 +606,13 @@ unsigned char _f_getclustervalue ( unsigned long cluster, unsigned long * pvalue
       sector /= ( F_SECTOR_SIZE / 2 );
       cluster -= sector * ( F_SECTOR_SIZE / 2 );
 
-      ret = _f_getfatsector( sector );
+      ret = _f_getfatsector( sector, &fc );
       if ( ret )
       {
         return ret;
       }
 
-      val = _f_getword( &gl_sector[cluster << 1] );
+      val = _f_getword( &fc->_tdata[cluster << 1] );
       if ( val >= ( F_CLUSTER_RESERVED & 0xffff ) )
       {
         val |= 0x0ffff000;                                       /*extends it*/
@@ -341,17 +635,17 @@ unsigned char _f_getclustervalue ( unsigned long cluster, unsigned long * pvalue
       pos = (unsigned short)( sector % F_SECTOR_SIZE );
       sector /= F_SECTOR_SIZE;
 
-      ret = _f_getfatsector( sector );
+      ret = _f_getfatsector( sector, &fc );
       if ( ret )
       {
         return ret;
       }
 
-      dataf12[0] = gl_sector[pos++];
+      dataf12[0] = fc->_tdata[pos++];
 
       if ( pos >= 512 )
       {
-        ret = _f_getfatsector( sector + 1 );
+        ret = _f_getfatsector( sector + 1, &fc );
         if ( ret )
         {
           return ret;
@@ -360,7 +654,7 @@ unsigned char _f_getclustervalue ( unsigned long cluster, unsigned long * pvalue
         pos = 0;
       }
 
-      dataf12[1] = gl_sector[pos];
+      dataf12[1] = fc->_tdata[pos];
 
       val = _f_getword( dataf12 );
 
@@ -391,7 +685,7 @@ unsigned char _f_getclustervalue ( unsigned long cluster, unsigned long * pvalue
       sector /= ( F_SECTOR_SIZE / 4 );
       cluster -= sector * ( F_SECTOR_SIZE / 4 );
 
-      ret = _f_getfatsector( sector );
+      ret = _f_getfatsector( sector, &fc );
       if ( ret )
       {
         return ret;
@@ -399,7 +693,7 @@ unsigned char _f_getclustervalue ( unsigned long cluster, unsigned long * pvalue
 
       if ( pvalue )
       {
-        *pvalue = _f_getlong( &gl_sector[cluster << 2] ) & 0x0fffffff;       /*28bit*/
+        *pvalue = _f_getlong( &fc->_tdata[cluster << 2] ) & 0x0fffffff;       /*28bit*/
       }
     }
     break;
@@ -457,9 +751,10 @@ void _f_clustertopos ( unsigned long cluster, F_POS * pos )
 
 /****************************************************************************
  *
- * _f_getcurrsector
+ * _f_seekcurrsector
  *
- * read current sector according in file structure
+ * step the file position into the next cluster if it is at the end of the
+ * current one, the sector is not read
  *
  * INPUTS
  * f - internal file pointer
@@ -468,15 +763,14 @@ void _f_clustertopos ( unsigned long cluster, F_POS * pos )
  * error code or zero if successful
  *
  ***************************************************************************/
-unsigned char _f_getcurrsector ( void )
+unsigned char _f_seekcurrsector ( F_FILE * f )
 {
   unsigned char  ret;
   unsigned long  cluster;
 
-  if ( gl_file.pos.sector == gl_file.pos.sectorend )
+  if ( f->pos.sector == f->pos.sectorend )
   {
-    gl_volume.fatsector = (unsigned long)-1;
-    ret = _f_getclustervalue( gl_file.pos.cluster, &cluster );
+    ret = _f_getnextcluster( f, f->pos.cluster, &cluster );
     if ( ret )
     {
       return ret;
@@ -487,10 +781,37 @@ unsigned char _f_getcurrsector ( void )
       return F_ERR_EOF;
     }
 
-    _f_clustertopos( cluster, &gl_file.pos );
+    _f_clustertopos( cluster, &f->pos );
   }
 
-  return _f_readglsector( gl_file.pos.sector );
+  return F_NO_ERROR;
+} /* _f_seekcurrsector */
+
+
+/****************************************************************************
+ *
+ * _f_getcurrsector
+ *
+ * read current sector according in file structure
+ *
+ * INPUTS
+ * f - internal file pointer
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_getcurrsector ( F_FILE * f )
+{
+  unsigned char  ret;
+
+  ret = _f_seekcurrsector( f );
+  if ( ret )
+  {
+    return ret;
+  }
+
+  return _f_readglsector( f->pos.sector );
 } /* _f_getcurrsector */
 
 
@@ -499,9 +820,13 @@ unsigned char _f_getcurrsector ( void )
  *
  * _f_alloccluster
  *
- * allocate cluster from FAT
+ * allocate cluster from FAT, the search starts after the last allocated
+ * cluster, when more clusters are needed and that is not followed by enough
+ * free ones a completely free cluster group is preferred to keep the file
+ * contiguous
  *
  * INPUTS
+ * count - number of clusters the caller is going to need
  * pcluster - where to store the allocated cluster number
  *
  * RETURNS
@@ -509,7 +834,7 @@ unsigned char _f_getcurrsector ( void )
  * error code or zero if successful
  *
  ***************************************************************************/
-unsigned char _f_alloccluster ( unsigned long * pcluster )
+unsigned char _f_alloccluster ( unsigned long count, unsigned long * pcluster )
 {
   unsigned long  maxcluster = gl_volume.maxcluster;
   unsigned long  cou;
@@ -517,6 +842,20 @@ unsigned char _f_alloccluster ( unsigned long * pcluster )
   unsigned long  value;
   unsigned char  ret;
 
+#if F_FREE_CLUSTER_GROUPS
+  unsigned char  shift;
+
+  ret = _f_countfreeclusters();
+  if ( ret )
+  {
+    return ret;
+  }
+
+  shift = gl_volume.freegroupshift;
+#else
+  (void)count;
+#endif
+
   for ( cou = 0 ; cou < maxcluster ; cou++ )
   {
     if ( cluster >= maxcluster )
@@ -524,6 +863,14 @@ unsigned char _f_alloccluster ( unsigned long * pcluster )
       cluster = 0;
     }
 
+#if F_FREE_CLUSTER_GROUPS
+    if ( !gl_volume.freegroups[cluster >> shift] )
+    {
+      cluster = ( ( cluster >> shift ) + 1 ) << shift;    /*skip full group*/
+      continue;
+    }
+#endif
+
     ret = _f_getclustervalue( cluster, &value );
     if ( ret )
     {
@@ -532,6 +879,17 @@ unsigned char _f_alloccluster ( unsigned long * pcluster )
 
     if ( !value )
     {
+#if F_FREE_CLUSTER_GROUPS
+      if ( ( count > 1 ) && ( cluster != gl_volume.lastalloccluster ) )
+      {
+        ret = _f_findfreegroup( count, &cluster );
+        if ( ret )
+        {
+          return ret;
+        }
+      }
+#endif
+
       gl_volume.lastalloccluster = cluster + 1;   /*set next one*/
       *pcluster = cluster;
 
@@ -563,8 +921,6 @@ unsigned char _f_alloccluster ( unsigned long * pcluster )
  ***************************************************************************/
 unsigned char _f_removechain ( unsigned long cluster )
 {
-  gl_volume.fatsector = (unsigned long)-1;
-
   if ( cluster < gl_volume.lastalloccluster ) /*this could be the begining of alloc*/
   {
     gl_volume.lastalloccluster = cluster;
@@ -594,4 +950,218 @@ unsigned char _f_removechain ( unsigned long cluster )
 
 
 
+/****************************************************************************
+ *
+ * _f_resetfileruns
+ *
+ * forget the cluster runs of a file, it has to be called when the
+ * cluster chain of the file is shortened
+ *
+ * INPUTS
+ * f - internal file pointer
+ *
+ ***************************************************************************/
+void _f_resetfileruns ( F_FILE * f )
+{
+#if F_FILE_CLUSTER_RUNS
+  f->runcount = 0;
+#else
+  (void)f;
+#endif
+} /* _f_resetfileruns */
+
+
+
+/****************************************************************************
+ *
+ * _f_setfilerun
+ *
+ * record a link of the cluster chain of a file, only links which
+ * continue the already known part of the chain are stored
+ *
+ * INPUTS
+ * f - internal file pointer
+ * cluster - a cluster of the file
+ * nextcluster - the cluster following it in the chain
+ *
+ ***************************************************************************/
+void _f_setfilerun ( F_FILE * f, unsigned long cluster, unsigned long nextcluster )
+{
+#if F_FILE_CLUSTER_RUNS
+  F_CLUSTERRUN * run;
+
+  if ( ( nextcluster < 2 ) || ( nextcluster >= F_CLUSTER_RESERVED ) )
+  {
+    return;
+  }
+
+  if ( f->runcount == 0 )
+  {
+    if ( f->startcluster == 0 )
+    {
+      return;
+    }
+
+    f->runs[0].cluster = f->startcluster;
+    f->runs[0].count = 1;
+    f->runcount = 1;
+  }
+
+  run = &f->runs[f->runcount - 1];
+  if ( cluster != run->cluster + run->count - 1 )
+  {
+    return;                    /*not the end of the known chain*/
+  }
+
+  if ( nextcluster == cluster + 1 )
+  {
+    run->count++;
+  }
+  else if ( f->runcount < F_FILE_CLUSTER_RUNS )
+  {
+    run++;
+    run->cluster = nextcluster;
+    run->count = 1;
+    f->runcount++;
+  }
+#else
+  (void)f;
+  (void)cluster;
+  (void)nextcluster;
+#endif /* if F_FILE_CLUSTER_RUNS */
+} /* _f_setfilerun */
+
+
+
+/****************************************************************************
+ *
+ * _f_getnextcluster
+ *
+ * get the cluster following a cluster of a file, the known cluster
+ * runs are used if possible otherwise the FAT is read
+ *
+ * INPUTS
+ * f - internal file pointer
+ * cluster - a cluster of the file
+ * pnextcluster - where to store the next cluster value
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_getnextcluster ( F_FILE * f, unsigned long cluster, unsigned long * pnextcluster )
+{
+  unsigned char  ret;
+
+#if F_FILE_CLUSTER_RUNS
+  unsigned char  a;
+
+  for ( a = 0 ; a < f->runcount ; a++ )
+  {
+    F_CLUSTERRUN * run = &f->runs[a];
+
+    if ( ( cluster >= run->cluster ) && ( cluster - run->cluster < run->count ) )
+    {
+      if ( cluster - run->cluster + 1 < run->count )
+      {
+        *pnextcluster = cluster + 1;
+        return F_NO_ERROR;
+      }
+
+      if ( a + 1 < f->runcount )
+      {
+        *pnextcluster = f->runs[a + 1].cluster;
+        return F_NO_ERROR;
+      }
+
+      break;
+    }
+  }
+#else
+  (void)f;
+#endif /* if F_FILE_CLUSTER_RUNS */
+
+  ret = _f_getclustervalue( cluster, pnextcluster );
+  if ( ret )
+  {
+    return ret;
+  }
+
+  _f_setfilerun( f, cluster, *pnextcluster );
+
+  return F_NO_ERROR;
+} /* _f_getnextcluster */
+
+
+
+/****************************************************************************
+ *
+ * _f_seekcluster
+ *
+ * find the cluster at a given cluster index of a file, the known
+ * cluster runs are skipped without reading the FAT
+ *
+ * INPUTS
+ * f - internal file pointer
+ * pindex - cluster index from the file start, on return the index which
+ *          was reached, it is smaller if the chain ends earlier
+ * pcluster - where to store the cluster
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+unsigned char _f_seekcluster ( F_FILE * f, unsigned long * pindex, unsigned long * pcluster )
+{
+  unsigned long  index = 0;
+  unsigned long  cluster = f->startcluster;
+  unsigned char  ret;
+
+#if F_FILE_CLUSTER_RUNS
+  unsigned char  a;
+
+  for ( a = 0 ; a < f->runcount ; a++ )
+  {
+    F_CLUSTERRUN * run = &f->runs[a];
+
+    if ( *pindex - index < run->count )
+    {
+      *pcluster = run->cluster + ( *pindex - index );
+      return F_NO_ERROR;
+    }
+
+    index += run->count;
+    cluster = run->cluster + run->count - 1;
+  }
+
+  if ( index )
+  {
+    index--;                   /*continue from the last known cluster*/
+  }
+#endif /* if F_FILE_CLUSTER_RUNS */
+
+  while ( index < *pindex )
+  {
+    unsigned long  nextcluster;
+
+    ret = _f_getclustervalue( cluster, &nextcluster );
+    if ( ret )
+    {
+      return ret;
+    }
+
+    if ( nextcluster >= F_CLUSTER_RESERVED )
+    {
+      break;
+    }
+
+    _f_setfilerun( f, cluster, nextcluster );
+    cluster = nextcluster;
+    index++;
+  }
+
+  *pindex = index;
+  *pcluster = cluster;
+  return F_NO_ERROR;
+} /* _f_seekcluster */
 
@@ -50,15 +50,24 @@
 extern "C" {
 #endif
 
-unsigned char _f_getfatsector ( unsigned long );
+void _f_resetfatcache ( void );
 unsigned char _f_getclustervalue ( unsigned long, unsigned long * );
 void _f_clustertopos ( unsigned long, F_POS * );
-unsigned char _f_getcurrsector ( void );
+unsigned char _f_seekcurrsector ( F_FILE * );
+unsigned char _f_getcurrsector ( F_FILE * );
 
 unsigned char _f_writefatsector ( void );
 unsigned char _f_setclustervalue ( unsigned long, unsigned long );
-unsigned char _f_alloccluster ( unsigned long * );
+unsigned char _f_alloccluster ( unsigned long, unsigned long * );
 unsigned char _f_removechain ( unsigned long );
+#if F_FREE_CLUSTER_GROUPS
+unsigned char _f_countfreeclusters ( void );
+#endif
+
+void _f_resetfileruns ( F_FILE * );
+void _f_setfilerun ( F_FILE *, unsigned long, unsigned long );
+unsigned char _f_getnextcluster ( F_FILE *, unsigned long, unsigned long * );
+unsigned char _f_seekcluster ( F_FILE *, unsigned long *, unsigned long * );
 
 #ifdef __cplusplus
 }
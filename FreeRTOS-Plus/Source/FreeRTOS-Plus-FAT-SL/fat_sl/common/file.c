@@ -53,7 +53,7 @@
  #error Incompatible FAT_SL version number!
 #endif
 
-static unsigned char _f_stepnextsector ( void );
+static unsigned char _f_stepnextsector ( F_FILE * f, unsigned long size );
 
 
 /****************************************************************************
@@ -117,33 +117,48 @@ long fn_filelength ( const char * filename )
 
 /****************************************************************************
  *
- * _f_emptywritebuffer
+ * _f_stepnextsector
  *
- * empty write buffer if it contains unwritten data
+ * step the file position to the next sector, a new cluster is allocated
+ * at the end of the cluster chain
+ *
+ * INPUTS
+ * f - internal file pointer
+ * size - number of bytes still to be written, used to allocate contiguous
+ *        clusters
  *
  * RETURNS
  * error code or zero if successful
  *
  ***************************************************************************/
-static unsigned char _f_stepnextsector ( void )
+static unsigned char _f_stepnextsector ( F_FILE * f, unsigned long size )
 {
   unsigned char  ret;
   unsigned char  b_alloc;
 
+  if ( gl_volume.modified )
+  {
+    ret = _f_writeglsector( (unsigned long)-1 );
+    if ( ret )
+    {
+      return ret;
+    }
+  }
+
   b_alloc = 0;
-  gl_volume.fatsector = (unsigned long)-1;
-  if ( gl_file.startcluster == 0 )
+  gl_volume.actsector = (unsigned long)-1;    /*buffer is going to hold the next sector*/
+  if ( f->startcluster == 0 )
   {
     b_alloc = 1;
   }
   else
   {
-    ++gl_file.pos.sector;
-    if ( gl_file.pos.sector >= gl_file.pos.sectorend )
+    ++f->pos.sector;
+    if ( f->pos.sector >= f->pos.sectorend )
     {
       unsigned long  value;
 
-      ret = _f_getclustervalue( gl_file.pos.cluster, &value );
+      ret = _f_getnextcluster( f, f->pos.cluster, &value );
       if ( ret )
       {
         return ret;
@@ -151,7 +166,7 @@ static unsigned char _f_stepnextsector ( void )
 
       if ( ( value >= 2 ) && ( value < F_CLUSTER_RESERVED ) ) /*we are in chain*/
       {
-        _f_clustertopos( value, &gl_file.pos );    /*go to next cluster*/
+        _f_clustertopos( value, &f->pos );    /*go to next cluster*/
       }
       else
       {
@@ -163,8 +178,9 @@ static unsigned char _f_stepnextsector ( void )
   if ( b_alloc != 0 )
   {
     unsigned long  nextcluster;
+    unsigned long  clustersize = gl_volume.bootrecord.sector_per_cluster * F_SECTOR_SIZE;
 
-    ret = _f_alloccluster( &nextcluster );
+    ret = _f_alloccluster( ( size + clustersize - 1 ) / clustersize, &nextcluster );
     if ( ret )
     {
       return ret;
@@ -176,22 +192,22 @@ static unsigned char _f_stepnextsector ( void )
       return ret;
     }
 
-    if ( gl_file.startcluster == 0 )
+    if ( f->startcluster == 0 )
     {
-      gl_file.startcluster = nextcluster;
+      f->startcluster = nextcluster;
     }
     else
     {
-      ret = _f_setclustervalue( gl_file.pos.cluster, nextcluster );
+      ret = _f_setclustervalue( f->pos.cluster, nextcluster );
       if ( ret )
       {
         return ret;
       }
-    }
 
-    _f_clustertopos( nextcluster, &gl_file.pos );
+      _f_setfilerun( f, f->pos.cluster, nextcluster );
+    }
 
-    return _f_writefatsector();
+    _f_clustertopos( nextcluster, &f->pos );
   }
 
   return F_NO_ERROR;
@@ -205,26 +221,26 @@ static unsigned char _f_stepnextsector ( void )
  * Extend file to a certain size
  *
  ***************************************************************************/
-static unsigned char _f_extend ( long size )
+static unsigned char _f_extend ( F_FILE * f, long size )
 {
   unsigned long  _size;
   unsigned char  rc;
 
-  size -= gl_file.filesize;
+  size -= f->filesize;
   _size = (unsigned long)size;
 
-  if ( gl_file.startcluster == 0 )
+  if ( f->startcluster == 0 )
   {
-    if ( _f_stepnextsector() )
+    if ( _f_stepnextsector( f, _size ) )
     {
       return F_ERR_WRITE;
     }
   }
   else
   {
-    if ( ( gl_file.relpos > 0 ) && ( gl_file.relpos < F_SECTOR_SIZE ) )
+    if ( ( f->relpos > 0 ) && ( f->relpos < F_SECTOR_SIZE ) )
     {
-      rc = _f_getcurrsector();
+      rc = _f_getcurrsector( f );
       if ( rc )
       {
         return rc;
@@ -232,20 +248,20 @@ static unsigned char _f_extend ( long size )
     }
   }
 
-  if ( gl_file.relpos + _size >= F_SECTOR_SIZE )
+  if ( f->relpos + _size >= F_SECTOR_SIZE )
   {
-    if ( gl_file.relpos < F_SECTOR_SIZE )
+    if ( f->relpos < F_SECTOR_SIZE )
     {
-      psp_memset( gl_sector + gl_file.relpos, 0, ( F_SECTOR_SIZE - gl_file.relpos ) );
-      _size -= ( F_SECTOR_SIZE - gl_file.relpos );
+      psp_memset( gl_sector + f->relpos, 0, ( F_SECTOR_SIZE - f->relpos ) );
+      _size -= ( F_SECTOR_SIZE - f->relpos );
 
-      if ( _f_writeglsector( gl_file.pos.sector ) )
+      if ( _f_writeglsector( f->pos.sector ) )
       {
         return F_ERR_WRITE;
       }
     }
 
-    if ( _f_stepnextsector() )
+    if ( _f_stepnextsector( f, _size ) )
     {
       return F_ERR_WRITE;
     }
@@ -254,12 +270,12 @@ static unsigned char _f_extend ( long size )
 
     while ( _size >= F_SECTOR_SIZE )
     {
-      if ( _f_writeglsector( gl_file.pos.sector ) )
+      if ( _f_writeglsector( f->pos.sector ) )
       {
         return F_ERR_WRITE;
       }
 
-      if ( _f_stepnextsector() )
+      if ( _f_stepnextsector( f, _size ) )
       {
         return F_ERR_WRITE;
       }
@@ -271,14 +287,15 @@ static unsigned char _f_extend ( long size )
   }
   else
   {
-    psp_memset( gl_sector + gl_file.relpos, 0, ( F_SECTOR_SIZE - gl_file.relpos ) );
-    _size += gl_file.relpos;
+    psp_memset( gl_sector + f->relpos, 0, ( F_SECTOR_SIZE - f->relpos ) );
+    _size += f->relpos;
   }
 
-  gl_file.modified = 1;
-  gl_file.filesize += size;
-  gl_file.abspos = gl_file.filesize & ( ~( F_SECTOR_SIZE - 1 ) );
-  gl_file.relpos = _size;
+  gl_volume.actsector = f->pos.sector;
+  gl_volume.modified = 1;
+  f->filesize += size;
+  f->abspos = f->filesize & ( ~( F_SECTOR_SIZE - 1 ) );
+  f->relpos = _size;
 
   return F_NO_ERROR;
 } /* _f_extend */
@@ -293,6 +310,7 @@ static unsigned char _f_extend ( long size )
  * the current sector
  *
  * INPUTS
+ * f - internal file pointer
  * offset - position from start
  *
  * RETURNS
@@ -300,9 +318,10 @@ static unsigned char _f_extend ( long size )
  * error code or zero if successful
  *
  ***************************************************************************/
-static unsigned char _f_fseek ( long offset )
+static unsigned char _f_fseek ( F_FILE * f, long offset )
 {
   unsigned long  cluster;
+  unsigned long  index;
   unsigned long  tmp;
   unsigned char  ret = F_NO_ERROR;
   long           remain;
@@ -312,87 +331,81 @@ static unsigned char _f_fseek ( long offset )
     offset = 0;
   }
 
-  if ( ( (unsigned long) offset <= gl_file.filesize )
-       && ( (unsigned long) offset >= gl_file.abspos )
-       && ( (unsigned long) offset < gl_file.abspos + F_SECTOR_SIZE ) )
+  if ( ( (unsigned long) offset <= f->filesize )
+       && ( (unsigned long) offset >= f->abspos )
+       && ( (unsigned long) offset < f->abspos + F_SECTOR_SIZE ) )
   {
-    gl_file.relpos = (unsigned short)( offset - gl_file.abspos );
+    f->relpos = (unsigned short)( offset - f->abspos );
   }
   else
   {
-    if ( gl_file.modified )
+    if ( gl_volume.modified )
     {
       ret = _f_writeglsector( (unsigned long)-1 );
       if ( ret )
       {
-        gl_file.mode = F_FILE_CLOSE; /*cant accessed any more*/
+        f->mode = F_FILE_CLOSE; /*cant accessed any more*/
         return ret;
       }
     }
 
-    if ( gl_file.startcluster )
+    if ( f->startcluster )
     {
-      gl_file.abspos = 0;
-      gl_file.relpos = 0;
-      gl_file.pos.cluster = gl_file.startcluster;
-      remain = gl_file.filesize;
+      f->relpos = 0;
+      remain = f->filesize;
 
       tmp = gl_volume.bootrecord.sector_per_cluster;
       tmp *= F_SECTOR_SIZE;   /* set to cluster size */
 
-      /*calc cluster*/
-      gl_volume.fatsector = (unsigned long)-1;
-      while ( (unsigned long)offset >= tmp )
+      /*calc cluster, never beyond the one holding the last byte*/
+      index = 0;
+      if ( remain )
       {
-        ret = _f_getclustervalue( gl_file.pos.cluster, &cluster );
-        if ( ret )
-        {
-          gl_file.mode = F_FILE_CLOSE;
-          return ret;
-        }
-
-        if ( (long) tmp >= remain )
-        {
-          break;
-        }
-
-        remain -= tmp;
-        offset -= tmp;
-        gl_file.abspos += tmp;
-        if ( cluster >= F_CLUSTER_RESERVED )
+        index = ( (unsigned long)remain - 1 ) / tmp;
+        if ( (unsigned long)offset / tmp < index )
         {
-          break;
+          index = (unsigned long)offset / tmp;
         }
+      }
 
-        gl_file.pos.cluster = cluster;
+      ret = _f_seekcluster( f, &index, &cluster );
+      if ( ret )
+      {
+        f->mode = F_FILE_CLOSE;
+        return ret;
       }
 
-      _f_clustertopos( gl_file.pos.cluster, &gl_file.pos );
+      f->pos.cluster = cluster;
+      f->abspos = index * tmp;
+      remain -= (long)f->abspos;
+      offset -= (long)f->abspos;
+
+      _f_clustertopos( f->pos.cluster, &f->pos );
       if ( remain && offset )
       {
         while ( ( offset > (long) F_SECTOR_SIZE )
                && ( remain > (long) F_SECTOR_SIZE ) )
         {
-          gl_file.pos.sector++;
+          f->pos.sector++;
           offset -= F_SECTOR_SIZE;
           remain -= F_SECTOR_SIZE;
-          gl_file.abspos += F_SECTOR_SIZE;
+          f->abspos += F_SECTOR_SIZE;
         }
       }
 
       if ( remain < offset )
       {
-        gl_file.relpos = (unsigned short)remain;
-        ret = _f_extend( gl_file.filesize + offset - remain );
+        f->relpos = (unsigned short)remain;
+        ret = _f_extend( f, f->filesize + offset - remain );
       }
       else
       {
-        gl_file.relpos = (unsigned short)offset;
+        f->relpos = (unsigned short)offset;
       }
     }
     else
     {
-      ret = _f_extend( offset );
+      ret = _f_extend( f, offset );
     }
   }
 
@@ -401,6 +414,74 @@ static unsigned char _f_fseek ( long offset )
 
 
 
+/****************************************************************************
+ *
+ * _f_checkhandle
+ *
+ * check whether a file handle points into the file table
+ *
+ * INPUTS
+ * f - file handle
+ *
+ * RETURNS
+ * error code or zero if the handle is valid
+ *
+ ***************************************************************************/
+static unsigned char _f_checkhandle ( const F_FILE * f )
+{
+  if ( ( f < gl_files ) || ( f >= gl_files + F_MAXFILES ) )
+  {
+    return F_ERR_NOTOPEN;
+  }
+
+  if ( ( (const char *)f - (const char *)gl_files ) % sizeof( F_FILE ) )
+  {
+    return F_ERR_NOTOPEN;
+  }
+
+  return F_NO_ERROR;
+} /* _f_checkhandle */
+
+
+
+/****************************************************************************
+ *
+ * _f_checklocked
+ *
+ * check whether a directory entry belongs to an open file, a file can be
+ * open more than once for reading only
+ *
+ * INPUTS
+ * pos - position of the directory entry
+ * mode - mode the file is going to be opened with, F_FILE_CLOSE if any
+ *        open file locks the entry
+ *
+ * RETURNS
+ * F_ERR_LOCKED if the file is in use or zero
+ *
+ ***************************************************************************/
+static unsigned char _f_checklocked ( const F_POS * pos, unsigned char mode )
+{
+  unsigned char  a;
+
+  for ( a = 0 ; a < F_MAXFILES ; a++ )
+  {
+    const F_FILE * f = &gl_files[a];
+
+    if ( ( f->mode != F_FILE_CLOSE ) && ( f->dirpos.sector == pos->sector ) && ( f->dirpos.pos == pos->pos ) )
+    {
+      if ( ( mode != F_FILE_RD ) || ( f->mode != F_FILE_RD ) )
+      {
+        return F_ERR_LOCKED;
+      }
+    }
+  }
+
+  return F_NO_ERROR;
+} /* _f_checklocked */
+
+
+
 /****************************************************************************
  *
  * fn_open
@@ -420,11 +501,13 @@ static unsigned char _f_fseek ( long offset )
  ***************************************************************************/
 F_FILE * fn_open ( const char * filename, const char * mode )
 {
+  F_FILE        * f = 0;
   F_DIRENTRY    * de;
   F_NAME          fsname;
   unsigned short  date;
   unsigned short  time;
   unsigned char   m_mode = F_FILE_CLOSE;
+  unsigned char   a;
 
   if ( mode[1] == 0 )
   {
@@ -488,14 +571,23 @@ F_FILE * fn_open ( const char * filename, const char * mode )
     return 0;                     /*cant open any*/
   }
 
-  if ( gl_file.mode != F_FILE_CLOSE )
+  for ( a = 0 ; a < F_MAXFILES ; a++ )
   {
-    return 0;
+    if ( gl_files[a].mode == F_FILE_CLOSE )
+    {
+      f = &gl_files[a];
+      break;
+    }
+  }
+
+  if ( !f )
+  {
+    return 0;                     /*no free file handle*/
   }
 
-  psp_memset( &gl_file, 0, sizeof( F_FILE ) );
+  psp_memset( f, 0, sizeof( F_FILE ) );
 
-  if ( !_f_findpath( &fsname, &gl_file.dirpos ) )
+  if ( !_f_findpath( &fsname, &f->dirpos ) )
   {
     return 0;
   }
@@ -504,7 +596,7 @@ F_FILE * fn_open ( const char * filename, const char * mode )
   {
     case F_FILE_RDP:   /*r*/
     case F_FILE_RD:   /*r*/
-      if ( !_f_findfilewc( fsname.filename, fsname.fileext, &gl_file.dirpos, &de, 0 ) )
+      if ( !_f_findfilewc( fsname.filename, fsname.fileext, &f->dirpos, &de, 0 ) )
       {
         return 0;
       }
@@ -514,14 +606,19 @@ F_FILE * fn_open ( const char * filename, const char * mode )
         return 0;                                      /*directory*/
       }
 
-      gl_file.startcluster = _f_getdecluster( de );
+      if ( _f_checklocked( &f->dirpos, m_mode ) )
+      {
+        return 0;
+      }
+
+      f->startcluster = _f_getdecluster( de );
 
-      if ( gl_file.startcluster )
+      if ( f->startcluster )
       {
-        _f_clustertopos( gl_file.startcluster, &gl_file.pos );
-        gl_file.filesize = _f_getlong( &de->filesize );
-        gl_file.abspos = (unsigned long) (-1 * (long) F_SECTOR_SIZE);
-        if ( _f_fseek( 0 ) )
+        _f_clustertopos( f->startcluster, &f->pos );
+        f->filesize = _f_getlong( &de->filesize );
+        f->abspos = (unsigned long) (-1 * (long) F_SECTOR_SIZE);
+        if ( _f_fseek( f, 0 ) )
         {
           return 0;
         }
@@ -530,7 +627,7 @@ F_FILE * fn_open ( const char * filename, const char * mode )
 #if F_FILE_CHANGED_EVENT
       if ( m_mode == F_FILE_RDP )
       {
-        _f_createfullname( gl_file.filename, sizeof( gl_file.filename ), fsname.path, fsname.filename, fsname.fileext );
+        _f_createfullname( f->filename, sizeof( f->filename ), fsname.path, fsname.filename, fsname.fileext );
       }
 
 #endif
@@ -539,34 +636,39 @@ F_FILE * fn_open ( const char * filename, const char * mode )
 
     case F_FILE_AP:
     case F_FILE_A: /*a*/
-      psp_memcpy( &( gl_file.pos ), &( gl_file.dirpos ), sizeof( F_POS ) );
-      if ( _f_findfilewc( fsname.filename, fsname.fileext, &gl_file.dirpos, &de, 0 ) )
+      psp_memcpy( &( f->pos ), &( f->dirpos ), sizeof( F_POS ) );
+      if ( _f_findfilewc( fsname.filename, fsname.fileext, &f->dirpos, &de, 0 ) )
       {
         if ( de->attr & ( F_ATTR_DIR | F_ATTR_READONLY ) )
         {
           return 0;
         }
 
-        gl_file.startcluster = _f_getdecluster( de );
-        gl_file.filesize = _f_getlong( &de->filesize );
+        if ( _f_checklocked( &f->dirpos, m_mode ) )
+        {
+          return 0;
+        }
+
+        f->startcluster = _f_getdecluster( de );
+        f->filesize = _f_getlong( &de->filesize );
 
-        if ( gl_file.startcluster )
+        if ( f->startcluster )
         {
-          _f_clustertopos( gl_file.startcluster, &gl_file.pos );
-          gl_file.abspos = (unsigned long) (-1 * (long) F_SECTOR_SIZE);   /*forcing seek to read 1st sector! abspos=0;*/
-          if ( _f_fseek( (long)gl_file.filesize ) )
+          _f_clustertopos( f->startcluster, &f->pos );
+          f->abspos = (unsigned long) (-1 * (long) F_SECTOR_SIZE);   /*forcing seek to read 1st sector! abspos=0;*/
+          if ( _f_fseek( f, (long)f->filesize ) )
           {
-            gl_file.mode = F_FILE_CLOSE;
+            f->mode = F_FILE_CLOSE;
             return 0;
           }
         }
       }
       else
       {
-        psp_memcpy( &( gl_file.dirpos ), &( gl_file.pos ), sizeof( F_POS ) );
-        _f_clustertopos( gl_file.dirpos.cluster, &gl_file.pos );
+        psp_memcpy( &( f->dirpos ), &( f->pos ), sizeof( F_POS ) );
+        _f_clustertopos( f->dirpos.cluster, &f->pos );
 
-        if ( _f_addentry( &fsname, &gl_file.dirpos, &de ) )
+        if ( _f_addentry( &fsname, &f->dirpos, &de ) )
         {
           return 0;                                                  /*couldnt be added*/
         }
@@ -579,15 +681,15 @@ F_FILE * fn_open ( const char * filename, const char * mode )
       }
 
  #if F_FILE_CHANGED_EVENT
-      _f_createfullname( gl_file.filename, sizeof( gl_file.filename ), fsname.path, fsname.filename, fsname.fileext );
+      _f_createfullname( f->filename, sizeof( f->filename ), fsname.path, fsname.filename, fsname.fileext );
  #endif
       break;
 
 
     case F_FILE_WR:  /*w*/
     case F_FILE_WRP: /*w+*/
-      _f_clustertopos( gl_file.dirpos.cluster, &gl_file.pos );
-      if ( _f_findfilewc( fsname.filename, fsname.fileext, &gl_file.pos, &de, 0 ) )
+      _f_clustertopos( f->dirpos.cluster, &f->pos );
+      if ( _f_findfilewc( fsname.filename, fsname.fileext, &f->pos, &de, 0 ) )
       {
         unsigned long  cluster = _f_getdecluster( de );    /*exist*/
 
@@ -596,7 +698,12 @@ F_FILE * fn_open ( const char * filename, const char * mode )
           return 0;
         }
 
-        psp_memcpy( &( gl_file.dirpos ), &( gl_file.pos ), sizeof( F_POS ) );
+        if ( _f_checklocked( &f->pos, m_mode ) )
+        {
+          return 0;
+        }
+
+        psp_memcpy( &( f->dirpos ), &( f->pos ), sizeof( F_POS ) );
 
         _f_setlong( de->filesize, 0 );  /*reset size;*/
         de->attr |= F_ATTR_ARC;         /*set as archiv*/
@@ -623,12 +730,11 @@ F_FILE * fn_open ( const char * filename, const char * mode )
       }
       else
       {
-        if ( _f_addentry( &fsname, &gl_file.dirpos, &de ) )
+        if ( _f_addentry( &fsname, &f->dirpos, &de ) )
         {
           return 0;                                                  /*couldnt be added*/
         }
 
-        psp_memset( &gl_file, 0, 21 );
         de->attr |= F_ATTR_ARC;         /*set as archiv*/
         if ( _f_writeglsector( (unsigned long)-1 ) )
         {
@@ -637,7 +743,7 @@ F_FILE * fn_open ( const char * filename, const char * mode )
       }
 
  #if F_FILE_CHANGED_EVENT
-      _f_createfullname( gl_file.filename, sizeof( gl_file.filename ), fsname.path, fsname.filename, fsname.fileext );
+      _f_createfullname( f->filename, sizeof( f->filename ), fsname.path, fsname.filename, fsname.fileext );
  #endif
 
       break;
@@ -646,8 +752,8 @@ F_FILE * fn_open ( const char * filename, const char * mode )
       return 0;        /*invalid mode*/
   } /* switch */
 
-  gl_file.mode = m_mode; /* lock it */
-  return (F_FILE *)1;
+  f->mode = m_mode; /* lock it */
+  return f;
 } /* fn_open */
 
 
@@ -656,24 +762,27 @@ F_FILE * fn_open ( const char * filename, const char * mode )
  * Updated a file directory entry or removes the entry
  * and the fat chain belonging to it.
  ***************************************************************************/
-static unsigned char _f_updatefileentry ( int remove )
+static unsigned char _f_updatefileentry ( F_FILE * f, int remove )
 {
   F_DIRENTRY    * de;
   unsigned short  date;
   unsigned short  time;
+  unsigned char   ret;
+
+  ret = _f_writefatsector(); /*chain has to be on the media before the entry*/
 
-  de = (F_DIRENTRY *)( gl_sector + sizeof( F_DIRENTRY ) * gl_file.dirpos.pos );
-  if ( _f_readglsector( gl_file.dirpos.sector ) || remove )
+  de = (F_DIRENTRY *)( gl_sector + sizeof( F_DIRENTRY ) * f->dirpos.pos );
+  if ( ret || _f_readglsector( f->dirpos.sector ) || remove )
   {
     _f_setdecluster( de, 0 );
     _f_setlong( &de->filesize, 0 );
     (void)_f_writeglsector( (unsigned long)-1 );
-    (void)_f_removechain( gl_file.startcluster );
+    (void)_f_removechain( f->startcluster );
     return F_ERR_WRITE;
   }
 
-  _f_setdecluster( de, gl_file.startcluster );
-  _f_setlong( &de->filesize, gl_file.filesize );
+  _f_setdecluster( de, f->startcluster );
+  _f_setlong( &de->filesize, f->filesize );
   f_igettimedate( &time, &date );
   _f_setword( &de->cdate, date );  /*if there is realtime clock then creation date could be set from*/
   _f_setword( &de->ctime, time );  /*if there is realtime clock then creation time could be set from*/
@@ -709,7 +818,7 @@ unsigned char fn_close ( F_FILE * f )
   unsigned char  mode;
 #endif
 
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return F_ERR_NOTOPEN;
   }
@@ -720,14 +829,14 @@ unsigned char fn_close ( F_FILE * f )
     return ret;
   }
 
-  if ( gl_file.mode == F_FILE_CLOSE )
+  if ( f->mode == F_FILE_CLOSE )
   {
     return F_ERR_NOTOPEN;
   }
 
-  else if ( gl_file.mode == F_FILE_RD )
+  else if ( f->mode == F_FILE_RD )
   {
-    gl_file.mode = F_FILE_CLOSE;
+    f->mode = F_FILE_CLOSE;
     return F_NO_ERROR;
   }
   else
@@ -735,18 +844,18 @@ unsigned char fn_close ( F_FILE * f )
  #if F_FILE_CHANGED_EVENT
     mode = f->mode;
  #endif
-    gl_file.mode = F_FILE_CLOSE;
+    f->mode = F_FILE_CLOSE;
 
-    if ( gl_file.modified )
+    if ( gl_volume.modified )
     {
       if ( _f_writeglsector( (unsigned long)-1 ) )
       {
-        (void)_f_updatefileentry( 1 );
+        (void)_f_updatefileentry( f, 1 );
         return F_ERR_WRITE;
       }
     }
 
-    ret = _f_updatefileentry( 0 );
+    ret = _f_updatefileentry( f, 0 );
 
  #if F_FILE_CHANGED_EVENT
     if ( f_filechangedevent && !ret )
@@ -797,7 +906,7 @@ unsigned char fn_flush ( F_FILE * f )
 {
   unsigned char  ret;
 
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return F_ERR_NOTOPEN;
   }
@@ -808,28 +917,129 @@ unsigned char fn_flush ( F_FILE * f )
     return ret;
   }
 
-  if ( gl_file.mode == F_FILE_CLOSE )
+  if ( f->mode == F_FILE_CLOSE )
   {
     return F_ERR_NOTOPEN;
   }
-  else if ( gl_file.mode != F_FILE_RD )
+  else if ( f->mode != F_FILE_RD )
   {
-    if ( gl_file.modified )
+    if ( gl_volume.modified )
     {
       if ( _f_writeglsector( (unsigned long)-1 ) )
       {
-        (void)_f_updatefileentry( 1 );
+        (void)_f_updatefileentry( f, 1 );
         return F_ERR_WRITE;
       }
     }
 
-    return _f_updatefileentry( 0 );
+    return _f_updatefileentry( f, 0 );
   }
 
   return F_NO_ERROR;
 } /* fn_flush */
 
 
+/****************************************************************************
+ *
+ * _f_transfersectors
+ *
+ * read or write whole sectors of a file directly between the caller's
+ * buffer and the media, the file position has to be at the start of a
+ * sector, consecutive sectors are passed to the driver at once even if
+ * they span more clusters, on return the file position is at the end of
+ * the last sector
+ *
+ * INPUTS
+ * f - internal file pointer
+ * buffer - data to be written or where to store read data
+ * cnt - number of sectors
+ * wr - nonzero to write, zero to read
+ *
+ * RETURNS
+ * error code or zero if successful
+ *
+ ***************************************************************************/
+static unsigned char _f_transfersectors ( F_FILE * f, char * buffer, unsigned long cnt, unsigned char wr )
+{
+  unsigned long  sector;
+  unsigned long  n;
+  unsigned char  ret;
+
+  if ( gl_volume.modified )
+  {
+    ret = _f_writeglsector( (unsigned long)-1 );     /*media has to be up to date*/
+    if ( ret )
+    {
+      return ret;
+    }
+  }
+
+  sector = f->pos.sector;
+  n = 0;
+  for ( ; ; )
+  {
+    unsigned long  m = f->pos.sectorend - f->pos.sector;  /*sectors left in the cluster*/
+
+    if ( m > cnt )
+    {
+      m = cnt;
+    }
+
+    n += m;
+    cnt -= m;
+    f->pos.sector += m - 1;
+    f->abspos += ( m - 1 ) * F_SECTOR_SIZE;
+
+    if ( cnt )
+    {
+      if ( wr )
+      {
+        ret = _f_stepnextsector( f, cnt * F_SECTOR_SIZE );
+      }
+      else
+      {
+        f->pos.sector++;
+        ret = _f_seekcurrsector( f );
+      }
+
+      if ( ret )
+      {
+        return ret;
+      }
+
+      f->abspos += F_SECTOR_SIZE;
+
+      if ( f->pos.sector == sector + n )
+      {
+        continue;                 /*next cluster is contiguous*/
+      }
+    }
+
+    if ( wr )
+    {
+      ret = _f_writemultiplesector( buffer, sector, n );
+      if ( gl_volume.actsector - sector < n )
+      {
+        gl_volume.actsector = (unsigned long)-1;  /*buffer is out of date*/
+      }
+    }
+    else
+    {
+      ret = _f_readmultiplesector( buffer, sector, n );
+    }
+
+    if ( ret || !cnt )
+    {
+      return ret;
+    }
+
+    buffer += n * F_SECTOR_SIZE;
+    sector = f->pos.sector;
+    n = 0;
+  }
+} /* _f_transfersectors */
+
+
 /****************************************************************************
  *
  * fn_read
@@ -853,12 +1063,12 @@ long fn_read ( void * buf, long size, long _size_st, F_FILE * f )
   char * buffer = (char *)buf;
   long   retsize;
 
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return 0;
   }
 
-  if ( ( gl_file.mode & ( F_FILE_RD | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
+  if ( ( f->mode & ( F_FILE_RD | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
   {
     return 0;
   }
@@ -873,9 +1083,9 @@ long fn_read ( void * buf, long size, long _size_st, F_FILE * f )
     return 0;                     /*cant read any*/
   }
 
-  if ( size + gl_file.relpos + gl_file.abspos >= gl_file.filesize ) /*read len longer than the file*/
+  if ( size + f->relpos + f->abspos >= f->filesize ) /*read len longer than the file*/
   {
-    size = (long)( ( gl_file.filesize ) - ( gl_file.relpos ) - ( gl_file.abspos ) ); /*calculate new size*/
+    size = (long)( ( f->filesize ) - ( f->relpos ) - ( f->abspos ) ); /*calculate new size*/
   }
 
   if ( size <= 0 )
@@ -883,62 +1093,82 @@ long fn_read ( void * buf, long size, long _size_st, F_FILE * f )
     return 0;
   }
 
-  if ( _f_getcurrsector() )
+  if ( ( f->relpos == 0 ) && ( size >= F_SECTOR_SIZE ) )
   {
-    gl_file.mode = F_FILE_CLOSE; /*no more read allowed*/
-    return 0;
+    if ( _f_seekcurrsector( f ) )   /*whole sectors are read directly*/
+    {
+      f->mode = F_FILE_CLOSE; /*no more read allowed*/
+      return 0;
+    }
+  }
+  else if ( f->relpos != F_SECTOR_SIZE )
+  {
+    if ( _f_getcurrsector( f ) )
+    {
+      f->mode = F_FILE_CLOSE; /*no more read allowed*/
+      return 0;
+    }
   }
 
   for( ; ; )
   {
     unsigned long  rdsize = (unsigned long)size;
 
-    if ( gl_file.relpos == F_SECTOR_SIZE )
+    if ( !size )
+    {
+      break;
+    }
+
+    if ( f->relpos == F_SECTOR_SIZE )
     {
       unsigned char  ret;
 
-      gl_file.abspos += gl_file.relpos;
-      gl_file.relpos = 0;
+      f->abspos += f->relpos;
+      f->relpos = 0;
+
+      f->pos.sector++;         /*goto next*/
 
-      if ( gl_file.modified )
+      if ( rdsize >= F_SECTOR_SIZE )
       {
-        ret = _f_writeglsector( (unsigned long)-1 );     /*empty write buffer */
-        if ( ret )
-        {
-          gl_file.mode = F_FILE_CLOSE;         /*no more read allowed*/
-          return retsize;
-        }
+        ret = _f_seekcurrsector( f );
       }
-
-      gl_file.pos.sector++;         /*goto next*/
-
-      ret = _f_getcurrsector();
-      if ( ( ret == F_ERR_EOF ) && ( !size ) )
+      else
       {
-        return retsize;
+        ret = _f_getcurrsector( f );
       }
 
       if ( ret )
       {
-        gl_file.mode = F_FILE_CLOSE;       /*no more read allowed*/
+        f->mode = F_FILE_CLOSE;       /*no more read allowed*/
         return retsize;
       }
     }
 
-    if ( !size )
+    if ( ( f->relpos == 0 ) && ( rdsize >= F_SECTOR_SIZE ) )
     {
-      break;
-    }
+      unsigned long  cnt = rdsize / F_SECTOR_SIZE;
 
-    if ( rdsize >= F_SECTOR_SIZE - gl_file.relpos )
-    {
-      rdsize = (unsigned long)( F_SECTOR_SIZE - gl_file.relpos );
+      if ( _f_transfersectors( f, buffer, cnt, 0 ) )
+      {
+        f->mode = F_FILE_CLOSE;       /*no more read allowed*/
+        return retsize;
+      }
+
+      rdsize = cnt * F_SECTOR_SIZE;
+      f->relpos = F_SECTOR_SIZE;
     }
+    else
+    {
+      if ( rdsize >= F_SECTOR_SIZE - f->relpos )
+      {
+        rdsize = (unsigned long)( F_SECTOR_SIZE - f->relpos );
+      }
 
-    psp_memcpy( buffer, gl_sector + gl_file.relpos, rdsize ); /*always less than 512*/
+      psp_memcpy( buffer, gl_sector + f->relpos, rdsize ); /*always less than 512*/
+      f->relpos += rdsize;
+    }
 
     buffer += rdsize;
-    gl_file.relpos += rdsize;
     size -= rdsize;
     retsize += rdsize;
   }
@@ -972,12 +1202,12 @@ long fn_write ( const void * buf, long size, long _size_st, F_FILE * f )
   long   retsize;
   long   ret = 0;
 
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return 0;
   }
 
-  if ( ( gl_file.mode & ( F_FILE_WR | F_FILE_A | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
+  if ( ( f->mode & ( F_FILE_WR | F_FILE_A | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
   {
     return 0;
   }
@@ -997,28 +1227,36 @@ long fn_write ( const void * buf, long size, long _size_st, F_FILE * f )
     return 0;                     /*can't write*/
   }
 
-  if ( ( gl_file.mode ) & ( F_FILE_A | F_FILE_AP ) )
+  if ( ( f->mode ) & ( F_FILE_A | F_FILE_AP ) )
   {
-    if ( _f_fseek( (long)gl_file.filesize ) )
+    if ( _f_fseek( f, (long)f->filesize ) )
     {
-      gl_file.mode = F_FILE_CLOSE;
+      f->mode = F_FILE_CLOSE;
       return 0;
     }
   }
 
-  if ( gl_file.startcluster == 0 )
+  if ( f->startcluster == 0 )
   {
-    if ( _f_stepnextsector() )
+    if ( _f_stepnextsector( f, (unsigned long)size ) )
     {
-      gl_file.mode = F_FILE_CLOSE;
+      f->mode = F_FILE_CLOSE;
       return 0;
     }
   }
-  else
+  else if ( ( f->relpos == 0 ) && ( size >= F_SECTOR_SIZE ) )
   {
-    if ( _f_getcurrsector() )
+    if ( _f_seekcurrsector( f ) )   /*whole sectors are written directly*/
     {
-      gl_file.mode = F_FILE_CLOSE;
+      f->mode = F_FILE_CLOSE;
+      return 0;
+    }
+  }
+  else if ( f->relpos != F_SECTOR_SIZE )
+  {
+    if ( _f_getcurrsector( f ) )
+    {
+      f->mode = F_FILE_CLOSE;
       return 0;
     }
   }
@@ -1027,30 +1265,17 @@ long fn_write ( const void * buf, long size, long _size_st, F_FILE * f )
   {
     unsigned long  wrsize = (unsigned long)size;
 
-    if ( gl_file.relpos == F_SECTOR_SIZE )
-    {     /*now full*/
-      if ( gl_file.modified )
-      {
-        if ( _f_writeglsector( gl_file.pos.sector ) )
-        {
-          gl_file.mode = F_FILE_CLOSE;
-          if ( _f_updatefileentry( 0 ) == 0 )
-          {
-            return retsize;
-          }
-          else
-          {
-            return 0;
-          }
-        }
-
-        gl_file.modified = 0;
-      }
+    if ( !size )
+    {
+      break;
+    }
 
-      if ( _f_stepnextsector() )
+    if ( f->relpos == F_SECTOR_SIZE )
+    {     /*now full, the modified sector is written when stepping*/
+      if ( _f_stepnextsector( f, (unsigned long)size ) )
       {
-        gl_file.mode = F_FILE_CLOSE;
-        if ( _f_updatefileentry( 0 ) == 0 )
+        f->mode = F_FILE_CLOSE;
+        if ( _f_updatefileentry( f, 0 ) == 0 )
         {
           return retsize;
         }
@@ -1060,46 +1285,71 @@ long fn_write ( const void * buf, long size, long _size_st, F_FILE * f )
         }
       }
 
-      gl_file.abspos += gl_file.relpos;
-      gl_file.relpos = 0;
+      f->abspos += f->relpos;
+      f->relpos = 0;
 
-      if ( wrsize && ( wrsize < F_SECTOR_SIZE ) )
+      if ( wrsize < F_SECTOR_SIZE )
       {
-        ret = _f_getcurrsector();
-
-        if ( ret )
+        if ( f->abspos >= f->filesize )
+        {
+          psp_memset( gl_sector, 0, F_SECTOR_SIZE );  /*beyond the end of file, nothing to read*/
+        }
+        else
         {
-          if ( ret != F_ERR_EOF )
+          ret = _f_getcurrsector( f );
+
+          if ( ret )
           {
-            gl_file.mode = F_FILE_CLOSE;       /*no more read allowed*/
-            return retsize;
+            if ( ret != F_ERR_EOF )
+            {
+              f->mode = F_FILE_CLOSE;       /*no more read allowed*/
+              return retsize;
+            }
           }
         }
       }
     }
 
-    if ( !size )
+    if ( ( f->relpos == 0 ) && ( wrsize >= F_SECTOR_SIZE ) )
     {
-      break;
-    }
+      unsigned long  cnt = wrsize / F_SECTOR_SIZE;
 
-    if ( wrsize >= F_SECTOR_SIZE - gl_file.relpos )
-    {
-      wrsize = (unsigned long)( F_SECTOR_SIZE - gl_file.relpos );
-    }
+      if ( _f_transfersectors( f, buffer, cnt, 1 ) )
+      {
+        f->mode = F_FILE_CLOSE;
+        if ( _f_updatefileentry( f, 0 ) == 0 )
+        {
+          return retsize;
+        }
+        else
+        {
+          return 0;
+        }
+      }
 
+      wrsize = cnt * F_SECTOR_SIZE;
+      f->relpos = F_SECTOR_SIZE;
+    }
+    else
+    {
+      if ( wrsize >= F_SECTOR_SIZE - f->relpos )
+      {
+        wrsize = (unsigned long)( F_SECTOR_SIZE - f->relpos );
+      }
 
-    psp_memcpy( gl_sector + gl_file.relpos, buffer, wrsize );
-    gl_file.modified = 1;    /*sector is modified*/
+      psp_memcpy( gl_sector + f->relpos, buffer, wrsize );
+      gl_volume.actsector = f->pos.sector;
+      gl_volume.modified = 1;    /*sector is modified*/
+      f->relpos += wrsize;
+    }
 
     buffer += wrsize;
-    gl_file.relpos += wrsize;
     size -= wrsize;
     retsize += wrsize;
 
-    if ( gl_file.filesize < gl_file.abspos + gl_file.relpos )
+    if ( f->filesize < f->abspos + f->relpos )
     {
-      gl_file.filesize = gl_file.abspos + gl_file.relpos;
+      f->filesize = f->abspos + f->relpos;
     }
   }
 
@@ -1132,12 +1382,12 @@ unsigned char fn_seek ( F_FILE * f, long offset, unsigned char whence )
 {
   unsigned char  ret;
 
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return F_ERR_NOTOPEN;
   }
 
-  if ( ( gl_file.mode & ( F_FILE_RD | F_FILE_WR | F_FILE_A | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
+  if ( ( f->mode & ( F_FILE_RD | F_FILE_WR | F_FILE_A | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
   {
     return F_ERR_NOTOPEN;
   }
@@ -1150,15 +1400,15 @@ unsigned char fn_seek ( F_FILE * f, long offset, unsigned char whence )
 
   if ( whence == F_SEEK_CUR )
   {
-    return _f_fseek( (long)( gl_file.abspos + gl_file.relpos + offset ) );
+    return _f_fseek( f, (long)( f->abspos + f->relpos + offset ) );
   }
   else if ( whence == F_SEEK_END )
   {
-    return _f_fseek( (long)( gl_file.filesize + offset ) );
+    return _f_fseek( f, (long)( f->filesize + offset ) );
   }
   else if ( whence == F_SEEK_SET )
   {
-    return _f_fseek( offset );
+    return _f_fseek( f, offset );
   }
 
   return F_ERR_NOTUSEABLE;
@@ -1184,17 +1434,17 @@ unsigned char fn_seek ( F_FILE * f, long offset, unsigned char whence )
 
 long fn_tell ( F_FILE * f )
 {
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return 0;
   }
 
-  if ( ( gl_file.mode & ( F_FILE_RD | F_FILE_WR | F_FILE_A | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
+  if ( ( f->mode & ( F_FILE_RD | F_FILE_WR | F_FILE_A | F_FILE_RDP | F_FILE_WRP | F_FILE_AP ) ) == 0 )
   {
     return 0;
   }
 
-  return (long)( gl_file.abspos + gl_file.relpos );
+  return (long)( f->abspos + f->relpos );
 }
 
 
@@ -1218,12 +1468,12 @@ long fn_tell ( F_FILE * f )
 
 unsigned char fn_eof ( F_FILE * f )
 {
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return F_ERR_NOTOPEN;          /*if error*/
   }
 
-  if ( gl_file.abspos + gl_file.relpos < gl_file.filesize )
+  if ( f->abspos + f->relpos < f->filesize )
   {
     return 0;
   }
@@ -1382,7 +1632,7 @@ unsigned char fn_delete ( const char * filename )
     return F_ERR_ACCESSDENIED;                                      /*readonly*/
   }
 
-  if ( ( gl_file.mode != F_FILE_CLOSE ) && ( gl_file.dirpos.sector == pos.sector ) && ( gl_file.dirpos.pos == pos.pos ) )
+  if ( _f_checklocked( &pos, F_FILE_CLOSE ) )
   {
     return F_ERR_LOCKED;
   }
@@ -1433,18 +1683,18 @@ unsigned char _f_seteof ( F_FILE * f, long filesize )
 {
   unsigned char  rc = F_NO_ERROR;
 
-  if ( !f )
+  if ( _f_checkhandle( f ) )
   {
     return F_ERR_NOTOPEN;        /*if error*/
   }
 
-  if ( ( unsigned long) filesize < gl_file.filesize )
+  if ( ( unsigned long) filesize < f->filesize )
   {
-    rc = _f_fseek( filesize );
+    rc = _f_fseek( f, filesize );
     if ( rc == F_NO_ERROR )
     {
       unsigned long  cluster;
-      rc = _f_getclustervalue( gl_file.pos.cluster, &cluster );
+      rc = _f_getclustervalue( f->pos.cluster, &cluster );
       if ( rc == F_NO_ERROR )
       {
         if ( cluster != F_CLUSTER_LAST )
@@ -1455,7 +1705,9 @@ unsigned char _f_seteof ( F_FILE * f, long filesize )
             return rc;
           }
 
-          rc = _f_setclustervalue( gl_file.pos.cluster, F_CLUSTER_LAST );
+          _f_resetfileruns( f );
+
+          rc = _f_setclustervalue( f->pos.cluster, F_CLUSTER_LAST );
           if ( rc )
           {
             return rc;
@@ -1468,13 +1720,13 @@ unsigned char _f_seteof ( F_FILE * f, long filesize )
           }
         }
 
-        gl_file.filesize = (unsigned long)filesize;
+        f->filesize = (unsigned long)filesize;
       }
     }
   }
-  else if ( (unsigned long) filesize > gl_file.filesize )
+  else if ( (unsigned long) filesize > f->filesize )
   {
-    rc = _f_fseek( filesize );
+    rc = _f_fseek( f, filesize );
   }
 
   return rc;
@@ -1497,7 +1749,12 @@ unsigned char fn_seteof ( F_FILE * f )
 {
   unsigned char  rc = F_NO_ERROR;
 
-  rc = _f_seteof( f, ( gl_file.abspos + gl_file.relpos ) );
+  if ( _f_checkhandle( f ) )
+  {
+    return F_ERR_NOTOPEN;
+  }
+
+  rc = _f_seteof( f, ( f->abspos + f->relpos ) );
 
   return rc;
 } /* fn_seteof */
@@ -1523,7 +1780,7 @@ F_FILE * fn_truncate ( const char * filename, long filesize )
 
   if ( f != NULL )
   {
-    rc = _f_fseek( (long)gl_file.filesize );
+    rc = _f_fseek( f, (long)f->filesize );
     if ( rc == F_NO_ERROR )
     {
       rc = _f_seteof( f, filesize );
@@ -58,7 +58,7 @@
 #endif
 
 F_VOLUME  gl_volume;                /* only one volume */
-F_FILE    gl_file;                  /* file */
+F_FILE    gl_files[F_MAXFILES];     /* files */
 char      gl_sector[F_SECTOR_SIZE]; /* actual sector */
 
 #if F_FILE_CHANGED_EVENT
@@ -462,7 +462,7 @@ static unsigned char _f_postformat ( F_PHY * phy, unsigned char fattype )
     return F_ERR_MEDIATOOSMALL;
   }
 
-  gl_volume.fatsector = (unsigned long)( -1 );
+  _f_resetfatcache();
 
   {
     unsigned char * ptr = (unsigned char *)gl_sector;
@@ -735,13 +735,17 @@ unsigned char _f_getvolume ( void )
 
     case F_STATE_NEEDMOUNT:
     {
-      gl_file.modified = 0;
+      unsigned char  a;
+
       gl_volume.modified = 0;
       gl_volume.lastalloccluster = 0;
       gl_volume.actsector = (unsigned long)( -1 );
-      gl_volume.fatsector = (unsigned long)( -1 );
+      _f_resetfatcache();
 
-      gl_file.mode = F_FILE_CLOSE;
+      for ( a = 0 ; a < F_MAXFILES ; a++ )
+      {
+        gl_files[a].mode = F_FILE_CLOSE;
+      }
 
       gl_volume.cwd[0] = 0;     /*reset cwd*/
       gl_volume.mediatype = F_UNKNOWN_MEDIA;
@@ -799,7 +803,17 @@ unsigned char fn_getfreespace ( F_SPACE * pspace )
   psp_memset( pspace, 0, sizeof( F_SPACE ) );
   pspace->total = gl_volume.maxcluster;
 
-  gl_volume.fatsector = (unsigned long)-1;
+#if F_FREE_CLUSTER_GROUPS
+  ret = _f_countfreeclusters();
+  if ( ret )
+  {
+    return ret;
+  }
+
+  pspace->free = gl_volume.freeclusters;
+  pspace->bad = gl_volume.badclusters;
+  pspace->used = pspace->total - pspace->free - pspace->bad;
+#else
   for ( a = 2 ; a < gl_volume.maxcluster + 2 ; a++ )
   {
     unsigned long  value;
@@ -823,6 +837,7 @@ unsigned char fn_getfreespace ( F_SPACE * pspace )
       ++( pspace->used );
     }
   }
+#endif /* if F_FREE_CLUSTER_GROUPS */
 
   clustersize = (unsigned long)( gl_volume.bootrecord.sector_per_cluster * F_SECTOR_SIZE );
   for ( a = 0 ; ( clustersize & 1 ) == 0 ; a++ )
@@ -72,6 +72,15 @@ typedef struct
 } F_SECTOR;
 
 
+typedef struct
+{
+  unsigned long  sector;   /*zero based FAT sector, (unsigned long)-1 if empty*/
+  unsigned long  used;     /*last use stamp for replacement*/
+  unsigned char  modified;
+  unsigned char  _tdata[F_SECTOR_SIZE];
+} F_FATCACHE;
+
+
 typedef struct
 {
   unsigned char  state;
@@ -81,10 +90,18 @@ typedef struct
   F_SECTOR       _tdata;
 
   unsigned long  actsector;
-  unsigned long  fatsector;
+  unsigned char  modified;       /*gl_sector holds data not yet written to actsector*/
+
+  F_FATCACHE     fatcache[F_FAT_CACHE_SECTORS];
+  unsigned long  fatcacheused;
 
   unsigned long  lastalloccluster;
-  unsigned char  modified;
+#if F_FREE_CLUSTER_GROUPS
+  unsigned long  freegroups[F_FREE_CLUSTER_GROUPS]; /*free clusters in each group*/
+  unsigned char  freegroupshift;                    /*log2 of clusters per group, 0 if not counted yet*/
+  unsigned long  freeclusters;
+  unsigned long  badclusters;
+#endif
   char           cwd[F_MAXPATH]; /*current working folder in this volume*/
   unsigned char  mediatype;
   unsigned long  maxcluster;
@@ -103,7 +120,7 @@ enum
 
 
 extern F_VOLUME  gl_volume;
-extern F_FILE    gl_file;
+extern F_FILE    gl_files[F_MAXFILES];
 extern char      gl_sector[F_SECTOR_SIZE]; /* actual sector */
 
 unsigned char _f_getvolume ( void );
@@ -61,9 +61,9 @@ static char in_use = 0;
 
 
 /****************************************************************************
- * Read one sector
+ * Read consecutive sectors
  ***************************************************************************/
-static int ram_readsector ( F_DRIVER * driver, void * data, unsigned long sector )
+static int ram_readmultiplesector ( F_DRIVER * driver, void * data, unsigned long sector, int cnt )
 {
   long       len;
   char     * d = (char *)data;
@@ -72,8 +72,8 @@ static int ram_readsector ( F_DRIVER * driver, void * data, unsigned long sector
   /* Not used. */
   ( void ) driver;
 
-  /* Check for valid sector. */
-  if ( sector >= maxsector )
+  /* Check for valid sectors. */
+  if ( ( cnt < 1 ) || ( sector >= maxsector ) || ( (unsigned long)cnt > maxsector - sector ) )
   {
     return MDRIVER_RAM_ERR_SECTOR;
   }
@@ -86,7 +86,7 @@ static int ram_readsector ( F_DRIVER * driver, void * data, unsigned long sector
   /* Locate offset into RAM disk for sector. */
   s = ramdrv;
   s += sector * MDRIVER_RAM_SECTOR_SIZE;
-  len = MDRIVER_RAM_SECTOR_SIZE;
+  len = (long)cnt * MDRIVER_RAM_SECTOR_SIZE;
 
 #if MDRIVER_MEM_LONG_ACCESS
   if ( ( !( len & 3 ) ) && ( !( ( (long)d ) & 3 ) ) && ( !( ( (long)s ) & 3 ) ) )
@@ -115,9 +115,9 @@ static int ram_readsector ( F_DRIVER * driver, void * data, unsigned long sector
 }
 
 /****************************************************************************
- * Write one sector
+ * Write consecutive sectors
  ***************************************************************************/
-static int ram_writesector ( F_DRIVER * driver, void * data, unsigned long sector )
+static int ram_writemultiplesector ( F_DRIVER * driver, void * data, unsigned long sector, int cnt )
 {
   long       len;
   char     * s = (char *)data;
@@ -126,8 +126,8 @@ static int ram_writesector ( F_DRIVER * driver, void * data, unsigned long secto
   /* Not used. */
   ( void ) driver;
 
-  /* Check for valid sector. */
-  if ( sector >= maxsector )
+  /* Check for valid sectors. */
+  if ( ( cnt < 1 ) || ( sector >= maxsector ) || ( (unsigned long)cnt > maxsector - sector ) )
   {
     return MDRIVER_RAM_ERR_SECTOR;
   }
@@ -140,7 +140,7 @@ static int ram_writesector ( F_DRIVER * driver, void * data, unsigned long secto
   /* Locate offset into RAM disk for sector. */
   d = ramdrv;
   d += sector * MDRIVER_RAM_SECTOR_SIZE;
-  len = MDRIVER_RAM_SECTOR_SIZE;
+  len = (long)cnt * MDRIVER_RAM_SECTOR_SIZE;
 
 #if MDRIVER_MEM_LONG_ACCESS
   if ( ( !( len & 3 ) ) && ( !( ( (long)d ) & 3 ) ) && ( !( ( (long)s ) & 3 ) ) )
@@ -168,6 +168,22 @@ static int ram_writesector ( F_DRIVER * driver, void * data, unsigned long secto
   return MDRIVER_RAM_NO_ERROR;
 }
 
+/****************************************************************************
+ * Read one sector
+ ***************************************************************************/
+static int ram_readsector ( F_DRIVER * driver, void * data, unsigned long sector )
+{
+  return ram_readmultiplesector( driver, data, sector, 1 );
+}
+
+/****************************************************************************
+ * Write one sector
+ ***************************************************************************/
+static int ram_writesector ( F_DRIVER * driver, void * data, unsigned long sector )
+{
+  return ram_writemultiplesector( driver, data, sector, 1 );
+}
+
 
 /****************************************************************************
  *
@@ -245,6 +261,8 @@ F_DRIVER * ram_initfunc ( unsigned long driver_param )
 
   t_driver.readsector = ram_readsector;
   t_driver.writesector = ram_writesector;
+  t_driver.readmultiplesector = ram_readmultiplesector;
+  t_driver.writemultiplesector = ram_writemultiplesector;
   t_driver.getphy = ram_getphy;
   t_driver.release = ram_release;
 
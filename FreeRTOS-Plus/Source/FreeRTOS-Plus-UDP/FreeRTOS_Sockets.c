@@ -63,11 +63,21 @@ fragmentation setting. */
 	#endif /* ipMAX_UDP_PAYLOAD_LENGTH */
 #endif /* ipconfigFRAGMENT_OUTGOING_PACKETS */
 
+#if ( ( ipconfigSOCKET_HASH_BUCKETS & ( ipconfigSOCKET_HASH_BUCKETS - 1 ) ) != 0 ) || ( ipconfigSOCKET_HASH_BUCKETS < 1 )
+	#error ipconfigSOCKET_HASH_BUCKETS must be a power of 2
+#endif
+
 /* The ItemValue of the sockets xBoundSocketListItem member holds the socket's
 port number. */
 #define socketSET_SOCKET_ADDRESS( pxSocket, usPort ) listSET_LIST_ITEM_VALUE( ( &( ( pxSocket )->xBoundSocketListItem ) ), ( usPort ) )
 #define socketGET_SOCKET_ADDRESS( pxSocket ) listGET_LIST_ITEM_VALUE( ( &( ( pxSocket )->xBoundSocketListItem ) ) )
 
+/* Bound sockets are spread over ipconfigSOCKET_HASH_BUCKETS lists by port
+number, so finding the socket bound to a port only has to search the sockets
+that share its bucket.  The port is held in network byte order, so both of its
+bytes are folded into the hash. */
+#define socketBOUND_SOCKETS_LIST( usPort ) ( &( xBoundSocketsList[ ( ( usPort ) ^ ( ( usPort ) >> 8 ) ) & ( ipconfigSOCKET_HASH_BUCKETS - 1 ) ] ) )
+
 /* xWaitingPacketSemaphore is not created until the socket is bound, so can be
 tested to see if bind() has been called. */
 #define socketSOCKET_IS_BOUND( pxSocket ) ( ( BaseType_t ) pxSocket->xWaitingPacketSemaphore )
@@ -107,6 +117,7 @@ typedef struct XSOCKET
 	xSemaphoreHandle xWaitingPacketSemaphore;
 	xList xWaitingPacketsList;
 	xListItem xBoundSocketListItem; /* Used to reference the socket from a bound sockets list. */
+	xListItem xWakeListItem; /* Used to reference the socket from the list of sockets whose receiving task is to be woken. */
 	TickType_t xReceiveBlockTime;
 	TickType_t xSendBlockTime;
 	uint8_t ucSocketOptions;
@@ -116,9 +127,56 @@ typedef struct XSOCKET
 } xFreeRTOS_Socket_t;
 
 
-/* The list that contains mappings between sockets and port numbers.  Accesses
-to this list must be protected by critical sections of one kind or another. */
-static xList xBoundSocketsList;
+/* The lists that contain mappings between sockets and port numbers.  Accesses
+to these lists must be protected by critical sections of one kind or another. */
+static xList xBoundSocketsList[ ipconfigSOCKET_HASH_BUCKETS ];
+
+/* The sockets that have had packets queued on them while they were empty since
+the IP task last woke their receiving tasks.  Only accessed with the scheduler
+suspended, or from within a critical section. */
+static xList xSocketsToWake;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Wait, for up to the socket's receive block time, for packets to be queued on
+ * pxSocket, then move up to uxMaxPackets of the queued packets to
+ * pxReceivedPackets in a single critical section.  Returns the number of
+ * packets moved.
+ */
+static UBaseType_t prvReceivePackets( xFreeRTOS_Socket_t *pxSocket, xList *pxReceivedPackets, UBaseType_t uxMaxPackets );
+
+/*
+ * Pass the received packet held in pxNetworkBuffer to the application, either
+ * by copying the payload into pvBuffer and releasing the network buffer, or, if
+ * FREERTOS_ZERO_COPY is set in ulFlags, by setting the pointer pointed to by
+ * pvBuffer to point to the payload.  Returns the number of bytes received.  A
+ * packet that was reassembled from fragments is copied from the whole chain of
+ * network buffers.  When FREERTOS_ZERO_COPY is set only the data in the first
+ * network buffer of the chain is received, unless FREERTOS_ZERO_COPY_SEGMENTS
+ * is also set, in which case the whole chain is passed to the application, the
+ * returned length is the length of the whole packet, and the data held in each
+ * network buffer of the chain is found by calling
+ * FreeRTOS_GetUDPPayloadSegment().
+ */
+static int32_t prvCopyReceivedPacket( xNetworkBufferDescriptor_t *pxNetworkBuffer, void *pvBuffer, size_t xBufferLength, uint32_t ulFlags, struct freertos_sockaddr *pxSourceAddress );
+
+/*
+ * Copy xLength bytes of payload from pvSource into the unfragmented UDP packet
+ * held in pxNetworkBuffer.  If the socket options passed in ucSocketOptions
+ * request an outgoing UDP checksum that is not calculated by the hardware then
+ * the payload is summed as it is copied, and the sum is left for the IP task in
+ * the part of the network buffer that will later hold the Ethernet header.
+ * Returns the socket options to pass to the IP task.
+ */
+static uint8_t prvCopyPayloadToPacket( xNetworkBufferDescriptor_t *pxNetworkBuffer, const void *pvSource, size_t xLength, uint8_t ucSocketOptions );
+
+/*
+ * Return the network buffer that holds the zero copy payload pointed to by
+ * pvPayload, or NULL if the payload cannot be sent in place because it is a
+ * packet that was received as a chain of network buffers.
+ */
+static xNetworkBufferDescriptor_t *prvGetZeroCopyNetworkBuffer( const void *pvPayload );
 
 /*-----------------------------------------------------------*/
 
@@ -130,7 +188,7 @@ xFreeRTOS_Socket_t *pxSocket;
 	configASSERT( xDomain == FREERTOS_AF_INET );
 	configASSERT( xType == FREERTOS_SOCK_DGRAM );
 	configASSERT( xProtocol == FREERTOS_IPPROTO_UDP );
-	configASSERT( listLIST_IS_INITIALISED( &xBoundSocketsList ) );
+	configASSERT( listLIST_IS_INITIALISED( &( xBoundSocketsList[ 0 ] ) ) );
 
 	/* Allocate the structure that will hold the socket information. */
 	pxSocket = ( xFreeRTOS_Socket_t * ) pvPortMalloc( sizeof( xFreeRTOS_Socket_t ) );
@@ -149,6 +207,8 @@ xFreeRTOS_Socket_t *pxSocket;
 		vListInitialise( &( pxSocket->xWaitingPacketsList ) );
 		vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
 		listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
+		vListInitialiseItem( &( pxSocket->xWakeListItem ) );
+		listSET_LIST_ITEM_OWNER( &( pxSocket->xWakeListItem ), ( void * ) pxSocket );
 		pxSocket->xSendBlockTime = ( TickType_t ) 0;
 		pxSocket->xReceiveBlockTime = portMAX_DELAY;
 		pxSocket->ucSocketOptions = FREERTOS_SO_UDPCKSUM_OUT;
@@ -198,7 +258,7 @@ xFreeRTOS_Socket_t *pxSocket;
 			taskENTER_CRITICAL();
 			{
 				/* Are there packets queued on the socket already? */
-				uxMessagesWaiting = uxQueueMessagesWaiting( pxSocket->xWaitingPacketSemaphore );
+				uxMessagesWaiting = listCURRENT_LIST_LENGTH( &( pxSocket->xWaitingPacketsList ) );
 
 				/* Are there enough notification spaces in the select queue for the
 				number of packets already queued on the socket? */
@@ -276,6 +336,7 @@ int32_t FreeRTOS_recvfrom( xSocket_t xSocket, void *pvBuffer, size_t xBufferLeng
 xNetworkBufferDescriptor_t *pxNetworkBuffer;
 int32_t lReturn;
 xFreeRTOS_Socket_t *pxSocket;
+xList xReceivedPackets;
 
 	pxSocket = ( xFreeRTOS_Socket_t * ) xSocket;
 
@@ -285,69 +346,93 @@ xFreeRTOS_Socket_t *pxSocket;
 
 	if( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE )
 	{
-		/* The semaphore is given when received data is queued on the socket. */
-		if( xSemaphoreTake( pxSocket->xWaitingPacketSemaphore, pxSocket->xReceiveBlockTime ) == pdPASS )
+		vListInitialise( &xReceivedPackets );
+
+		if( prvReceivePackets( pxSocket, &xReceivedPackets, 1 ) > 0U )
 		{
-			taskENTER_CRITICAL();
-			{
-				configASSERT( ( listCURRENT_LIST_LENGTH( &( pxSocket->xWaitingPacketsList ) ) > 0U ) );
+			/* The owner of the list item is the network buffer. */
+			pxNetworkBuffer = ( xNetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xReceivedPackets );
+			uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
 
-				/* The owner of the list item is the network buffer. */
-				pxNetworkBuffer = ( xNetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->xWaitingPacketsList ) );
+			lReturn = prvCopyReceivedPacket( pxNetworkBuffer, pvBuffer, xBufferLength, ulFlags, pxSourceAddress );
+		}
+		else
+		{
+			lReturn = FREERTOS_EWOULDBLOCK;
+			iptraceRECVFROM_TIMEOUT();
+		}
+	}
+	else
+	{
+		lReturn = FREERTOS_EINVAL;
+	}
 
-				/* Remove the network buffer from the list of buffers waiting to
-				be processed by the socket. */
-				uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
-			}
-			taskEXIT_CRITICAL();
+	return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ipconfigSUPPORT_MMSG_FUNCTIONS == 1
+
+	int32_t FreeRTOS_recvmmsg( xSocket_t xSocket, struct freertos_mmsghdr *pxMessages, size_t xMessageCount, uint32_t ulFlags )
+	{
+	xNetworkBufferDescriptor_t *pxNetworkBuffer;
+	int32_t lReturn;
+	xFreeRTOS_Socket_t *pxSocket;
+	xList xReceivedPackets;
+	UBaseType_t uxReceived, ux;
+	void *pvBuffer;
 
-			if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
+		pxSocket = ( xFreeRTOS_Socket_t * ) xSocket;
+
+		configASSERT( pxMessages );
+
+		if( ( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE ) && ( xMessageCount > 0 ) )
+		{
+			/* Wait for packets in the same way as FreeRTOS_recvfrom(), but
+			take as many of the queued packets as there are messages in one
+			go. */
+			vListInitialise( &xReceivedPackets );
+			uxReceived = prvReceivePackets( pxSocket, &xReceivedPackets, ( UBaseType_t ) xMessageCount );
+
+			for( ux = 0; ux < uxReceived; ux++ )
 			{
-				/* The zero copy flag is not set.  Truncate the length if it
-				won't fit in the provided buffer. */
-				if( pxNetworkBuffer->xDataLength > xBufferLength )
+				/* The owner of the list item is the network buffer. */
+				pxNetworkBuffer = ( xNetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xReceivedPackets );
+				uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
+
+				if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
+				{
+					pvBuffer = pxMessages[ ux ].msg_buf;
+				}
+				else
 				{
-					iptraceRECVFROM_DISCARDING_BYTES( ( xBufferLength - pxNetworkBuffer->xDataLength ) );
-					pxNetworkBuffer->xDataLength = xBufferLength;
+					/* The message's buffer pointer is set to point to the
+					received data. */
+					pvBuffer = ( void * ) &( pxMessages[ ux ].msg_buf );
 				}
 
-				/* Copy the received data into the provided buffer, then
-				release the network buffer. */
-				memcpy( pvBuffer, ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ), pxNetworkBuffer->xDataLength );
-				vNetworkBufferRelease( pxNetworkBuffer );
+				pxMessages[ ux ].msg_len = ( size_t ) prvCopyReceivedPacket( pxNetworkBuffer, pvBuffer, pxMessages[ ux ].msg_len, ulFlags, &( pxMessages[ ux ].msg_addr ) );
 			}
-			else
+
+			if( uxReceived > 0U )
 			{
-				/* The zero copy flag was set.  pvBuffer is not a buffer into
-				which the received data can be copied, but a pointer that must
-				be set to point to the buffer in which the received data has
-				already been placed. */
-				*( ( void** ) pvBuffer ) = ( void * ) ( &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ) );
+				lReturn = ( int32_t ) uxReceived;
 			}
-
-			/* The returned value is the data length, which may have been
-			capped to the receive buffer size. */
-			lReturn = ( int32_t ) pxNetworkBuffer->xDataLength;
-
-			if( pxSourceAddress != NULL )
+			else
 			{
-				pxSourceAddress->sin_port = pxNetworkBuffer->usPort;
-				pxSourceAddress->sin_addr = pxNetworkBuffer->ulIPAddress;
+				lReturn = FREERTOS_EWOULDBLOCK;
+				iptraceRECVFROM_TIMEOUT();
 			}
 		}
 		else
 		{
-			lReturn = FREERTOS_EWOULDBLOCK;
-			iptraceRECVFROM_TIMEOUT();
+			lReturn = FREERTOS_EINVAL;
 		}
-	}
-	else
-	{
-		lReturn = FREERTOS_EINVAL;
+
+		return lReturn;
 	}
 
-	return lReturn;
-}
+#endif /* ipconfigSUPPORT_MMSG_FUNCTIONS */
 /*-----------------------------------------------------------*/
 
 #if ipconfigCAN_FRAGMENT_OUTGOING_PACKETS == 1
@@ -436,9 +521,7 @@ xFreeRTOS_Socket_t *pxSocket;
 						/* When zero copy is used, pvBuffer is a pointer to the
 						payload of a buffer that has already been obtained from the
 						stack.  Obtain the network buffer pointer from the buffer. */
-						pucBuffer = ( uint8_t * ) pvBuffer;
-						pucBuffer -= ( ipBUFFER_PADDING + sizeof( xUDPPacket_t ) );
-						pxNetworkBuffer = * ( ( xNetworkBufferDescriptor_t ** ) pucBuffer );
+						pxNetworkBuffer = prvGetZeroCopyNetworkBuffer( pvBuffer );
 					}
 				}
 
@@ -484,7 +567,17 @@ xFreeRTOS_Socket_t *pxSocket;
 						/* Only copy the data if it is not already in the
 						expected location. */
 						usFragmentOffset = ipGET_UDP_PAYLOAD_OFFSET_FOR_FRAGMENT( usFragmentOffset );
-						memcpy( ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ usFragmentOffset ] ), ( void * ) pucBuffer, xBytesToSend );
+
+						if( xTotalDataLength > ipMAX_UDP_PAYLOAD_LENGTH )
+						{
+							/* Fragmented packets are sent without a UDP
+							checksum, so there is nothing to sum. */
+							memcpy( ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ usFragmentOffset ] ), ( void * ) pucBuffer, xBytesToSend );
+						}
+						else
+						{
+							pxFragmentParameters->ucSocketOptions = prvCopyPayloadToPacket( pxNetworkBuffer, pucBuffer, xBytesToSend, pxFragmentParameters->ucSocketOptions );
+						}
 					}
 					pxNetworkBuffer->xDataLength = xTotalDataLength;
 					pxNetworkBuffer->usPort = pxDestinationAddress->sin_port;
@@ -540,7 +633,7 @@ xFreeRTOS_Socket_t *pxSocket;
 	TickType_t xTicksToWait;
 	int32_t lReturn = 0;
 	xFreeRTOS_Socket_t *pxSocket;
-	uint8_t *pucBuffer;
+	uint8_t ucSocketOptions;
 
 		pxSocket = ( xFreeRTOS_Socket_t * ) xSocket;
 
@@ -564,6 +657,7 @@ xFreeRTOS_Socket_t *pxSocket;
 			if( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE )
 			{
 				xTicksToWait = pxSocket->xSendBlockTime;
+				ucSocketOptions = pxSocket->ucSocketOptions;
 
 				if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
 				{
@@ -574,7 +668,7 @@ xFreeRTOS_Socket_t *pxSocket;
 
 					if( pxNetworkBuffer != NULL )
 					{
-						memcpy( ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ), ( void * ) pvBuffer, xTotalDataLength );
+						ucSocketOptions = prvCopyPayloadToPacket( pxNetworkBuffer, pvBuffer, xTotalDataLength, ucSocketOptions );
 
 						if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
 						{
@@ -588,9 +682,7 @@ xFreeRTOS_Socket_t *pxSocket;
 					/* When zero copy is used, pvBuffer is a pointer to the
 					payload of a buffer that has already been obtained from the
 					stack.  Obtain the network buffer pointer from the buffer. */
-					pucBuffer = ( uint8_t * ) pvBuffer;
-					pucBuffer -= ( ipBUFFER_PADDING + sizeof( xUDPPacket_t ) );
-					pxNetworkBuffer = * ( ( xNetworkBufferDescriptor_t ** ) pucBuffer );
+					pxNetworkBuffer = prvGetZeroCopyNetworkBuffer( pvBuffer );
 				}
 
 				if( pxNetworkBuffer != NULL )
@@ -602,7 +694,7 @@ xFreeRTOS_Socket_t *pxSocket;
 
 					/* The socket options are passed to the IP layer in the
 					space that will eventually get used by the Ethernet header. */
-					pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = pxSocket->ucSocketOptions;
+					pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = ucSocketOptions;
 
 					/* Tell the networking task that the packet needs sending. */
 					xStackTxEvent.pvData = pxNetworkBuffer;
@@ -649,10 +741,161 @@ xFreeRTOS_Socket_t *pxSocket;
 #endif /* ipconfigCAN_FRAGMENT_OUTGOING_PACKETS */
 /*-----------------------------------------------------------*/
 
+#if ipconfigSUPPORT_MMSG_FUNCTIONS == 1
+
+	int32_t FreeRTOS_sendmmsg( xSocket_t xSocket, struct freertos_mmsghdr *pxMessages, size_t xMessageCount, uint32_t ulFlags )
+	{
+	xNetworkBufferDescriptor_t *pxNetworkBuffer, *pxFirstBuffer = NULL, *pxLastBuffer = NULL;
+	xIPStackEvent_t xStackTxEvent = { eStackTxEvent, NULL };
+	extern xQueueHandle xNetworkEventQueue;
+	xTimeOutType xTimeOut;
+	TickType_t xTicksToWait;
+	int32_t lReturn = 0;
+	xFreeRTOS_Socket_t *pxSocket;
+	uint8_t ucSocketOptions;
+	size_t xMessage = 0;
+
+		pxSocket = ( xFreeRTOS_Socket_t * ) xSocket;
+
+		configASSERT( xNetworkEventQueue );
+		configASSERT( pxMessages );
+
+		if( socketSOCKET_IS_BOUND( pxSocket ) == pdFALSE )
+		{
+			/* If the socket is not already bound to an address, bind it now.
+			Passing NULL as the address parameter tells FreeRTOS_bind() to
+			select the address to bind to. */
+			FreeRTOS_bind( pxSocket, NULL, 0 );
+		}
+
+		if( socketSOCKET_IS_BOUND( pxSocket ) != pdFALSE )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
+			xTicksToWait = pxSocket->xSendBlockTime;
+
+			/* Place each datagram in a network buffer and link the buffers
+			together, so the whole chain can be passed to the IP task in one
+			event.  Stop at the first datagram that cannot be sent. */
+			for( xMessage = 0; xMessage < xMessageCount; xMessage++ )
+			{
+				if( pxMessages[ xMessage ].msg_len > ipMAX_UDP_PAYLOAD_LENGTH )
+				{
+					/* Datagrams sent by this function are not fragmented. */
+					iptraceSENDTO_DATA_TOO_LONG();
+					break;
+				}
+
+				ucSocketOptions = pxSocket->ucSocketOptions;
+
+				if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
+				{
+					if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+					{
+						/* The entire block time has been used up. */
+						xTicksToWait = 0;
+					}
+
+					/* Zero copy is not set, so obtain a network buffer into
+					which the payload will be copied. */
+					pxNetworkBuffer = pxNetworkBufferGet( pxMessages[ xMessage ].msg_len + sizeof( xUDPPacket_t ), xTicksToWait );
+
+					if( pxNetworkBuffer == NULL )
+					{
+						iptraceNO_BUFFER_FOR_SENDTO();
+						break;
+					}
+
+					ucSocketOptions = prvCopyPayloadToPacket( pxNetworkBuffer, pxMessages[ xMessage ].msg_buf, pxMessages[ xMessage ].msg_len, ucSocketOptions );
+				}
+				else
+				{
+					/* When zero copy is used, msg_buf is a pointer to the
+					payload of a buffer that has already been obtained from the
+					stack.  Obtain the network buffer pointer from the buffer. */
+					pxNetworkBuffer = prvGetZeroCopyNetworkBuffer( pxMessages[ xMessage ].msg_buf );
+
+					if( pxNetworkBuffer == NULL )
+					{
+						iptraceNO_BUFFER_FOR_SENDTO();
+						break;
+					}
+				}
+
+				pxNetworkBuffer->xDataLength = pxMessages[ xMessage ].msg_len;
+				pxNetworkBuffer->usPort = pxMessages[ xMessage ].msg_addr.sin_port;
+				pxNetworkBuffer->usBoundPort = ( uint16_t ) socketGET_SOCKET_ADDRESS( pxSocket );
+				pxNetworkBuffer->ulIPAddress = pxMessages[ xMessage ].msg_addr.sin_addr;
+
+				/* The socket options are passed to the IP layer in the space
+				that will eventually get used by the Ethernet header. */
+				pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = ucSocketOptions;
+
+				pxNetworkBuffer->pxNextBuffer = NULL;
+
+				if( pxLastBuffer == NULL )
+				{
+					pxFirstBuffer = pxNetworkBuffer;
+				}
+				else
+				{
+					pxLastBuffer->pxNextBuffer = pxNetworkBuffer;
+				}
+
+				pxLastBuffer = pxNetworkBuffer;
+			}
+
+			if( pxFirstBuffer != NULL )
+			{
+				if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+				{
+					xTicksToWait = 0;
+				}
+
+				/* Tell the networking task that the packets need sending. */
+				xStackTxEvent.pvData = pxFirstBuffer;
+
+				if( xQueueSendToBack( xNetworkEventQueue, &xStackTxEvent, xTicksToWait ) != pdPASS )
+				{
+					/* Break the chain up again, and release the buffers that
+					were allocated in this function.  Zero copy buffers still
+					belong to the caller. */
+					while( pxFirstBuffer != NULL )
+					{
+						pxNetworkBuffer = pxFirstBuffer;
+						pxFirstBuffer = pxNetworkBuffer->pxNextBuffer;
+						pxNetworkBuffer->pxNextBuffer = NULL;
+
+						if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
+						{
+							vNetworkBufferRelease( pxNetworkBuffer );
+						}
+					}
+
+					iptraceSTACK_TX_EVENT_LOST( ipSTACK_TX_EVENT );
+				}
+				else
+				{
+					/* Return the number of datagrams sent. */
+					lReturn = ( int32_t ) xMessage;
+				}
+			}
+		}
+		else
+		{
+			iptraceSENDTO_SOCKET_NOT_BOUND();
+		}
+
+		return lReturn;
+	}
+
+#endif /* ipconfigSUPPORT_MMSG_FUNCTIONS */
+/*-----------------------------------------------------------*/
+
 BaseType_t FreeRTOS_bind( xSocket_t xSocket, struct freertos_sockaddr * pxAddress, socklen_t xAddressLength )
 {
 BaseType_t xReturn = 0; /* In Berkeley sockets, 0 means pass for bind(). */
 xFreeRTOS_Socket_t *pxSocket;
+xList *pxBoundSocketsList;
 #if ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND == 1
 	struct freertos_sockaddr xAddress;
 #endif /* ipconfigALLOW_SOCKET_SEND_WITHOUT_BIND */
@@ -692,48 +935,55 @@ xFreeRTOS_Socket_t *pxSocket;
 			pxAddress->sin_port = prvGetPrivatePortNumber();
 		}
 
-		vTaskSuspendAll();
+		if( pxSocket->xWaitingPacketSemaphore == NULL )
 		{
-			/* Check to ensure the port is not already in use. */
-			if( pxListFindListItemWithValue( &xBoundSocketsList, ( TickType_t ) pxAddress->sin_port ) != NULL )
-			{
-				xReturn = FREERTOS_EADDRINUSE;
-			}
-		}
-		xTaskResumeAll();
+			/* Create the semaphore used to wake a task that is waiting for
+			packets to be queued on this socket. */
+			pxSocket->xWaitingPacketSemaphore = xSemaphoreCreateBinary();
 
-		/* Check that xReturn has not been set before continuing. */
-		if( xReturn == 0 )
-		{
-			if( pxSocket->xWaitingPacketSemaphore == NULL )
+			if( pxSocket->xWaitingPacketSemaphore != NULL )
 			{
-				/* Create the semaphore used to count the number of packets that
-				are queued on this socket. */
-				pxSocket->xWaitingPacketSemaphore = xSemaphoreCreateCounting( ipconfigNUM_NETWORK_BUFFERS, 0 );
-
-				if( pxSocket->xWaitingPacketSemaphore != NULL )
+				/* Allocate the port number to the socket. */
+				socketSET_SOCKET_ADDRESS( pxSocket, pxAddress->sin_port );
+				pxBoundSocketsList = socketBOUND_SOCKETS_LIST( pxAddress->sin_port );
+
+				/* Only the sockets that share the port's bucket have to be
+				checked, so checking the port is free and claiming it are done
+				in one short critical section, without suspending the
+				scheduler. */
+				taskENTER_CRITICAL();
 				{
-					/* Allocate the port number to the socket. */
-					socketSET_SOCKET_ADDRESS( pxSocket, pxAddress->sin_port );
-					taskENTER_CRITICAL();
+					/* Check to ensure the port is not already in use. */
+					if( pxListFindListItemWithValue( pxBoundSocketsList, ( TickType_t ) pxAddress->sin_port ) != NULL )
+					{
+						xReturn = FREERTOS_EADDRINUSE;
+					}
+					else
 					{
 						/* Add the socket to the list of bound ports. */
-						vListInsertEnd( &xBoundSocketsList, &( pxSocket->xBoundSocketListItem ) );
+						vListInsertEnd( pxBoundSocketsList, &( pxSocket->xBoundSocketListItem ) );
 					}
-					taskEXIT_CRITICAL();
 				}
-				else
+				taskEXIT_CRITICAL();
+
+				if( xReturn != 0 )
 				{
-					/* Out of memory. */
-					xReturn = FREERTOS_ENOBUFS;
+					/* The socket remains unbound. */
+					vSemaphoreDelete( pxSocket->xWaitingPacketSemaphore );
+					pxSocket->xWaitingPacketSemaphore = NULL;
 				}
 			}
 			else
 			{
-				/* The socket is already bound. */
-				xReturn = FREERTOS_EINVAL;
+				/* Out of memory. */
+				xReturn = FREERTOS_ENOBUFS;
 			}
 		}
+		else
+		{
+			/* The socket is already bound. */
+			xReturn = FREERTOS_EINVAL;
+		}
 	}
 	else
 	{
@@ -766,6 +1016,13 @@ xFreeRTOS_Socket_t *pxSocket;
 		taskENTER_CRITICAL();
 		{
 			uxListRemove( &( pxSocket->xBoundSocketListItem ) );
+
+			/* The IP task must not attempt to wake the socket's receiving
+			task once the socket has been deleted. */
+			if( listLIST_ITEM_CONTAINER( &( pxSocket->xWakeListItem ) ) != NULL )
+			{
+				uxListRemove( &( pxSocket->xWakeListItem ) );
+			}
 		}
 		taskEXIT_CRITICAL();
 	}
@@ -778,7 +1035,18 @@ xFreeRTOS_Socket_t *pxSocket;
 		{
 			pxNetworkBuffer = ( xNetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->xWaitingPacketsList ) );
 			uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
-			vNetworkBufferRelease( pxNetworkBuffer );
+
+			#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+			{
+				/* The packet may have been reassembled into a chain of
+				network buffers. */
+				vNetworkBufferReleaseChain( pxNetworkBuffer );
+			}
+			#else
+			{
+				vNetworkBufferRelease( pxNetworkBuffer );
+			}
+			#endif
 		}
 		vSemaphoreDelete( pxSocket->xWaitingPacketSemaphore );
 	}
@@ -791,7 +1059,14 @@ xFreeRTOS_Socket_t *pxSocket;
 
 void FreeRTOS_SocketsInit( void )
 {
-	vListInitialise( &xBoundSocketsList );
+UBaseType_t ux;
+
+	for( ux = 0; ux < ( UBaseType_t ) ipconfigSOCKET_HASH_BUCKETS; ux++ )
+	{
+		vListInitialise( &( xBoundSocketsList[ ux ] ) );
+	}
+
+	vListInitialise( &xSocketsToWake );
 }
 /*-----------------------------------------------------------*/
 
@@ -861,21 +1136,19 @@ BaseType_t xReturn = pdPASS;
 xFreeRTOS_Socket_t *pxSocket;
 BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
+	/* The scheduler stays suspended from finding the socket until the packet
+	is queued on it, so the socket cannot be closed in between. */
 	vTaskSuspendAll();
 	{
 		/* See if there is a list item associated with the port number on the
 		list of bound sockets. */
-		pxListItem = pxListFindListItemWithValue( &xBoundSocketsList, ( TickType_t ) usPort );
-	}
-	xTaskResumeAll();
-
-	if( pxListItem != NULL )
-	{
-		/* The owner of the list item is the socket itself. */
-		pxSocket = ( xFreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+		pxListItem = pxListFindListItemWithValue( socketBOUND_SOCKETS_LIST( usPort ), ( TickType_t ) usPort );
 
-		vTaskSuspendAll();
+		if( pxListItem != NULL )
 		{
+			/* The owner of the list item is the socket itself. */
+			pxSocket = ( xFreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxListItem );
+
 			#if( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
 			{
 				/* Is the socket a member of a select() group? */
@@ -900,28 +1173,309 @@ BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 					/* Add the network packet to the list of packets to be
 					processed by the socket. */
 					vListInsertEnd( &( pxSocket->xWaitingPacketsList ), &( pxNetworkBuffer->xBufferListItem ) );
+
+					/* A task can only be blocked on the socket if the socket
+					was empty.  The task is woken by vSocketsWakeReceivers()
+					once the IP task has processed the current batch of
+					events, however many packets the batch queues on the
+					socket. */
+					if( ( listCURRENT_LIST_LENGTH( &( pxSocket->xWaitingPacketsList ) ) == 1U ) &&
+						( listLIST_ITEM_CONTAINER( &( pxSocket->xWakeListItem ) ) == NULL ) )
+					{
+						vListInsertEnd( &xSocketsToWake, &( pxSocket->xWakeListItem ) );
+					}
 				}
 				taskEXIT_CRITICAL();
+			}
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	if( xTaskResumeAll() == pdFALSE )
+	{
+		if( xHigherPriorityTaskWoken != pdFALSE )
+		{
+			taskYIELD();
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
 
-				/* The socket's counting semaphore records how many packets are
-				waiting	to be processed by the socket. */
-				xSemaphoreGiveFromISR( pxSocket->xWaitingPacketSemaphore, &xHigherPriorityTaskWoken );
+void vSocketsWakeReceivers( void )
+{
+xFreeRTOS_Socket_t *pxSocket;
+
+	/* With the scheduler suspended any number of tasks can be woken for the
+	cost of at most one context switch, which is performed when the scheduler
+	is resumed. */
+	vTaskSuspendAll();
+	{
+		while( listCURRENT_LIST_LENGTH( &xSocketsToWake ) > 0U )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* The owner of the list item is the socket itself. */
+				pxSocket = ( xFreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xSocketsToWake );
+				uxListRemove( &( pxSocket->xWakeListItem ) );
 			}
+			taskEXIT_CRITICAL();
+
+			xSemaphoreGiveFromISR( pxSocket->xWaitingPacketSemaphore, NULL );
 		}
-		if( xTaskResumeAll() == pdFALSE )
+	}
+	xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvReceivePackets( xFreeRTOS_Socket_t *pxSocket, xList *pxReceivedPackets, UBaseType_t uxMaxPackets )
+{
+xNetworkBufferDescriptor_t *pxNetworkBuffer;
+xTimeOutType xTimeOut;
+TickType_t xTicksToWait;
+UBaseType_t uxReceived = 0;
+BaseType_t xBlocked = pdFALSE, xMorePacketsWaiting = pdFALSE;
+
+	vTaskSetTimeOutState( &xTimeOut );
+	xTicksToWait = pxSocket->xReceiveBlockTime;
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
 		{
-			if( xHigherPriorityTaskWoken != pdFALSE )
+			while( ( uxReceived < uxMaxPackets ) && ( listCURRENT_LIST_LENGTH( &( pxSocket->xWaitingPacketsList ) ) > 0U ) )
 			{
-				taskYIELD();
+				/* The owner of the list item is the network buffer. */
+				pxNetworkBuffer = ( xNetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->xWaitingPacketsList ) );
+
+				/* Move the network buffer from the list of buffers waiting to
+				be processed by the socket to the caller's list. */
+				uxListRemove( &( pxNetworkBuffer->xBufferListItem ) );
+				vListInsertEnd( pxReceivedPackets, &( pxNetworkBuffer->xBufferListItem ) );
+				uxReceived++;
 			}
+
+			xMorePacketsWaiting = ( BaseType_t ) ( listCURRENT_LIST_LENGTH( &( pxSocket->xWaitingPacketsList ) ) > 0U );
+		}
+		taskEXIT_CRITICAL();
+
+		if( uxReceived > 0U )
+		{
+			break;
 		}
+
+		/* No packets are queued on the socket.  The semaphore is given when
+		received data is queued on the socket while it is empty, but may also
+		have been left given by a packet that has already been read, so the
+		list must be checked again once it is obtained. */
+		if( xSemaphoreTake( pxSocket->xWaitingPacketSemaphore, xTicksToWait ) != pdPASS )
+		{
+			break;
+		}
+
+		xBlocked = pdTRUE;
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			/* Check the list once more, without blocking. */
+			xTicksToWait = 0;
+		}
+	}
+
+	if( ( xBlocked != pdFALSE ) && ( xMorePacketsWaiting != pdFALSE ) )
+	{
+		/* The IP task only gives the semaphore once for any number of
+		packets, so pass it on in case another task is also waiting to
+		receive from this socket. */
+		xSemaphoreGive( pxSocket->xWaitingPacketSemaphore );
+	}
+
+	return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+static int32_t prvCopyReceivedPacket( xNetworkBufferDescriptor_t *pxNetworkBuffer, void *pvBuffer, size_t xBufferLength, uint32_t ulFlags, struct freertos_sockaddr *pxSourceAddress )
+{
+int32_t lReturn;
+#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	xNetworkBufferDescriptor_t *pxSegment;
+	size_t xSegmentLength, xBytesRemaining;
+	uint8_t *pucDestination;
+#endif
+
+	#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	{
+		/* A packet that was reassembled from fragments is held in a chain of
+		network buffers, the first of which holds xSegmentLength bytes of the
+		payload. */
+		xSegmentLength = pxNetworkBuffer->xDataLength;
+		for( pxSegment = pxNetworkBuffer->pxNextBuffer; pxSegment != NULL; pxSegment = pxSegment->pxNextBuffer )
+		{
+			xSegmentLength -= pxSegment->xDataLength;
+		}
+
+		if( ( ( ulFlags & FREERTOS_ZERO_COPY ) != 0 ) && ( ( ulFlags & FREERTOS_ZERO_COPY_SEGMENTS ) == 0 ) && ( pxNetworkBuffer->pxNextBuffer != NULL ) )
+		{
+			/* Only the data held in the first network buffer can be read from
+			the pointer passed to the application, so the rest of the packet
+			is discarded unless the application asked for every segment. */
+			iptraceRECVFROM_DISCARDING_BYTES( ( pxNetworkBuffer->xDataLength - xSegmentLength ) );
+			vNetworkBufferReleaseChain( pxNetworkBuffer->pxNextBuffer );
+			pxNetworkBuffer->pxNextBuffer = NULL;
+			pxNetworkBuffer->xDataLength = xSegmentLength;
+		}
+	}
+	#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+
+	if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
+	{
+		/* The zero copy flag is not set.  Truncate the length if it won't
+		fit in the provided buffer. */
+		if( pxNetworkBuffer->xDataLength > xBufferLength )
+		{
+			iptraceRECVFROM_DISCARDING_BYTES( ( xBufferLength - pxNetworkBuffer->xDataLength ) );
+			pxNetworkBuffer->xDataLength = xBufferLength;
+		}
+
+		/* Copy the received data into the provided buffer, then release the
+		network buffer. */
+		#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+		{
+			/* Copy the data from each network buffer in the chain in turn. */
+			pucDestination = ( uint8_t * ) pvBuffer;
+			xBytesRemaining = pxNetworkBuffer->xDataLength;
+			pxSegment = pxNetworkBuffer;
+
+			while( ( pxSegment != NULL ) && ( xBytesRemaining > 0U ) )
+			{
+				if( xSegmentLength > xBytesRemaining )
+				{
+					xSegmentLength = xBytesRemaining;
+				}
+
+				if( pxSegment == pxNetworkBuffer )
+				{
+					memcpy( ( void * ) pucDestination, ( void * ) &( pxSegment->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ), xSegmentLength );
+				}
+				else
+				{
+					memcpy( ( void * ) pucDestination, ( void * ) &( pxSegment->pucEthernetBuffer[ ipIP_PAYLOAD_OFFSET ] ), xSegmentLength );
+				}
+
+				pucDestination += xSegmentLength;
+				xBytesRemaining -= xSegmentLength;
+				pxSegment = pxSegment->pxNextBuffer;
+
+				if( pxSegment != NULL )
+				{
+					xSegmentLength = pxSegment->xDataLength;
+				}
+			}
+		}
+		#else
+		{
+			memcpy( pvBuffer, ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ), pxNetworkBuffer->xDataLength );
+		}
+		#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
 	}
 	else
 	{
-		xReturn = pdFAIL;
+		/* The zero copy flag was set.  pvBuffer is not a buffer into which
+		the received data can be copied, but a pointer that must be set to
+		point to the buffer in which the received data has already been
+		placed.  If the whole of a packet that was reassembled from fragments
+		is being received the rest of the chain stays attached, and is
+		released along with the first network buffer by
+		FreeRTOS_ReleaseUDPPayloadBuffer(). */
+		*( ( void** ) pvBuffer ) = ( void * ) ( &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ) );
 	}
 
-	return xReturn;
+	/* The returned value is the data length, which may have been capped to
+	the receive buffer size. */
+	lReturn = ( int32_t ) pxNetworkBuffer->xDataLength;
+
+	if( pxSourceAddress != NULL )
+	{
+		pxSourceAddress->sin_port = pxNetworkBuffer->usPort;
+		pxSourceAddress->sin_addr = pxNetworkBuffer->ulIPAddress;
+	}
+
+	if( ( ulFlags & FREERTOS_ZERO_COPY ) == 0 )
+	{
+		#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+		{
+			vNetworkBufferReleaseChain( pxNetworkBuffer );
+		}
+		#else
+		{
+			vNetworkBufferRelease( pxNetworkBuffer );
+		}
+		#endif
+	}
+
+	return lReturn;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvCopyPayloadToPacket( xNetworkBufferDescriptor_t *pxNetworkBuffer, const void *pvSource, size_t xLength, uint8_t ucSocketOptions )
+{
+uint8_t *pucPayload;
+
+	pucPayload = &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] );
+
+	#if ipconfigETHERNET_DRIVER_ADDS_UDP_CHECKSUM == 0
+	{
+	xIPFragmentParameters_t *pxFragmentParameters;
+
+		if( ( ucSocketOptions & FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
+		{
+			/* Sum the payload while it is being copied, so the IP task does not
+			need to read it again when it completes the UDP checksum. */
+			pxFragmentParameters = ( xIPFragmentParameters_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipFRAGMENTATION_PARAMETERS_OFFSET ] );
+			pxFragmentParameters->usPayloadChecksum = usGenerateChecksumAndCopy( pucPayload, ( const uint8_t * ) pvSource, xLength );
+			ucSocketOptions |= FREERTOS_PAYLOAD_CHECKSUMMED;
+		}
+		else
+		{
+			memcpy( ( void * ) pucPayload, pvSource, xLength );
+		}
+	}
+	#else
+	{
+		memcpy( ( void * ) pucPayload, pvSource, xLength );
+	}
+	#endif /* ipconfigETHERNET_DRIVER_ADDS_UDP_CHECKSUM */
+
+	return ucSocketOptions;
+}
+/*-----------------------------------------------------------*/
+
+static xNetworkBufferDescriptor_t *prvGetZeroCopyNetworkBuffer( const void *pvPayload )
+{
+const uint8_t *pucBuffer;
+xNetworkBufferDescriptor_t *pxNetworkBuffer;
+
+	/* The network buffer pointer is stored in front of the Ethernet frame. */
+	pucBuffer = ( const uint8_t * ) pvPayload;
+	pucBuffer -= ( ipBUFFER_PADDING + sizeof( xUDPPacket_t ) );
+	pxNetworkBuffer = * ( ( xNetworkBufferDescriptor_t * const * ) pucBuffer );
+
+	#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	{
+		/* A packet received with FREERTOS_ZERO_COPY_SEGMENTS may still be a
+		chain of network buffers, and only a single network buffer can be sent.
+		The caller keeps the chain, and must release it. */
+		if( pxNetworkBuffer->pxNextBuffer != NULL )
+		{
+			pxNetworkBuffer = NULL;
+		}
+	}
+	#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+
+	return pxNetworkBuffer;
 }
 /*-----------------------------------------------------------*/
 
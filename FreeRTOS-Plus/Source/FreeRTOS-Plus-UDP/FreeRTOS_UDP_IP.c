@@ -78,6 +78,28 @@
 #if ( ipconfigNETWORK_MTU < 46 )
 	#error ipconfigNETWORK_MTU must be at least 46.
 #endif
+
+#if ( ipconfigIP_TASK_BATCH_SIZE < 1 )
+	#error ipconfigIP_TASK_BATCH_SIZE must be at least 1
+#endif
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+	#if ( ipconfigREASSEMBLY_CONTEXTS < 1 ) || ( ipconfigREASSEMBLY_MAX_AGE < 1 ) || ( ipconfigREASSEMBLY_MAX_AGE > 255 )
+		#error ipconfigREASSEMBLY_CONTEXTS must be at least 1, and ipconfigREASSEMBLY_MAX_AGE must be between 1 and 255
+	#endif
+
+	#if ( ipconfigREASSEMBLY_MAX_FRAGMENTS < 2 ) || ( ipconfigREASSEMBLY_MAX_FRAGMENTS > 255 )
+		#error ipconfigREASSEMBLY_MAX_FRAGMENTS must be between 2 and 255
+	#endif
+
+	#if ( ( ipconfigREASSEMBLY_CONTEXTS * ipconfigREASSEMBLY_MAX_FRAGMENTS ) >= ipconfigNUM_NETWORK_BUFFERS )
+		#error ipconfigREASSEMBLY_CONTEXTS multiplied by ipconfigREASSEMBLY_MAX_FRAGMENTS must be less than ipconfigNUM_NETWORK_BUFFERS
+	#endif
+
+	#if ( ipconfigREASSEMBLY_MAX_PAYLOAD_BYTES > 65507 )
+		#error ipconfigREASSEMBLY_MAX_PAYLOAD_BYTES cannot be greater than 65507, the largest UDP payload an IP packet can carry
+	#endif
+#endif
 /*-----------------------------------------------------------*/
 
 /* The IP header length in bytes. */
@@ -105,6 +127,22 @@ rather than duplicated in its own variable. */
 rather than duplicated in its own variable. */
 #define ipLOCAL_IP_ADDRESS_POINTER ( ( uint32_t * ) &( xDefaultPartUDPPacketHeader[ 20 ] ) )
 
+/* The ones complement sum does not depend on the byte order, so data is summed
+in whatever byte order the CPU loads it.  ipCHECKSUM_BYTE() returns the value
+a single byte adds to the sum, which depends on whether the byte is the first
+or the second byte of a 16-bit word - that is, whether it is at an even or an
+odd offset from the start of the data being summed. */
+#if ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN
+	#define ipCHECKSUM_BYTE( ucByte, xOddOffset ) ( ( ( xOddOffset ) != pdFALSE ) ? ( ( uint32_t ) ( ucByte ) << 8UL ) : ( uint32_t ) ( ucByte ) )
+#else
+	#define ipCHECKSUM_BYTE( ucByte, xOddOffset ) ( ( ( xOddOffset ) != pdFALSE ) ? ( uint32_t ) ( ucByte ) : ( ( uint32_t ) ( ucByte ) << 8UL ) )
+#endif
+
+/* Swap the bytes of a 16-bit partial checksum.  Summing data that starts at an
+odd offset pairs its bytes the wrong way round, which swaps the bytes of the
+result. */
+#define ipSWAP_CHECKSUM_BYTES( usSum ) ( ( uint16_t ) ( ( ( usSum ) << 8U ) | ( ( usSum ) >> 8U ) ) )
+
 /* Defines how often the ARP timer callback function is executed.  The time is
 shorted in the Windows simulator as simulated time is not real time. */
 #ifdef _WINDOWS_
@@ -147,11 +185,12 @@ number is used to distinguish between the two, as 0 is an invalid UDP port. */
 character expected to fill ICMP echo replies. */
 #define ipECHO_DATA_FILL_BYTE						'x'
 
-#if( ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN )
-	#define ipFRAGMENT_OFFSET_BIT_MASK				( ( uint16_t ) 0xff0f ) /* The bits in the two byte IP header field that make up the fragment offset value. */
-#else
-	#define ipFRAGMENT_OFFSET_BIT_MASK				( ( uint16_t ) 0x0fff ) /* The bits in the two byte IP header field that make up the fragment offset value. */
-	#if ipconfigCAN_FRAGMENT_OUTGOING_PACKETS == 1
+/* The bits in the two byte IP header field that make up the fragment offset
+value, once the field has been converted to host byte order. */
+#define ipFRAGMENT_OFFSET_BIT_MASK					( ( uint16_t ) 0x1fffU )
+
+#if( ipconfigBYTE_ORDER != FREERTOS_LITTLE_ENDIAN )
+	#if ( ipconfigCAN_FRAGMENT_OUTGOING_PACKETS == 1 ) || ( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
 		#warning Fragment offsets have not been tested on big endian machines.
 	#endif /* ipconfigCAN_FRAGMENT_OUTGOING_PACKETS */
 #endif /* ipconfigBYTE_ORDER */
@@ -181,6 +220,26 @@ typedef enum
 	eFollowingFragment			/* The IP packet being sent is part of a set of fragmented packets. */
 } eIPFragmentStatus_t;
 
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+
+	/* Holds the fragments of a received UDP packet until the whole packet has
+	been received.  While a fragment is held its network buffer's xDataLength
+	member holds the number of IP payload bytes in the fragment, and its usPort
+	member holds the offset of the fragment within the IP payload. */
+	typedef struct xREASSEMBLY_CONTEXT
+	{
+		uint32_t ulSourceIPAddress;			/* The source address of the fragmented packet. */
+		uint32_t ulDestinationIPAddress;	/* The destination address of the fragmented packet. */
+		uint16_t usIdentification;			/* The identification field shared by the fragments of the packet. */
+		uint16_t usTotalLength;				/* The length of the IP payload, or 0 until the last fragment has been received. */
+		uint16_t usReceivedLength;			/* The number of IP payload bytes received so far. */
+		uint8_t ucFragmentCount;			/* The number of fragments held in the chain. */
+		uint8_t ucAge;						/* Decremented by the ARP timer.  The packet is dropped when it reaches zero, and zero marks an unused context. */
+		xNetworkBufferDescriptor_t *pxFirstFragment; /* The received fragments, linked in order of their offset. */
+	} xReassemblyContext_t;
+
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+
 
 /*-----------------------------------------------------------*/
 
@@ -189,11 +248,25 @@ typedef enum
  */
 static void prvProcessEthernetPacket( xNetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+/*
+ * Called when an eEthernetRxEvent is received.  Processes the received buffer,
+ * or, if ipconfigUSE_LINKED_RX_MESSAGES is not 0, each buffer in the chain of
+ * received buffers that starts with pxFirstBuffer.
+ */
+static void prvProcessReceivedFrames( xNetworkBufferDescriptor_t *pxFirstBuffer );
+
 /*
  * Called when the application has generated a UDP packet to send.
  */
 static void prvProcessGeneratedPacket( xNetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+/*
+ * Called when an eStackTxEvent is received.  Processes the generated buffer,
+ * or, if ipconfigSUPPORT_MMSG_FUNCTIONS is 1, each buffer in the chain of
+ * generated buffers that starts with pxFirstBuffer.
+ */
+static void prvProcessGeneratedPackets( xNetworkBufferDescriptor_t *pxFirstBuffer );
+
 /*
  * Processes incoming ARP packets.
  */
@@ -204,6 +277,42 @@ static eFrameProcessingResult_t prvProcessARPPacket( xARPPacket_t * const pxARPF
  */
 static eFrameProcessingResult_t prvProcessIPPacket( const xIPPacket_t * const pxIPPacket, xNetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+/*
+ * Process a UDP packet, including one that was reassembled from fragments into
+ * a chain of network buffers.
+ */
+static eFrameProcessingResult_t prvProcessUDPPacket( xNetworkBufferDescriptor_t * const pxNetworkBuffer );
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+	/*
+	 * Add the received fragment of a UDP packet to the packet's reassembly
+	 * context, and process the packet once all its fragments have been
+	 * received.  usFragmentOffset is the IP header's fragment offset field in
+	 * host byte order.  eFrameConsumed is returned if the network buffer is now
+	 * held by the reassembly context, or was passed on as part of the complete
+	 * packet.  eReleaseBuffer is returned if the fragment was dropped.
+	 */
+	static eFrameProcessingResult_t prvReassembleFragment( xNetworkBufferDescriptor_t * const pxNetworkBuffer, uint16_t usFragmentOffset );
+
+	/*
+	 * Called by the ARP timer.  Drop packets that have been in the process of
+	 * being reassembled for too long.
+	 */
+	static void prvAgeReassemblyContexts( void );
+
+	/*
+	 * Release the fragments held by a reassembly context, and mark the context
+	 * as unused.
+	 */
+	static void prvDropReassemblyContext( xReassemblyContext_t *pxContext );
+
+	/*
+	 * Return the ones complement sum of the UDP payload of a packet that was
+	 * reassembled into a chain of network buffers.
+	 */
+	static uint16_t prvSumReassembledPayload( const xNetworkBufferDescriptor_t *pxFirstBuffer );
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+
 /*
  * Process incoming ICMP packets.
  */
@@ -222,6 +331,17 @@ static void prvReturnEthernetFrame( xNetworkBufferDescriptor_t * const pxNetwork
  */
 static uint16_t prvGenerateChecksum( const uint8_t * const pucNextData, const uint16_t usDataLengthBytes, BaseType_t xChecksumIsOffloaded );
 
+/*
+ * Return the sum of xWordCount 32-bit words starting at pulNextWord, which must
+ * be 4 byte aligned.  The sum is not folded.
+ */
+static uint64_t prvSumWords( const uint32_t *pulNextWord, size_t xWordCount );
+
+/*
+ * Fold a wide sum down to a 16-bit ones complement sum.
+ */
+static uint16_t prvFoldChecksum( uint64_t ullSum );
+
 /*
  * The callback function that is assigned to all periodic processing timers -
  * namely the DHCP timer and the ARP timer.
@@ -244,9 +364,12 @@ static void prvRefreshARPCacheEntry( const xMACAddress_t * const pxMACAddress, c
 
 /*
  * Creates the pseudo header necessary then generate the checksum over the UDP
- * packet.  Returns the calculated checksum.
+ * packet.  Returns the calculated checksum.  If pusPayloadChecksum is not NULL
+ * then it points to the ones complement sum of the UDP payload, which was
+ * calculated as the payload was copied into the packet, so only the pseudo
+ * header and the UDP header are summed.
  */
-static uint16_t prvGenerateUDPChecksum( const xUDPPacket_t * const pxUDPPacket, BaseType_t xChecksumIsOffloaded );
+static uint16_t prvGenerateUDPChecksum( const xUDPPacket_t * const pxUDPPacket, const uint16_t * const pusPayloadChecksum, BaseType_t xChecksumIsOffloaded );
 
 /*
  * Look for ulIPAddress in the ARP cache.  If the IP address exists, copy the
@@ -332,6 +455,11 @@ static xARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
 /* The timer that triggers ARP events. */
 static xTimerHandle xARPTimer = NULL;
 
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+	/* The received packets that are in the process of being reassembled. */
+	static xReassemblyContext_t xReassemblyContexts[ ipconfigREASSEMBLY_CONTEXTS ];
+#endif
+
 /* Used to ensure network down events cannot be missed when they cannot be
 posted to the network event queue because the network event queue is already
 full. */
@@ -386,6 +514,8 @@ static xNetworkAddressingParameters_t xNetworkAddressing = { 0, 0, 0, 0 };
 static void prvIPTask( void *pvParameters )
 {
 xIPStackEvent_t xReceivedEvent;
+UBaseType_t uxBatchedEvents = 0;
+TickType_t xTicksToWait;
 
 	/* Just to prevent compiler warnings about unused parameters. */
 	( void ) pvParameters;
@@ -404,10 +534,22 @@ xIPStackEvent_t xReceivedEvent;
 	/* Loop, processing IP events. */
 	for( ;; )
 	{
-		/* Wait until there is something to do. */
-		if( xQueueReceive( xNetworkEventQueue, ( void * ) &xReceivedEvent, portMAX_DELAY ) == pdPASS )
+		/* Wait until there is something to do.  Once the first event of a
+		batch has been received, events that are already queued are processed
+		without blocking again. */
+		if( uxBatchedEvents == 0U )
+		{
+			xTicksToWait = portMAX_DELAY;
+		}
+		else
+		{
+			xTicksToWait = 0;
+		}
+
+		if( xQueueReceive( xNetworkEventQueue, ( void * ) &xReceivedEvent, xTicksToWait ) == pdPASS )
 		{
 			iptraceNETWORK_EVENT_RECEIVED( xReceivedEvent.eEventType );
+			uxBatchedEvents++;
 
 			switch( xReceivedEvent.eEventType )
 			{
@@ -417,22 +559,31 @@ xIPStackEvent_t xReceivedEvent;
 					break;
 
 				case eEthernetRxEvent :
-					/* The network hardware driver has received a new packet.
-					A pointer to the received buffer is located in the pvData
-					member of the received event structure. */
-					prvProcessEthernetPacket( ( xNetworkBufferDescriptor_t * ) ( xReceivedEvent.pvData ) );
+					/* The network hardware driver has received a new packet,
+					or a chain of packets.  A pointer to the (first) received
+					buffer is located in the pvData member of the received event
+					structure. */
+					prvProcessReceivedFrames( ( xNetworkBufferDescriptor_t * ) ( xReceivedEvent.pvData ) );
 					break;
 
 				case eARPTimerEvent :
 					/* The ARP timer has expired, process the ARP cache. */
 					prvAgeARPCache();
+
+					#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+					{
+						/* Drop incomplete packets that have timed out. */
+						prvAgeReassemblyContexts();
+					}
+					#endif
 					break;
 
 				case eStackTxEvent :
-					/* The network stack has generated a packet to send.  A
-					pointer to the generated buffer is located in the pvData
-					member of the received event structure. */
-					prvProcessGeneratedPacket( ( xNetworkBufferDescriptor_t * ) ( xReceivedEvent.pvData ) );
+					/* The network stack has generated a packet, or a chain of
+					packets, to send.  A pointer to the (first) generated buffer
+					is located in the pvData member of the received event
+					structure. */
+					prvProcessGeneratedPackets( ( xNetworkBufferDescriptor_t * ) ( xReceivedEvent.pvData ) );
 					break;
 
 				case eDHCPEvent:
@@ -456,6 +607,19 @@ xIPStackEvent_t xReceivedEvent;
 				FreeRTOS_NetworkDown();
 			}
 		}
+		else
+		{
+			/* There are no more events queued, so the batch is complete. */
+			uxBatchedEvents = ipconfigIP_TASK_BATCH_SIZE;
+		}
+
+		if( uxBatchedEvents >= ( UBaseType_t ) ipconfigIP_TASK_BATCH_SIZE )
+		{
+			/* Wake the tasks that are waiting for the packets received during
+			the batch, once per socket rather than once per packet. */
+			vSocketsWakeReceivers();
+			uxBatchedEvents = 0;
+		}
 	}
 }
 /*-----------------------------------------------------------*/
@@ -499,6 +663,54 @@ BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t FreeRTOS_ReceivedEthernetFrames( xNetworkBufferDescriptor_t * const pxFirstBuffer, TickType_t xBlockTimeTicks )
+{
+xIPStackEvent_t xRxEvent = { eEthernetRxEvent, NULL };
+BaseType_t xReturn;
+
+	configASSERT( pxFirstBuffer );
+
+	xRxEvent.pvData = ( void * ) pxFirstBuffer;
+
+	if( xQueueSendToBack( xNetworkEventQueue, &xRxEvent, xBlockTimeTicks ) == pdPASS )
+	{
+		iptraceNETWORK_INTERFACE_RECEIVE();
+		xReturn = pdPASS;
+	}
+	else
+	{
+		iptraceETHERNET_RX_EVENT_LOST();
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_ReceivedEthernetFramesFromISR( xNetworkBufferDescriptor_t * const pxFirstBuffer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+xIPStackEvent_t xRxEvent = { eEthernetRxEvent, NULL };
+BaseType_t xReturn;
+
+	configASSERT( pxFirstBuffer );
+
+	xRxEvent.pvData = ( void * ) pxFirstBuffer;
+
+	if( xQueueSendToBackFromISR( xNetworkEventQueue, &xRxEvent, pxHigherPriorityTaskWoken ) == pdPASS )
+	{
+		iptraceNETWORK_INTERFACE_RECEIVE();
+		xReturn = pdPASS;
+	}
+	else
+	{
+		iptraceETHERNET_RX_EVENT_LOST();
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 void *FreeRTOS_GetUDPPayloadBuffer( size_t xRequestedSizeBytes, TickType_t xBlockTimeTicks )
 {
 xNetworkBufferDescriptor_t *pxNetworkBuffer;
@@ -537,7 +749,83 @@ uint8_t *pucBuffer;
 	pucBuffer = ( uint8_t * ) pvBuffer;
 	pucBuffer -= ( ipBUFFER_PADDING + sizeof( xUDPPacket_t ) );
 
-	vNetworkBufferRelease( * ( ( xNetworkBufferDescriptor_t ** ) pucBuffer ) );
+	#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	{
+		/* A packet that was reassembled from fragments is received as a chain
+		of network buffers, all of which are released. */
+		vNetworkBufferReleaseChain( * ( ( xNetworkBufferDescriptor_t ** ) pucBuffer ) );
+	}
+	#else
+	{
+		vNetworkBufferRelease( * ( ( xNetworkBufferDescriptor_t ** ) pucBuffer ) );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void *FreeRTOS_GetUDPPayloadSegment( void *pvPayload, UBaseType_t uxSegment, size_t *pxSegmentLength )
+{
+uint8_t *pucBuffer;
+xNetworkBufferDescriptor_t *pxNetworkBuffer;
+void *pvReturn = NULL;
+size_t xLength;
+#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	xNetworkBufferDescriptor_t *pxSegment;
+#endif
+
+	configASSERT( pvPayload );
+
+	/* Obtain the network buffer from the zero copy pointer. */
+	pucBuffer = ( uint8_t * ) pvPayload;
+	pucBuffer -= ( ipBUFFER_PADDING + sizeof( xUDPPacket_t ) );
+	pxNetworkBuffer = * ( ( xNetworkBufferDescriptor_t ** ) pucBuffer );
+
+	/* The xDataLength member of the first network buffer holds the length of
+	the whole payload. */
+	xLength = pxNetworkBuffer->xDataLength;
+
+	if( uxSegment == 0 )
+	{
+		pvReturn = pvPayload;
+	}
+
+	#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	{
+		if( uxSegment == 0 )
+		{
+			/* The first network buffer holds the part of the payload that the
+			following network buffers of the chain do not. */
+			for( pxSegment = pxNetworkBuffer->pxNextBuffer; pxSegment != NULL; pxSegment = pxSegment->pxNextBuffer )
+			{
+				xLength -= pxSegment->xDataLength;
+			}
+		}
+		else
+		{
+			/* The following network buffers hold the payload of one fragment
+			each, without a UDP header. */
+			pxSegment = pxNetworkBuffer->pxNextBuffer;
+			while( ( pxSegment != NULL ) && ( uxSegment > 1 ) )
+			{
+				pxSegment = pxSegment->pxNextBuffer;
+				uxSegment--;
+			}
+
+			if( pxSegment != NULL )
+			{
+				pvReturn = ( void * ) &( pxSegment->pucEthernetBuffer[ ipIP_PAYLOAD_OFFSET ] );
+				xLength = pxSegment->xDataLength;
+			}
+		}
+	}
+	#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+
+	if( pxSegmentLength != NULL )
+	{
+		*pxSegmentLength = ( pvReturn != NULL ) ? xLength : 0;
+	}
+
+	return pvReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -974,6 +1262,9 @@ uint8_t ucMinAgeFound = 0U;
 static void prvCompleteUDPHeader( xNetworkBufferDescriptor_t *pxNetworkBuffer, xUDPPacket_t *pxUDPPacket, uint8_t ucSocketOptions )
 {
 xUDPHeader_t *pxUDPHeader;
+xIPFragmentParameters_t *pxFragmentParameters;
+uint16_t usPayloadChecksum;
+const uint16_t *pusPayloadChecksum = NULL;
 
 	pxUDPHeader = &( pxUDPPacket->xUDPHeader );
 
@@ -985,7 +1276,17 @@ xUDPHeader_t *pxUDPHeader;
 
 	if( ( ucSocketOptions & FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
 	{
-		pxUDPHeader->usChecksum = prvGenerateUDPChecksum( pxUDPPacket, ipconfigETHERNET_DRIVER_ADDS_UDP_CHECKSUM );
+		if( ( ucSocketOptions & FREERTOS_PAYLOAD_CHECKSUMMED ) != 0U )
+		{
+			/* The payload was summed as it was copied into the packet, and the
+			sum was left in the part of the buffer that will later hold the
+			Ethernet header. */
+			pxFragmentParameters = ( xIPFragmentParameters_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipFRAGMENTATION_PARAMETERS_OFFSET ] );
+			usPayloadChecksum = pxFragmentParameters->usPayloadChecksum;
+			pusPayloadChecksum = &usPayloadChecksum;
+		}
+
+		pxUDPHeader->usChecksum = prvGenerateUDPChecksum( pxUDPPacket, pusPayloadChecksum, ipconfigETHERNET_DRIVER_ADDS_UDP_CHECKSUM );
 		if( pxUDPHeader->usChecksum == 0x00 )
 		{
 			/* A calculated checksum of 0 must be inverted as 0 means the
@@ -1414,6 +1715,56 @@ static void prvProcessNetworkDownEvent( void )
 }
 /*-----------------------------------------------------------*/
 
+static void prvProcessGeneratedPackets( xNetworkBufferDescriptor_t *pxFirstBuffer )
+{
+	#if( ipconfigSUPPORT_MMSG_FUNCTIONS == 1 )
+	{
+	xNetworkBufferDescriptor_t *pxNextBuffer;
+
+		while( pxFirstBuffer != NULL )
+		{
+			/* Unlink the buffer before it is processed, as processing can
+			release the buffer or turn it into an ARP request. */
+			pxNextBuffer = pxFirstBuffer->pxNextBuffer;
+			pxFirstBuffer->pxNextBuffer = NULL;
+
+			prvProcessGeneratedPacket( pxFirstBuffer );
+			pxFirstBuffer = pxNextBuffer;
+		}
+	}
+	#else
+	{
+		prvProcessGeneratedPacket( pxFirstBuffer );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessReceivedFrames( xNetworkBufferDescriptor_t *pxFirstBuffer )
+{
+	#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+	{
+	xNetworkBufferDescriptor_t *pxNextBuffer;
+
+		while( pxFirstBuffer != NULL )
+		{
+			/* Unlink the buffer before it is processed, as processing can
+			release the buffer or pass it on to a socket. */
+			pxNextBuffer = pxFirstBuffer->pxNextBuffer;
+			pxFirstBuffer->pxNextBuffer = NULL;
+
+			prvProcessEthernetPacket( pxFirstBuffer );
+			pxFirstBuffer = pxNextBuffer;
+		}
+	}
+	#else
+	{
+		prvProcessEthernetPacket( pxFirstBuffer );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
 static void prvProcessEthernetPacket( xNetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
 xEthernetHeader_t *pxEthernetHeader;
@@ -1479,21 +1830,44 @@ static eFrameProcessingResult_t prvProcessIPPacket( const xIPPacket_t * const px
 {
 eFrameProcessingResult_t eReturn = eReleaseBuffer;
 const xIPHeader_t * pxIPHeader;
-xUDPPacket_t *pxUDPPacket;
-BaseType_t xChecksumIsCorrect;
+uint16_t usFragmentOffset;
 
 	pxIPHeader = &( pxIPPacket->xIPHeader );
+	usFragmentOffset = FreeRTOS_ntohs( pxIPHeader->usFragmentOffset );
 
 	/* Is the packet for this node? */
 	if( ( pxIPHeader->ulDestinationIPAddress == *ipLOCAL_IP_ADDRESS_POINTER ) || ( pxIPHeader->ulDestinationIPAddress == ipBROADCAST_IP_ADDRESS ) || ( *ipLOCAL_IP_ADDRESS_POINTER == 0 ) )
 	{
-		/* Ensure the frame is IPv4 with no options bytes, and that the incoming
-		packet is not fragmented (only outgoing packets can be fragmented) as
-		these are the only handled IP frames currently. */
-		if( ( pxIPHeader->ucVersionHeaderLength == ipIP_VERSION_AND_HEADER_LENGTH_BYTE ) && ( ( pxIPHeader->usFragmentOffset & ipFRAGMENT_OFFSET_BIT_MASK ) == 0U ) )
+		/* Ensure the frame is IPv4 with no options bytes, as these are the only
+		handled IP frames currently. */
+		if( pxIPHeader->ucVersionHeaderLength == ipIP_VERSION_AND_HEADER_LENGTH_BYTE )
 		{
 			/* Is the IP header checksum correct? */
-			if( prvGenerateChecksum( ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipIP_HEADER_LENGTH, ipconfigETHERNET_DRIVER_CHECKS_IP_CHECKSUM ) == 0 )
+			if( prvGenerateChecksum( ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ipIP_HEADER_LENGTH, ipconfigETHERNET_DRIVER_CHECKS_IP_CHECKSUM ) != 0 )
+			{
+				/* The packet is dropped. */
+			}
+			else if( ( usFragmentOffset & ( ipMORE_FRAGMENTS_FLAG_BIT | ipFRAGMENT_OFFSET_BIT_MASK ) ) != 0U )
+			{
+				/* The packet is a fragment of a larger packet.  Fragments are
+				dropped unless they can be reassembled, which is only done for
+				UDP packets. */
+				#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+				{
+					if( pxIPHeader->ucProtocol == ipPROTOCOL_UDP )
+					{
+						prvRefreshARPCacheEntry( &( pxIPPacket->xEthernetHeader.xSourceAddress ), pxIPHeader->ulSourceIPAddress );
+						eReturn = prvReassembleFragment( pxNetworkBuffer, usFragmentOffset );
+					}
+				}
+				#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+
+				if( eReturn == eReleaseBuffer )
+				{
+					iptraceIP_FRAGMENT_DROPPED( pxIPHeader->ulSourceIPAddress );
+				}
+			}
+			else
 			{
 				/* Add the IP and MAC addresses to the ARP table if they are not
 				already there - otherwise refresh the age of the existing
@@ -1521,39 +1895,7 @@ BaseType_t xChecksumIsCorrect;
 					case ipPROTOCOL_UDP :
 
 						/* The IP packet contained a UDP frame. */
-						pxUDPPacket = ( xUDPPacket_t * ) ( pxNetworkBuffer->pucEthernetBuffer );
-
-						/* Note the header values required prior to the
-						checksum generation as the checksum pseudo header
-						may clobber some of these values. */
-						pxNetworkBuffer->xDataLength = FreeRTOS_ntohs( pxUDPPacket->xUDPHeader.usLength ) - sizeof( xUDPHeader_t );
-						pxNetworkBuffer->usPort = pxUDPPacket->xUDPHeader.usSourcePort;
-						pxNetworkBuffer->ulIPAddress = pxUDPPacket->xIPHeader.ulSourceIPAddress;
-
-						/* Is the checksum required? */
-						if( pxUDPPacket->xUDPHeader.usChecksum == 0 )
-						{
-							xChecksumIsCorrect = pdTRUE;
-						}
-						else if( prvGenerateUDPChecksum( pxUDPPacket, ipconfigETHERNET_DRIVER_CHECKS_UDP_CHECKSUM ) == 0 )
-						{
-							xChecksumIsCorrect = pdTRUE;
-						}
-						else
-						{
-							xChecksumIsCorrect = pdFALSE;
-						}
-
-						/* Is the checksum correct? */
-						if( xChecksumIsCorrect == pdTRUE )
-						{
-							/* Pass the packet payload to the UDP sockets
-							implementation. */
-							if( xProcessReceivedUDPPacket( pxNetworkBuffer, pxUDPPacket->xUDPHeader.usDestinationPort ) == pdPASS )
-							{
-								eReturn = eFrameConsumed;
-							}
-						}
+						eReturn = prvProcessUDPPacket( pxNetworkBuffer );
 						break;
 
 					default	:
@@ -1569,7 +1911,336 @@ BaseType_t xChecksumIsCorrect;
 }
 /*-----------------------------------------------------------*/
 
-static uint16_t prvGenerateUDPChecksum( const xUDPPacket_t * const pxUDPPacket, BaseType_t xChecksumIsOffloaded )
+static eFrameProcessingResult_t prvProcessUDPPacket( xNetworkBufferDescriptor_t * const pxNetworkBuffer )
+{
+eFrameProcessingResult_t eReturn = eReleaseBuffer;
+xUDPPacket_t *pxUDPPacket;
+BaseType_t xChecksumIsCorrect;
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+	uint16_t usPayloadChecksum;
+#endif
+
+	pxUDPPacket = ( xUDPPacket_t * ) ( pxNetworkBuffer->pucEthernetBuffer );
+
+	/* Note the header values required prior to the checksum generation as the
+	checksum pseudo header may clobber some of these values. */
+	pxNetworkBuffer->xDataLength = FreeRTOS_ntohs( pxUDPPacket->xUDPHeader.usLength ) - sizeof( xUDPHeader_t );
+	pxNetworkBuffer->usPort = pxUDPPacket->xUDPHeader.usSourcePort;
+	pxNetworkBuffer->ulIPAddress = pxUDPPacket->xIPHeader.ulSourceIPAddress;
+
+	/* Is the checksum required? */
+	if( pxUDPPacket->xUDPHeader.usChecksum == 0 )
+	{
+		xChecksumIsCorrect = pdTRUE;
+	}
+	#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+	else if( pxNetworkBuffer->pxNextBuffer != NULL )
+	{
+		/* The packet was reassembled from fragments, so the hardware cannot
+		have checked the checksum, and the payload is spread across the chain
+		of network buffers. */
+		usPayloadChecksum = prvSumReassembledPayload( pxNetworkBuffer );
+
+		if( prvGenerateUDPChecksum( pxUDPPacket, &usPayloadChecksum, pdFALSE ) == 0 )
+		{
+			xChecksumIsCorrect = pdTRUE;
+		}
+		else
+		{
+			xChecksumIsCorrect = pdFALSE;
+		}
+	}
+	#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+	else if( prvGenerateUDPChecksum( pxUDPPacket, NULL, ipconfigETHERNET_DRIVER_CHECKS_UDP_CHECKSUM ) == 0 )
+	{
+		xChecksumIsCorrect = pdTRUE;
+	}
+	else
+	{
+		xChecksumIsCorrect = pdFALSE;
+	}
+
+	/* Is the checksum correct? */
+	if( xChecksumIsCorrect == pdTRUE )
+	{
+		/* Pass the packet payload to the UDP sockets implementation. */
+		if( xProcessReceivedUDPPacket( pxNetworkBuffer, pxUDPPacket->xUDPHeader.usDestinationPort ) == pdPASS )
+		{
+			eReturn = eFrameConsumed;
+		}
+	}
+
+	return eReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+
+	static eFrameProcessingResult_t prvReassembleFragment( xNetworkBufferDescriptor_t * const pxNetworkBuffer, uint16_t usFragmentOffset )
+	{
+	eFrameProcessingResult_t eReturn = eReleaseBuffer;
+	const xIPHeader_t *pxIPHeader;
+	xReassemblyContext_t *pxContext = NULL, *pxOldestContext = NULL;
+	xNetworkBufferDescriptor_t *pxPrevious = NULL, *pxNext;
+	uint32_t ulOffset, ulLength, ulEnd;
+	BaseType_t xMoreFragments, x;
+
+		pxIPHeader = &( ( ( xIPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer )->xIPHeader );
+
+		/* Obtain the position of the fragment's payload within the IP payload
+		of the whole packet. */
+		ulOffset = ( ( uint32_t ) ( usFragmentOffset & ipFRAGMENT_OFFSET_BIT_MASK ) ) << ipSHIFT_TO_DIVIDE_BY_8;
+		ulLength = ( uint32_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+
+		if( ulLength > ipIP_HEADER_LENGTH )
+		{
+			ulLength -= ipIP_HEADER_LENGTH;
+		}
+		else
+		{
+			ulLength = 0UL;
+		}
+
+		ulEnd = ulOffset + ulLength;
+		xMoreFragments = ( ( usFragmentOffset & ipMORE_FRAGMENTS_FLAG_BIT ) != 0U ) ? pdTRUE : pdFALSE;
+
+		/* Only fragments that are not empty, are held completely in the
+		received frame, and form part of a packet that is not too big to be
+		reassembled are accepted.  All but the last fragment must hold a
+		multiple of 8 bytes. */
+		if( ( ulLength > 0UL ) &&
+			( ( ipIP_PAYLOAD_OFFSET + ulLength ) <= pxNetworkBuffer->xDataLength ) &&
+			( ulEnd <= ( ipconfigREASSEMBLY_MAX_PAYLOAD_BYTES + sizeof( xUDPHeader_t ) ) ) &&
+			( ( xMoreFragments == pdFALSE ) || ( ( ulLength & 0x07UL ) == 0UL ) ) )
+		{
+			/* Find the context of the packet the fragment belongs to, and the
+			context that will be reused if the packet does not have one yet. */
+			for( x = 0; x < ipconfigREASSEMBLY_CONTEXTS; x++ )
+			{
+				if( xReassemblyContexts[ x ].ucAge == 0U )
+				{
+					if( ( pxOldestContext == NULL ) || ( pxOldestContext->ucAge != 0U ) )
+					{
+						pxOldestContext = &( xReassemblyContexts[ x ] );
+					}
+				}
+				else if( ( xReassemblyContexts[ x ].ulSourceIPAddress == pxIPHeader->ulSourceIPAddress ) &&
+						 ( xReassemblyContexts[ x ].ulDestinationIPAddress == pxIPHeader->ulDestinationIPAddress ) &&
+						 ( xReassemblyContexts[ x ].usIdentification == pxIPHeader->usIdentification ) )
+				{
+					pxContext = &( xReassemblyContexts[ x ] );
+					break;
+				}
+				else if( ( pxOldestContext == NULL ) || ( xReassemblyContexts[ x ].ucAge < pxOldestContext->ucAge ) )
+				{
+					pxOldestContext = &( xReassemblyContexts[ x ] );
+				}
+				else
+				{
+					/* Not a candidate. */
+				}
+			}
+
+			if( pxContext == NULL )
+			{
+				/* This is the first fragment of the packet to be received.  If
+				all the contexts are in use then the packet that has been
+				waiting longest is dropped to make room for this one. */
+				pxContext = pxOldestContext;
+
+				if( pxContext->ucAge != 0U )
+				{
+					prvDropReassemblyContext( pxContext );
+				}
+
+				pxContext->ulSourceIPAddress = pxIPHeader->ulSourceIPAddress;
+				pxContext->ulDestinationIPAddress = pxIPHeader->ulDestinationIPAddress;
+				pxContext->usIdentification = pxIPHeader->usIdentification;
+				pxContext->usTotalLength = 0U;
+				pxContext->usReceivedLength = 0U;
+				pxContext->ucFragmentCount = 0U;
+				pxContext->ucAge = ( uint8_t ) ipconfigREASSEMBLY_MAX_AGE;
+				pxContext->pxFirstFragment = NULL;
+			}
+
+			/* Find where the fragment goes in the chain, which is held in order
+			of offset. */
+			pxNext = pxContext->pxFirstFragment;
+			while( ( pxNext != NULL ) && ( ( uint32_t ) pxNext->usPort < ulOffset ) )
+			{
+				pxPrevious = pxNext;
+				pxNext = pxNext->pxNextBuffer;
+			}
+
+			if( ( ( pxPrevious != NULL ) && ( ( ( uint32_t ) pxPrevious->usPort + pxPrevious->xDataLength ) > ulOffset ) ) ||
+				( ( pxNext != NULL ) && ( ( uint32_t ) pxNext->usPort < ulEnd ) ) )
+			{
+				/* The fragment overlaps a fragment that has already been
+				received, most likely because it is a duplicate, so it is
+				dropped but the fragments already received are kept. */
+			}
+			else if( ( ( pxContext->usTotalLength != 0U ) && ( ( ulEnd > pxContext->usTotalLength ) || ( ( xMoreFragments == pdFALSE ) && ( ulEnd != pxContext->usTotalLength ) ) ) ) ||
+					 ( ( xMoreFragments == pdFALSE ) && ( pxNext != NULL ) ) ||
+					 ( pxContext->ucFragmentCount >= ( uint8_t ) ipconfigREASSEMBLY_MAX_FRAGMENTS ) )
+			{
+				/* The fragment is not consistent with the fragments already
+				received, or the packet is in too many fragments to be
+				reassembled, so the whole packet is dropped. */
+				prvDropReassemblyContext( pxContext );
+			}
+			else
+			{
+				/* Hold the fragment in the chain. */
+				pxNetworkBuffer->xDataLength = ( size_t ) ulLength;
+				pxNetworkBuffer->usPort = ( uint16_t ) ulOffset;
+				pxNetworkBuffer->pxNextBuffer = pxNext;
+
+				if( pxPrevious == NULL )
+				{
+					pxContext->pxFirstFragment = pxNetworkBuffer;
+				}
+				else
+				{
+					pxPrevious->pxNextBuffer = pxNetworkBuffer;
+				}
+
+				pxContext->usReceivedLength += ( uint16_t ) ulLength;
+				( pxContext->ucFragmentCount )++;
+
+				if( xMoreFragments == pdFALSE )
+				{
+					pxContext->usTotalLength = ( uint16_t ) ulEnd;
+				}
+
+				eReturn = eFrameConsumed;
+
+				/* Fragments cannot overlap, so the packet is complete once
+				the number of bytes received matches the length of the
+				packet. */
+				if( pxContext->usReceivedLength == pxContext->usTotalLength )
+				{
+					pxNext = pxContext->pxFirstFragment;
+					pxContext->pxFirstFragment = NULL;
+					pxContext->ucAge = 0U;
+
+					/* The first fragment holds the UDP header, which must
+					describe the whole packet. */
+					if( FreeRTOS_ntohs( ( ( xUDPPacket_t * ) pxNext->pucEthernetBuffer )->xUDPHeader.usLength ) == pxContext->usTotalLength )
+					{
+						iptraceREASSEMBLY_COMPLETE( pxContext->ulSourceIPAddress, ( size_t ) ( pxContext->usTotalLength - sizeof( xUDPHeader_t ) ) );
+
+						if( prvProcessUDPPacket( pxNext ) == eFrameConsumed )
+						{
+							pxNext = NULL;
+						}
+					}
+
+					if( pxNext != NULL )
+					{
+						vNetworkBufferReleaseChain( pxNext );
+					}
+				}
+			}
+		}
+
+		return eReturn;
+	}
+
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+/*-----------------------------------------------------------*/
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+
+	static void prvAgeReassemblyContexts( void )
+	{
+	BaseType_t x;
+
+		for( x = 0; x < ipconfigREASSEMBLY_CONTEXTS; x++ )
+		{
+			if( xReassemblyContexts[ x ].ucAge > 0U )
+			{
+				( xReassemblyContexts[ x ].ucAge )--;
+
+				if( xReassemblyContexts[ x ].ucAge == 0U )
+				{
+					/* The packet has not been completely received in time. */
+					prvDropReassemblyContext( &( xReassemblyContexts[ x ] ) );
+				}
+			}
+		}
+	}
+
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+/*-----------------------------------------------------------*/
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+
+	static void prvDropReassemblyContext( xReassemblyContext_t *pxContext )
+	{
+		iptraceREASSEMBLY_DROPPED( pxContext->ulSourceIPAddress );
+
+		if( pxContext->pxFirstFragment != NULL )
+		{
+			vNetworkBufferReleaseChain( pxContext->pxFirstFragment );
+			pxContext->pxFirstFragment = NULL;
+		}
+
+		pxContext->ucAge = 0U;
+	}
+
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+/*-----------------------------------------------------------*/
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+
+	static uint16_t prvSumReassembledPayload( const xNetworkBufferDescriptor_t *pxFirstBuffer )
+	{
+	const xNetworkBufferDescriptor_t *pxBuffer;
+	size_t xFirstLength;
+	uint16_t usSum;
+
+		/* The first buffer's xDataLength holds the length of the whole
+		payload, so the length of the part it holds itself is what remains
+		once the lengths of the following buffers are subtracted. */
+		xFirstLength = pxFirstBuffer->xDataLength;
+		for( pxBuffer = pxFirstBuffer->pxNextBuffer; pxBuffer != NULL; pxBuffer = pxBuffer->pxNextBuffer )
+		{
+			xFirstLength -= pxBuffer->xDataLength;
+		}
+
+		/* All but the last fragment hold a multiple of 8 bytes, so the sums
+		of the individual buffers can be combined. */
+		usSum = usGenerateChecksum( 0UL, &( pxFirstBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET ] ), xFirstLength );
+		for( pxBuffer = pxFirstBuffer->pxNextBuffer; pxBuffer != NULL; pxBuffer = pxBuffer->pxNextBuffer )
+		{
+			usSum = usGenerateChecksum( ( uint32_t ) usSum, &( pxBuffer->pucEthernetBuffer[ ipIP_PAYLOAD_OFFSET ] ), pxBuffer->xDataLength );
+		}
+
+		return usSum;
+	}
+
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+/*-----------------------------------------------------------*/
+
+#if ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1
+
+	void vNetworkBufferReleaseChain( xNetworkBufferDescriptor_t *pxFirstBuffer )
+	{
+	xNetworkBufferDescriptor_t *pxNextBuffer;
+
+		while( pxFirstBuffer != NULL )
+		{
+			pxNextBuffer = pxFirstBuffer->pxNextBuffer;
+			pxFirstBuffer->pxNextBuffer = NULL;
+			vNetworkBufferRelease( pxFirstBuffer );
+			pxFirstBuffer = pxNextBuffer;
+		}
+	}
+
+#endif /* ipconfigCAN_REASSEMBLE_INCOMING_PACKETS */
+/*-----------------------------------------------------------*/
+
+static uint16_t prvGenerateUDPChecksum( const xUDPPacket_t * const pxUDPPacket, const uint16_t * const pusPayloadChecksum, BaseType_t xChecksumIsOffloaded )
 {
 xPseudoHeader_t *pxPseudoHeader;
 uint16_t usLength, usReturn;
@@ -1589,8 +2260,17 @@ uint16_t usLength, usReturn;
 		pxPseudoHeader->ucProtocol = ipPROTOCOL_UDP;
 		pxPseudoHeader->usUDPLength = pxUDPPacket->xUDPHeader.usLength;
 
-		usLength = FreeRTOS_ntohs( pxPseudoHeader->usUDPLength );
-		usReturn = prvGenerateChecksum( ( uint8_t * ) pxPseudoHeader, usLength + sizeof( xPseudoHeader_t ), pdFALSE );
+		if( pusPayloadChecksum == NULL )
+		{
+			usLength = FreeRTOS_ntohs( pxPseudoHeader->usUDPLength );
+			usReturn = prvGenerateChecksum( ( uint8_t * ) pxPseudoHeader, usLength + sizeof( xPseudoHeader_t ), pdFALSE );
+		}
+		else
+		{
+			/* The payload starts an even number of bytes after the pseudo
+			header, so its sum can be added to the sum of the headers. */
+			usReturn = ~usGenerateChecksum( ( uint32_t ) *pusPayloadChecksum, ( uint8_t * ) pxPseudoHeader, sizeof( xPseudoHeader_t ) + sizeof( xUDPHeader_t ) );
+		}
 	}
 	else
 	{
@@ -1729,48 +2409,201 @@ uint16_t usLength, usReturn;
 
 static uint16_t prvGenerateChecksum( const uint8_t * const pucNextData, const uint16_t usDataLengthBytes, BaseType_t xChecksumIsOffloaded )
 {
-uint32_t ulChecksum = 0;
-uint16_t us, usDataLength16BitWords, *pusNextData, usReturn;
+uint16_t usReturn;
 
 	if( xChecksumIsOffloaded == pdFALSE )
 	{
-		/* There are half as many 16 bit words than bytes. */
-		usDataLength16BitWords = ( usDataLengthBytes >> 1U );
+		usReturn = ~usGenerateChecksum( 0UL, pucNextData, ( size_t ) usDataLengthBytes );
+	}
+	else
+	{
+		/* The checksum is calculated by the hardware.  Return 0 here to ensure
+		this works for both incoming and outgoing checksums. */
+		usReturn = 0;
+	}
+
+	return usReturn;
+}
+/*-----------------------------------------------------------*/
+
+static uint16_t prvFoldChecksum( uint64_t ullSum )
+{
+	/* Add the carries back into the bottom 16 bits, as required by ones
+	complement addition. */
+	while( ( ullSum >> 16ULL ) != 0ULL )
+	{
+		ullSum = ( ullSum & 0xffffULL ) + ( ullSum >> 16ULL );
+	}
+
+	return ( uint16_t ) ullSum;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvSumWords( const uint32_t *pulNextWord, size_t xWordCount )
+{
+uint64_t ullSum0 = 0ULL, ullSum1 = 0ULL;
+
+	/* Adding a 32-bit word to a 64-bit accumulator cannot lose a carry, so
+	the words can be summed without folding.  The loop is unrolled, and
+	uses two accumulators so consecutive additions do not depend on each
+	other. */
+	while( xWordCount >= 8 )
+	{
+		ullSum0 += pulNextWord[ 0 ];
+		ullSum1 += pulNextWord[ 1 ];
+		ullSum0 += pulNextWord[ 2 ];
+		ullSum1 += pulNextWord[ 3 ];
+		ullSum0 += pulNextWord[ 4 ];
+		ullSum1 += pulNextWord[ 5 ];
+		ullSum0 += pulNextWord[ 6 ];
+		ullSum1 += pulNextWord[ 7 ];
+		pulNextWord += 8;
+		xWordCount -= 8;
+	}
+
+	while( xWordCount > 0 )
+	{
+		ullSum0 += *pulNextWord;
+		pulNextWord++;
+		xWordCount--;
+	}
+
+	return ullSum0 + ullSum1;
+}
+/*-----------------------------------------------------------*/
+
+uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t *pucNextData, size_t xByteCount )
+{
+uint64_t ullSum;
+uint16_t usWordsSum;
+BaseType_t xOddOffset = pdFALSE;
+size_t xWordCount;
+
+	ullSum = ( uint64_t ) ulSum;
+
+	/* Sum single bytes until pucNextData is aligned for 32-bit accesses. */
+	while( ( ( ( size_t ) pucNextData & 0x03U ) != 0U ) && ( xByteCount > 0U ) )
+	{
+		ullSum += ipCHECKSUM_BYTE( *pucNextData, xOddOffset );
+		xOddOffset = !xOddOffset;
+		pucNextData++;
+		xByteCount--;
+	}
+
+	/* Sum the bulk of the data a word at a time. */
+	xWordCount = xByteCount >> 2;
+	usWordsSum = prvFoldChecksum( prvSumWords( ( const uint32_t * ) pucNextData, xWordCount ) );
+	pucNextData += ( xWordCount << 2 );
+	xByteCount &= 0x03U;
 
-		pusNextData = ( uint16_t * ) pucNextData;
+	if( xOddOffset != pdFALSE )
+	{
+		usWordsSum = ipSWAP_CHECKSUM_BYTES( usWordsSum );
+	}
+
+	ullSum += usWordsSum;
+
+	/* Sum any bytes that remain. */
+	while( xByteCount > 0U )
+	{
+		ullSum += ipCHECKSUM_BYTE( *pucNextData, xOddOffset );
+		xOddOffset = !xOddOffset;
+		pucNextData++;
+		xByteCount--;
+	}
+
+	return prvFoldChecksum( ullSum );
+}
+/*-----------------------------------------------------------*/
+
+uint16_t usGenerateChecksumAndCopy( uint8_t *pucDestination, const uint8_t *pucSource, size_t xByteCount )
+{
+uint64_t ullSum = 0ULL, ullWordsSum = 0ULL;
+uint32_t ulWord;
+uint16_t usWordsSum, usReturn;
+BaseType_t xOddOffset = pdFALSE;
 
-		for( us = 0U; us < usDataLength16BitWords; us++ )
+	if( ( ( ( size_t ) pucDestination ^ ( size_t ) pucSource ) & 0x01U ) != 0U )
+	{
+		/* The source and destination can never both be aligned for 16-bit
+		accesses, so copy first, then sum the copy. */
+		memcpy( ( void * ) pucDestination, ( const void * ) pucSource, xByteCount );
+		usReturn = usGenerateChecksum( 0UL, pucDestination, xByteCount );
+	}
+	else
+	{
+		/* Copy and sum single bytes until pucSource is aligned for 32-bit
+		accesses.  pucDestination is then aligned for at least 16-bit accesses. */
+		while( ( ( ( size_t ) pucSource & 0x03U ) != 0U ) && ( xByteCount > 0U ) )
 		{
-			ulChecksum += ( uint32_t ) pusNextData[ us ];
+			*pucDestination = *pucSource;
+			ullSum += ipCHECKSUM_BYTE( *pucSource, xOddOffset );
+			xOddOffset = !xOddOffset;
+			pucDestination++;
+			pucSource++;
+			xByteCount--;
 		}
 
-		if( ( usDataLengthBytes & 0x01U ) != 0x00 )
+		if( ( ( size_t ) pucDestination & 0x03U ) == 0U )
 		{
-			/* There is one byte left over. */
-			#if ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN
+			while( xByteCount >= 4U )
 			{
-				ulChecksum += ( uint32_t ) pucNextData[ usDataLengthBytes - 1 ];
+				ulWord = *( ( const uint32_t * ) pucSource );
+				*( ( uint32_t * ) pucDestination ) = ulWord;
+				ullWordsSum += ulWord;
+				pucDestination += 4;
+				pucSource += 4;
+				xByteCount -= 4U;
 			}
-			#else
+		}
+		else
+		{
+			/* The destination is only aligned for 16-bit accesses, which is the
+			case when a 4 byte aligned buffer is copied into a UDP payload. */
+			while( xByteCount >= 4U )
 			{
-				us = ( uint16_t ) pucNextData[ usDataLengthBytes - 1 ];
-				ulChecksum += ( uint32_t ) ( us << 8 );
+				ulWord = *( ( const uint32_t * ) pucSource );
+
+				#if ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN
+				{
+					( ( uint16_t * ) pucDestination )[ 0 ] = ( uint16_t ) ulWord;
+					( ( uint16_t * ) pucDestination )[ 1 ] = ( uint16_t ) ( ulWord >> 16UL );
+				}
+				#else
+				{
+					( ( uint16_t * ) pucDestination )[ 0 ] = ( uint16_t ) ( ulWord >> 16UL );
+					( ( uint16_t * ) pucDestination )[ 1 ] = ( uint16_t ) ulWord;
+				}
+				#endif
+
+				ullWordsSum += ulWord;
+				pucDestination += 4;
+				pucSource += 4;
+				xByteCount -= 4U;
 			}
-			#endif
 		}
 
-		while( ( ulChecksum >> 16UL ) != 0x00UL )
+		usWordsSum = prvFoldChecksum( ullWordsSum );
+
+		if( xOddOffset != pdFALSE )
 		{
-			ulChecksum = ( ulChecksum & 0xffffUL ) + ( ulChecksum >> 16UL );
+			usWordsSum = ipSWAP_CHECKSUM_BYTES( usWordsSum );
 		}
 
-		usReturn = ~( ( uint16_t ) ulChecksum );
-	}
-	else
-	{
-		/* The checksum is calculated by the hardware.  Return 0 here to ensure
-		this works for both incoming and outgoing checksums. */
-		usReturn = 0;
+		ullSum += usWordsSum;
+
+		/* Copy and sum any bytes that remain. */
+		while( xByteCount > 0U )
+		{
+			*pucDestination = *pucSource;
+			ullSum += ipCHECKSUM_BYTE( *pucSource, xOddOffset );
+			xOddOffset = !xOddOffset;
+			pucDestination++;
+			pucSource++;
+			xByteCount--;
+		}
+
+		usReturn = prvFoldChecksum( ullSum );
 	}
 
 	return usReturn;
@@ -90,6 +90,26 @@ from the FreeRTOSIPConfig.h configuration header file. */
 	#define ipconfigCAN_FRAGMENT_OUTGOING_PACKETS 0
 #endif
 
+#ifndef ipconfigCAN_REASSEMBLE_INCOMING_PACKETS
+	#define ipconfigCAN_REASSEMBLE_INCOMING_PACKETS 0
+#endif
+
+#ifndef ipconfigREASSEMBLY_CONTEXTS
+	#define ipconfigREASSEMBLY_CONTEXTS 2
+#endif
+
+#ifndef ipconfigREASSEMBLY_MAX_PAYLOAD_BYTES
+	#define ipconfigREASSEMBLY_MAX_PAYLOAD_BYTES 16384
+#endif
+
+#ifndef ipconfigREASSEMBLY_MAX_FRAGMENTS
+	#define ipconfigREASSEMBLY_MAX_FRAGMENTS 12
+#endif
+
+#ifndef ipconfigREASSEMBLY_MAX_AGE
+	#define ipconfigREASSEMBLY_MAX_AGE 2
+#endif
+
 #ifndef ipconfigNETWORK_MTU
 	#define ipconfigNETWORK_MTU 1500
 #endif
@@ -151,7 +171,23 @@ from the FreeRTOSIPConfig.h configuration header file. */
 #ifndef ipconfigSUPPORT_SELECT_FUNCTION
 	#define ipconfigSUPPORT_SELECT_FUNCTION 0
 #endif
+
+#ifndef ipconfigSUPPORT_MMSG_FUNCTIONS
+	#define ipconfigSUPPORT_MMSG_FUNCTIONS 0
+#endif
 		
+#ifndef ipconfigSOCKET_HASH_BUCKETS
+	#define ipconfigSOCKET_HASH_BUCKETS 8
+#endif
+
+#ifndef ipconfigUSE_LINKED_RX_MESSAGES
+	#define ipconfigUSE_LINKED_RX_MESSAGES 0
+#endif
+
+#ifndef ipconfigIP_TASK_BATCH_SIZE
+	#define ipconfigIP_TASK_BATCH_SIZE 8
+#endif
+
 #ifndef ipconfigETHERNET_DRIVER_ADDS_UDP_CHECKSUM
 	#define ipconfigETHERNET_DRIVER_ADDS_UDP_CHECKSUM 0
 #endif
@@ -274,6 +274,16 @@ typedef struct xUDP_IP_FRACMENT_PARAMETERS xIPFragmentParameters_t;
 
 #endif /* ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN */
 
+/* Network buffers are linked into chains when several received frames are
+passed to the IP task in one event, when several datagrams are passed to the
+IP task in one event by FreeRTOS_sendmmsg(), or to hold the fragments of a
+received packet that is being reassembled. */
+#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 ) || ( ipconfigSUPPORT_MMSG_FUNCTIONS != 0 ) || ( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS != 0 )
+	#define ipLINKED_NETWORK_BUFFERS	1
+#else
+	#define ipLINKED_NETWORK_BUFFERS	0
+#endif
+
 /* The structure used to store buffers and pass them around the network stack.
 Buffers can be in use by the stack, in use by the network interface hardware
 driver, or free (not in use). */
@@ -285,10 +295,26 @@ typedef struct xNETWORK_BUFFER
 	size_t xDataLength; 			/* Starts by holding the total Ethernet frame length, then the UDP payload length. */
 	uint16_t usPort;				/* Source or destination port, depending on usage scenario. */
 	uint16_t usBoundPort;			/* The port to which a transmitting socket is bound. */
+	#if( ipLINKED_NETWORK_BUFFERS != 0 )
+		struct xNETWORK_BUFFER *pxNextBuffer; /* Links buffers that are passed to the IP task in a single event. */
+	#endif
 } xNetworkBufferDescriptor_t;
 
 void vNetworkBufferRelease( xNetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+#if( ipconfigCAN_REASSEMBLE_INCOMING_PACKETS == 1 )
+	/*
+	 * Release pxFirstBuffer, and any network buffers chained to it through
+	 * their pxNextBuffer members.  A UDP packet that was reassembled from
+	 * fragments is passed to its socket as such a chain.  The first buffer holds
+	 * the UDP header, and its xDataLength member holds the length of the whole
+	 * UDP payload.  Each following buffer holds the payload of one further
+	 * fragment, starting at ipIP_PAYLOAD_OFFSET, and its xDataLength member holds
+	 * the number of payload bytes it contains.
+	 */
+	void vNetworkBufferReleaseChain( xNetworkBufferDescriptor_t *pxFirstBuffer );
+#endif
+
 /*
  * A version of FreeRTOS_GetReleaseNetworkBuffer() that can be called from an
  * interrupt.  If a non zero value is returned, then the calling ISR should
@@ -311,6 +337,23 @@ BaseType_t FreeRTOS_ReleaseFreeNetworkBufferFromISR( void );
 void FreeRTOS_NetworkDown( void );
 BaseType_t FreeRTOS_NetworkDownFromISR( void );
 
+/*
+ * Pass received Ethernet frames to the IP task.  pxFirstBuffer is the first of
+ * the received network buffers.  When ipconfigUSE_LINKED_RX_MESSAGES is not 0
+ * further buffers can be chained to it through their pxNextBuffer members, the
+ * last buffer in the chain having a NULL pxNextBuffer, and the whole chain is
+ * then passed to the IP task in a single event.  pdPASS is returned if the
+ * event was sent.  If pdFAIL is returned the buffers still belong to the
+ * caller, which must release them.
+ *
+ * Only use the FreeRTOS_ReceivedEthernetFramesFromISR() version if the function
+ * is to be called from an interrupt service routine, in which case
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if a context switch should be
+ * performed before the interrupt is exited.
+ */
+BaseType_t FreeRTOS_ReceivedEthernetFrames( xNetworkBufferDescriptor_t * const pxFirstBuffer, TickType_t xBlockTimeTicks );
+BaseType_t FreeRTOS_ReceivedEthernetFramesFromISR( xNetworkBufferDescriptor_t * const pxFirstBuffer, BaseType_t *pxHigherPriorityTaskWoken );
+
 /*
  * Inspect an Ethernet frame to see if it contains data that the stack needs to
  * process.  eProcessBuffer is returned if the frame should be processed by the
@@ -318,12 +361,29 @@ BaseType_t FreeRTOS_NetworkDownFromISR( void );
  */
 eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucEthernetBuffer );
 
+/*
+ * Return the ones complement sum of xByteCount bytes starting at pucNextData,
+ * added to the partial sum ulSum.  The result is folded to 16 bits but not
+ * inverted, so the sums of separate blocks of data can be combined by passing
+ * the sum of one block as ulSum when summing the next.  Each block other than
+ * the last must hold an even number of bytes.
+ */
+uint16_t usGenerateChecksum( uint32_t ulSum, const uint8_t *pucNextData, size_t xByteCount );
+
+/*
+ * Copy xByteCount bytes from pucSource to pucDestination, and return the same
+ * sum as usGenerateChecksum( 0, pucSource, xByteCount ).  The data is summed
+ * as it is copied so it only needs to be read once.
+ */
+uint16_t usGenerateChecksumAndCopy( uint8_t *pucDestination, const uint8_t *pucSource, size_t xByteCount );
+
 #if( ipconfigINCLUDE_TEST_CODE == 1 )
 	UBaseType_t uxGetNumberOfFreeNetworkBuffers( void );
 #endif /* ipconfigINCLUDE_TEST_CODE */
 
 /* Socket related private functions. */
 BaseType_t xProcessReceivedUDPPacket( xNetworkBufferDescriptor_t *pxNetworkBuffer, uint16_t usPort );
+void vSocketsWakeReceivers( void );
 void FreeRTOS_SocketsInit( void );
 
 /* If FreeRTOS+NABTO is included then include the prototype of the function that
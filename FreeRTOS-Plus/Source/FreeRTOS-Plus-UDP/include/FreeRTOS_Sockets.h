@@ -85,6 +85,16 @@ indicates that the zero copy interface is being used.  See the documentation for
 FreeRTOS_sockets() for more information. */
 #define FREERTOS_ZERO_COPY		( 0x01UL )
 
+/* A bit value that can be passed into the FreeRTOS_recvfrom() and
+FreeRTOS_recvmmsg() functions together with FREERTOS_ZERO_COPY.  A zero copy
+receive normally returns only the part of a packet that was reassembled from
+fragments that is held in the packet's first segment, as that is the only part
+that can be read from the returned pointer.  When FREERTOS_ZERO_COPY_SEGMENTS
+is also set the whole packet is received, the returned length is the length of
+the whole packet, and each of its segments must be found by calling
+FreeRTOS_GetUDPPayloadSegment(). */
+#define FREERTOS_ZERO_COPY_SEGMENTS	( 0x02UL )
+
 /* Values that can be passed in the option name parameter of calls to
 FreeRTOS_setsockopt(). */
 #define FREERTOS_SO_RCVTIMEO		( 0 )		/* Used to set the receive time out. */
@@ -92,6 +102,7 @@ FreeRTOS_setsockopt(). */
 #define FREERTOS_SO_UDPCKSUM_OUT	( 0x02 ) 	/* Used to turn the use of the UDP checksum by a socket on or off.  This also doubles as part of an 8-bit bitwise socket option. */
 #define FREERTOS_NOT_LAST_IN_FRAGMENTED_PACKET 	( 0x80 )  /* For internal use only, but also part of an 8-bit bitwise value. */
 #define FREERTOS_FRAGMENTED_PACKET				( 0x40 )  /* For internal use only, but also part of an 8-bit bitwise value. */
+#define FREERTOS_PAYLOAD_CHECKSUMMED			( 0x20 )  /* For internal use only, but also part of an 8-bit bitwise value. */
 
 /* For compatibility with the expected Berkeley sockets naming. */
 #define socklen_t uint32_t
@@ -104,6 +115,20 @@ struct freertos_sockaddr
 	uint32_t sin_addr;
 };
 
+/* Describes one of the datagrams received by FreeRTOS_recvmmsg() or sent by
+FreeRTOS_sendmmsg().  msg_len is the length of the buffer pointed to by msg_buf
+on entry to FreeRTOS_recvmmsg(), and the number of bytes received into it on
+exit.  When FREERTOS_ZERO_COPY is used msg_buf is instead set to point to the
+received data, which must be returned to the stack by calling
+FreeRTOS_ReleaseUDPPayloadBuffer().  msg_addr receives the source address of a
+received datagram, or holds the destination address of a datagram to send. */
+struct freertos_mmsghdr
+{
+	void *msg_buf;
+	size_t msg_len;
+	struct freertos_sockaddr msg_addr;
+};
+
 #if ipconfigBYTE_ORDER == FREERTOS_LITTLE_ENDIAN
 
 	#define FreeRTOS_inet_addr_quick( ucOctet0, ucOctet1, ucOctet2, ucOctet3 )				\
@@ -164,6 +189,11 @@ uint32_t FreeRTOS_inet_addr( const char *pcIPAddress );
 	xSocket_t FreeRTOS_select( xSocketSet_t xSocketSet, TickType_t xBlockTimeTicks );
 #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
 
+#if ipconfigSUPPORT_MMSG_FUNCTIONS == 1
+	int32_t FreeRTOS_recvmmsg( xSocket_t xSocket, struct freertos_mmsghdr *pxMessages, size_t xMessageCount, uint32_t ulFlags );
+	int32_t FreeRTOS_sendmmsg( xSocket_t xSocket, struct freertos_mmsghdr *pxMessages, size_t xMessageCount, uint32_t ulFlags );
+#endif /* ipconfigSUPPORT_MMSG_FUNCTIONS */
+
 #endif /* FREERTOS_UDP_H */
 
 
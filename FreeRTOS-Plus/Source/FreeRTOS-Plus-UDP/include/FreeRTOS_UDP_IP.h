@@ -105,6 +105,17 @@ BaseType_t FreeRTOS_SendPingRequest( uint32_t ulIPAddress, size_t xNumberOfBytes
 void vApplicationIPNetworkEventHook( eIPCallbackEvent_t eNetworkEvent );
 void vApplicationPingReplyHook( ePingReplyStatus_t eStatus, uint16_t usIdentifier );
 void FreeRTOS_ReleaseUDPPayloadBuffer( void *pvBuffer );
+
+/*
+ * A packet received with the FREERTOS_ZERO_COPY and FREERTOS_ZERO_COPY_SEGMENTS
+ * flags that was reassembled from fragments is held in several separate
+ * segments.  pvPayload is the pointer returned by the zero copy receive.  Returns a pointer to segment uxSegment of
+ * the payload, and writes the number of bytes it holds to *pxSegmentLength, or
+ * returns NULL if the payload does not have that many segments.  Segment 0
+ * always starts at pvPayload.  A packet that was not fragmented has only one
+ * segment, which holds the whole payload.
+ */
+void * FreeRTOS_GetUDPPayloadSegment( void *pvPayload, UBaseType_t uxSegment, size_t *pxSegmentLength );
 uint8_t * FreeRTOS_GetMACAddress( void );
 
 #if ( ipconfigFREERTOS_PLUS_NABTO == 1 )
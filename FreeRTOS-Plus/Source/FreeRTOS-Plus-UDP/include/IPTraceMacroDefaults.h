@@ -191,4 +191,16 @@ http://www.FreeRTOS.org/FreeRTOS-Plus/FreeRTOS_Plus_UDP/UDP_IP_Trace.shtml */
 	#define iptraceSENDTO_DATA_TOO_LONG()
 #endif
 
+#ifndef iptraceIP_FRAGMENT_DROPPED
+	#define iptraceIP_FRAGMENT_DROPPED( ulIPAddress )
+#endif
+
+#ifndef iptraceREASSEMBLY_DROPPED
+	#define iptraceREASSEMBLY_DROPPED( ulIPAddress )
+#endif
+
+#ifndef iptraceREASSEMBLY_COMPLETE
+	#define iptraceREASSEMBLY_COMPLETE( ulIPAddress, xDataLength )
+#endif
+
 #endif /* UDP_TRACE_MACRO_DEFAULTS_H */
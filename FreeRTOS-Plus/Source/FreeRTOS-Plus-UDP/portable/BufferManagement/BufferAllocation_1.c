@@ -144,6 +144,13 @@ xNetworkBufferDescriptor_t *pxReturn = NULL;
 			uxListRemove( &( pxReturn->xBufferListItem ) );
 		}
 		taskEXIT_CRITICAL();
+
+		#if( ipLINKED_NETWORK_BUFFERS != 0 )
+		{
+			/* The buffer is not part of a chain of buffers yet. */
+			pxReturn->pxNextBuffer = NULL;
+		}
+		#endif
 		iptraceNETWORK_BUFFER_OBTAINED( pxReturn );
 	}
 	else
@@ -181,6 +188,13 @@ UBaseType_t uxSavedInterruptStatus;
 			}
 			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
+			#if( ipLINKED_NETWORK_BUFFERS != 0 )
+			{
+				/* The buffer is not part of a chain of buffers yet. */
+				pxReturn->pxNextBuffer = NULL;
+			}
+			#endif
+
 			iptraceNETWORK_BUFFER_OBTAINED_FROM_ISR( pxReturn );
 		}
 	}
@@ -199,6 +199,13 @@ xNetworkBufferDescriptor_t *pxReturn = NULL;
 		}
 		taskEXIT_CRITICAL();
 
+		#if( ipLINKED_NETWORK_BUFFERS != 0 )
+		{
+			/* The buffer is not part of a chain of buffers yet. */
+			pxReturn->pxNextBuffer = NULL;
+		}
+		#endif
+
 		/* Allocate storage of exactly the requested size to the buffer. */
 		configASSERT( pxReturn->pucEthernetBuffer == NULL );
 		if( xRequestedSizeBytes > 0 )
@@ -75,6 +75,11 @@ needs to call eConsiderFrameForProcessing. */
 	#define ipCONSIDER_FRAME_FOR_PROCESSING( pucEthernetBuffer ) eConsiderFrameForProcessing( ( pucEthernetBuffer ) )
 #endif
 
+/* When ipconfigUSE_LINKED_RX_MESSAGES is not 0 the frames that WinPCap already
+has waiting are linked together and passed to the IP task in a single event,
+up to this many frames at a time. */
+#define niMAX_LINKED_RX_FRAMES	( 8 )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -101,6 +106,14 @@ static void prvConfigureCaptureBehaviour( void );
  */
 static void prvInterruptSimulatorTask( void *pvParameters );
 
+#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+	/*
+	 * Pass the chain of received frames that starts with pxFirstBuffer to the
+	 * IP task, releasing the network buffers again if that is not possible.
+	 */
+	static void prvPassFramesToIPTask( xNetworkBufferDescriptor_t *pxFirstBuffer );
+#endif
+
 /* The interface being used by WinPCap. */
 static pcap_t *pxOpenedInterfaceHandle = NULL;
 
@@ -392,8 +405,13 @@ static struct pcap_pkthdr *pxHeader;
 const uint8_t *pucPacketData;
 long lResult;
 xNetworkBufferDescriptor_t *pxNetworkBuffer;
-xIPStackEvent_t xRxEvent = { eEthernetRxEvent, NULL };
 eFrameProcessingResult_t eResult;
+#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+	xNetworkBufferDescriptor_t *pxFirstBuffer = NULL, *pxLastBuffer = NULL;
+	UBaseType_t uxLinkedFrames = 0;
+#else
+	xIPStackEvent_t xRxEvent = { eEthernetRxEvent, NULL };
+#endif
 
 	/* Just to kill the compiler warning. */
 	( void ) pvParameters;
@@ -428,23 +446,55 @@ eFrameProcessingResult_t eResult;
 					{
 						memcpy( pxNetworkBuffer->pucEthernetBuffer, pucPacketData, pxHeader->len );
 						pxNetworkBuffer->xDataLength = ( size_t ) pxHeader->len;
-						xRxEvent.pvData = ( void * ) pxNetworkBuffer;
 
-						/* Data was received and stored.  Send a message to the IP
-						task to let it know. */
-						if( xQueueSendToBack( xNetworkEventQueue, &xRxEvent, ( TickType_t ) 0 ) == pdFALSE )
+						#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
 						{
-							/* The buffer could not be sent to the stack so
-							must be released again.  This is only an interrupt
-							simulator, not a real interrupt, so it is ok to use
-							the task level function here. */
-							vNetworkBufferRelease( pxNetworkBuffer );
-							iptraceETHERNET_RX_EVENT_LOST();
+							/* Add the frame to the end of the chain.  The chain
+							is passed to the IP task once WinPCap has no more
+							frames waiting, or once it is full. */
+							pxNetworkBuffer->pxNextBuffer = NULL;
+
+							if( pxLastBuffer == NULL )
+							{
+								pxFirstBuffer = pxNetworkBuffer;
+							}
+							else
+							{
+								pxLastBuffer->pxNextBuffer = pxNetworkBuffer;
+							}
+
+							pxLastBuffer = pxNetworkBuffer;
+							uxLinkedFrames++;
+
+							if( uxLinkedFrames >= niMAX_LINKED_RX_FRAMES )
+							{
+								prvPassFramesToIPTask( pxFirstBuffer );
+								pxFirstBuffer = NULL;
+								pxLastBuffer = NULL;
+								uxLinkedFrames = 0;
+							}
 						}
-						else
+						#else
 						{
-							iptraceNETWORK_INTERFACE_RECEIVE();
+							xRxEvent.pvData = ( void * ) pxNetworkBuffer;
+
+							/* Data was received and stored.  Send a message to
+							the IP task to let it know. */
+							if( xQueueSendToBack( xNetworkEventQueue, &xRxEvent, ( TickType_t ) 0 ) == pdFALSE )
+							{
+								/* The buffer could not be sent to the stack so
+								must be released again.  This is only an
+								interrupt simulator, not a real interrupt, so it
+								is ok to use the task level function here. */
+								vNetworkBufferRelease( pxNetworkBuffer );
+								iptraceETHERNET_RX_EVENT_LOST();
+							}
+							else
+							{
+								iptraceNETWORK_INTERFACE_RECEIVE();
+							}
 						}
+						#endif /* ipconfigUSE_LINKED_RX_MESSAGES */
 					}
 					else
 					{
@@ -460,6 +510,20 @@ eFrameProcessingResult_t eResult;
 		}
 		else
 		{
+			#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+			{
+				/* No more frames are waiting, so pass the frames that have
+				already been received to the IP task. */
+				if( pxFirstBuffer != NULL )
+				{
+					prvPassFramesToIPTask( pxFirstBuffer );
+					pxFirstBuffer = NULL;
+					pxLastBuffer = NULL;
+					uxLinkedFrames = 0;
+				}
+			}
+			#endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+
 			/* There is no real way of simulating an interrupt.  Make sure
 			other tasks can run. */
 			vTaskDelay( configWINDOWS_MAC_INTERRUPT_SIMULATOR_DELAY );
@@ -468,6 +532,29 @@ eFrameProcessingResult_t eResult;
 }
 /*-----------------------------------------------------------*/
 
+#if( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+
+	static void prvPassFramesToIPTask( xNetworkBufferDescriptor_t *pxFirstBuffer )
+	{
+	xNetworkBufferDescriptor_t *pxNextBuffer;
+
+		if( FreeRTOS_ReceivedEthernetFrames( pxFirstBuffer, ( TickType_t ) 0 ) == pdFAIL )
+		{
+			/* The frames could not be sent to the stack so must be released
+			again.  This is only an interrupt simulator, not a real interrupt,
+			so it is ok to use the task level function here. */
+			while( pxFirstBuffer != NULL )
+			{
+				pxNextBuffer = pxFirstBuffer->pxNextBuffer;
+				vNetworkBufferRelease( pxFirstBuffer );
+				pxFirstBuffer = pxNextBuffer;
+			}
+		}
+	}
+
+#endif /* ipconfigUSE_LINKED_RX_MESSAGES */
+/*-----------------------------------------------------------*/
+
 #if configUSE_STATIC_BUFFERS == 1
 	void vNetworkInterfaceAllocateRAMToBuffers( xNetworkBufferDescriptor_t pxNetworkBuffers[ ipconfigNUM_NETWORK_BUFFERS ] )
 	{
@@ -31,6 +31,14 @@
     volumes).  Block buffers may be either dirty or clean.  Most I/O passes
     through this module.  When a buffer is needed for a block which is not in
     the cache, a "victim" is selected via a simple LRU scheme.
+
+    Buffers are found by block number through a hash index, and the LRU order
+    is kept in a doubly linked list, so the cost of a lookup does not grow with
+    the number of buffers.
+
+    When REDCONF_BUFFER_STAGE_BLOCKS is nonzero, a staging buffer of that many
+    blocks lets this module read ahead sequential file data into the buffers
+    and gather contiguous dirty buffers into a single write when flushing.
 */
 #include <redfs.h>
 #include <redcore.h>
@@ -104,10 +112,36 @@
 #define BBLK_INVALID UINT32_MAX
 
 
+/*  An invalid buffer index.  Used to terminate the hash chains and the LRU
+    list.  REDCONF_BUFFER_COUNT is at most 255, so this is never the index of a
+    buffer.
+*/
+#define BIDX_INVALID UINT8_MAX
+
+
+/*  Number of bits in a hash bucket number.  There are at least as many hash
+    buckets as there are buffers, so the hash chains are short.
+*/
+#if REDCONF_BUFFER_COUNT <= 8U
+  #define BUFFER_HASH_BITS 3U
+#elif REDCONF_BUFFER_COUNT <= 16U
+  #define BUFFER_HASH_BITS 4U
+#elif REDCONF_BUFFER_COUNT <= 32U
+  #define BUFFER_HASH_BITS 5U
+#elif REDCONF_BUFFER_COUNT <= 64U
+  #define BUFFER_HASH_BITS 6U
+#elif REDCONF_BUFFER_COUNT <= 128U
+  #define BUFFER_HASH_BITS 7U
+#else
+  #define BUFFER_HASH_BITS 8U
+#endif
+
+#define BUFFER_HASH_BUCKETS (1U << BUFFER_HASH_BITS)
+
+
 /** @brief Metadata stored for each block buffer.
 
-    To make better use of CPU caching when searching the BUFFERHEAD array, this
-    structure should be kept small.
+    This structure should be kept small, to make better use of CPU caching.
 */
 typedef struct
 {
@@ -115,6 +149,9 @@ typedef struct
     uint8_t     bVolNum;    /**< Volume the block resides on. */
     uint8_t     bRefCount;  /**< Number of references. */
     uint16_t    uFlags;     /**< Buffer flags: mask of BFLAG_* values. */
+    uint8_t     bHashNext;  /**< Next buffer in the same hash chain; BIDX_INVALID if last. */
+    uint8_t     bNewer;     /**< Next more recently used buffer; BIDX_INVALID if this is the MRU buffer. */
+    uint8_t     bOlder;     /**< Next less recently used buffer; BIDX_INVALID if this is the LRU buffer. */
 } BUFFERHEAD;
 
 
@@ -126,13 +163,22 @@ typedef struct
     */
     uint16_t    uNumUsed;
 
-    /** MRU array.  Each element of the array stores a buffer index; each buffer
-        index appears in the array once and only once.  The first element of the
-        array is the most-recently-used (MRU) buffer, followed by the next most
-        recently used, and so on, till the last element, which is the least-
-        recently-used (LRU) buffer.
+    /** Index of the most-recently-used (MRU) buffer.  Every buffer is on the
+        LRU list, which is linked through the bOlder and bNewer members of the
+        buffer heads, and ends with the least-recently-used buffer.
     */
-    uint8_t     abMRU[REDCONF_BUFFER_COUNT];
+    uint8_t     bMRU;
+
+    /** Index of the least-recently-used (LRU) buffer.
+    */
+    uint8_t     bLRU;
+
+    /** Hash index.  Each element is the first buffer in a chain, linked
+        through the bHashNext member of the buffer heads, of the buffers whose
+        block number and volume hash to that element.  Buffers which are not in
+        use (ulBlock is BBLK_INVALID) are not in the index.
+    */
+    uint8_t     abHash[BUFFER_HASH_BUCKETS];
 
     /** Buffer heads, storing metadata for each buffer.
     */
@@ -144,6 +190,14 @@ typedef struct
         to cast buffer pointers to node structure pointers.
     */
     ALIGNED_2D_BYTE_ARRAY(b, aabBuffer, REDCONF_BUFFER_COUNT, REDCONF_BLOCK_SIZE);
+
+  #if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+    /** Staging buffer for multi-block reads and writes.  The block buffers
+        for a run of contiguous blocks are rarely contiguous in memory, so
+        they are copied through here to be transferred with one I/O request.
+    */
+    ALIGNED_2D_BYTE_ARRAY(s, aabStage, REDCONF_BUFFER_STAGE_BLOCKS, REDCONF_BLOCK_SIZE);
+  #endif
 } BUFFERCTX;
 
 
@@ -152,9 +206,17 @@ static bool BufferToIdx(const void *pBuffer, uint8_t *pbIdx);
 #if REDCONF_READ_ONLY == 0
 static REDSTATUS BufferWrite(uint8_t bIdx);
 static REDSTATUS BufferFinalize(uint8_t *pbBuffer, uint16_t uFlags);
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+static REDSTATUS BufferWriteGather(const uint8_t *pabIdx, uint32_t ulCount);
+#endif
 #endif
+static REDSTATUS BufferDiscardIdx(uint8_t bIdx);
 static void BufferMakeLRU(uint8_t bIdx);
 static void BufferMakeMRU(uint8_t bIdx);
+static void BufferListRemove(uint8_t bIdx);
+static uint32_t BufferHash(uint8_t bVolNum, uint32_t ulBlock);
+static void BufferHashInsert(uint8_t bIdx);
+static void BufferHashRemove(uint8_t bIdx);
 static bool BufferFind(uint32_t ulBlock, uint8_t *pbIdx);
 
 #ifdef REDCONF_ENDIAN_SWAP
@@ -177,15 +239,24 @@ void RedBufferInit(void)
     uint8_t bIdx;
 
     RedMemSet(&gBufCtx, 0U, sizeof(gBufCtx));
+    RedMemSet(gBufCtx.abHash, BIDX_INVALID, sizeof(gBufCtx.abHash));
 
     for(bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++)
     {
+        BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+
         /*  When the buffers have been freshly initialized, acquire the buffers
-            in the order in which they appear in the array.
+            in the order in which they appear in the array: the first buffer is
+            the LRU buffer and the last buffer is the MRU buffer.
         */
-        gBufCtx.abMRU[bIdx] = (uint8_t)((REDCONF_BUFFER_COUNT - bIdx) - 1U);
-        gBufCtx.aHead[bIdx].ulBlock = BBLK_INVALID;
+        pHead->ulBlock = BBLK_INVALID;
+        pHead->bHashNext = BIDX_INVALID;
+        pHead->bOlder = (bIdx == 0U) ? BIDX_INVALID : (uint8_t)(bIdx - 1U);
+        pHead->bNewer = (bIdx == (REDCONF_BUFFER_COUNT - 1U)) ? BIDX_INVALID : (uint8_t)(bIdx + 1U);
     }
+
+    gBufCtx.bLRU = 0U;
+    gBufCtx.bMRU = (uint8_t)(REDCONF_BUFFER_COUNT - 1U);
 }
 
 
@@ -247,17 +318,15 @@ REDSTATUS RedBufferGet(
             BUFFERHEAD *pHead;
 
             /*  Search for the least recently used buffer which is not
-                referenced.
+                referenced.  Only referenced buffers are skipped, and few
+                buffers are referenced at any one time.
             */
-            for(bIdx = (uint8_t)(REDCONF_BUFFER_COUNT - 1U); bIdx > 0U; bIdx--)
+            bIdx = gBufCtx.bLRU;
+            while((gBufCtx.aHead[bIdx].bRefCount != 0U) && (gBufCtx.aHead[bIdx].bNewer != BIDX_INVALID))
             {
-                if(gBufCtx.aHead[gBufCtx.abMRU[bIdx]].bRefCount == 0U)
-                {
-                    break;
-                }
+                bIdx = gBufCtx.aHead[bIdx].bNewer;
             }
 
-            bIdx = gBufCtx.abMRU[bIdx];
             pHead = &gBufCtx.aHead[bIdx];
 
             if(pHead->bRefCount == 0U)
@@ -286,6 +355,11 @@ REDSTATUS RedBufferGet(
 
             if(ret == 0)
             {
+                /*  The buffer is being repurposed, so it can no longer be found
+                    under its old block number.
+                */
+                BufferHashRemove(bIdx);
+
                 if((uFlags & BFLAG_NEW) == 0U)
                 {
                     /*  Invalidate the LRU buffer.  If the read fails, we do not
@@ -334,6 +408,8 @@ REDSTATUS RedBufferGet(
                 pHead->bVolNum = gbRedVolNum;
                 pHead->ulBlock = ulBlock;
                 pHead->uFlags = 0U;
+
+                BufferHashInsert(bIdx);
             }
         }
 
@@ -422,8 +498,64 @@ REDSTATUS RedBufferFlush(
         REDERROR();
         ret = -RED_EINVAL;
     }
+    else if(ulBlockCount <= REDCONF_BUFFER_COUNT)
+    {
+        uint32_t ulBlock;
+
+        /*  For a small range, it is quicker to look up each block in the hash
+            index than to examine every buffer.
+        */
+        for(ulBlock = ulBlockStart; (ret == 0) && (ulBlock < (ulBlockStart + ulBlockCount)); ulBlock++)
+        {
+            uint8_t bIdx;
+
+            if(BufferFind(ulBlock, &bIdx) && ((gBufCtx.aHead[bIdx].uFlags & BFLAG_DIRTY) != 0U))
+            {
+                ret = BufferWrite(bIdx);
+
+                if(ret == 0)
+                {
+                    gBufCtx.aHead[bIdx].uFlags &= (~BFLAG_DIRTY);
+                }
+            }
+        }
+    }
     else
     {
+      #if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+        uint8_t     abDirty[REDCONF_BUFFER_COUNT];
+        uint32_t    ulDirtyCount = 0U;
+        uint8_t     bIdx;
+
+        /*  This is the flush done when a transaction point writes out all of
+            the buffers.  List the dirty buffers in order of block number, so
+            that runs of contiguous blocks can be written together.
+        */
+        for(bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++)
+        {
+            const BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+
+            if(    (pHead->bVolNum == gbRedVolNum)
+                && (pHead->ulBlock != BBLK_INVALID)
+                && ((pHead->uFlags & BFLAG_DIRTY) != 0U)
+                && (pHead->ulBlock >= ulBlockStart)
+                && (pHead->ulBlock < (ulBlockStart + ulBlockCount)))
+            {
+                uint32_t ulPos = ulDirtyCount;
+
+                while((ulPos > 0U) && (gBufCtx.aHead[abDirty[ulPos - 1U]].ulBlock > pHead->ulBlock))
+                {
+                    abDirty[ulPos] = abDirty[ulPos - 1U];
+                    ulPos--;
+                }
+
+                abDirty[ulPos] = bIdx;
+                ulDirtyCount++;
+            }
+        }
+
+        ret = BufferWriteGather(abDirty, ulDirtyCount);
+      #else
         uint8_t bIdx;
 
         for(bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++)
@@ -448,6 +580,7 @@ REDSTATUS RedBufferFlush(
                 }
             }
         }
+      #endif
     }
 
     return ret;
@@ -499,8 +632,12 @@ void RedBufferBranch(
         REDASSERT(pHead->bRefCount > 0U);
         REDASSERT((pHead->uFlags & BFLAG_DIRTY) == 0U);
 
+        BufferHashRemove(bIdx);
+
         pHead->uFlags |= BFLAG_DIRTY;
         pHead->ulBlock = ulBlockNew;
+
+        BufferHashInsert(bIdx);
     }
 }
 
@@ -524,6 +661,8 @@ void RedBufferDiscard(
         REDASSERT(gBufCtx.aHead[bIdx].bRefCount == 1U);
         REDASSERT(gBufCtx.uNumUsed > 0U);
 
+        BufferHashRemove(bIdx);
+
         gBufCtx.aHead[bIdx].bRefCount = 0U;
         gBufCtx.aHead[bIdx].ulBlock = BBLK_INVALID;
 
@@ -561,44 +700,129 @@ REDSTATUS RedBufferDiscardRange(
         REDERROR();
         ret = -RED_EINVAL;
     }
+    else if(ulBlockCount <= REDCONF_BUFFER_COUNT)
+    {
+        uint32_t ulBlock;
+
+        /*  For a small range, such as a single block which has become free,
+            it is quicker to look up each block in the hash index than to
+            examine every buffer.
+        */
+        for(ulBlock = ulBlockStart; (ret == 0) && (ulBlock < (ulBlockStart + ulBlockCount)); ulBlock++)
+        {
+            uint8_t bIdx;
+
+            if(BufferFind(ulBlock, &bIdx))
+            {
+                ret = BufferDiscardIdx(bIdx);
+            }
+        }
+    }
     else
     {
         uint8_t bIdx;
 
-        for(bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++)
+        for(bIdx = 0U; (ret == 0) && (bIdx < REDCONF_BUFFER_COUNT); bIdx++)
         {
-            BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+            const BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
 
             if(    (pHead->bVolNum == gbRedVolNum)
                 && (pHead->ulBlock != BBLK_INVALID)
                 && (pHead->ulBlock >= ulBlockStart)
                 && (pHead->ulBlock < (ulBlockStart + ulBlockCount)))
             {
-                if(pHead->bRefCount == 0U)
-                {
-                    pHead->ulBlock = BBLK_INVALID;
+                ret = BufferDiscardIdx(bIdx);
+            }
+        }
+    }
 
-                    BufferMakeLRU(bIdx);
-                }
-                else
+    return ret;
+}
+
+
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+/** @brief Read file data blocks into the buffers before they are needed.
+
+    Reads the leading run of blocks in the range which are not buffered, up to
+    REDCONF_BUFFER_STAGE_BLOCKS of them, with a single I/O request.  The blocks
+    go into buffers which are neither referenced nor dirty, taken from the
+    older half of the LRU list, so reading ahead never writes a buffer or
+    displaces the most recently used ones.  Fewer blocks are read if there are
+    not enough such buffers.
+
+    @param ulBlockStart The first block number to read.
+    @param ulBlockCount The number of blocks, starting at @p ulBlockStart, which
+                        may be read.  Must not be zero.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EIO    A disk I/O error occurred.
+    @retval -RED_EINVAL Invalid parameters.
+*/
+REDSTATUS RedBufferReadAhead(
+    uint32_t    ulBlockStart,
+    uint32_t    ulBlockCount)
+{
+    REDSTATUS   ret = 0;
+
+    if(    (ulBlockStart >= gpRedVolume->ulBlockCount)
+        || ((gpRedVolume->ulBlockCount - ulBlockStart) < ulBlockCount)
+        || (ulBlockCount == 0U))
+    {
+        REDERROR();
+        ret = -RED_EINVAL;
+    }
+    else
+    {
+        uint8_t     abIdx[REDCONF_BUFFER_STAGE_BLOCKS];
+        uint32_t    ulMaxCount = REDMIN(ulBlockCount, REDCONF_BUFFER_STAGE_BLOCKS);
+        uint32_t    ulCount = 0U;
+        uint32_t    ulPosition = 0U;
+        uint8_t     bIdx = gBufCtx.bLRU;
+
+        while((ulCount < ulMaxCount) && (bIdx != BIDX_INVALID) && (ulPosition < (REDCONF_BUFFER_COUNT / 2U)))
+        {
+            const BUFFERHEAD   *pHead = &gBufCtx.aHead[bIdx];
+            uint8_t             bFoundIdx;
+
+            if(BufferFind(ulBlockStart + ulCount, &bFoundIdx))
+            {
+                break;
+            }
+
+            if((pHead->bRefCount == 0U) && ((pHead->uFlags & BFLAG_DIRTY) == 0U))
+            {
+                abIdx[ulCount] = bIdx;
+                ulCount++;
+            }
+
+            bIdx = pHead->bNewer;
+            ulPosition++;
+        }
+
+        if(ulCount > 0U)
+        {
+            ret = RedIoRead(gbRedVolNum, ulBlockStart, ulCount, gBufCtx.s.aabStage[0U]);
+
+            if(ret == 0)
+            {
+                uint32_t ulStageIdx;
+
+                for(ulStageIdx = 0U; ulStageIdx < ulCount; ulStageIdx++)
                 {
-                    /*  This should never happen.  There are three general cases
-                        when this function is used:
-
-                        1) Discarding every block, as happens during unmount
-                           and at the end of format.  There should no longer be
-                           any referenced buffers at those points.
-                        2) Discarding a block which has become free.  All
-                           buffers for such blocks should be put or branched
-                           beforehand.
-                        3) Discarding of blocks that were just written straight
-                           to disk, leaving stale data in the buffer.  The write
-                           code should never reference buffers for these blocks,
-                           since they would not be needed or used.
-                    */
-                    CRITICAL_ERROR();
-                    ret = -RED_EBUSY;
-                    break;
+                    BUFFERHEAD *pHead = &gBufCtx.aHead[abIdx[ulStageIdx]];
+
+                    BufferHashRemove(abIdx[ulStageIdx]);
+
+                    RedMemCpy(gBufCtx.b.aabBuffer[abIdx[ulStageIdx]], gBufCtx.s.aabStage[ulStageIdx], REDCONF_BLOCK_SIZE);
+
+                    pHead->bVolNum = gbRedVolNum;
+                    pHead->ulBlock = ulBlockStart + ulStageIdx;
+                    pHead->uFlags = 0U;
+
+                    BufferHashInsert(abIdx[ulStageIdx]);
+                    BufferMakeMRU(abIdx[ulStageIdx]);
                 }
             }
         }
@@ -608,6 +832,102 @@ REDSTATUS RedBufferDiscardRange(
 }
 
 
+/** @brief Copy buffered file data blocks into a caller buffer.
+
+    Copies the leading run of blocks in the range which are buffered, stopping
+    at the first block which is not.  Sequential reads use each block once, so
+    the clean buffers which were copied are made LRU, to be reused first.
+
+    @param ulBlockStart The first block number to copy.
+    @param ulBlockCount The number of blocks, starting at @p ulBlockStart, to
+                        copy.
+    @param pBuffer      The buffer to copy into.
+
+    @return The number of blocks copied.
+*/
+uint32_t RedBufferReadCached(
+    uint32_t    ulBlockStart,
+    uint32_t    ulBlockCount,
+    void       *pBuffer)
+{
+    uint32_t    ulCount = 0U;
+
+    if(pBuffer == NULL)
+    {
+        REDERROR();
+    }
+    else
+    {
+        uint8_t    *pbBuffer = CAST_VOID_PTR_TO_UINT8_PTR(pBuffer);
+        uint8_t     bIdx;
+
+        while((ulCount < ulBlockCount) && BufferFind(ulBlockStart + ulCount, &bIdx))
+        {
+            const BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+
+            REDASSERT((pHead->uFlags & BFLAG_META) == 0U);
+
+            RedMemCpy(&pbBuffer[ulCount << BLOCK_SIZE_P2], gBufCtx.b.aabBuffer[bIdx], REDCONF_BLOCK_SIZE);
+
+            if((pHead->bRefCount == 0U) && ((pHead->uFlags & BFLAG_DIRTY) == 0U))
+            {
+                BufferMakeLRU(bIdx);
+            }
+
+            ulCount++;
+        }
+    }
+
+    return ulCount;
+}
+#endif /* REDCONF_BUFFER_STAGE_BLOCKS > 0U */
+
+
+/** @brief Discard a buffer which is not referenced, marking it invalid.
+
+    @param bIdx The index of the buffer to discard.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EBUSY  The buffer is referenced.
+*/
+static REDSTATUS BufferDiscardIdx(
+    uint8_t     bIdx)
+{
+    REDSTATUS   ret = 0;
+
+    if(gBufCtx.aHead[bIdx].bRefCount == 0U)
+    {
+        BufferHashRemove(bIdx);
+
+        gBufCtx.aHead[bIdx].ulBlock = BBLK_INVALID;
+
+        BufferMakeLRU(bIdx);
+    }
+    else
+    {
+        /*  This should never happen.  There are three general cases when
+            RedBufferDiscardRange() is used:
+
+            1) Discarding every block, as happens during unmount and at the end
+               of format.  There should no longer be any referenced buffers at
+               those points.
+            2) Discarding a block which has become free.  All buffers for such
+               blocks should be put or branched beforehand.
+            3) Discarding of blocks that were just written straight to disk,
+               leaving stale data in the buffer.  The write code should never
+               reference buffers for these blocks, since they would not be
+               needed or used.
+        */
+        CRITICAL_ERROR();
+        ret = -RED_EBUSY;
+    }
+
+    return ret;
+}
+
+
 /** Determine whether a metadata buffer is valid.
 
     This includes checking its signature, CRC, and sequence number.
@@ -733,22 +1053,18 @@ static bool BufferToIdx(
 
     if((pBuffer != NULL) && (pbIdx != NULL))
     {
-        uint8_t bIdx;
+        uintptr_t   ulOffset = PTR_OFFSET(pBuffer, &gBufCtx.b.aabBuffer[0U][0U]);
+        uint8_t     bIdx = BIDX_INVALID;
 
-        /*  pBuffer should be a pointer to one of the block buffers.
-
-            A good compiler should optimize this loop into a bounds check and an
-            alignment check, although GCC has been observed to not do so; if the
-            number of buffers is small, it should not make much difference.  The
-            alternative is to use pointer comparisons, but this both deviates
-            from MISRA-C:2012 and involves undefined behavior.
+        /*  pBuffer should be a pointer to one of the block buffers.  A bounds
+            check and an alignment check of its offset from the first buffer
+            give its index without examining every buffer, which matters when
+            there are many buffers.
         */
-        for(bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++)
+        if(    (ulOffset < ((uintptr_t)REDCONF_BUFFER_COUNT * REDCONF_BLOCK_SIZE))
+            && ((ulOffset % REDCONF_BLOCK_SIZE) == 0U))
         {
-            if(pBuffer == &gBufCtx.b.aabBuffer[bIdx][0U])
-            {
-                break;
-            }
+            bIdx = (uint8_t)(ulOffset / REDCONF_BLOCK_SIZE);
         }
 
         if(    (bIdx < REDCONF_BUFFER_COUNT)
@@ -899,6 +1215,93 @@ static REDSTATUS BufferFinalize(
 
     return ret;
 }
+
+
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+/** @brief Write out dirty buffers, gathering runs of contiguous blocks.
+
+    Each run of up to REDCONF_BUFFER_STAGE_BLOCKS contiguous blocks is copied
+    into the staging buffer and written with a single I/O request.  The buffers
+    are marked clean once they have been written.
+
+    @param pabIdx   Indices of the dirty buffers to write, sorted by block
+                    number.  All must belong to the same volume.
+    @param ulCount  The number of elements in @p pabIdx.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EIO    A disk I/O error occurred.
+    @retval -RED_EINVAL Invalid parameters.
+*/
+static REDSTATUS BufferWriteGather(
+    const uint8_t  *pabIdx,
+    uint32_t        ulCount)
+{
+    REDSTATUS       ret = 0;
+    uint32_t        ulIdx = 0U;
+
+    while((ret == 0) && (ulIdx < ulCount))
+    {
+        const BUFFERHEAD   *pFirst = &gBufCtx.aHead[pabIdx[ulIdx]];
+        uint32_t            ulRunLen = 1U;
+        uint32_t            ulRunIdx;
+
+        while(    ((ulIdx + ulRunLen) < ulCount)
+               && (ulRunLen < REDCONF_BUFFER_STAGE_BLOCKS)
+               && (gBufCtx.aHead[pabIdx[ulIdx + ulRunLen]].ulBlock == (pFirst->ulBlock + ulRunLen)))
+        {
+            ulRunLen++;
+        }
+
+        if(ulRunLen == 1U)
+        {
+            ret = BufferWrite(pabIdx[ulIdx]);
+        }
+        else
+        {
+            for(ulRunIdx = 0U; (ret == 0) && (ulRunIdx < ulRunLen); ulRunIdx++)
+            {
+                uint8_t     bIdx = pabIdx[ulIdx + ulRunIdx];
+                uint16_t    uFlags = gBufCtx.aHead[bIdx].uFlags;
+
+                REDASSERT((uFlags & BFLAG_DIRTY) != 0U);
+
+                if((uFlags & BFLAG_META) != 0U)
+                {
+                    ret = BufferFinalize(gBufCtx.b.aabBuffer[bIdx], uFlags);
+                }
+
+                if(ret == 0)
+                {
+                    RedMemCpy(gBufCtx.s.aabStage[ulRunIdx], gBufCtx.b.aabBuffer[bIdx], REDCONF_BLOCK_SIZE);
+
+                  #ifdef REDCONF_ENDIAN_SWAP
+                    BufferEndianSwap(gBufCtx.b.aabBuffer[bIdx], uFlags);
+                  #endif
+                }
+            }
+
+            if(ret == 0)
+            {
+                ret = RedIoWrite(pFirst->bVolNum, pFirst->ulBlock, ulRunLen, gBufCtx.s.aabStage[0U]);
+            }
+        }
+
+        if(ret == 0)
+        {
+            for(ulRunIdx = 0U; ulRunIdx < ulRunLen; ulRunIdx++)
+            {
+                gBufCtx.aHead[pabIdx[ulIdx + ulRunIdx]].uFlags &= (~BFLAG_DIRTY);
+            }
+
+            ulIdx += ulRunLen;
+        }
+    }
+
+    return ret;
+}
+#endif /* REDCONF_BUFFER_STAGE_BLOCKS > 0U */
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
@@ -1083,34 +1486,16 @@ static void BufferMakeLRU(
     {
         REDERROR();
     }
-    else if(bIdx != gBufCtx.abMRU[REDCONF_BUFFER_COUNT - 1U])
+    else if(bIdx != gBufCtx.bLRU)
     {
-        uint8_t bMruIdx;
-
-        /*  Find the current position of the buffer in the MRU array.  We do not
-            need to check the last slot, since we already know from the above
-            check that the index is not there.
+        /*  Move the buffer to the LRU end of the list.
         */
-        for(bMruIdx = 0U; bMruIdx < (REDCONF_BUFFER_COUNT - 1U); bMruIdx++)
-        {
-            if(bIdx == gBufCtx.abMRU[bMruIdx])
-            {
-                break;
-            }
-        }
+        BufferListRemove(bIdx);
 
-        if(bMruIdx < (REDCONF_BUFFER_COUNT - 1U))
-        {
-            /*  Move the buffer index to the back of the MRU array, making it
-                the LRU buffer.
-            */
-            RedMemMove(&gBufCtx.abMRU[bMruIdx], &gBufCtx.abMRU[bMruIdx + 1U], REDCONF_BUFFER_COUNT - ((uint32_t)bMruIdx + 1U));
-            gBufCtx.abMRU[REDCONF_BUFFER_COUNT - 1U] = bIdx;
-        }
-        else
-        {
-            REDERROR();
-        }
+        gBufCtx.aHead[bIdx].bNewer = gBufCtx.bLRU;
+        gBufCtx.aHead[bIdx].bOlder = BIDX_INVALID;
+        gBufCtx.aHead[gBufCtx.bLRU].bOlder = bIdx;
+        gBufCtx.bLRU = bIdx;
     }
     else
     {
@@ -1131,40 +1516,126 @@ static void BufferMakeMRU(
     {
         REDERROR();
     }
-    else if(bIdx != gBufCtx.abMRU[0U])
+    else if(bIdx != gBufCtx.bMRU)
     {
-        uint8_t bMruIdx;
+        /*  Move the buffer to the MRU end of the list.
+        */
+        BufferListRemove(bIdx);
 
-        /*  Find the current position of the buffer in the MRU array.  We do not
-            need to check the first slot, since we already know from the above
-            check that the index is not there.
+        gBufCtx.aHead[bIdx].bOlder = gBufCtx.bMRU;
+        gBufCtx.aHead[bIdx].bNewer = BIDX_INVALID;
+        gBufCtx.aHead[gBufCtx.bMRU].bNewer = bIdx;
+        gBufCtx.bMRU = bIdx;
+    }
+    else
+    {
+        /*  Buffer already MRU, nothing to do.
         */
-        for(bMruIdx = 1U; bMruIdx < REDCONF_BUFFER_COUNT; bMruIdx++)
+    }
+}
+
+
+/** @brief Unlink a buffer from the LRU list.
+
+    The buffer must be put back on the list before the list is used again.
+    There must be at least two buffers, which MINIMUM_BUFFER_COUNT ensures.
+
+    @param bIdx The index of the buffer to unlink.
+*/
+static void BufferListRemove(
+    uint8_t     bIdx)
+{
+    BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+
+    if(pHead->bNewer == BIDX_INVALID)
+    {
+        gBufCtx.bMRU = pHead->bOlder;
+    }
+    else
+    {
+        gBufCtx.aHead[pHead->bNewer].bOlder = pHead->bOlder;
+    }
+
+    if(pHead->bOlder == BIDX_INVALID)
+    {
+        gBufCtx.bLRU = pHead->bNewer;
+    }
+    else
+    {
+        gBufCtx.aHead[pHead->bOlder].bNewer = pHead->bNewer;
+    }
+}
+
+
+/** @brief Compute the hash bucket for a block.
+
+    @param bVolNum  The volume the block resides on.
+    @param ulBlock  The block number.
+
+    @return The index of the hash bucket in gBufCtx.abHash.
+*/
+static uint32_t BufferHash(
+    uint8_t     bVolNum,
+    uint32_t    ulBlock)
+{
+    /*  Multiplicative (Fibonacci) hashing: the top bits of the product depend
+        on every bit of the key, so consecutive block numbers, which are
+        common, are spread across the buckets.
+    */
+    return ((ulBlock ^ ((uint32_t)bVolNum << 24U)) * 0x9E3779B1U) >> (32U - BUFFER_HASH_BITS);
+}
+
+
+/** @brief Add a buffer to the hash index under its block number and volume.
+
+    @param bIdx The index of the buffer to add.  Its ulBlock must be valid.
+*/
+static void BufferHashInsert(
+    uint8_t     bIdx)
+{
+    BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+    uint32_t    ulBucket;
+
+    REDASSERT(pHead->ulBlock != BBLK_INVALID);
+
+    ulBucket = BufferHash(pHead->bVolNum, pHead->ulBlock);
+    pHead->bHashNext = gBufCtx.abHash[ulBucket];
+    gBufCtx.abHash[ulBucket] = bIdx;
+}
+
+
+/** @brief Remove a buffer from the hash index.
+
+    Does nothing if the buffer is not in use, since such buffers are not in the
+    index.  Must be called before the block number or volume of a buffer in use
+    is changed.
+
+    @param bIdx The index of the buffer to remove.
+*/
+static void BufferHashRemove(
+    uint8_t     bIdx)
+{
+    BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
+
+    if(pHead->ulBlock != BBLK_INVALID)
+    {
+        uint8_t *pbLink = &gBufCtx.abHash[BufferHash(pHead->bVolNum, pHead->ulBlock)];
+
+        while((*pbLink != bIdx) && (*pbLink != BIDX_INVALID))
         {
-            if(bIdx == gBufCtx.abMRU[bMruIdx])
-            {
-                break;
-            }
+            pbLink = &gBufCtx.aHead[*pbLink].bHashNext;
         }
 
-        if(bMruIdx < REDCONF_BUFFER_COUNT)
+        if(*pbLink == bIdx)
         {
-            /*  Move the buffer index to the front of the MRU array, making it
-                the MRU buffer.
-            */
-            RedMemMove(&gBufCtx.abMRU[1U], &gBufCtx.abMRU[0U], bMruIdx);
-            gBufCtx.abMRU[0U] = bIdx;
+            *pbLink = pHead->bHashNext;
+            pHead->bHashNext = BIDX_INVALID;
         }
         else
         {
             REDERROR();
         }
     }
-    else
-    {
-        /*  Buffer already MRU, nothing to do.
-        */
-    }
 }
 
 
@@ -1192,9 +1663,9 @@ static bool BufferFind(
     }
     else
     {
-        uint8_t bIdx;
+        uint8_t bIdx = gBufCtx.abHash[BufferHash(gbRedVolNum, ulBlock)];
 
-        for(bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++)
+        while(bIdx != BIDX_INVALID)
         {
             const BUFFERHEAD *pHead = &gBufCtx.aHead[bIdx];
 
@@ -1204,9 +1675,10 @@ static bool BufferFind(
                 ret = true;
                 break;
             }
+
+            bIdx = pHead->bHashNext;
         }
     }
 
     return ret;
 }
-
@@ -388,6 +388,13 @@ REDSTATUS RedCoreVolFormat(void)
 */
 REDSTATUS RedCoreVolMount(void)
 {
+  #if (REDCONF_API_POSIX == 1) && (REDCONF_DIR_INDEX_SLOTS > 0U)
+    /*  The directory index may describe a directory as it was before the
+        volume was last unmounted, which might not match what is on disk.
+    */
+    RedDirIndexInvalidate();
+  #endif
+
     return RedVolMount();
 }
 
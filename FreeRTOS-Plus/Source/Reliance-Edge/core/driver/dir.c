@@ -24,6 +24,12 @@
 */
 /** @file
     @brief Implements directory operations.
+
+    When REDCONF_DIR_INDEX_SLOTS is nonzero, lookups in a large directory use
+    an in-memory hash index of the names in that directory.  The index covers
+    one directory at a time: it is built on the first lookup in a directory
+    with more than one block of entries, and kept up to date as entries are
+    written and deleted.
 */
 #include <redfs.h>
 
@@ -68,6 +74,34 @@ typedef struct
 } DIRENT;
 
 
+#if REDCONF_DIR_INDEX_SLOTS > 0U
+/*  The most entries the directory index will hold.  Beyond this, the probe
+    sequences in the open-addressed table become long.
+*/
+#define DIR_INDEX_MAX_ENTRIES (REDCONF_DIR_INDEX_SLOTS - (REDCONF_DIR_INDEX_SLOTS / 4U))
+
+/** @brief A slot in the directory index hash table.
+*/
+typedef struct
+{
+    uint32_t    ulHash; /**< Hash of the name of the entry. */
+    uint32_t    ulIdx;  /**< Position of the entry; DIR_INDEX_INVALID if the slot is empty. */
+} DIRINDEXSLOT;
+
+/** @brief In-memory hash index of the names in one directory.
+*/
+typedef struct
+{
+    uint8_t         bVolNum;        /**< Volume of the indexed directory. */
+    uint32_t        ulInode;        /**< Indexed directory; INODE_INVALID if the index is not in use. */
+    uint32_t        ulDirentCount;  /**< Size of the directory, in entries. */
+    uint32_t        ulFreeIdx;      /**< Position of the first free entry; equals ulDirentCount if there are none. */
+    uint32_t        ulEntries;      /**< Number of entries in the index. */
+    DIRINDEXSLOT    aSlot[REDCONF_DIR_INDEX_SLOTS]; /**< Hash table, with linear probing. */
+} DIRINDEX;
+#endif
+
+
 #if (REDCONF_READ_ONLY == 0) && (REDCONF_API_POSIX_RENAME == 1)
 static REDSTATUS DirCyclicRenameCheck(uint32_t ulSrcInode, const CINODE *pDstPInode);
 #endif
@@ -76,6 +110,22 @@ static REDSTATUS DirEntryWrite(CINODE *pPInode, uint32_t ulIdx, uint32_t ulInode
 static uint64_t DirEntryIndexToOffset(uint32_t ulIdx);
 #endif
 static uint32_t DirOffsetToEntryIndex(uint64_t ullOffset);
+#if REDCONF_DIR_INDEX_SLOTS > 0U
+static bool DirIndexIsCurrent(const CINODE *pPInode);
+static REDSTATUS DirIndexBuild(CINODE *pPInode);
+static REDSTATUS DirIndexLookup(CINODE *pPInode, const char *pszName, uint32_t ulNameLen, uint32_t *pulEntryIdx, uint32_t *pulInode);
+#if REDCONF_READ_ONLY == 0
+static void DirIndexEntryRemove(CINODE *pPInode, uint32_t ulIdx);
+static void DirIndexEntryAdd(CINODE *pPInode, uint32_t ulIdx, const char *pszName, uint32_t ulNameLen);
+static REDSTATUS DirIndexNextFree(CINODE *pPInode, uint32_t ulStartIdx, uint32_t *pulFreeIdx);
+static void DirIndexSlotRemove(uint32_t ulHash, uint32_t ulIdx);
+#endif
+static bool DirIndexSlotAdd(uint32_t ulHash, uint32_t ulIdx);
+static uint32_t DirNameHash(const char *pszName, uint32_t ulNameLen);
+
+
+static DIRINDEX gDirIndex;
+#endif
 
 
 #if REDCONF_READ_ONLY == 0
@@ -208,7 +258,7 @@ REDSTATUS RedDirEntryDelete(
         */
         while((ret == 0) && (ulTruncIdx > 0U) && !fDone)
         {
-            ret = RedInodeDataSeekAndRead(pPInode, ulTruncIdx / DIRENTS_PER_BLOCK);
+            ret = RedInodeDataSeekAndRead(pPInode, (ulTruncIdx - 1U) / DIRENTS_PER_BLOCK);
 
             if(ret == 0)
             {
@@ -247,7 +297,31 @@ REDSTATUS RedDirEntryDelete(
         */
         if(ret == 0)
         {
+          #if REDCONF_DIR_INDEX_SLOTS > 0U
+            bool fIndexed = DirIndexIsCurrent(pPInode);
+
+            if(fIndexed)
+            {
+                DirIndexEntryRemove(pPInode, ulDeleteIdx);
+            }
+          #endif
+
             ret = RedInodeDataTruncate(pPInode, DirEntryIndexToOffset(ulTruncIdx));
+
+          #if REDCONF_DIR_INDEX_SLOTS > 0U
+            if(fIndexed)
+            {
+                if(ret == 0)
+                {
+                    gDirIndex.ulDirentCount = ulTruncIdx;
+                    gDirIndex.ulFreeIdx = REDMIN(gDirIndex.ulFreeIdx, ulTruncIdx);
+                }
+                else
+                {
+                    RedDirIndexInvalidate();
+                }
+            }
+          #endif
         }
     }
     else
@@ -322,6 +396,22 @@ REDSTATUS RedDirEntryLookup(
         {
             ret = -RED_ENAMETOOLONG;
         }
+      #if REDCONF_DIR_INDEX_SLOTS > 0U
+        else if(    DirIndexIsCurrent(pPInode)
+                 || (    (pPInode->pInodeBuf->ullSize > REDCONF_BLOCK_SIZE)
+                      && (DirOffsetToEntryIndex(pPInode->pInodeBuf->ullSize) <= DIR_INDEX_MAX_ENTRIES)))
+        {
+            if(!DirIndexIsCurrent(pPInode))
+            {
+                ret = DirIndexBuild(pPInode);
+            }
+
+            if(ret == 0)
+            {
+                ret = DirIndexLookup(pPInode, pszName, ulNameLen, pulEntryIdx, pulInode);
+            }
+        }
+      #endif
         else
         {
             uint32_t    ulIdx = 0U;
@@ -882,6 +972,9 @@ static REDSTATUS DirEntryWrite(
         uint64_t        ullOffset = DirEntryIndexToOffset(ulIdx);
         uint32_t        ulLen = DIRENT_SIZE;
         static DIRENT   de;
+      #if REDCONF_DIR_INDEX_SLOTS > 0U
+        bool            fIndexed = DirIndexIsCurrent(pPInode);
+      #endif
 
         RedMemSet(&de, 0U, sizeof(de));
 
@@ -893,7 +986,28 @@ static REDSTATUS DirEntryWrite(
 
         RedStrNCpy(de.acName, pszName, ulNameLen);
 
+      #if REDCONF_DIR_INDEX_SLOTS > 0U
+        if(fIndexed)
+        {
+            DirIndexEntryRemove(pPInode, ulIdx);
+        }
+      #endif
+
         ret = RedInodeDataWrite(pPInode, ullOffset, &ulLen, &de);
+
+      #if REDCONF_DIR_INDEX_SLOTS > 0U
+        if(fIndexed)
+        {
+            if(ret == 0)
+            {
+                DirIndexEntryAdd(pPInode, ulIdx, pszName, ulNameLen);
+            }
+            else
+            {
+                RedDirIndexInvalidate();
+            }
+        }
+      #endif
     }
 
     return ret;
@@ -946,5 +1060,522 @@ static uint32_t DirOffsetToEntryIndex(
 }
 
 
+#if REDCONF_DIR_INDEX_SLOTS > 0U
+/** @brief Stop using the directory index.
+
+    The index is rebuilt on the next lookup in a large directory.
+*/
+void RedDirIndexInvalidate(void)
+{
+    gDirIndex.ulInode = INODE_INVALID;
+}
+
+
+/** @brief Determine whether the directory index describes a directory.
+
+    @param pPInode  A pointer to the cached inode structure of the directory.
+
+    @return Whether the index is in use for @p pPInode.
+*/
+static bool DirIndexIsCurrent(
+    const CINODE   *pPInode)
+{
+    /*  The directory size is compared as a safeguard: a change to the size
+        which was not made through this module means that the index is stale.
+    */
+    return (gDirIndex.ulInode == pPInode->ulInode)
+        && (gDirIndex.bVolNum == gbRedVolNum)
+        && (gDirIndex.ulDirentCount == DirOffsetToEntryIndex(pPInode->pInodeBuf->ullSize));
+}
+
+
+/** @brief Build the directory index for a directory.
+
+    Reads every entry in the directory.  The directory must have no more than
+    DIR_INDEX_MAX_ENTRIES entries, used or free.
+
+    @param pPInode  A pointer to the cached inode structure of the directory.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EIO    A disk I/O error occurred.
+*/
+static REDSTATUS DirIndexBuild(
+    CINODE     *pPInode)
+{
+    REDSTATUS   ret = 0;
+    uint32_t    ulDirentCount = DirOffsetToEntryIndex(pPInode->pInodeBuf->ullSize);
+    uint32_t    ulIdx = 0U;
+    uint32_t    ulSlot;
+
+    REDASSERT(ulDirentCount <= DIR_INDEX_MAX_ENTRIES);
+
+    for(ulSlot = 0U; ulSlot < REDCONF_DIR_INDEX_SLOTS; ulSlot++)
+    {
+        gDirIndex.aSlot[ulSlot].ulIdx = DIR_INDEX_INVALID;
+    }
+
+    gDirIndex.bVolNum = gbRedVolNum;
+    gDirIndex.ulInode = INODE_INVALID;
+    gDirIndex.ulDirentCount = ulDirentCount;
+    gDirIndex.ulFreeIdx = ulDirentCount;
+    gDirIndex.ulEntries = 0U;
+
+    while((ret == 0) && (ulIdx < ulDirentCount))
+    {
+        ret = RedInodeDataSeekAndRead(pPInode, ulIdx / DIRENTS_PER_BLOCK);
+
+        if(ret == 0)
+        {
+            const DIRENT *pDirents = CAST_CONST_DIRENT_PTR(pPInode->pbData);
+            uint32_t      ulBlockLastIdx = REDMIN(DIRENTS_PER_BLOCK, ulDirentCount - ulIdx);
+            uint32_t      ulBlockIdx;
+
+            for(ulBlockIdx = 0U; ulBlockIdx < ulBlockLastIdx; ulBlockIdx++)
+            {
+                const DIRENT *pDirent = &pDirents[ulBlockIdx];
+
+                if(pDirent->ulInode != INODE_INVALID)
+                {
+                    uint32_t ulNameLen = RedStrLen(pDirent->acName);
+
+                    /*  The name is not null terminated if it is of the maximum
+                        length.
+                    */
+                    if(ulNameLen > REDCONF_NAME_MAX)
+                    {
+                        ulNameLen = REDCONF_NAME_MAX;
+                    }
+
+                    (void)DirIndexSlotAdd(DirNameHash(pDirent->acName, ulNameLen), ulIdx + ulBlockIdx);
+                }
+                else if(gDirIndex.ulFreeIdx == ulDirentCount)
+                {
+                    gDirIndex.ulFreeIdx = ulIdx + ulBlockIdx;
+                }
+                else
+                {
+                    /*  A free entry was already found; nothing to do.
+                    */
+                }
+            }
+
+            ulIdx += ulBlockLastIdx;
+        }
+        else if(ret == -RED_ENODATA)
+        {
+            if(gDirIndex.ulFreeIdx == ulDirentCount)
+            {
+                gDirIndex.ulFreeIdx = ulIdx;
+            }
+
+            ret = 0;
+            ulIdx += DIRENTS_PER_BLOCK;
+        }
+        else
+        {
+            /*  Unexpected error, let the loop terminate, no action here.
+            */
+        }
+    }
+
+    if(ret == 0)
+    {
+        gDirIndex.ulInode = pPInode->ulInode;
+    }
+
+    return ret;
+}
+
+
+/** @brief Look up a name in the directory index.
+
+    Has the same results as the linear search in RedDirEntryLookup(), except
+    that only the entries whose names hash to the same value are read.
+
+    @param pPInode      A pointer to the cached inode structure of the indexed
+                        directory.
+    @param pszName      The name of the desired entry.
+    @param ulNameLen    The length of @p pszName.
+    @param pulEntryIdx  On successful return, populated with the position of the
+                        entry.  If returning an -RED_ENOENT error, populated
+                        with the position of the first available entry, or set
+                        to DIR_INDEX_INVALID if the directory is full.
+                        Optional.
+    @param pulInode     On successful return, populated with the inode number
+                        that the name points to.  Optional.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0               Operation was successful.
+    @retval -RED_EIO        A disk I/O error occurred.
+    @retval -RED_ENOENT     @p pszName is not in the directory.
+    @retval -RED_EFUBAR     The index refers to a sparse block.
+*/
+static REDSTATUS DirIndexLookup(
+    CINODE     *pPInode,
+    const char *pszName,
+    uint32_t    ulNameLen,
+    uint32_t   *pulEntryIdx,
+    uint32_t   *pulInode)
+{
+    REDSTATUS   ret = -RED_ENOENT;
+    uint32_t    ulHash = DirNameHash(pszName, ulNameLen);
+    uint32_t    ulSlot = ulHash & (REDCONF_DIR_INDEX_SLOTS - 1U);
+    uint32_t    ulIdx = DIR_INDEX_INVALID;
+
+    while((ret == -RED_ENOENT) && (gDirIndex.aSlot[ulSlot].ulIdx != DIR_INDEX_INVALID))
+    {
+        if(gDirIndex.aSlot[ulSlot].ulHash == ulHash)
+        {
+            ulIdx = gDirIndex.aSlot[ulSlot].ulIdx;
+
+            ret = RedInodeDataSeekAndRead(pPInode, ulIdx / DIRENTS_PER_BLOCK);
+
+            if(ret == 0)
+            {
+                const DIRENT *pDirent = &CAST_CONST_DIRENT_PTR(pPInode->pbData)[ulIdx % DIRENTS_PER_BLOCK];
+
+                if(    (pDirent->ulInode != INODE_INVALID)
+                    && (RedStrNCmp(pDirent->acName, pszName, ulNameLen) == 0)
+                    && ((ulNameLen == REDCONF_NAME_MAX) || (pDirent->acName[ulNameLen] == '\0')))
+                {
+                    if(pulInode != NULL)
+                    {
+                        *pulInode = pDirent->ulInode;
+
+                      #ifdef REDCONF_ENDIAN_SWAP
+                        *pulInode = RedRev32(*pulInode);
+                      #endif
+                    }
+                }
+                else
+                {
+                    /*  A different name with the same hash.
+                    */
+                    ret = -RED_ENOENT;
+                }
+            }
+            else if(ret == -RED_ENODATA)
+            {
+                /*  The index only holds entries which were read from disk or
+                    written, so it should never point into a sparse block.
+                */
+                CRITICAL_ERROR();
+                ret = -RED_EFUBAR;
+            }
+            else
+            {
+                /*  Unexpected error, let the loop terminate, no action here.
+                */
+            }
+        }
+
+        ulSlot = (ulSlot + 1U) & (REDCONF_DIR_INDEX_SLOTS - 1U);
+    }
+
+    if(ret == -RED_ENOENT)
+    {
+        ulIdx = (gDirIndex.ulFreeIdx < DIRENTS_MAX) ? gDirIndex.ulFreeIdx : DIR_INDEX_INVALID;
+    }
+
+    if(((ret == 0) || (ret == -RED_ENOENT)) && (pulEntryIdx != NULL))
+    {
+        *pulEntryIdx = ulIdx;
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_READ_ONLY == 0
+/** @brief Remove the entry at a position from the directory index.
+
+    Used before the entry is overwritten or deleted.  The entry is read to find
+    the hash of its name.  If that fails, the index is invalidated.
+
+    @param pPInode  A pointer to the cached inode structure of the indexed
+                    directory.
+    @param ulIdx    The position of the entry.
+*/
+static void DirIndexEntryRemove(
+    CINODE     *pPInode,
+    uint32_t    ulIdx)
+{
+    if(ulIdx < gDirIndex.ulDirentCount)
+    {
+        REDSTATUS ret = RedInodeDataSeekAndRead(pPInode, ulIdx / DIRENTS_PER_BLOCK);
+
+        if(ret == 0)
+        {
+            const DIRENT *pDirent = &CAST_CONST_DIRENT_PTR(pPInode->pbData)[ulIdx % DIRENTS_PER_BLOCK];
+
+            if(pDirent->ulInode != INODE_INVALID)
+            {
+                uint32_t ulNameLen = RedStrLen(pDirent->acName);
+
+                if(ulNameLen > REDCONF_NAME_MAX)
+                {
+                    ulNameLen = REDCONF_NAME_MAX;
+                }
+
+                DirIndexSlotRemove(DirNameHash(pDirent->acName, ulNameLen), ulIdx);
+            }
+        }
+        else if(ret != -RED_ENODATA)
+        {
+            RedDirIndexInvalidate();
+        }
+        else
+        {
+            /*  Sparse block: the entry is already free.
+            */
+        }
+
+        if(ulIdx < gDirIndex.ulFreeIdx)
+        {
+            gDirIndex.ulFreeIdx = ulIdx;
+        }
+    }
+}
+
+
+/** @brief Add an entry which was just written to the directory index.
+
+    If the index is full, or the next free entry cannot be found, the index is
+    invalidated.
+
+    @param pPInode      A pointer to the cached inode structure of the indexed
+                        directory.
+    @param ulIdx        The position of the entry.
+    @param pszName      The name written to the entry; empty if the entry was
+                        freed.
+    @param ulNameLen    The length of @p pszName.
+*/
+static void DirIndexEntryAdd(
+    CINODE     *pPInode,
+    uint32_t    ulIdx,
+    const char *pszName,
+    uint32_t    ulNameLen)
+{
+    if(ulIdx >= gDirIndex.ulDirentCount)
+    {
+        gDirIndex.ulDirentCount = ulIdx + 1U;
+    }
+
+    if(ulNameLen > 0U)
+    {
+        if(!DirIndexSlotAdd(DirNameHash(pszName, ulNameLen), ulIdx))
+        {
+            RedDirIndexInvalidate();
+        }
+        else if(ulIdx == gDirIndex.ulFreeIdx)
+        {
+            if(DirIndexNextFree(pPInode, ulIdx + 1U, &gDirIndex.ulFreeIdx) != 0)
+            {
+                RedDirIndexInvalidate();
+            }
+        }
+        else
+        {
+            /*  The first free entry is unchanged.
+            */
+        }
+    }
+}
+
+
+/** @brief Find the first free entry in the indexed directory at or after a
+           position.
+
+    @param pPInode      A pointer to the cached inode structure of the indexed
+                        directory.
+    @param ulStartIdx   The position at which to start looking.
+    @param pulFreeIdx   On successful return, populated with the position of the
+                        free entry, or the directory size in entries if there is
+                        none.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EIO    A disk I/O error occurred.
+*/
+static REDSTATUS DirIndexNextFree(
+    CINODE     *pPInode,
+    uint32_t    ulStartIdx,
+    uint32_t   *pulFreeIdx)
+{
+    REDSTATUS   ret = 0;
+    uint32_t    ulIdx = ulStartIdx;
+    bool        fFound = false;
+
+    while((ret == 0) && !fFound && (ulIdx < gDirIndex.ulDirentCount))
+    {
+        ret = RedInodeDataSeekAndRead(pPInode, ulIdx / DIRENTS_PER_BLOCK);
+
+        if(ret == 0)
+        {
+            const DIRENT *pDirents = CAST_CONST_DIRENT_PTR(pPInode->pbData);
+            uint32_t      ulBlockEndIdx = ((ulIdx / DIRENTS_PER_BLOCK) + 1U) * DIRENTS_PER_BLOCK;
+
+            ulBlockEndIdx = REDMIN(ulBlockEndIdx, gDirIndex.ulDirentCount);
+
+            while(!fFound && (ulIdx < ulBlockEndIdx))
+            {
+                if(pDirents[ulIdx % DIRENTS_PER_BLOCK].ulInode == INODE_INVALID)
+                {
+                    fFound = true;
+                }
+                else
+                {
+                    ulIdx++;
+                }
+            }
+        }
+        else if(ret == -RED_ENODATA)
+        {
+            fFound = true;
+            ret = 0;
+        }
+        else
+        {
+            /*  Unexpected error, let the loop terminate, no action here.
+            */
+        }
+    }
+
+    if(ret == 0)
+    {
+        *pulFreeIdx = REDMIN(ulIdx, gDirIndex.ulDirentCount);
+    }
+
+    return ret;
+}
+
+
+/** @brief Remove a slot from the directory index hash table.
+
+    Later slots in the same probe sequence are shifted back to fill the gap, so
+    that no deleted-slot markers are needed.
+
+    @param ulHash   The hash of the name of the entry.
+    @param ulIdx    The position of the entry.
+*/
+static void DirIndexSlotRemove(
+    uint32_t    ulHash,
+    uint32_t    ulIdx)
+{
+    uint32_t    ulSlot = ulHash & (REDCONF_DIR_INDEX_SLOTS - 1U);
+
+    while(    (gDirIndex.aSlot[ulSlot].ulIdx != DIR_INDEX_INVALID)
+           && (gDirIndex.aSlot[ulSlot].ulIdx != ulIdx))
+    {
+        ulSlot = (ulSlot + 1U) & (REDCONF_DIR_INDEX_SLOTS - 1U);
+    }
+
+    if(gDirIndex.aSlot[ulSlot].ulIdx == DIR_INDEX_INVALID)
+    {
+        /*  Every used entry is in the index, so this should not happen.
+        */
+        REDERROR();
+        RedDirIndexInvalidate();
+    }
+    else
+    {
+        uint32_t ulNext = ulSlot;
+
+        for(;;)
+        {
+            uint32_t ulHome;
+
+            ulNext = (ulNext + 1U) & (REDCONF_DIR_INDEX_SLOTS - 1U);
+
+            if(gDirIndex.aSlot[ulNext].ulIdx == DIR_INDEX_INVALID)
+            {
+                break;
+            }
+
+            /*  The entry in ulNext can fill the gap only if its home slot is
+                not cyclically between the gap and ulNext.
+            */
+            ulHome = gDirIndex.aSlot[ulNext].ulHash & (REDCONF_DIR_INDEX_SLOTS - 1U);
+
+            if(((ulNext - ulHome) & (REDCONF_DIR_INDEX_SLOTS - 1U)) >= ((ulNext - ulSlot) & (REDCONF_DIR_INDEX_SLOTS - 1U)))
+            {
+                gDirIndex.aSlot[ulSlot] = gDirIndex.aSlot[ulNext];
+                ulSlot = ulNext;
+            }
+        }
+
+        gDirIndex.aSlot[ulSlot].ulIdx = DIR_INDEX_INVALID;
+
+        REDASSERT(gDirIndex.ulEntries > 0U);
+        gDirIndex.ulEntries--;
+    }
+}
+#endif /* REDCONF_READ_ONLY == 0 */
+
+
+/** @brief Add a slot to the directory index hash table.
+
+    @param ulHash   The hash of the name of the entry.
+    @param ulIdx    The position of the entry.
+
+    @return Whether the slot was added.  Returns false if the index is full.
+*/
+static bool DirIndexSlotAdd(
+    uint32_t    ulHash,
+    uint32_t    ulIdx)
+{
+    bool        fAdded = false;
+
+    if(gDirIndex.ulEntries < DIR_INDEX_MAX_ENTRIES)
+    {
+        uint32_t ulSlot = ulHash & (REDCONF_DIR_INDEX_SLOTS - 1U);
+
+        while(gDirIndex.aSlot[ulSlot].ulIdx != DIR_INDEX_INVALID)
+        {
+            ulSlot = (ulSlot + 1U) & (REDCONF_DIR_INDEX_SLOTS - 1U);
+        }
+
+        gDirIndex.aSlot[ulSlot].ulHash = ulHash;
+        gDirIndex.aSlot[ulSlot].ulIdx = ulIdx;
+        gDirIndex.ulEntries++;
+
+        fAdded = true;
+    }
+
+    return fAdded;
+}
+
+
+/** @brief Hash a name for the directory index.
+
+    Uses the 32-bit FNV-1a hash.
+
+    @param pszName      The name to hash.
+    @param ulNameLen    The length of @p pszName.
+
+    @return The hash of the name.
+*/
+static uint32_t DirNameHash(
+    const char *pszName,
+    uint32_t    ulNameLen)
+{
+    uint32_t    ulHash = 2166136261U;
+    uint32_t    ulIdx;
+
+    for(ulIdx = 0U; ulIdx < ulNameLen; ulIdx++)
+    {
+        ulHash ^= (uint8_t)pszName[ulIdx];
+        ulHash *= 16777619U;
+    }
+
+    return ulHash;
+}
+#endif /* REDCONF_DIR_INDEX_SLOTS > 0U */
+
+
 #endif /* REDCONF_API_POSIX == 1 */
 
@@ -28,11 +28,28 @@
     This module implements routines for working with the imap, a bitmap which
     tracks which blocks are allocated or free.  Some of the functionality is
     delegated to imapinline.c and imapextern.c.
+
+    When REDCONF_IMAP_FREE_GROUPS is nonzero, this module also keeps a count of
+    the free blocks in each of that many groups of blocks, so that allocation
+    can skip over full groups without reading their part of the imap.
 */
 #include <redfs.h>
 #include <redcore.h>
 
 
+#if (REDCONF_READ_ONLY == 0) && (REDCONF_IMAP_FREE_GROUPS > 0U)
+/*  The most blocks in a run of free blocks found by FreeRunFind().  Blocks in
+    the run are allocated without reading the imap again, so this limits the
+    imap reads for blocks which might never be allocated.
+*/
+#define FREE_RUN_MAX_BLOCKS 64U
+
+
+static REDSTATUS FreeRunFind(void);
+static uint32_t FreeGroup(uint32_t ulBlock);
+#endif
+
+
 /** @brief Get the allocation bit of a block from either metaroot.
 
     Will pass the call down either to the inline imap or to the external imap
@@ -164,6 +181,10 @@ REDSTATUS RedImapBlockSet(
         if(fAllocated)
         {
             gpRedMR->ulFreeBlocks--;
+
+          #if REDCONF_IMAP_FREE_GROUPS > 0U
+            gpRedCoreVol->aulGroupFreeBlocks[FreeGroup(ulBlock)]--;
+          #endif
         }
         else
         {
@@ -181,10 +202,18 @@ REDSTATUS RedImapBlockSet(
                 if(fWasAllocated)
                 {
                     gpRedCoreVol->ulAlmostFreeBlocks++;
+
+                  #if REDCONF_IMAP_FREE_GROUPS > 0U
+                    gpRedCoreVol->aulGroupAlmostFreeBlocks[FreeGroup(ulBlock)]++;
+                  #endif
                 }
                 else
                 {
                     gpRedMR->ulFreeBlocks++;
+
+                  #if REDCONF_IMAP_FREE_GROUPS > 0U
+                    gpRedCoreVol->aulGroupFreeBlocks[FreeGroup(ulBlock)]++;
+                  #endif
                 }
             }
         }
@@ -222,6 +251,39 @@ REDSTATUS RedImapAllocBlock(
     }
     else
     {
+      #if REDCONF_IMAP_FREE_GROUPS > 0U
+        if(gpRedCoreVol->ulFreeRunStart == gpRedCoreVol->ulFreeRunEnd)
+        {
+            ret = FreeRunFind();
+        }
+        else
+        {
+            ret = 0;
+        }
+
+        if(ret == 0)
+        {
+            uint32_t ulBlock = gpRedCoreVol->ulFreeRunStart;
+
+            ret = RedImapBlockSet(ulBlock, true);
+            CRITICAL_ASSERT(ret == 0);
+
+            if(ret == 0)
+            {
+                *pulBlock = ulBlock;
+                gpRedCoreVol->ulFreeRunStart++;
+
+                /*  Advance the forward allocation pointer, which is saved in
+                    the metaroot, just as the imap scan would have.
+                */
+                gpRedMR->ulAllocNextBlock = ulBlock + 1U;
+                if(gpRedMR->ulAllocNextBlock == gpRedVolume->ulBlockCount)
+                {
+                    gpRedMR->ulAllocNextBlock = gpRedCoreVol->ulFirstAllocableBN;
+                }
+            }
+        }
+      #else
         uint32_t ulStopBlock = gpRedMR->ulAllocNextBlock;
         bool     fAllocated = false;
 
@@ -264,10 +326,225 @@ REDSTATUS RedImapAllocBlock(
             CRITICAL_ERROR();
             ret = -RED_EFUBAR;
         }
+      #endif
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_IMAP_FREE_GROUPS > 0U
+/** @brief Build the free index for the mounted volume.
+
+    Counts the free and almost free blocks in each group by reading the whole
+    imap, and empties the free run.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EIO    A disk I/O error occurred.
+*/
+REDSTATUS RedImapFreeIndexBuild(void)
+{
+    REDSTATUS   ret = 0;
+    uint32_t    ulGroupBlocks = (((gpRedVolume->ulBlockCount - gpRedCoreVol->ulInodeTableStartBN) - 1U) / REDCONF_IMAP_FREE_GROUPS) + 1U;
+    uint32_t    ulFreeBlocks = 0U;
+    uint32_t    ulBlock;
+
+  #if REDCONF_IMAP_EXTERNAL == 1
+    if(!gpRedCoreVol->fImapInline)
+    {
+        /*  Round the groups up to whole imap nodes, so that the blocks of each
+            group are covered by as few imap nodes as possible.
+        */
+        ulGroupBlocks = (((ulGroupBlocks - 1U) / IMAPNODE_ENTRIES) + 1U) * IMAPNODE_ENTRIES;
+    }
+  #endif
+
+    gpRedCoreVol->ulFreeGroupBlocks = ulGroupBlocks;
+    gpRedCoreVol->ulFreeRunStart = 0U;
+    gpRedCoreVol->ulFreeRunEnd = 0U;
+
+    RedMemSet(gpRedCoreVol->aulGroupFreeBlocks, 0U, sizeof(gpRedCoreVol->aulGroupFreeBlocks));
+    RedMemSet(gpRedCoreVol->aulGroupAlmostFreeBlocks, 0U, sizeof(gpRedCoreVol->aulGroupAlmostFreeBlocks));
+
+    for(ulBlock = gpRedCoreVol->ulFirstAllocableBN; (ret == 0) && (ulBlock < gpRedVolume->ulBlockCount); ulBlock++)
+    {
+        ALLOCSTATE state;
+
+        ret = RedImapBlockState(ulBlock, &state);
+
+        if(ret == 0)
+        {
+            if(state == ALLOCSTATE_FREE)
+            {
+                gpRedCoreVol->aulGroupFreeBlocks[FreeGroup(ulBlock)]++;
+                ulFreeBlocks++;
+            }
+            else if(state == ALLOCSTATE_AFREE)
+            {
+                gpRedCoreVol->aulGroupAlmostFreeBlocks[FreeGroup(ulBlock)]++;
+            }
+            else
+            {
+                /*  Block is in use; nothing to count.
+                */
+            }
+        }
+    }
+
+    REDASSERT((ret != 0) || (ulFreeBlocks == gpRedMR->ulFreeBlocks));
+
+    return ret;
+}
+
+
+/** @brief Update the free index for a transaction point.
+
+    Blocks which were almost free become free once the transaction point is
+    committed.  This is the per-group counterpart of adding the almost free
+    block count to the free block count in RedVolTransact().
+*/
+void RedImapFreeIndexTransact(void)
+{
+    uint32_t ulGroup;
+
+    for(ulGroup = 0U; ulGroup < REDCONF_IMAP_FREE_GROUPS; ulGroup++)
+    {
+        gpRedCoreVol->aulGroupFreeBlocks[ulGroup] += gpRedCoreVol->aulGroupAlmostFreeBlocks[ulGroup];
+        gpRedCoreVol->aulGroupAlmostFreeBlocks[ulGroup] = 0U;
+    }
+}
+
+
+/** @brief Find the next run of free blocks to allocate.
+
+    Searches forward from the forward allocation pointer, wrapping around at
+    the end of the volume, for a free block.  Groups with no free blocks are
+    skipped without reading the imap.  The run then extends through the free
+    blocks which immediately follow, up to FREE_RUN_MAX_BLOCKS in all, so that
+    consecutive allocations are contiguous.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EIO    A disk I/O error occurred.
+    @retval -RED_EFUBAR No free block was found, even though the free block
+                        count is nonzero.
+*/
+static REDSTATUS FreeRunFind(void)
+{
+    REDSTATUS   ret = 0;
+    uint32_t    ulBlock = gpRedMR->ulAllocNextBlock;
+    uint32_t    ulGroupVisits = 0U;
+    bool        fFound = false;
+
+    /*  The search usually starts partway through a group, so after wrapping
+        around, that group is visited a second time.
+    */
+    while((ret == 0) && !fFound && (ulGroupVisits <= REDCONF_IMAP_FREE_GROUPS))
+    {
+        uint32_t ulGroup = FreeGroup(ulBlock);
+        uint32_t ulGroupStart = gpRedCoreVol->ulInodeTableStartBN + (ulGroup * gpRedCoreVol->ulFreeGroupBlocks);
+        uint32_t ulGroupEnd = gpRedVolume->ulBlockCount;
+
+        if((gpRedVolume->ulBlockCount - ulGroupStart) > gpRedCoreVol->ulFreeGroupBlocks)
+        {
+            ulGroupEnd = ulGroupStart + gpRedCoreVol->ulFreeGroupBlocks;
+        }
+
+        if(gpRedCoreVol->aulGroupFreeBlocks[ulGroup] > 0U)
+        {
+            while((ret == 0) && !fFound && (ulBlock < ulGroupEnd))
+            {
+                ALLOCSTATE state;
+
+                ret = RedImapBlockState(ulBlock, &state);
+                CRITICAL_ASSERT(ret == 0);
+
+                if((ret == 0) && (state == ALLOCSTATE_FREE))
+                {
+                    fFound = true;
+                }
+                else
+                {
+                    ulBlock++;
+                }
+            }
+        }
+
+        if(!fFound)
+        {
+            ulBlock = ulGroupEnd;
+            if(ulBlock == gpRedVolume->ulBlockCount)
+            {
+                ulBlock = gpRedCoreVol->ulFirstAllocableBN;
+            }
+
+            ulGroupVisits++;
+        }
+    }
+
+    if(fFound)
+    {
+        uint32_t ulRunEnd = ulBlock + 1U;
+
+        while(    (ret == 0)
+               && (ulRunEnd < gpRedVolume->ulBlockCount)
+               && ((ulRunEnd - ulBlock) < FREE_RUN_MAX_BLOCKS))
+        {
+            ALLOCSTATE state;
+
+            ret = RedImapBlockState(ulRunEnd, &state);
+            CRITICAL_ASSERT(ret == 0);
+
+            if((ret == 0) && (state != ALLOCSTATE_FREE))
+            {
+                break;
+            }
+
+            ulRunEnd++;
+        }
+
+        if(ret == 0)
+        {
+            gpRedCoreVol->ulFreeRunStart = ulBlock;
+            gpRedCoreVol->ulFreeRunEnd = ulRunEnd;
+        }
+    }
+    else if(ret == 0)
+    {
+        /*  The free block count was already determined to be non-zero, no
+            error occurred while looking for free blocks, but no free blocks
+            were found.  This indicates metadata corruption.
+        */
+        CRITICAL_ERROR();
+        ret = -RED_EFUBAR;
+    }
+    else
+    {
+        /*  An I/O error occurred; just return it.
+        */
     }
 
     return ret;
 }
+
+
+/** @brief Get the free index group of a block.
+
+    @param ulBlock  The block number.
+
+    @return The index of the group which contains @p ulBlock.
+*/
+static uint32_t FreeGroup(
+    uint32_t    ulBlock)
+{
+    REDASSERT(ulBlock >= gpRedCoreVol->ulInodeTableStartBN);
+
+    return (ulBlock - gpRedCoreVol->ulInodeTableStartBN) / gpRedCoreVol->ulFreeGroupBlocks;
+}
+#endif /* REDCONF_IMAP_FREE_GROUPS > 0U */
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
@@ -53,6 +53,19 @@ typedef enum
 } BRANCHDEPTH;
 
 
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+/** @brief State used to detect sequential reads and read ahead of them.
+*/
+typedef struct
+{
+    uint32_t    ulInode;        /**< Inode most recently read from. */
+    uint8_t     bVolNum;        /**< Volume of the inode most recently read from. */
+    uint64_t    ullNextOffset;  /**< File offset just past the most recent read. */
+    uint32_t    ulAheadBlock;   /**< File block offset at which the data read ahead ends. */
+} READAHEAD;
+#endif
+
+
 #if REDCONF_READ_ONLY == 0
 #if DELETE_SUPPORTED || TRUNCATE_SUPPORTED
 static REDSTATUS Shrink(CINODE *pInode, uint64_t ullSize);
@@ -74,6 +87,9 @@ static REDSTATUS WriteUnaligned(CINODE *pInode, uint64_t ullStart, uint32_t ulLe
 static REDSTATUS WriteAligned(CINODE *pInode, uint32_t ulBlockStart, uint32_t *pulBlockCount, const uint8_t *pbBuffer);
 #endif
 static REDSTATUS GetExtent(CINODE *pInode, uint32_t ulBlockStart, uint32_t *pulExtentStart, uint32_t *pulExtentLen);
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+static void ReadAhead(CINODE *pInode, uint64_t ullStart, uint32_t ulLen);
+#endif
 #if REDCONF_READ_ONLY == 0
 static REDSTATUS BranchBlock(CINODE *pInode, BRANCHDEPTH depth, bool fBuffer);
 static REDSTATUS BranchOneBlock(uint32_t *pulBlock, void **ppBuffer, uint16_t uBFlag);
@@ -82,6 +98,11 @@ static uint32_t FreeBlockCount(void);
 #endif
 
 
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+static READAHEAD gReadAhead;
+#endif
+
+
 /** @brief Read data from an inode.
 
     @param pInode   A pointer to the cached inode structure of the inode from
@@ -185,6 +206,10 @@ REDSTATUS RedInodeDataRead(
         if(ret == 0)
         {
             *pulLen = ulLen;
+
+          #if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+            ReadAhead(pInode, ullStart, ulLen);
+          #endif
         }
     }
 
@@ -1226,20 +1251,34 @@ static REDSTATUS ReadAligned(
 
             if(ret == 0)
             {
-              #if REDCONF_READ_ONLY == 0
-                /*  Before reading directly from disk, flush any dirty file data
-                    buffers in the range to avoid reading stale data.
+              #if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+                /*  Blocks which were read ahead are copied from the buffers,
+                    and only the rest of the extent is read from disk.
                 */
-                ret = RedBufferFlush(ulExtentStart, ulExtentLen);
+                uint32_t ulCachedLen = RedBufferReadCached(ulExtentStart, ulExtentLen, &pbBuffer[ulBlockIndex << BLOCK_SIZE_P2]);
 
-                if(ret == 0)
+                ulBlockIndex += ulCachedLen;
+                ulExtentStart += ulCachedLen;
+                ulExtentLen -= ulCachedLen;
+
+                if(ulExtentLen > 0U)
               #endif
                 {
-                    ret = RedIoRead(gbRedVolNum, ulExtentStart, ulExtentLen, &pbBuffer[ulBlockIndex << BLOCK_SIZE_P2]);
+                  #if REDCONF_READ_ONLY == 0
+                    /*  Before reading directly from disk, flush any dirty file
+                        data buffers in the range to avoid reading stale data.
+                    */
+                    ret = RedBufferFlush(ulExtentStart, ulExtentLen);
 
                     if(ret == 0)
+                  #endif
                     {
-                        ulBlockIndex += ulExtentLen;
+                        ret = RedIoRead(gbRedVolNum, ulExtentStart, ulExtentLen, &pbBuffer[ulBlockIndex << BLOCK_SIZE_P2]);
+
+                        if(ret == 0)
+                        {
+                            ulBlockIndex += ulExtentLen;
+                        }
                     }
                 }
             }
@@ -1493,6 +1532,73 @@ static REDSTATUS GetExtent(
 }
 
 
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+/** @brief Read ahead of a sequential reader.
+
+    A read is sequential if it starts at the beginning of the file, or where
+    the previous read of the same inode ended.  After a sequential read, the
+    extent which follows it is read into the buffers, up to
+    REDCONF_BUFFER_STAGE_BLOCKS at a time, unless that was already done.  Reads
+    at least that large already transfer whole extents, so they are not read
+    ahead of.
+
+    Reading ahead is only an optimization: if it fails, the blocks are read,
+    and any error is reported, when they are needed.
+
+    @param pInode   A pointer to the cached inode structure.
+    @param ullStart The file offset at which the read started.
+    @param ulLen    The number of bytes which were read.
+*/
+static void ReadAhead(
+    CINODE     *pInode,
+    uint64_t    ullStart,
+    uint32_t    ulLen)
+{
+    uint32_t    ulNextBlock = (uint32_t)(((ullStart + ulLen) + (REDCONF_BLOCK_SIZE - 1U)) >> BLOCK_SIZE_P2);
+    uint32_t    ulFileBlocks = (uint32_t)((pInode->pInodeBuf->ullSize + (REDCONF_BLOCK_SIZE - 1U)) >> BLOCK_SIZE_P2);
+    bool        fSequential = true;
+
+    if(    (gReadAhead.ulInode != pInode->ulInode)
+        || (gReadAhead.bVolNum != gbRedVolNum)
+        || (gReadAhead.ullNextOffset != ullStart))
+    {
+        fSequential = (ullStart == 0U);
+
+        gReadAhead.ulInode = pInode->ulInode;
+        gReadAhead.bVolNum = gbRedVolNum;
+        gReadAhead.ulAheadBlock = 0U;
+    }
+
+    gReadAhead.ullNextOffset = ullStart + ulLen;
+
+    if(    fSequential
+        && (ulLen < (REDCONF_BUFFER_STAGE_BLOCKS << BLOCK_SIZE_P2))
+        && (ulNextBlock < ulFileBlocks)
+        && (ulNextBlock >= gReadAhead.ulAheadBlock))
+    {
+        uint32_t    ulExtentStart;
+        uint32_t    ulExtentLen = REDMIN(ulFileBlocks - ulNextBlock, REDCONF_BUFFER_STAGE_BLOCKS);
+        REDSTATUS   ret;
+
+        ret = GetExtent(pInode, ulNextBlock, &ulExtentStart, &ulExtentLen);
+
+        if(ret == 0)
+        {
+            (void)RedBufferReadAhead(ulExtentStart, ulExtentLen);
+            gReadAhead.ulAheadBlock = ulNextBlock + ulExtentLen;
+        }
+        else
+        {
+            /*  Nothing to read ahead for a sparse block; the next read will try
+                again after it.
+            */
+            gReadAhead.ulAheadBlock = ulNextBlock + 1U;
+        }
+    }
+}
+#endif /* REDCONF_BUFFER_STAGE_BLOCKS > 0U */
+
+
 #if REDCONF_READ_ONLY == 0
 /** @brief Allocate or branch the file metadata path and data block if necessary.
 
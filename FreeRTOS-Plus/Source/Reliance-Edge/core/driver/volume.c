@@ -262,6 +262,18 @@ REDSTATUS RedVolMountMetaroot(void)
         gpRedMR = &gpRedCoreVol->aMR[gpRedCoreVol->bCurMR];
     }
 
+  #if (REDCONF_READ_ONLY == 0) && (REDCONF_IMAP_FREE_GROUPS > 0U)
+    if(ret == 0)
+    {
+        ret = RedImapFreeIndexBuild();
+
+        if(ret != 0)
+        {
+            gpRedVolume->fMounted = false;
+        }
+    }
+  #endif
+
     return ret;
 }
 
@@ -358,6 +370,10 @@ REDSTATUS RedVolTransact(void)
         gpRedMR->ulFreeBlocks += gpRedCoreVol->ulAlmostFreeBlocks;
         gpRedCoreVol->ulAlmostFreeBlocks = 0U;
 
+      #if REDCONF_IMAP_FREE_GROUPS > 0U
+        RedImapFreeIndexTransact();
+      #endif
+
         ret = RedBufferFlush(0U, gpRedVolume->ulBlockCount);
 
         if(ret == 0)
@@ -100,6 +100,10 @@ void RedBufferDiscard(const void *pBuffer);
 #endif
 #endif
 REDSTATUS RedBufferDiscardRange(uint32_t ulBlockStart, uint32_t ulBlockCount);
+#if REDCONF_BUFFER_STAGE_BLOCKS > 0U
+REDSTATUS RedBufferReadAhead(uint32_t ulBlockStart, uint32_t ulBlockCount);
+uint32_t RedBufferReadCached(uint32_t ulBlockStart, uint32_t ulBlockCount, void *pBuffer);
+#endif
 
 
 /** @brief Allocation state of a block.
@@ -116,6 +120,10 @@ REDSTATUS RedImapBlockGet(uint8_t bMR, uint32_t ulBlock, bool *pfAllocated);
 #if REDCONF_READ_ONLY == 0
 REDSTATUS RedImapBlockSet(uint32_t ulBlock, bool fAllocated);
 REDSTATUS RedImapAllocBlock(uint32_t *pulBlock);
+#if REDCONF_IMAP_FREE_GROUPS > 0U
+REDSTATUS RedImapFreeIndexBuild(void);
+void RedImapFreeIndexTransact(void);
+#endif
 #endif
 REDSTATUS RedImapBlockState(uint32_t ulBlock, ALLOCSTATE *pState);
 
@@ -237,6 +245,9 @@ REDSTATUS RedDirEntryRead(CINODE *pPInode, uint32_t *pulIdx, char *pszName, uint
 #if (REDCONF_READ_ONLY == 0) && (REDCONF_API_POSIX_RENAME == 1)
 REDSTATUS RedDirEntryRename(CINODE *pSrcPInode, const char *pszSrcName, CINODE *pSrcInode, CINODE *pDstPInode, const char *pszDstName, CINODE *pDstInode);
 #endif
+#if REDCONF_DIR_INDEX_SLOTS > 0U
+void RedDirIndexInvalidate(void);
+#endif
 #endif
 
 REDSTATUS RedVolMount(void);
@@ -72,6 +72,33 @@ typedef struct
     */
     uint32_t    ulAlmostFreeBlocks;
 
+  #if (REDCONF_READ_ONLY == 0) && (REDCONF_IMAP_FREE_GROUPS > 0U)
+    /** The number of blocks in each free index group.  The groups divide up
+        the blocks covered by the imap, starting at ulInodeTableStartBN; with
+        the external imap, each group is a whole number of imap nodes.
+    */
+    uint32_t    ulFreeGroupBlocks;
+
+    /** The number of free blocks in each group.
+    */
+    uint32_t    aulGroupFreeBlocks[REDCONF_IMAP_FREE_GROUPS];
+
+    /** The number of blocks in each group which will become free after the
+        next transaction.
+    */
+    uint32_t    aulGroupAlmostFreeBlocks[REDCONF_IMAP_FREE_GROUPS];
+
+    /** The start of a run of blocks known to be free, which are allocated in
+        order without consulting the imap.
+    */
+    uint32_t    ulFreeRunStart;
+
+    /** The block number just past the end of the free run.  The run is empty
+        when this equals ulFreeRunStart.
+    */
+    uint32_t    ulFreeRunEnd;
+  #endif
+
   #if RESERVED_BLOCKS > 0U
     /** Whether to use the blocks reserved for operations that create free
         space.
@@ -240,6 +240,28 @@
   #error "Configuration error: invalid value of REDCONF_TASK_COUNT"
 #endif
 
+/*  REDCONF_API_POSIX_FINE_LOCKING is optional: configurations which predate it
+    get the single file system mutex.
+*/
+#ifndef REDCONF_API_POSIX_FINE_LOCKING
+  #define REDCONF_API_POSIX_FINE_LOCKING 0
+#endif
+
+#if (REDCONF_API_POSIX_FINE_LOCKING != 0) && (REDCONF_API_POSIX_FINE_LOCKING != 1)
+  #error "Configuration error: REDCONF_API_POSIX_FINE_LOCKING must be either 0 or 1."
+#endif
+
+#if (REDCONF_API_POSIX_FINE_LOCKING == 1) && ((REDCONF_API_POSIX == 0) || (REDCONF_TASK_COUNT == 1U))
+  #error "Configuration error: REDCONF_API_POSIX_FINE_LOCKING requires REDCONF_API_POSIX and REDCONF_TASK_COUNT > 1."
+#endif
+
+/*  The FSE API serializes on the FS mutex alone, which fine-grained locking
+    does not use to protect the core.
+*/
+#if (REDCONF_API_POSIX_FINE_LOCKING == 1) && (REDCONF_API_FSE == 1)
+  #error "Configuration error: REDCONF_API_POSIX_FINE_LOCKING cannot be used with REDCONF_API_FSE."
+#endif
+
 #if (REDCONF_ENDIAN_BIG != 0) && (REDCONF_ENDIAN_BIG != 1)
   #error "Configuration error: REDCONF_ENDIAN_BIG must be either 0 or 1."
 #endif
@@ -303,6 +325,50 @@
   #error "REDCONF_BUFFER_COUNT cannot be greater than 255"
 #endif
 
+/*  REDCONF_BUFFER_STAGE_BLOCKS is optional: configurations which predate it do
+    not read ahead or gather writes.
+*/
+#ifndef REDCONF_BUFFER_STAGE_BLOCKS
+  #define REDCONF_BUFFER_STAGE_BLOCKS 0U
+#endif
+
+#if REDCONF_BUFFER_STAGE_BLOCKS > REDCONF_BUFFER_COUNT
+  #error "REDCONF_BUFFER_STAGE_BLOCKS cannot be greater than REDCONF_BUFFER_COUNT"
+#endif
+
+/*  REDCONF_IMAP_FREE_GROUPS is optional: configurations which predate it
+    allocate by scanning the imap.
+*/
+#ifndef REDCONF_IMAP_FREE_GROUPS
+  #define REDCONF_IMAP_FREE_GROUPS 0U
+#endif
+
+#if REDCONF_IMAP_FREE_GROUPS > 4096U
+  #error "REDCONF_IMAP_FREE_GROUPS cannot be greater than 4096"
+#endif
+
+/*  REDCONF_DIR_INDEX_SLOTS is optional: configurations which predate it search
+    directories linearly.
+*/
+#ifndef REDCONF_DIR_INDEX_SLOTS
+  #define REDCONF_DIR_INDEX_SLOTS 0U
+#endif
+
+#if (REDCONF_DIR_INDEX_SLOTS & (REDCONF_DIR_INDEX_SLOTS - 1U)) != 0U
+  #error "REDCONF_DIR_INDEX_SLOTS must be zero or a power of two"
+#endif
+
+#if REDCONF_DIR_INDEX_SLOTS > 0x1000000U
+  #error "REDCONF_DIR_INDEX_SLOTS cannot be greater than 16777216"
+#endif
+
+/*  REDCONF_MEM_ALGORITHM is optional: configurations which predate it use the
+    byte-at-a-time memory functions.  Checked in memory.c.
+*/
+#ifndef REDCONF_MEM_ALGORITHM
+  #define REDCONF_MEM_ALGORITHM 0U
+#endif
+
 #if (REDCONF_IMAGE_BUILDER != 0) && (REDCONF_IMAGE_BUILDER != 1)
   #error "Configuration error: REDCONF_IMAGE_BUILDER must be either 0 or 1."
 #endif
@@ -119,6 +119,16 @@
 #define CAST_CONST_UINT32_PTR(PTR) ((const uint32_t *)(const void *)(PTR))
 
 
+/** @brief Cast a pointer to a uint32_t pointer.
+
+    The non-const counterpart of CAST_CONST_UINT32_PTR(), with the same
+    deviations from MISRA C:2012 Rules 11.5 (advisory) and 11.3 (required).
+    It is only used on pointers which IS_UINT32_ALIGNED_PTR() has found to be
+    aligned to the size of a uint32_t.
+*/
+#define CAST_UINT32_PTR(PTR) ((uint32_t *)(void *)(PTR))
+
+
 /** @brief Cast a pointer to a pointer to (void **).
 
     Usages of this macro deviate from MISRA C:2012 Rule 11.3 (required).
@@ -220,5 +230,34 @@
 #define IS_ALIGNED_PTR(ptr) (((uintptr_t)(ptr) & (REDCONF_ALIGNMENT_SIZE - 1U)) == 0U)
 
 
+/** @brief Determine whether a pointer is aligned to the size of a uint32_t.
+
+    This is used by the word-wise memory functions, which access byte buffers
+    as uint32_t words.  Unlike IS_ALIGNED_PTR(), it does not depend on
+    ::REDCONF_ALIGNMENT_SIZE, which may be less than the size of a uint32_t on
+    platforms which allow unaligned access.
+
+    Usage of this macro deviates from MISRA C:2012 Rule 11.4 (advisory), for the
+    same reasons as IS_ALIGNED_PTR().
+*/
+#define IS_UINT32_ALIGNED_PTR(ptr) (((uintptr_t)(ptr) & ((uintptr_t)sizeof(uint32_t) - 1U)) == 0U)
+
+
+/** @brief Compute the distance in bytes from one pointer to another.
+
+    This is used by the block buffer module to find the index of a buffer from
+    a pointer to it, without comparing the pointer against every buffer.
+
+    Subtracting pointers is undefined unless both point into the same array
+    (MISRA C:2012 Rule 18.2, required), which is not known in advance since the
+    pointer being checked might not be a buffer pointer.  The pointers are
+    instead cast to uintptr_t and the integers are subtracted.  If @p ptr is
+    below @p base, the unsigned result wraps to a large value, which the caller
+    rejects with a bounds check.  Usage of this macro deviates from MISRA C:2012
+    Rule 11.4 (advisory), for the same reasons as IS_ALIGNED_PTR().
+*/
+#define PTR_OFFSET(ptr, base) ((uintptr_t)(ptr) - (uintptr_t)(base))
+
+
 #endif
 
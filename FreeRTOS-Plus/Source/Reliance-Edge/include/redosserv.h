@@ -63,6 +63,12 @@ void RedOsMutexRelease(void);
 #if (REDCONF_TASK_COUNT > 1U) && (REDCONF_API_POSIX == 1)
 uint32_t RedOsTaskId(void);
 #endif
+#if REDCONF_API_POSIX_FINE_LOCKING == 1
+REDSTATUS RedOsTaskWaitInit(void);
+REDSTATUS RedOsTaskWaitUninit(void);
+void RedOsTaskWait(uint32_t ulTaskIdx);
+void RedOsTaskWake(uint32_t ulTaskIdx);
+#endif
 
 REDSTATUS RedOsClockInit(void);
 REDSTATUS RedOsClockUninit(void);
@@ -45,6 +45,13 @@
       && (REDCONF_API_POSIX_RMDIR == 1) && (REDCONF_API_POSIX_RENAME == 1) && (REDCONF_API_POSIX_LINK == 1) \
       && (REDCONF_API_POSIX_FTRUNCATE == 1) && (REDCONF_API_POSIX_READDIR == 1))
 
+#define FSMTSTRESS_SUPPORTED \
+    (    ((RED_KIT == RED_KIT_GPL) || (RED_KIT == RED_KIT_SANDBOX)) \
+      && (REDCONF_OUTPUT == 1) && (REDCONF_READ_ONLY == 0) && (REDCONF_PATH_SEPARATOR == '/') \
+      && (REDCONF_TASK_COUNT > 1U) && (REDCONF_API_POSIX == 1) && (REDCONF_API_POSIX_UNLINK == 1) \
+      && (REDCONF_API_POSIX_MKDIR == 1) && (REDCONF_API_POSIX_RMDIR == 1) && (REDCONF_API_POSIX_RENAME == 1) \
+      && (REDCONF_API_POSIX_FTRUNCATE == 1) && (REDCONF_API_POSIX_READDIR == 1))
+
 #define FSE_STRESS_TEST_SUPPORTED \
     (    ((RED_KIT == RED_KIT_COMMERCIAL) || (RED_KIT == RED_KIT_SANDBOX)) \
       && (REDCONF_OUTPUT == 1) && (REDCONF_READ_ONLY == 0) && (REDCONF_API_FSE == 1) \
@@ -76,6 +83,10 @@
     (    ((RED_KIT == RED_KIT_COMMERCIAL) || (RED_KIT == RED_KIT_SANDBOX)) \
       && (REDCONF_OUTPUT == 1) && (REDCONF_READ_ONLY == 0))
 
+#define CRCBENCH_SUPPORTED (REDCONF_OUTPUT == 1)
+
+#define MEMBENCH_SUPPORTED (REDCONF_OUTPUT == 1)
+
 #define DISKFULL_TEST_SUPPORTED \
    (    ((RED_KIT == RED_KIT_COMMERCIAL) || (RED_KIT == RED_KIT_SANDBOX)) \
      && (REDCONF_OUTPUT == 1) && (REDCONF_READ_ONLY == 0) && (REDCONF_API_POSIX == 1) \
@@ -106,6 +117,22 @@ void FsstressDefaultParams(FSSTRESSPARAM *pParam);
 int FsstressStart(const FSSTRESSPARAM *pParam);
 #endif
 
+#if FSMTSTRESS_SUPPORTED
+typedef struct
+{
+    const char *pszVolume;  /**< Path prefix of the volume to test. */
+    uint32_t    ulTasks;    /**< Number of tasks which run FsMtStressTask(). */
+    uint32_t    ulNops;     /**< Number of operations performed by each task. */
+    uint32_t    ulSeed;     /**< Random seed; zero to use the clock. */
+    bool        fVerbose;   /**< Whether to print each operation. */
+} FSMTSTRESSPARAM;
+
+void FsMtStressDefaultParams(FSMTSTRESSPARAM *pParam);
+int FsMtStressPrepare(const FSMTSTRESSPARAM *pParam);
+int FsMtStressTask(const FSMTSTRESSPARAM *pParam, uint32_t ulTaskNum);
+int FsMtStressCleanup(const FSMTSTRESSPARAM *pParam);
+#endif
+
 #if STOCH_POSIX_TEST_SUPPORTED
 typedef struct
 {
@@ -231,6 +258,28 @@ void BDevTestDefaultParams(BDEVTESTPARAM *pParam);
 int BDevTestStart(const BDEVTESTPARAM *pParam);
 #endif
 
+#if CRCBENCH_SUPPORTED
+typedef struct
+{
+    uint32_t    ulBytes;    /**< Bytes to checksum with each algorithm at each buffer size. */
+    uint32_t    ulSeed;     /**< Random seed; zero to use the clock. */
+} CRCBENCHPARAM;
+
+void CrcBenchDefaultParams(CRCBENCHPARAM *pParam);
+int CrcBenchStart(const CRCBENCHPARAM *pParam);
+#endif
+
+#if MEMBENCH_SUPPORTED
+typedef struct
+{
+    uint32_t    ulBytes;    /**< Bytes to process with each function in each case. */
+    uint32_t    ulSeed;     /**< Random seed; zero to use the clock. */
+} MEMBENCHPARAM;
+
+void MemBenchDefaultParams(MEMBENCHPARAM *pParam);
+int MemBenchStart(const MEMBENCHPARAM *pParam);
+#endif
+
 #if DISKFULL_TEST_SUPPORTED
 typedef struct
 {
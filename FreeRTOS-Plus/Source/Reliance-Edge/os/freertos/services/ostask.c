@@ -27,6 +27,7 @@
 */
 #include <FreeRTOS.h>
 #include <task.h>
+#include <semphr.h>
 
 #include <redfs.h>
 
@@ -64,5 +65,109 @@ uint32_t RedOsTaskId(void)
     return ulTaskPtr + 1U;
 }
 
+
+#if REDCONF_API_POSIX_FINE_LOCKING == 1
+
+/*  One binary semaphore per file system task slot, on which a task sleeps
+    while it waits for a lock held by another task.
+*/
+static SemaphoreHandle_t axTaskWait[REDCONF_TASK_COUNT];
+
+
+/** @brief Initialize the task wait objects.
+
+    After initialization, no task has a pending wake-up.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0               Operation was successful.
+    @retval -RED_ENOMEM     Insufficient memory to create the wait objects.
+*/
+REDSTATUS RedOsTaskWaitInit(void)
+{
+    uint32_t    ulIdx;
+    REDSTATUS   ret = 0;
+
+    for(ulIdx = 0U; ulIdx < REDCONF_TASK_COUNT; ulIdx++)
+    {
+        axTaskWait[ulIdx] = xSemaphoreCreateBinary();
+        if(axTaskWait[ulIdx] == NULL)
+        {
+            ret = -RED_ENOMEM;
+            break;
+        }
+    }
+
+    if(ret != 0)
+    {
+        (void)RedOsTaskWaitUninit();
+    }
+
+    return ret;
+}
+
+
+/** @brief Uninitialize the task wait objects.
+
+    The behavior of calling this function while a task is waiting is
+    undefined.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0   Operation was successful.
+*/
+REDSTATUS RedOsTaskWaitUninit(void)
+{
+    uint32_t ulIdx;
+
+    for(ulIdx = 0U; ulIdx < REDCONF_TASK_COUNT; ulIdx++)
+    {
+        if(axTaskWait[ulIdx] != NULL)
+        {
+            vSemaphoreDelete(axTaskWait[ulIdx]);
+            axTaskWait[ulIdx] = NULL;
+        }
+    }
+
+    return 0;
+}
+
+
+/** @brief Block the calling task until it is woken by RedOsTaskWake().
+
+    If the task was woken before it started waiting, this function returns
+    immediately.
+
+    @param ulTaskIdx    The task slot index of the calling task.
+*/
+void RedOsTaskWait(
+    uint32_t    ulTaskIdx)
+{
+    REDASSERT(ulTaskIdx < REDCONF_TASK_COUNT);
+
+    while(xSemaphoreTake(axTaskWait[ulTaskIdx], portMAX_DELAY) != pdTRUE)
+    {
+    }
+}
+
+
+/** @brief Wake a task which is waiting, or is about to wait, in
+           RedOsTaskWait().
+
+    @param ulTaskIdx    The task slot index of the task to wake.
+*/
+void RedOsTaskWake(
+    uint32_t    ulTaskIdx)
+{
+    REDASSERT(ulTaskIdx < REDCONF_TASK_COUNT);
+
+    /*  A binary semaphore remembers at most one wake-up, which is all that is
+        needed: the woken task always rechecks the condition it waited for.
+    */
+    (void)xSemaphoreGive(axTaskWait[ulTaskIdx]);
+}
+
+#endif /* REDCONF_API_POSIX_FINE_LOCKING == 1 */
+
 #endif
 
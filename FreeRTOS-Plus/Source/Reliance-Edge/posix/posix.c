@@ -114,6 +114,50 @@ typedef struct
 } TASKSLOT;
 #endif
 
+/*-------------------------------------------------------------------
+    Locks
+-------------------------------------------------------------------*/
+
+#if REDCONF_API_POSIX_FINE_LOCKING == 1
+/*  With fine-grained locking, operations on open file descriptors which do not
+    change the namespace (reads, writes, seeks, truncates, stats, and directory
+    reads) hold the volume lock shared, plus a lock on the file they operate on.
+    Everything else holds the volume lock exclusively.  The core is not
+    reentrant, so core calls are additionally serialized by the core lock,
+    which reads and writes hold for at most POSIX_IO_CHUNK_SIZE bytes at a
+    time.  That way a large transfer on one file only delays operations on
+    other files by one chunk.
+
+    Locks are always acquired in the order volume lock, file lock, core lock.
+    The state of all locks is protected by the FS mutex, which is never held
+    while waiting.
+*/
+
+/*  Largest number of bytes read or written while holding the core lock.  Must
+    be a power of two multiple of the block size.
+*/
+#define POSIX_IO_CHUNK_SIZE (REDCONF_BLOCK_SIZE * 16U)
+
+/*  @brief Reader/writer lock.
+*/
+typedef struct
+{
+    uint32_t    ulReaders;          /**< Number of tasks holding the lock shared. */
+    uint32_t    ulWritersWaiting;   /**< Number of tasks waiting to hold the lock exclusively. */
+    bool        fWriter;            /**< Whether a task holds the lock exclusively. */
+} RWLOCK;
+
+/*  @brief Lock which serializes the operations on one file or directory.
+*/
+typedef struct
+{
+    uint32_t    ulInode;    /**< Inode which is locked. */
+    uint8_t     bVolNum;    /**< Volume containing the inode. */
+    uint32_t    ulUsers;    /**< Tasks holding or waiting for the lock; 0 if free. */
+    RWLOCK      lock;       /**< The lock; only ever held exclusively. */
+} FILELOCK;
+#endif
+
 /*-------------------------------------------------------------------
     Local Prototypes
 -------------------------------------------------------------------*/
@@ -131,6 +175,20 @@ static bool DirStreamIsValid(const REDDIR *pDirStream);
 #endif
 static REDSTATUS PosixEnter(void);
 static void PosixLeave(void);
+static void PosixUnlock(void);
+static REDSTATUS PosixEnterShared(uint32_t *pulTaskIdx);
+static void PosixLeaveShared(void);
+static void PosixFileLock(const REDHANDLE *pHandle, uint32_t ulTaskIdx);
+static void PosixFileUnlock(const REDHANDLE *pHandle);
+static REDSTATUS PosixCoreEnter(uint32_t ulTaskIdx, uint8_t bVolNum);
+static void PosixCoreLeave(void);
+static uint32_t IoChunkLength(uint64_t ullOffset, uint32_t ulRemaining);
+#if REDCONF_API_POSIX_FINE_LOCKING == 1
+static void RwLockAcquire(RWLOCK *pLock, bool fExclusive, uint32_t ulTaskIdx);
+static void RwLockRelease(RWLOCK *pLock);
+static bool RwLockIsAvailable(const RWLOCK *pLock, bool fExclusive, bool fQueued);
+static FILELOCK *FileLockFind(uint8_t bVolNum, uint32_t ulInode, bool fAllocate);
+#endif
 static REDSTATUS ModeTypeCheck(uint16_t uMode, FTYPE expectedType);
 #if (REDCONF_READ_ONLY == 0) && ((REDCONF_API_POSIX_UNLINK == 1) || (REDCONF_API_POSIX_RMDIR == 1) || ((REDCONF_API_POSIX_RENAME == 1) && (REDCONF_RENAME_ATOMIC == 1)))
 static REDSTATUS InodeUnlinkCheck(uint32_t ulInode);
@@ -149,6 +207,12 @@ static REDHANDLE gaHandle[REDCONF_HANDLE_COUNT];        /* Array of all handles.
 #if REDCONF_TASK_COUNT > 1U
 static TASKSLOT gaTask[REDCONF_TASK_COUNT];             /* Array of task slots. */
 #endif
+#if REDCONF_API_POSIX_FINE_LOCKING == 1
+static RWLOCK gVolumeLock;                              /* Shared by file data operations. */
+static RWLOCK gCoreLock;                                /* Serializes core calls. */
+static FILELOCK gaFileLock[REDCONF_TASK_COUNT];         /* At most one per task. */
+static bool gafTaskWaiting[REDCONF_TASK_COUNT];         /* Which task slots are waiting for a lock. */
+#endif
 
 /*  Array of volume mount "generations".  These are incremented for a volume
     each time that volume is mounted.  The generation number (along with the
@@ -192,6 +256,18 @@ int32_t red_init(void)
     else
     {
         ret = RedCoreInit();
+
+      #if REDCONF_API_POSIX_FINE_LOCKING == 1
+        if(ret == 0)
+        {
+            ret = RedOsTaskWaitInit();
+            if(ret != 0)
+            {
+                (void)RedCoreUninit();
+            }
+        }
+      #endif
+
         if(ret == 0)
         {
             RedMemSet(gaHandle, 0U, sizeof(gaHandle));
@@ -200,6 +276,13 @@ int32_t red_init(void)
             RedMemSet(gaTask, 0U, sizeof(gaTask));
           #endif
 
+          #if REDCONF_API_POSIX_FINE_LOCKING == 1
+            RedMemSet(&gVolumeLock, 0U, sizeof(gVolumeLock));
+            RedMemSet(&gCoreLock, 0U, sizeof(gCoreLock));
+            RedMemSet(gaFileLock, 0U, sizeof(gaFileLock));
+            RedMemSet(gafTaskWaiting, 0U, sizeof(gafTaskWaiting));
+          #endif
+
             gfPosixInited = true;
         }
     }
@@ -263,11 +346,16 @@ int32_t red_uninit(void)
 
                 Don't use PosixLeave(), since it asserts gfPosixInited is true.
             */
-          #if REDCONF_TASK_COUNT > 1U
-            RedOsMutexRelease();
-          #endif
+            PosixUnlock();
         }
 
+      #if REDCONF_API_POSIX_FINE_LOCKING == 1
+        if(ret == 0)
+        {
+            ret = RedOsTaskWaitUninit();
+        }
+      #endif
+
         if(ret == 0)
         {
             ret = RedCoreUninit();
@@ -1366,6 +1454,7 @@ int32_t red_read(
     uint32_t    ulLength)
 {
     uint32_t    ulLenRead = 0U;
+    uint32_t    ulTaskIdx;
     REDSTATUS   ret;
     int32_t     iReturn;
 
@@ -1375,7 +1464,7 @@ int32_t red_read(
     }
     else
     {
-        ret = PosixEnter();
+        ret = PosixEnterShared(&ulTaskIdx);
     }
 
     if(ret == 0)
@@ -1389,27 +1478,43 @@ int32_t red_read(
             ret = -RED_EBADF;
         }
 
-      #if REDCONF_VOLUME_COUNT > 1U
         if(ret == 0)
         {
-            ret = RedCoreVolSetCurrent(pHandle->bVolNum);
-        }
-      #endif
+            uint8_t    *pbBuffer = CAST_VOID_PTR_TO_UINT8_PTR(pBuffer);
+            uint32_t    ulChunkLen;
+            uint32_t    ulChunkRead;
 
-        if(ret == 0)
-        {
-            ulLenRead = ulLength;
-            ret = RedCoreFileRead(pHandle->ulInode, pHandle->ullOffset, &ulLenRead, pBuffer);
-        }
+            PosixFileLock(pHandle, ulTaskIdx);
 
-        if(ret == 0)
-        {
-            REDASSERT(ulLenRead <= ulLength);
+            /*  Read in chunks, giving other tasks a chance to use the core in
+                between.  Without fine-grained locking, there is one chunk.
+                Stop at the end-of-file, indicated by a short read.
+            */
+            do
+            {
+                ulChunkLen = IoChunkLength(pHandle->ullOffset, ulLength - ulLenRead);
+                ulChunkRead = ulChunkLen;
+
+                ret = PosixCoreEnter(ulTaskIdx, pHandle->bVolNum);
+                if(ret == 0)
+                {
+                    ret = RedCoreFileRead(pHandle->ulInode, pHandle->ullOffset, &ulChunkRead, (pbBuffer == NULL) ? NULL : &pbBuffer[ulLenRead]);
+                }
+                PosixCoreLeave();
 
-            pHandle->ullOffset += ulLenRead;
+                if(ret == 0)
+                {
+                    REDASSERT(ulChunkRead <= ulChunkLen);
+
+                    pHandle->ullOffset += ulChunkRead;
+                    ulLenRead += ulChunkRead;
+                }
+            } while((ret == 0) && (ulChunkRead == ulChunkLen) && (ulLenRead < ulLength));
+
+            PosixFileUnlock(pHandle);
         }
 
-        PosixLeave();
+        PosixLeaveShared();
     }
 
     if(ret == 0)
@@ -1472,6 +1577,7 @@ int32_t red_write(
     uint32_t    ulLength)
 {
     uint32_t    ulLenWrote = 0U;
+    uint32_t    ulTaskIdx;
     REDSTATUS   ret;
     int32_t     iReturn;
 
@@ -1481,7 +1587,7 @@ int32_t red_write(
     }
     else
     {
-        ret = PosixEnter();
+        ret = PosixEnterShared(&ulTaskIdx);
     }
 
     if(ret == 0)
@@ -1505,38 +1611,89 @@ int32_t red_write(
             ret = -RED_EBADF;
         }
 
-      #if REDCONF_VOLUME_COUNT > 1U
         if(ret == 0)
         {
-            ret = RedCoreVolSetCurrent(pHandle->bVolNum);
-        }
-      #endif
+            const uint8_t  *pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR(pBuffer);
+            bool            fChunked = true;
+            uint32_t        ulChunkLen;
+            uint32_t        ulChunkWrote;
 
-        if((ret == 0) && ((pHandle->bFlags & HFLAG_APPENDING) != 0U))
-        {
-            REDSTAT s;
+            PosixFileLock(pHandle, ulTaskIdx);
+
+            ret = PosixCoreEnter(ulTaskIdx, pHandle->bVolNum);
+
+            if((ret == 0) && ((pHandle->bFlags & HFLAG_APPENDING) != 0U))
+            {
+                REDSTAT s;
+
+                ret = RedCoreStat(pHandle->ulInode, &s);
+                if(ret == 0)
+                {
+                    pHandle->ullOffset = s.st_size;
+                }
+            }
 
-            ret = RedCoreStat(pHandle->ulInode, &s);
+          #if REDCONF_API_POSIX_FINE_LOCKING == 1
             if(ret == 0)
             {
-                pHandle->ullOffset = s.st_size;
+                uint32_t ulTransMask;
+
+                /*  If every write is a transaction point, a chunked write
+                    would be several transactions; write it all at once.
+                */
+                ret = RedCoreTransMaskGet(&ulTransMask);
+                fChunked = (ulTransMask & RED_TRANSACT_WRITE) == 0U;
             }
-        }
+          #endif
 
-        if(ret == 0)
-        {
-            ulLenWrote = ulLength;
-            ret = RedCoreFileWrite(pHandle->ulInode, pHandle->ullOffset, &ulLenWrote, pBuffer);
-        }
+            PosixCoreLeave();
 
-        if(ret == 0)
-        {
-            REDASSERT(ulLenWrote <= ulLength);
+            /*  Write in chunks, giving other tasks a chance to use the core in
+                between.  Without fine-grained locking, there is one chunk.
+                Stop if the disk or the file is full, indicated by a short
+                write.
+            */
+            if(ret == 0)
+            {
+                do
+                {
+                    ulChunkLen = fChunked ? IoChunkLength(pHandle->ullOffset, ulLength - ulLenWrote) : (ulLength - ulLenWrote);
+                    ulChunkWrote = ulChunkLen;
+
+                    ret = PosixCoreEnter(ulTaskIdx, pHandle->bVolNum);
+                    if(ret == 0)
+                    {
+                        ret = RedCoreFileWrite(pHandle->ulInode, pHandle->ullOffset, &ulChunkWrote, (pbBuffer == NULL) ? NULL : &pbBuffer[ulLenWrote]);
+                    }
+                    PosixCoreLeave();
+
+                    if(ret == 0)
+                    {
+                        REDASSERT(ulChunkWrote <= ulChunkLen);
 
-            pHandle->ullOffset += ulLenWrote;
+                        pHandle->ullOffset += ulChunkWrote;
+                        ulLenWrote += ulChunkWrote;
+                    }
+                    else if((ulLenWrote > 0U) && ((ret == -RED_ENOSPC) || (ret == -RED_EFBIG)))
+                    {
+                        /*  Earlier chunks were written, so this is a short
+                            write rather than an error.
+                        */
+                        ulChunkWrote = 0U;
+                        ret = 0;
+                    }
+                    else
+                    {
+                        /*  Nothing was written, or a critical error occurred.
+                        */
+                    }
+                } while((ret == 0) && (ulChunkWrote == ulChunkLen) && (ulLenWrote < ulLength));
+            }
+
+            PosixFileUnlock(pHandle);
         }
 
-        PosixLeave();
+        PosixLeaveShared();
     }
 
     if(ret == 0)
@@ -1670,25 +1827,26 @@ int64_t red_lseek(
     int64_t     llOffset,
     REDWHENCE   whence)
 {
+    uint32_t    ulTaskIdx;
     REDSTATUS   ret;
     int64_t     llReturn = -1;  /* Init'd to quiet warnings. */
 
-    ret = PosixEnter();
+    ret = PosixEnterShared(&ulTaskIdx);
     if(ret == 0)
     {
         int64_t     llFrom = 0; /* Init'd to quiet warnings. */
-        REDHANDLE  *pHandle;
+        REDHANDLE  *pHandle = NULL;
 
         /*  Unlike POSIX, we disallow lseek() on directory handles.
         */
         ret = FildesToHandle(iFildes, FTYPE_FILE, &pHandle);
 
-      #if REDCONF_VOLUME_COUNT > 1U
         if(ret == 0)
         {
-            ret = RedCoreVolSetCurrent(pHandle->bVolNum);
+            PosixFileLock(pHandle, ulTaskIdx);
+
+            ret = PosixCoreEnter(ulTaskIdx, pHandle->bVolNum);
         }
-      #endif
 
         if(ret == 0)
         {
@@ -1759,7 +1917,13 @@ int64_t red_lseek(
             }
         }
 
-        PosixLeave();
+        if(pHandle != NULL)
+        {
+            PosixCoreLeave();
+            PosixFileUnlock(pHandle);
+        }
+
+        PosixLeaveShared();
     }
 
     if(ret != 0)
@@ -1808,9 +1972,10 @@ int32_t red_ftruncate(
     int32_t     iFildes,
     uint64_t    ullSize)
 {
+    uint32_t    ulTaskIdx;
     REDSTATUS   ret;
 
-    ret = PosixEnter();
+    ret = PosixEnterShared(&ulTaskIdx);
     if(ret == 0)
     {
         REDHANDLE *pHandle;
@@ -1829,19 +1994,21 @@ int32_t red_ftruncate(
             ret = -RED_EBADF;
         }
 
-      #if REDCONF_VOLUME_COUNT > 1U
         if(ret == 0)
         {
-            ret = RedCoreVolSetCurrent(pHandle->bVolNum);
-        }
-      #endif
+            PosixFileLock(pHandle, ulTaskIdx);
 
-        if(ret == 0)
-        {
-            ret = RedCoreFileTruncate(pHandle->ulInode, ullSize);
+            ret = PosixCoreEnter(ulTaskIdx, pHandle->bVolNum);
+            if(ret == 0)
+            {
+                ret = RedCoreFileTruncate(pHandle->ulInode, ullSize);
+            }
+            PosixCoreLeave();
+
+            PosixFileUnlock(pHandle);
         }
 
-        PosixLeave();
+        PosixLeaveShared();
     }
 
     return PosixReturn(ret);
@@ -1870,28 +2037,27 @@ int32_t red_fstat(
     int32_t     iFildes,
     REDSTAT    *pStat)
 {
+    uint32_t    ulTaskIdx;
     REDSTATUS   ret;
 
-    ret = PosixEnter();
+    ret = PosixEnterShared(&ulTaskIdx);
     if(ret == 0)
     {
         REDHANDLE *pHandle;
 
         ret = FildesToHandle(iFildes, FTYPE_EITHER, &pHandle);
 
-      #if REDCONF_VOLUME_COUNT > 1U
         if(ret == 0)
         {
-            ret = RedCoreVolSetCurrent(pHandle->bVolNum);
-        }
-      #endif
-
-        if(ret == 0)
-        {
-            ret = RedCoreStat(pHandle->ulInode, pStat);
+            ret = PosixCoreEnter(ulTaskIdx, pHandle->bVolNum);
+            if(ret == 0)
+            {
+                ret = RedCoreStat(pHandle->ulInode, pStat);
+            }
+            PosixCoreLeave();
         }
 
-        PosixLeave();
+        PosixLeaveShared();
     }
 
     return PosixReturn(ret);
@@ -1983,22 +2149,25 @@ REDDIR *red_opendir(
 REDDIRENT *red_readdir(
     REDDIR     *pDirStream)
 {
+    uint32_t    ulTaskIdx;
     REDSTATUS   ret;
     REDDIRENT  *pDirEnt = NULL;
 
-    ret = PosixEnter();
+    ret = PosixEnterShared(&ulTaskIdx);
     if(ret == 0)
     {
-        if(!DirStreamIsValid(pDirStream))
+        bool fValid = DirStreamIsValid(pDirStream);
+
+        if(fValid)
         {
-            ret = -RED_EBADF;
+            PosixFileLock(pDirStream, ulTaskIdx);
+
+            ret = PosixCoreEnter(ulTaskIdx, pDirStream->bVolNum);
         }
-      #if REDCONF_VOLUME_COUNT > 1U
         else
         {
-            ret = RedCoreVolSetCurrent(pDirStream->bVolNum);
+            ret = -RED_EBADF;
         }
-      #endif
 
         if(ret == 0)
         {
@@ -2039,7 +2208,13 @@ REDDIRENT *red_readdir(
             }
         }
 
-        PosixLeave();
+        if(fValid)
+        {
+            PosixCoreLeave();
+            PosixFileUnlock(pDirStream);
+        }
+
+        PosixLeaveShared();
     }
 
     if(ret != 0)
@@ -2067,14 +2242,18 @@ REDDIRENT *red_readdir(
 void red_rewinddir(
     REDDIR *pDirStream)
 {
-    if(PosixEnter() == 0)
+    uint32_t ulTaskIdx;
+
+    if(PosixEnterShared(&ulTaskIdx) == 0)
     {
         if(DirStreamIsValid(pDirStream))
         {
+            PosixFileLock(pDirStream, ulTaskIdx);
             pDirStream->ullOffset = 0U;
+            PosixFileUnlock(pDirStream);
         }
 
-        PosixLeave();
+        PosixLeaveShared();
     }
 }
 
@@ -2843,7 +3022,20 @@ static REDSTATUS PosixEnter(void)
 
     if(gfPosixInited)
     {
-      #if REDCONF_TASK_COUNT > 1U
+      #if REDCONF_API_POSIX_FINE_LOCKING == 1
+        uint32_t ulTaskIdx;
+
+        RedOsMutexAcquire();
+
+        ret = TaskRegister(&ulTaskIdx);
+        if(ret == 0)
+        {
+            RwLockAcquire(&gVolumeLock, true, ulTaskIdx);
+            RwLockAcquire(&gCoreLock, true, ulTaskIdx);
+        }
+
+        RedOsMutexRelease();
+      #elif REDCONF_TASK_COUNT > 1U
         RedOsMutexAcquire();
 
         ret = TaskRegister(NULL);
@@ -2873,12 +3065,396 @@ static void PosixLeave(void)
     */
     REDASSERT(gfPosixInited);
 
-  #if REDCONF_TASK_COUNT > 1U
+    PosixUnlock();
+}
+
+
+/** @brief Release the locks acquired by PosixEnter().
+*/
+static void PosixUnlock(void)
+{
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    RedOsMutexAcquire();
+    RwLockRelease(&gCoreLock);
+    RwLockRelease(&gVolumeLock);
+    RedOsMutexRelease();
+  #elif REDCONF_TASK_COUNT > 1U
+    RedOsMutexRelease();
+  #endif
+}
+
+
+/** @brief Enter the file system driver to operate on an open file descriptor,
+           without changing the namespace or the handle table.
+
+    Unlike PosixEnter(), this does not give the caller access to the core: each
+    core call must be bracketed by PosixCoreEnter() and PosixCoreLeave().  With
+    fine-grained locking, any number of tasks may be in the driver this way at
+    once; otherwise, this is equivalent to PosixEnter().
+
+    @param pulTaskIdx   Populated with the task slot index of the caller, to be
+                        passed to the other locking functions.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EINVAL The file system driver is uninitialized.
+    @retval -RED_EUSERS Cannot become a file system user: too many users.
+*/
+static REDSTATUS PosixEnterShared(
+    uint32_t   *pulTaskIdx)
+{
+    REDSTATUS   ret;
+
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    if(gfPosixInited)
+    {
+        RedOsMutexAcquire();
+
+        ret = TaskRegister(pulTaskIdx);
+        if(ret == 0)
+        {
+            RwLockAcquire(&gVolumeLock, false, *pulTaskIdx);
+        }
+
+        RedOsMutexRelease();
+    }
+    else
+    {
+        ret = -RED_EINVAL;
+    }
+  #else
+    *pulTaskIdx = 0U;
+    ret = PosixEnter();
+  #endif
+
+    return ret;
+}
+
+
+/** @brief Leave the file system driver after PosixEnterShared().
+*/
+static void PosixLeaveShared(void)
+{
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    REDASSERT(gfPosixInited);
+
+    RedOsMutexAcquire();
+    RwLockRelease(&gVolumeLock);
+    RedOsMutexRelease();
+  #else
+    PosixLeave();
+  #endif
+}
+
+
+/** @brief Lock the file or directory referred to by a handle.
+
+    Serializes the operations on one file or directory, including those made
+    through different handles.  The caller must have entered the driver with
+    PosixEnterShared().
+
+    @param pHandle      The handle whose inode is to be locked.
+    @param ulTaskIdx    The task slot index from PosixEnterShared().
+*/
+static void PosixFileLock(
+    const REDHANDLE    *pHandle,
+    uint32_t            ulTaskIdx)
+{
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    FILELOCK           *pFileLock;
+
+    RedOsMutexAcquire();
+
+    pFileLock = FileLockFind(pHandle->bVolNum, pHandle->ulInode, true);
+    pFileLock->ulUsers++;
+    RwLockAcquire(&pFileLock->lock, true, ulTaskIdx);
+
+    RedOsMutexRelease();
+  #else
+    (void)pHandle;
+    (void)ulTaskIdx;
+  #endif
+}
+
+
+/** @brief Unlock the file or directory locked by PosixFileLock().
+
+    @param pHandle  The handle which was passed to PosixFileLock().
+*/
+static void PosixFileUnlock(
+    const REDHANDLE    *pHandle)
+{
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    FILELOCK           *pFileLock;
+
+    RedOsMutexAcquire();
+
+    pFileLock = FileLockFind(pHandle->bVolNum, pHandle->ulInode, false);
+    REDASSERT((pFileLock != NULL) && (pFileLock->ulUsers > 0U));
+    RwLockRelease(&pFileLock->lock);
+    pFileLock->ulUsers--;
+
+    RedOsMutexRelease();
+  #else
+    (void)pHandle;
+  #endif
+}
+
+
+/** @brief Acquire exclusive access to the core.
+
+    Even if an error is returned, PosixCoreLeave() must be called.
+
+    @param ulTaskIdx    The task slot index from PosixEnterShared().
+    @param bVolNum      The volume to make current.
+
+    @return A negated ::REDSTATUS code indicating the operation result.
+
+    @retval 0           Operation was successful.
+    @retval -RED_EINVAL @p bVolNum is an invalid volume number.
+*/
+static REDSTATUS PosixCoreEnter(
+    uint32_t    ulTaskIdx,
+    uint8_t     bVolNum)
+{
+    REDSTATUS   ret;
+
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    RedOsMutexAcquire();
+    RwLockAcquire(&gCoreLock, true, ulTaskIdx);
+    RedOsMutexRelease();
+  #else
+    (void)ulTaskIdx;
+  #endif
+
+  #if REDCONF_VOLUME_COUNT > 1U
+    ret = RedCoreVolSetCurrent(bVolNum);
+  #else
+    (void)bVolNum;
+    ret = 0;
+  #endif
+
+    return ret;
+}
+
+
+/** @brief Release the access to the core acquired by PosixCoreEnter().
+*/
+static void PosixCoreLeave(void)
+{
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    RedOsMutexAcquire();
+    RwLockRelease(&gCoreLock);
     RedOsMutexRelease();
   #endif
 }
 
 
+/** @brief Determine how much of a read or write to do in one core call.
+
+    @param ullOffset    The file offset at which the next core call will start.
+    @param ulRemaining  The number of bytes remaining to be transferred.
+
+    @return The number of bytes to transfer in the next core call.  With
+            fine-grained locking, this ends at a chunk boundary so that
+            subsequent core calls are block aligned.
+*/
+static uint32_t IoChunkLength(
+    uint64_t    ullOffset,
+    uint32_t    ulRemaining)
+{
+    uint32_t    ulLen;
+
+  #if REDCONF_API_POSIX_FINE_LOCKING == 1
+    ulLen = POSIX_IO_CHUNK_SIZE - ((uint32_t)ullOffset & (POSIX_IO_CHUNK_SIZE - 1U));
+    ulLen = REDMIN(ulLen, ulRemaining);
+  #else
+    (void)ullOffset;
+    ulLen = ulRemaining;
+  #endif
+
+    return ulLen;
+}
+
+
+#if REDCONF_API_POSIX_FINE_LOCKING == 1
+/** @brief Acquire a reader/writer lock.
+
+    The caller must hold the FS mutex, which is released while waiting.
+
+    @param pLock        The lock to acquire.
+    @param fExclusive   Whether to acquire the lock exclusively (for writing)
+                        rather than shared (for reading).
+    @param ulTaskIdx    The task slot index of the caller.
+*/
+static void RwLockAcquire(
+    RWLOCK     *pLock,
+    bool        fExclusive,
+    uint32_t    ulTaskIdx)
+{
+    bool        fQueued = false;
+
+    while(!RwLockIsAvailable(pLock, fExclusive, fQueued))
+    {
+        if(fExclusive && !fQueued)
+        {
+            pLock->ulWritersWaiting++;
+            fQueued = true;
+        }
+
+        gafTaskWaiting[ulTaskIdx] = true;
+
+        RedOsMutexRelease();
+        RedOsTaskWait(ulTaskIdx);
+        RedOsMutexAcquire();
+    }
+
+    if(fQueued)
+    {
+        pLock->ulWritersWaiting--;
+    }
+
+    if(fExclusive)
+    {
+        pLock->fWriter = true;
+    }
+    else
+    {
+        pLock->ulReaders++;
+    }
+}
+
+
+/** @brief Release a reader/writer lock.
+
+    The caller must hold the FS mutex.  All waiting tasks are woken to recheck
+    the lock they are waiting for.
+
+    @param pLock    The lock to release.
+*/
+static void RwLockRelease(
+    RWLOCK     *pLock)
+{
+    uint32_t    ulIdx;
+
+    if(pLock->fWriter)
+    {
+        pLock->fWriter = false;
+    }
+    else
+    {
+        REDASSERT(pLock->ulReaders > 0U);
+        pLock->ulReaders--;
+    }
+
+    for(ulIdx = 0U; ulIdx < REDCONF_TASK_COUNT; ulIdx++)
+    {
+        if(gafTaskWaiting[ulIdx])
+        {
+            gafTaskWaiting[ulIdx] = false;
+            RedOsTaskWake(ulIdx);
+        }
+    }
+}
+
+
+/** @brief Determine whether a reader/writer lock can be acquired.
+
+    Tasks waiting for exclusive access take precedence over new requests of
+    either kind.  This keeps a stream of readers from starving a writer, and
+    it makes a task which releases the core lock between chunks queue behind
+    the tasks which were waiting for it.
+
+    @param pLock        The lock to examine.
+    @param fExclusive   Whether exclusive access is requested.
+    @param fQueued      Whether the requester is already counted as a waiting
+                        writer.
+
+    @return Whether the lock can be acquired.
+*/
+static bool RwLockIsAvailable(
+    const RWLOCK   *pLock,
+    bool            fExclusive,
+    bool            fQueued)
+{
+    bool            fAvailable;
+
+    if(pLock->fWriter)
+    {
+        fAvailable = false;
+    }
+    else if(fExclusive)
+    {
+        fAvailable = (pLock->ulReaders == 0U) && (fQueued || (pLock->ulWritersWaiting == 0U));
+    }
+    else
+    {
+        fAvailable = pLock->ulWritersWaiting == 0U;
+    }
+
+    return fAvailable;
+}
+
+
+/** @brief Find the lock for a file or directory.
+
+    The caller must hold the FS mutex.
+
+    @param bVolNum      The volume containing the inode.
+    @param ulInode      The inode whose lock is to be found.
+    @param fAllocate    Whether to allocate a free lock if no task is using a
+                        lock for the inode.  Since each task holds or waits for
+                        at most one file lock, allocation cannot fail.
+
+    @return Pointer to the file lock, or `NULL` if there is none and
+            @p fAllocate is false.
+*/
+static FILELOCK *FileLockFind(
+    uint8_t     bVolNum,
+    uint32_t    ulInode,
+    bool        fAllocate)
+{
+    FILELOCK   *pFree = NULL;
+    FILELOCK   *pFound = NULL;
+    uint32_t    ulIdx;
+
+    for(ulIdx = 0U; ulIdx < REDCONF_TASK_COUNT; ulIdx++)
+    {
+        if(gaFileLock[ulIdx].ulUsers == 0U)
+        {
+            if(pFree == NULL)
+            {
+                pFree = &gaFileLock[ulIdx];
+            }
+        }
+        else if((gaFileLock[ulIdx].ulInode == ulInode) && (gaFileLock[ulIdx].bVolNum == bVolNum))
+        {
+            pFound = &gaFileLock[ulIdx];
+            break;
+        }
+        else
+        {
+            /*  In use for another inode.
+            */
+        }
+    }
+
+    if((pFound == NULL) && fAllocate)
+    {
+        REDASSERT(pFree != NULL);
+
+        pFound = pFree;
+        pFound->ulInode = ulInode;
+        pFound->bVolNum = bVolNum;
+        REDASSERT(!pFound->lock.fWriter && (pFound->lock.ulWritersWaiting == 0U));
+    }
+
+    return pFound;
+}
+#endif /* REDCONF_API_POSIX_FINE_LOCKING == 1 */
+
+
 /** @brief Check that a mode is consistent with the given expected type.
 
     @param uMode        An inode mode, indicating whether the inode is a file
@@ -0,0 +1,284 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+
+                   Copyright (c) 2014-2015 Datalight, Inc.
+                       All Rights Reserved Worldwide.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; use version 2 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+/*  Businesses and individuals that for commercial or other reasons cannot
+    comply with the terms of the GPLv2 license may obtain a commercial license
+    before incorporating Reliance Edge into proprietary software for
+    distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+    more information.
+*/
+/** @file
+    @brief CRC-32 microbenchmark.
+
+    Compares the throughput of the four CRC-32 algorithms which can be selected
+    with REDCONF_CRC_ALGORITHM, at buffer sizes from 16 bytes to several
+    blocks, and checks that they all compute the same CRCs.  Since only one
+    algorithm is normally built, this file builds all of them by including
+    util/crc.c once per algorithm, with the public functions renamed.
+*/
+#include <redfs.h>
+#include <redtests.h>
+
+#if CRCBENCH_SUPPORTED
+
+#include <redosserv.h>
+#include <redutils.h>
+
+
+#undef REDCONF_CRC_ALGORITHM
+#define REDCONF_CRC_ALGORITHM   0U
+#define RedCrc32Update          CrcBenchBitwise
+#define RedCrcNode              CrcBenchNodeBitwise
+#include "../../util/crc.c"
+#undef REDCONF_CRC_ALGORITHM
+#undef RedCrc32Update
+#undef RedCrcNode
+
+#define REDCONF_CRC_ALGORITHM   1U
+#define RedCrc32Update          CrcBenchSarwate
+#define RedCrcNode              CrcBenchNodeSarwate
+#include "../../util/crc.c"
+#undef REDCONF_CRC_ALGORITHM
+#undef RedCrc32Update
+#undef RedCrcNode
+
+#define REDCONF_CRC_ALGORITHM   2U
+#define RedCrc32Update          CrcBenchSliceBy8
+#define RedCrcNode              CrcBenchNodeSliceBy8
+#include "../../util/crc.c"
+#undef REDCONF_CRC_ALGORITHM
+#undef RedCrc32Update
+#undef RedCrcNode
+#undef CLMUL_ARCH
+
+#define REDCONF_CRC_ALGORITHM   3U
+#define RedCrc32Update          CrcBenchClmul
+#define RedCrcNode              CrcBenchNodeClmul
+#include "../../util/crc.c"
+#undef RedCrc32Update
+#undef RedCrcNode
+
+
+/*  The largest buffer which is checksummed.
+*/
+#define CRCBENCH_MAX_SIZE   (REDCONF_BLOCK_SIZE * 8U)
+
+/*  Buffers are offset by up to this many bytes, to check unaligned buffers.
+*/
+#define CRCBENCH_MAX_OFFSET (8U)
+
+#define CRCBENCH_ALGORITHMS (4U)
+
+
+typedef uint32_t (*CRCFUNC)(uint32_t ulInitCrc32, const void *pBuffer, uint32_t ulLength);
+typedef uint32_t (*NODECRCFUNC)(const void *pBuffer);
+
+
+typedef struct
+{
+    const char *pszName;
+    CRCFUNC     pfnCrc;
+} CRCALGORITHM;
+
+
+static int CrcBenchVerify(uint32_t *pulSeed);
+static uint64_t CrcBenchTime(CRCFUNC pfnCrc, uint32_t ulSize, uint32_t ulBytes);
+
+
+static const CRCALGORITHM gaAlgorithm[CRCBENCH_ALGORITHMS] =
+{
+    { "bitwise", CrcBenchBitwise },
+    { "sarwate", CrcBenchSarwate },
+    { "sliceby8", CrcBenchSliceBy8 },
+    { "clmul", CrcBenchClmul }
+};
+
+static uint8_t gabBuffer[CRCBENCH_MAX_SIZE + CRCBENCH_MAX_OFFSET];
+
+
+/** @brief Populate a CRCBENCHPARAM structure with its default values.
+
+    @param pParam   The structure to populate.
+*/
+void CrcBenchDefaultParams(
+    CRCBENCHPARAM  *pParam)
+{
+    RedMemSet(pParam, 0U, sizeof(*pParam));
+
+    pParam->ulBytes = 4U * 1024U * 1024U;
+}
+
+
+/** @brief Run the CRC-32 microbenchmark.
+
+    @param pParam   Benchmark parameters.
+
+    @return Zero if all of the algorithms computed the same CRCs, otherwise
+            nonzero.
+*/
+int CrcBenchStart(
+    const CRCBENCHPARAM    *pParam)
+{
+    uint32_t                ulSeed = (pParam->ulSeed == 0U) ? RedOsClockGetTime() : pParam->ulSeed;
+    uint32_t                ulIdx;
+    int                     iRet;
+
+    RedPrintf("crcbench: seed %lu\n", (unsigned long)ulSeed);
+
+  #if CLMUL_ARCH != CLMUL_ARCH_NONE
+    RedPrintf("crcbench: carry-less multiply is %s\n", Crc32ClmulIsSupported() ? "supported" : "not supported; clmul uses sliceby8");
+  #else
+    RedPrintf("crcbench: carry-less multiply is not built for this target; clmul uses sliceby8\n");
+  #endif
+
+    for(ulIdx = 0U; ulIdx < sizeof(gabBuffer); ulIdx++)
+    {
+        gabBuffer[ulIdx] = (uint8_t)RedRand32(&ulSeed);
+    }
+
+    iRet = CrcBenchVerify(&ulSeed);
+
+    if(iRet == 0)
+    {
+        uint32_t ulSize;
+
+        RedPrintf("crcbench: KB/s by buffer size\n");
+        RedPrintf("%8s", "size");
+
+        for(ulIdx = 0U; ulIdx < CRCBENCH_ALGORITHMS; ulIdx++)
+        {
+            RedPrintf(" %10s", gaAlgorithm[ulIdx].pszName);
+        }
+
+        RedPrintf("\n");
+
+        for(ulSize = 16U; ulSize <= CRCBENCH_MAX_SIZE; ulSize *= 2U)
+        {
+            RedPrintf("%8lu", (unsigned long)ulSize);
+
+            for(ulIdx = 0U; ulIdx < CRCBENCH_ALGORITHMS; ulIdx++)
+            {
+                RedPrintf(" %10llu", (unsigned long long)CrcBenchTime(gaAlgorithm[ulIdx].pfnCrc, ulSize, pParam->ulBytes));
+            }
+
+            RedPrintf("\n");
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Check that every algorithm computes the same CRCs as the bitwise
+           algorithm.
+
+    Lengths which are not multiples of the word or fold sizes, unaligned
+    buffers, nonzero initial CRCs, and metadata nodes are all checked.
+
+    @param pulSeed  Random seed.
+
+    @return Zero if all of the CRCs matched, otherwise nonzero.
+*/
+static int CrcBenchVerify(
+    uint32_t   *pulSeed)
+{
+    static const NODECRCFUNC apfnNode[CRCBENCH_ALGORITHMS] =
+    {
+        CrcBenchNodeBitwise, CrcBenchNodeSarwate, CrcBenchNodeSliceBy8, CrcBenchNodeClmul
+    };
+    uint32_t    ulOffset;
+    uint32_t    ulLen;
+    uint32_t    ulIdx;
+    int         iRet = 0;
+
+    for(ulOffset = 0U; (iRet == 0) && (ulOffset < CRCBENCH_MAX_OFFSET); ulOffset++)
+    {
+        for(ulLen = 0U; (iRet == 0) && (ulLen <= CRCBENCH_MAX_SIZE); ulLen += (ulLen < 512U) ? 1U : 61U)
+        {
+            uint32_t ulInitCrc = RedRand32(pulSeed);
+            uint32_t ulExpected = CrcBenchBitwise(ulInitCrc, &gabBuffer[ulOffset], ulLen);
+
+            for(ulIdx = 1U; ulIdx < CRCBENCH_ALGORITHMS; ulIdx++)
+            {
+                uint32_t ulCrc = gaAlgorithm[ulIdx].pfnCrc(ulInitCrc, &gabBuffer[ulOffset], ulLen);
+
+                if(ulCrc != ulExpected)
+                {
+                    RedPrintf("crcbench: %s CRC of %lu bytes at offset %lu is %08lx, expected %08lx\n",
+                        gaAlgorithm[ulIdx].pszName, (unsigned long)ulLen, (unsigned long)ulOffset,
+                        (unsigned long)ulCrc, (unsigned long)ulExpected);
+                    iRet = 1;
+                }
+            }
+        }
+    }
+
+    for(ulIdx = 1U; (iRet == 0) && (ulIdx < CRCBENCH_ALGORITHMS); ulIdx++)
+    {
+        if(apfnNode[ulIdx](gabBuffer) != CrcBenchNodeBitwise(gabBuffer))
+        {
+            RedPrintf("crcbench: %s node CRC does not match\n", gaAlgorithm[ulIdx].pszName);
+            iRet = 1;
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Measure the throughput of an algorithm at one buffer size.
+
+    @param pfnCrc   The CRC function.
+    @param ulSize   The size of each buffer.
+    @param ulBytes  The total number of bytes to checksum.
+
+    @return The throughput, in KB per second.
+*/
+static uint64_t CrcBenchTime(
+    CRCFUNC         pfnCrc,
+    uint32_t        ulSize,
+    uint32_t        ulBytes)
+{
+    uint32_t        ulCount = (ulBytes > ulSize) ? (ulBytes / ulSize) : 1U;
+    uint32_t        ulCrc = 0U;
+    uint32_t        ulIdx;
+    REDTIMESTAMP    ts;
+    uint64_t        ullUS;
+
+    ts = RedOsTimestamp();
+
+    for(ulIdx = 0U; ulIdx < ulCount; ulIdx++)
+    {
+        ulCrc = pfnCrc(ulCrc, gabBuffer, ulSize);
+    }
+
+    ullUS = RedOsTimePassed(ts);
+    if(ullUS == 0U)
+    {
+        ullUS = 1U;
+    }
+
+    /*  Keep the result live so that the loop is not optimized away.
+    */
+    gabBuffer[0U] ^= (uint8_t)(ulCrc & 1U);
+
+    return RedMulDiv64((uint64_t)ulCount * ulSize, 1000000U, ullUS * 1024U);
+}
+
+#endif /* CRCBENCH_SUPPORTED */
+
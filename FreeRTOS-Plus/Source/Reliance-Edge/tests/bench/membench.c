@@ -0,0 +1,375 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+
+                   Copyright (c) 2014-2015 Datalight, Inc.
+                       All Rights Reserved Worldwide.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; use version 2 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+/*  Businesses and individuals that for commercial or other reasons cannot
+    comply with the terms of the GPLv2 license may obtain a commercial license
+    before incorporating Reliance Edge into proprietary software for
+    distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+    more information.
+*/
+/** @file
+    @brief Memory function microbenchmark.
+
+    Compares the throughput of RedMemCpy(), RedMemSet(), and RedMemCmp(), as
+    configured by REDCONF_MEM_ALGORITHM, with the byte-at-a-time
+    implementations, for full blocks and for short unaligned buffers, and
+    checks that both compute the same results.  The byte-at-a-time
+    implementations are built into this file by including util/memory.c with
+    the public functions renamed.
+*/
+#include <redfs.h>
+#include <redtests.h>
+
+#if MEMBENCH_SUPPORTED
+
+#include <redosserv.h>
+#include <redutils.h>
+
+
+#define MEM_BYTEWISE    (0U)
+#define MEM_WORDWISE    (1U)
+#define MEM_UNROLLED    (2U)
+#define MEM_SIMD        (3U)
+
+#if REDCONF_MEM_ALGORITHM == MEM_WORDWISE
+#define MEMBENCH_ALGORITHM  "wordwise"
+#elif REDCONF_MEM_ALGORITHM == MEM_UNROLLED
+#define MEMBENCH_ALGORITHM  "unrolled"
+#elif REDCONF_MEM_ALGORITHM == MEM_SIMD
+#define MEMBENCH_ALGORITHM  "simd"
+#else
+#define MEMBENCH_ALGORITHM  "bytewise"
+#endif
+
+#undef REDCONF_MEM_ALGORITHM
+#define REDCONF_MEM_ALGORITHM   MEM_BYTEWISE
+#define RedMemCpy               MemBenchCpyBytewise
+#define RedMemMove              MemBenchMoveBytewise
+#define RedMemSet               MemBenchSetBytewise
+#define RedMemCmp               MemBenchCmpBytewise
+#include "../../util/memory.c"
+#undef RedMemCpy
+#undef RedMemMove
+#undef RedMemSet
+#undef RedMemCmp
+
+
+/*  Buffers are offset by up to this many bytes, to check unaligned buffers.
+*/
+#define MEMBENCH_MAX_OFFSET (8U)
+
+/*  Each case is timed this many times, and the best time is reported.
+*/
+#define MEMBENCH_RUNS       (3U)
+
+/*  The largest length which is checked byte by byte.
+*/
+#define MEMBENCH_CHECK_LEN  REDMIN(300U, REDCONF_BLOCK_SIZE)
+
+
+typedef enum
+{
+    MEMOP_CPY,
+    MEMOP_SET,
+    MEMOP_CMP
+} MEMOP;
+
+
+typedef struct
+{
+    void      (*pfnCpy)(void *pDest, const void *pSrc, uint32_t ulLen);
+    void      (*pfnSet)(void *pDest, uint8_t bVal, uint32_t ulLen);
+    int32_t   (*pfnCmp)(const void *pMem1, const void *pMem2, uint32_t ulLen);
+} MEMFUNCS;
+
+
+typedef struct
+{
+    const char *pszName;    /**< Description printed with the results. */
+    MEMOP       op;         /**< Operation to time. */
+    uint32_t    ulLen;      /**< Length of each operation. */
+    uint32_t    ulOffset1;  /**< Offset of the destination, or the first buffer. */
+    uint32_t    ulOffset2;  /**< Offset of the source, or the second buffer. */
+} MEMCASE;
+
+
+static int MemBenchVerify(uint32_t *pulSeed);
+static uint64_t MemBenchTime(const MEMCASE *pCase, bool fBytewise, uint32_t ulBytes);
+
+
+static const MEMCASE gaCase[] =
+{
+    { "copy block, aligned",      MEMOP_CPY, REDCONF_BLOCK_SIZE, 0U, 0U },
+    { "copy block, unaligned",    MEMOP_CPY, REDCONF_BLOCK_SIZE, 1U, 3U },
+    { "copy 13 bytes, unaligned", MEMOP_CPY, 13U,                1U, 2U },
+    { "copy 60 bytes, unaligned", MEMOP_CPY, 60U,                3U, 3U },
+    { "set block, aligned",       MEMOP_SET, REDCONF_BLOCK_SIZE, 0U, 0U },
+    { "set 13 bytes, unaligned",  MEMOP_SET, 13U,                1U, 0U },
+    { "cmp block, aligned",       MEMOP_CMP, REDCONF_BLOCK_SIZE, 0U, 0U },
+    { "cmp 13 bytes, unaligned",  MEMOP_CMP, 13U,                1U, 2U }
+};
+
+/*  The functions being timed.  Called through pointers which are set at run
+    time, so that neither set of functions is inlined into the timing loop.
+*/
+static MEMFUNCS gFuncs;
+
+static uint8_t gabBuffer1[REDCONF_BLOCK_SIZE + MEMBENCH_MAX_OFFSET];
+static uint8_t gabBuffer2[REDCONF_BLOCK_SIZE + MEMBENCH_MAX_OFFSET];
+static uint8_t gabBuffer3[REDCONF_BLOCK_SIZE + MEMBENCH_MAX_OFFSET];
+
+
+/** @brief Populate a MEMBENCHPARAM structure with its default values.
+
+    @param pParam   The structure to populate.
+*/
+void MemBenchDefaultParams(
+    MEMBENCHPARAM  *pParam)
+{
+    RedMemSet(pParam, 0U, sizeof(*pParam));
+
+    pParam->ulBytes = 16U * 1024U * 1024U;
+}
+
+
+/** @brief Run the memory function microbenchmark.
+
+    @param pParam   Benchmark parameters.
+
+    @return Zero if the configured and byte-at-a-time functions computed the
+            same results, otherwise nonzero.
+*/
+int MemBenchStart(
+    const MEMBENCHPARAM    *pParam)
+{
+    uint32_t                ulSeed = (pParam->ulSeed == 0U) ? RedOsClockGetTime() : pParam->ulSeed;
+    int                     iRet;
+
+    RedPrintf("membench: seed %lu, algorithm %s\n", (unsigned long)ulSeed, MEMBENCH_ALGORITHM);
+
+  #if defined(RedMemCpyUnchecked) || defined(RedMemSetUnchecked) || defined(RedMemCmpUnchecked)
+    RedPrintf("membench: redconf.h replaces some of the memory functions, which are used for both columns\n");
+  #endif
+
+    iRet = MemBenchVerify(&ulSeed);
+
+    if(iRet == 0)
+    {
+        uint32_t ulIdx;
+
+        RedPrintf("membench: KB/s\n");
+        RedPrintf("%-26s %10s %10s %8s\n", "", "bytewise", MEMBENCH_ALGORITHM, "speedup");
+
+        for(ulIdx = 0U; ulIdx < (sizeof(gaCase) / sizeof(gaCase[0U])); ulIdx++)
+        {
+            uint64_t    ullBytewise = MemBenchTime(&gaCase[ulIdx], true, pParam->ulBytes);
+            uint64_t    ullConfigured = MemBenchTime(&gaCase[ulIdx], false, pParam->ulBytes);
+            char        szRatio[16U];
+
+            RedPrintf("%-26s %10llu %10llu %8s\n", gaCase[ulIdx].pszName, (unsigned long long)ullBytewise,
+                (unsigned long long)ullConfigured, RedRatio(szRatio, sizeof(szRatio), ullConfigured, (ullBytewise == 0U) ? 1U : ullBytewise, 2U));
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Check that the configured functions compute the same results as
+           the byte-at-a-time functions.
+
+    Every length up to MEMBENCH_CHECK_LEN, and a full block, is checked at
+    every combination of buffer offsets.
+
+    @param pulSeed  Random seed.
+
+    @return Zero if all of the results matched, otherwise nonzero.
+*/
+static int MemBenchVerify(
+    uint32_t   *pulSeed)
+{
+    uint32_t    ulOffset1;
+    uint32_t    ulOffset2;
+    uint32_t    ulLen = 0U;
+    int         iRet = 0;
+
+    while((iRet == 0) && (ulLen <= REDCONF_BLOCK_SIZE))
+    {
+        for(ulOffset1 = 0U; (iRet == 0) && (ulOffset1 < MEMBENCH_MAX_OFFSET); ulOffset1++)
+        {
+            for(ulOffset2 = 0U; (iRet == 0) && (ulOffset2 < MEMBENCH_MAX_OFFSET); ulOffset2++)
+            {
+                uint32_t ulIdx;
+                uint8_t  bVal = (uint8_t)RedRand32(pulSeed);
+
+                for(ulIdx = 0U; ulIdx < sizeof(gabBuffer1); ulIdx++)
+                {
+                    gabBuffer1[ulIdx] = (uint8_t)RedRand32(pulSeed);
+                    gabBuffer2[ulIdx] = (uint8_t)RedRand32(pulSeed);
+                }
+
+                /*  Copy, then set part of the copy.  Both the copied and set
+                    bytes, and the bytes around them, must match.
+                */
+                MemBenchCpyBytewise(gabBuffer3, gabBuffer2, sizeof(gabBuffer3));
+                MemBenchCpyBytewise(&gabBuffer3[ulOffset1], &gabBuffer1[ulOffset2], ulLen);
+                MemBenchSetBytewise(&gabBuffer3[ulOffset2], bVal, ulLen / 2U);
+                RedMemCpy(&gabBuffer2[ulOffset1], &gabBuffer1[ulOffset2], ulLen);
+                RedMemSet(&gabBuffer2[ulOffset2], bVal, ulLen / 2U);
+
+                if(MemBenchCmpBytewise(gabBuffer2, gabBuffer3, sizeof(gabBuffer2)) != 0)
+                {
+                    RedPrintf("membench: copy or set of %lu bytes at offsets %lu and %lu is wrong\n",
+                        (unsigned long)ulLen, (unsigned long)ulOffset1, (unsigned long)ulOffset2);
+                    iRet = 1;
+                }
+                else
+                {
+                    /*  Compare equal buffers, then buffers which differ at a
+                        random position.
+                    */
+                    int32_t lExpected;
+
+                    MemBenchCpyBytewise(&gabBuffer2[ulOffset2], &gabBuffer1[ulOffset1], ulLen);
+
+                    if(RedMemCmp(&gabBuffer1[ulOffset1], &gabBuffer2[ulOffset2], ulLen) != 0)
+                    {
+                        iRet = 1;
+                    }
+                    else if(ulLen > 0U)
+                    {
+                        gabBuffer2[ulOffset2 + (RedRand32(pulSeed) % ulLen)] ^= (uint8_t)((RedRand32(pulSeed) % 255U) + 1U);
+                        lExpected = MemBenchCmpBytewise(&gabBuffer1[ulOffset1], &gabBuffer2[ulOffset2], ulLen);
+
+                        if(RedMemCmp(&gabBuffer1[ulOffset1], &gabBuffer2[ulOffset2], ulLen) != lExpected)
+                        {
+                            iRet = 1;
+                        }
+                    }
+                    else
+                    {
+                        /*  Nothing more to compare.
+                        */
+                    }
+
+                    if(iRet != 0)
+                    {
+                        RedPrintf("membench: compare of %lu bytes at offsets %lu and %lu is wrong\n",
+                            (unsigned long)ulLen, (unsigned long)ulOffset1, (unsigned long)ulOffset2);
+                    }
+                }
+            }
+        }
+
+        if(ulLen < MEMBENCH_CHECK_LEN)
+        {
+            ulLen++;
+        }
+        else if(ulLen < REDCONF_BLOCK_SIZE)
+        {
+            ulLen = REDCONF_BLOCK_SIZE;
+        }
+        else
+        {
+            ulLen = REDCONF_BLOCK_SIZE + 1U;
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Measure the best throughput of one case over MEMBENCH_RUNS runs.
+
+    @param pCase        The case to time.
+    @param fBytewise    Whether to time the byte-at-a-time function, rather
+                        than the configured one.
+    @param ulBytes      The total number of bytes to process.
+
+    @return The throughput, in KB per second.
+*/
+static uint64_t MemBenchTime(
+    const MEMCASE  *pCase,
+    bool            fBytewise,
+    uint32_t        ulBytes)
+{
+    uint8_t        *pbBuffer1 = &gabBuffer1[pCase->ulOffset1];
+    uint8_t        *pbBuffer2 = &gabBuffer2[pCase->ulOffset2];
+    uint32_t        ulCount = (ulBytes > pCase->ulLen) ? (ulBytes / pCase->ulLen) : 1U;
+    uint32_t        ulRun;
+    int32_t         lSum = 0;
+    uint64_t        ullBestUS = UINT64_MAX;
+
+    if(fBytewise)
+    {
+        gFuncs.pfnCpy = MemBenchCpyBytewise;
+        gFuncs.pfnSet = MemBenchSetBytewise;
+        gFuncs.pfnCmp = MemBenchCmpBytewise;
+    }
+    else
+    {
+        gFuncs.pfnCpy = RedMemCpy;
+        gFuncs.pfnSet = RedMemSet;
+        gFuncs.pfnCmp = RedMemCmp;
+    }
+
+    MemBenchCpyBytewise(pbBuffer1, pbBuffer2, pCase->ulLen);
+
+    for(ulRun = 0U; ulRun < MEMBENCH_RUNS; ulRun++)
+    {
+        REDTIMESTAMP    ts = RedOsTimestamp();
+        uint64_t        ullUS;
+        uint32_t        ulIdx;
+
+        for(ulIdx = 0U; ulIdx < ulCount; ulIdx++)
+        {
+            switch(pCase->op)
+            {
+                case MEMOP_CPY:
+                    gFuncs.pfnCpy(pbBuffer1, pbBuffer2, pCase->ulLen);
+                    break;
+                case MEMOP_SET:
+                    gFuncs.pfnSet(pbBuffer1, (uint8_t)ulIdx, pCase->ulLen);
+                    break;
+                default:
+                    lSum += gFuncs.pfnCmp(pbBuffer1, pbBuffer2, pCase->ulLen);
+                    break;
+            }
+        }
+
+        ullUS = RedOsTimePassed(ts);
+        if(ullUS == 0U)
+        {
+            ullUS = 1U;
+        }
+
+        if(ullUS < ullBestUS)
+        {
+            ullBestUS = ullUS;
+        }
+    }
+
+    /*  Keep the result live so that the loop is not optimized away.
+    */
+    gabBuffer3[0U] ^= (uint8_t)lSum;
+
+    return RedMulDiv64((uint64_t)ulCount * pCase->ulLen, 1000000U, ullBestUS * 1024U);
+}
+
+#endif /* MEMBENCH_SUPPORTED */
+
@@ -0,0 +1,1009 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+
+                   Copyright (c) 2014-2015 Datalight, Inc.
+                       All Rights Reserved Worldwide.
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; use version 2 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+    of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+/*  Businesses and individuals that for commercial or other reasons cannot
+    comply with the terms of the GPLv2 license may obtain a commercial license
+    before incorporating Reliance Edge into proprietary software for
+    distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+    more information.
+*/
+/** @file
+    @brief Multi-task file system stress test.
+
+    This is a multi-task counterpart to fsstress.  Like the original SGI
+    fsstress, where each process worked in its own directory, each task works
+    in its own directory, running operations picked at random from a weighted
+    table.  Unlike fsstress, the expected contents of every file are known, so
+    all data which is read is verified.  In addition, all tasks concurrently
+    read a shared file, so that reads and writes of different files, and reads
+    of the same file, are interleaved.
+
+    The test has three parts: FsMtStressPrepare() is called once; then
+    FsMtStressTask() is called from each of FSMTSTRESSPARAM::ulTasks tasks,
+    which run concurrently; then, after all of them have returned,
+    FsMtStressCleanup() is called once.  Each task uses at most two file
+    descriptors at a time, and up to FSMT_FILES * FSMT_MAX_FILE_SIZE bytes of
+    file data, which the volume must have room for (with room to spare, since
+    the previous transaction point is preserved until the next one).
+*/
+#include <stdlib.h>
+
+#include <redposix.h>
+#include <redtests.h>
+
+#if FSMTSTRESS_SUPPORTED
+
+#include <redosserv.h>
+#include <redutils.h>
+#include <redmacs.h>
+
+
+/*  Number of file name slots in the directory of each task.
+*/
+#define FSMT_FILES          8U
+
+/*  Largest file which a task will create.
+*/
+#define FSMT_MAX_FILE_SIZE  (256U * REDCONF_BLOCK_SIZE)
+
+/*  Largest single read or write, large enough to span several of the chunks
+    in which the POSIX layer transfers data with fine-grained locking.
+*/
+#define FSMT_MAX_IO         (40U * REDCONF_BLOCK_SIZE)
+
+/*  Size of the file which all tasks read.
+*/
+#define FSMT_SHARED_SIZE    (64U * REDCONF_BLOCK_SIZE)
+
+/*  Pattern identifier for the contents of the shared file.  Per-task
+    identifiers have the task number in the upper bits, so they never collide
+    with this one.
+*/
+#define FSMT_SHARED_ID      0xFFFFFFFFU
+
+#define FSMT_NAME_LEN       (REDCONF_NAME_MAX + 32U)
+
+
+typedef enum
+{
+    OP_CREAT,
+    OP_WRITE,
+    OP_READ,
+    OP_TRUNCATE,
+    OP_RENAME,
+    OP_UNLINK,
+    OP_STAT,
+    OP_GETDENTS,
+    OP_TRANSACT,
+    OP_SHAREDREAD,
+    OP_LAST
+} FSMTOP;
+
+typedef struct
+{
+    FSMTOP      op;
+    const char *pszName;
+    uint32_t    ulFreq;
+} FSMTOPDESC;
+
+/*  @brief What a file slot of a task is expected to contain.
+*/
+typedef struct
+{
+    bool        fExists;    /**< Whether the file exists. */
+    uint32_t    ulId;       /**< Pattern identifier of the contents. */
+    uint32_t    ulSize;     /**< Expected size of the file. */
+} FSMTFILE;
+
+/*  @brief State of one task running the test.
+*/
+typedef struct
+{
+    const FSMTSTRESSPARAM  *pParam;
+    uint32_t                ulTaskNum;
+    uint64_t                ullSeed;
+    uint32_t                ulNextId;
+    int32_t                 iSharedFd;
+    uint8_t                *pbBuffer;
+    FSMTFILE                aFile[FSMT_FILES];
+} FSMTTASK;
+
+
+static const FSMTOPDESC gaOps[] =
+{
+    { OP_CREAT,         "creat",        3U },
+    { OP_WRITE,         "write",        6U },
+    { OP_READ,          "read",         6U },
+    { OP_TRUNCATE,      "truncate",     1U },
+    { OP_RENAME,        "rename",       1U },
+    { OP_UNLINK,        "unlink",       1U },
+    { OP_STAT,          "stat",         2U },
+    { OP_GETDENTS,      "getdents",     1U },
+    { OP_TRANSACT,      "transact",     1U },
+    { OP_SHAREDREAD,    "sharedread",   4U }
+};
+
+
+static int DoOp(FSMTTASK *pTask, FSMTOP op);
+static int OpCreat(FSMTTASK *pTask);
+static int OpWrite(FSMTTASK *pTask);
+static int OpRead(FSMTTASK *pTask);
+static int OpTruncate(FSMTTASK *pTask);
+static int OpRename(FSMTTASK *pTask);
+static int OpUnlink(FSMTTASK *pTask);
+static int OpStat(FSMTTASK *pTask);
+static int OpGetdents(FSMTTASK *pTask);
+static int OpTransact(FSMTTASK *pTask);
+static int OpSharedRead(FSMTTASK *pTask);
+static int VerifyRead(FSMTTASK *pTask, int32_t iFd, uint32_t ulId, uint32_t ulFileSize, uint32_t ulOffset, uint32_t ulLen);
+static int32_t PickFile(FSMTTASK *pTask, bool fExists);
+static uint32_t Random(FSMTTASK *pTask, uint32_t ulLimit);
+static void FileName(const FSMTTASK *pTask, uint32_t ulSlot, char *pszName);
+static void FillPattern(uint8_t *pbBuffer, uint32_t ulId, uint32_t ulOffset, uint32_t ulLen);
+static uint8_t PatternByte(uint32_t ulId, uint32_t ulOffset);
+static int Fail(const FSMTTASK *pTask, const char *pszWhat);
+
+
+/** @brief Set default multi-task fsstress parameters.
+
+    @param pParam   Populated with the default parameters.
+*/
+void FsMtStressDefaultParams(
+    FSMTSTRESSPARAM *pParam)
+{
+    RedMemSet(pParam, 0U, sizeof(*pParam));
+    pParam->pszVolume = "";
+    pParam->ulTasks = 4U;
+    pParam->ulNops = 2000U;
+}
+
+
+/** @brief Create the directories and the shared file used by the test.
+
+    Must be called before any task calls FsMtStressTask().
+
+    @param pParam   Test parameters.
+
+    @return Zero on success, otherwise nonzero.
+*/
+int FsMtStressPrepare(
+    const FSMTSTRESSPARAM  *pParam)
+{
+    char                    szName[FSMT_NAME_LEN];
+    uint32_t                ulTask;
+    int32_t                 iFd;
+    int                     iRet = 0;
+
+    if((pParam->ulTasks == 0U) || (pParam->ulTasks > REDCONF_TASK_COUNT) || ((pParam->ulTasks * 2U) > REDCONF_HANDLE_COUNT))
+    {
+        RedPrintf("fsmtstress: invalid task count %lu\n", (unsigned long)pParam->ulTasks);
+        iRet = 1;
+    }
+
+    for(ulTask = 0U; (iRet == 0) && (ulTask < pParam->ulTasks); ulTask++)
+    {
+        (void)RedSNPrintf(szName, sizeof(szName), "%s/mt%lu", pParam->pszVolume, (unsigned long)ulTask);
+        if(red_mkdir(szName) != 0)
+        {
+            RedPrintf("fsmtstress: mkdir %s failed, errno %d\n", szName, (int)red_errno);
+            iRet = 1;
+        }
+    }
+
+    if(iRet == 0)
+    {
+        (void)RedSNPrintf(szName, sizeof(szName), "%s/mtshared", pParam->pszVolume);
+        iFd = red_open(szName, RED_O_WRONLY | RED_O_CREAT | RED_O_EXCL);
+        if(iFd < 0)
+        {
+            RedPrintf("fsmtstress: creat %s failed, errno %d\n", szName, (int)red_errno);
+            iRet = 1;
+        }
+        else
+        {
+            uint8_t     abBlock[REDCONF_BLOCK_SIZE];
+            uint32_t    ulOffset;
+
+            for(ulOffset = 0U; (iRet == 0) && (ulOffset < FSMT_SHARED_SIZE); ulOffset += sizeof(abBlock))
+            {
+                FillPattern(abBlock, FSMT_SHARED_ID, ulOffset, sizeof(abBlock));
+                if(red_write(iFd, abBlock, sizeof(abBlock)) != (int32_t)sizeof(abBlock))
+                {
+                    RedPrintf("fsmtstress: write %s failed, errno %d\n", szName, (int)red_errno);
+                    iRet = 1;
+                }
+            }
+
+            (void)red_close(iFd);
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Run the test in one task.
+
+    @param pParam       Test parameters.
+    @param ulTaskNum    Number of the calling task, from zero to
+                        FSMTSTRESSPARAM::ulTasks minus one.  Each concurrently
+                        running task must use a different number.
+
+    @return Zero on success, otherwise nonzero.
+*/
+int FsMtStressTask(
+    const FSMTSTRESSPARAM  *pParam,
+    uint32_t                ulTaskNum)
+{
+    FSMTTASK                task;
+    uint32_t                ulFreqTotal = 0U;
+    uint32_t                ulOp;
+    uint32_t                ulIdx;
+    int                     iRet = 0;
+
+    RedMemSet(&task, 0U, sizeof(task));
+    task.pParam = pParam;
+    task.ulTaskNum = ulTaskNum;
+    task.iSharedFd = -1;
+    task.ulNextId = ulTaskNum << 24U;
+    task.ullSeed = (pParam->ulSeed == 0U) ? RedOsClockGetTime() : pParam->ulSeed;
+    task.ullSeed += (uint64_t)ulTaskNum * 0x9E3779B9U;
+
+    if(pParam->fVerbose)
+    {
+        RedPrintf("fsmtstress: task %lu seed %lu\n", (unsigned long)ulTaskNum, (unsigned long)task.ullSeed);
+    }
+
+    task.pbBuffer = malloc(FSMT_MAX_IO);
+    if(task.pbBuffer == NULL)
+    {
+        iRet = Fail(&task, "malloc");
+    }
+    else
+    {
+        char szName[FSMT_NAME_LEN];
+
+        (void)RedSNPrintf(szName, sizeof(szName), "%s/mtshared", pParam->pszVolume);
+        task.iSharedFd = red_open(szName, RED_O_RDONLY);
+        if(task.iSharedFd < 0)
+        {
+            iRet = Fail(&task, "open shared");
+        }
+    }
+
+    for(ulIdx = 0U; ulIdx < (sizeof(gaOps) / sizeof(gaOps[0U])); ulIdx++)
+    {
+        ulFreqTotal += gaOps[ulIdx].ulFreq;
+    }
+
+    for(ulOp = 0U; (iRet == 0) && (ulOp < pParam->ulNops); ulOp++)
+    {
+        uint32_t ulPick = Random(&task, ulFreqTotal);
+
+        for(ulIdx = 0U; ulPick >= gaOps[ulIdx].ulFreq; ulIdx++)
+        {
+            ulPick -= gaOps[ulIdx].ulFreq;
+        }
+
+        if(pParam->fVerbose)
+        {
+            RedPrintf("%lu/%lu: %s\n", (unsigned long)ulTaskNum, (unsigned long)ulOp, gaOps[ulIdx].pszName);
+        }
+
+        iRet = DoOp(&task, gaOps[ulIdx].op);
+    }
+
+    if(task.iSharedFd >= 0)
+    {
+        (void)red_close(task.iSharedFd);
+    }
+
+    free(task.pbBuffer);
+
+    return iRet;
+}
+
+
+/** @brief Verify the shared file and remove everything created by the test.
+
+    Must be called after all tasks have returned from FsMtStressTask().
+
+    @param pParam   Test parameters.
+
+    @return Zero on success, otherwise nonzero.
+*/
+int FsMtStressCleanup(
+    const FSMTSTRESSPARAM  *pParam)
+{
+    FSMTTASK                task;
+    char                    szName[FSMT_NAME_LEN];
+    uint32_t                ulTask;
+    int                     iRet = 0;
+
+    RedMemSet(&task, 0U, sizeof(task));
+    task.pParam = pParam;
+    task.ulTaskNum = pParam->ulTasks;
+
+    task.pbBuffer = malloc(FSMT_MAX_IO);
+    if(task.pbBuffer == NULL)
+    {
+        iRet = Fail(&task, "malloc");
+    }
+    else
+    {
+        (void)RedSNPrintf(szName, sizeof(szName), "%s/mtshared", pParam->pszVolume);
+        task.iSharedFd = red_open(szName, RED_O_RDONLY);
+        if(task.iSharedFd < 0)
+        {
+            iRet = Fail(&task, "open shared");
+        }
+        else
+        {
+            uint32_t ulOffset;
+
+            for(ulOffset = 0U; (iRet == 0) && (ulOffset < FSMT_SHARED_SIZE); ulOffset += FSMT_MAX_IO)
+            {
+                iRet = VerifyRead(&task, task.iSharedFd, FSMT_SHARED_ID, FSMT_SHARED_SIZE, ulOffset, FSMT_MAX_IO);
+            }
+
+            (void)red_close(task.iSharedFd);
+
+            if((iRet == 0) && (red_unlink(szName) != 0))
+            {
+                iRet = Fail(&task, "unlink shared");
+            }
+        }
+
+        free(task.pbBuffer);
+    }
+
+    for(ulTask = 0U; (iRet == 0) && (ulTask < pParam->ulTasks); ulTask++)
+    {
+        uint32_t ulSlot;
+
+        task.ulTaskNum = ulTask;
+
+        for(ulSlot = 0U; ulSlot < FSMT_FILES; ulSlot++)
+        {
+            FileName(&task, ulSlot, szName);
+            (void)red_unlink(szName);
+        }
+
+        (void)RedSNPrintf(szName, sizeof(szName), "%s/mt%lu", pParam->pszVolume, (unsigned long)ulTask);
+        if(red_rmdir(szName) != 0)
+        {
+            iRet = Fail(&task, "rmdir");
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Perform one operation.
+
+    @param pTask    Task state.
+    @param op       Operation to perform.
+
+    @return Zero on success, otherwise nonzero.
+*/
+static int DoOp(
+    FSMTTASK   *pTask,
+    FSMTOP      op)
+{
+    int         iRet;
+
+    switch(op)
+    {
+        case OP_CREAT:
+            iRet = OpCreat(pTask);
+            break;
+        case OP_WRITE:
+            iRet = OpWrite(pTask);
+            break;
+        case OP_READ:
+            iRet = OpRead(pTask);
+            break;
+        case OP_TRUNCATE:
+            iRet = OpTruncate(pTask);
+            break;
+        case OP_RENAME:
+            iRet = OpRename(pTask);
+            break;
+        case OP_UNLINK:
+            iRet = OpUnlink(pTask);
+            break;
+        case OP_STAT:
+            iRet = OpStat(pTask);
+            break;
+        case OP_GETDENTS:
+            iRet = OpGetdents(pTask);
+            break;
+        case OP_TRANSACT:
+            iRet = OpTransact(pTask);
+            break;
+        case OP_SHAREDREAD:
+            iRet = OpSharedRead(pTask);
+            break;
+        default:
+            REDERROR();
+            iRet = 1;
+            break;
+    }
+
+    return iRet;
+}
+
+
+/** @brief Create an empty file in a free slot.
+*/
+static int OpCreat(
+    FSMTTASK   *pTask)
+{
+    int32_t     iSlot = PickFile(pTask, false);
+    int         iRet = 0;
+
+    if(iSlot >= 0)
+    {
+        char    szName[FSMT_NAME_LEN];
+        int32_t iFd;
+
+        FileName(pTask, (uint32_t)iSlot, szName);
+        iFd = red_open(szName, RED_O_WRONLY | RED_O_CREAT | RED_O_EXCL);
+        if(iFd < 0)
+        {
+            iRet = Fail(pTask, "creat");
+        }
+        else
+        {
+            pTask->aFile[iSlot].fExists = true;
+            pTask->aFile[iSlot].ulId = pTask->ulNextId;
+            pTask->aFile[iSlot].ulSize = 0U;
+            pTask->ulNextId++;
+
+            if(red_close(iFd) != 0)
+            {
+                iRet = Fail(pTask, "close");
+            }
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Overwrite or extend an existing file.
+
+    Writes never start beyond the end-of-file, so files have no sparse
+    regions and their contents are entirely described by their pattern
+    identifier and size.
+*/
+static int OpWrite(
+    FSMTTASK   *pTask)
+{
+    int32_t     iSlot = PickFile(pTask, true);
+    int         iRet = 0;
+
+    if(iSlot >= 0)
+    {
+        FSMTFILE   *pFile = &pTask->aFile[iSlot];
+        char        szName[FSMT_NAME_LEN];
+        int32_t     iFd;
+        uint32_t    ulOffset = Random(pTask, REDMIN(pFile->ulSize + 1U, FSMT_MAX_FILE_SIZE));
+        uint32_t    ulLen = Random(pTask, REDMIN(FSMT_MAX_IO, FSMT_MAX_FILE_SIZE - ulOffset)) + 1U;
+
+        FileName(pTask, (uint32_t)iSlot, szName);
+        iFd = red_open(szName, RED_O_RDWR);
+        if(iFd < 0)
+        {
+            iRet = Fail(pTask, "open for write");
+        }
+        else
+        {
+            FillPattern(pTask->pbBuffer, pFile->ulId, ulOffset, ulLen);
+
+            if(red_lseek(iFd, (int64_t)ulOffset, RED_SEEK_SET) != (int64_t)ulOffset)
+            {
+                iRet = Fail(pTask, "lseek");
+            }
+            else if(red_write(iFd, pTask->pbBuffer, ulLen) != (int32_t)ulLen)
+            {
+                /*  The disk is large enough for every task to fill all of its
+                    files, so writes are never short.
+                */
+                iRet = Fail(pTask, "write");
+            }
+            else
+            {
+                if((ulOffset + ulLen) > pFile->ulSize)
+                {
+                    pFile->ulSize = ulOffset + ulLen;
+                }
+
+                /*  Read back part of what was just written.
+                */
+                iRet = VerifyRead(pTask, iFd, pFile->ulId, pFile->ulSize, ulOffset, Random(pTask, ulLen) + 1U);
+            }
+
+            if((red_close(iFd) != 0) && (iRet == 0))
+            {
+                iRet = Fail(pTask, "close");
+            }
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Read and verify a random range of an existing file.
+*/
+static int OpRead(
+    FSMTTASK   *pTask)
+{
+    int32_t     iSlot = PickFile(pTask, true);
+    int         iRet = 0;
+
+    if(iSlot >= 0)
+    {
+        const FSMTFILE *pFile = &pTask->aFile[iSlot];
+        char            szName[FSMT_NAME_LEN];
+        int32_t         iFd;
+
+        FileName(pTask, (uint32_t)iSlot, szName);
+        iFd = red_open(szName, RED_O_RDONLY);
+        if(iFd < 0)
+        {
+            iRet = Fail(pTask, "open for read");
+        }
+        else
+        {
+            /*  Reads may extend beyond the end-of-file, to exercise short
+                reads.
+            */
+            iRet = VerifyRead(pTask, iFd, pFile->ulId, pFile->ulSize,
+                Random(pTask, pFile->ulSize + REDCONF_BLOCK_SIZE), Random(pTask, FSMT_MAX_IO) + 1U);
+
+            if((red_close(iFd) != 0) && (iRet == 0))
+            {
+                iRet = Fail(pTask, "close");
+            }
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Shrink an existing file.
+*/
+static int OpTruncate(
+    FSMTTASK   *pTask)
+{
+    int32_t     iSlot = PickFile(pTask, true);
+    int         iRet = 0;
+
+    if(iSlot >= 0)
+    {
+        FSMTFILE   *pFile = &pTask->aFile[iSlot];
+        char        szName[FSMT_NAME_LEN];
+        int32_t     iFd;
+        uint32_t    ulNewSize = Random(pTask, pFile->ulSize + 1U);
+
+        FileName(pTask, (uint32_t)iSlot, szName);
+        iFd = red_open(szName, RED_O_WRONLY);
+        if(iFd < 0)
+        {
+            iRet = Fail(pTask, "open for truncate");
+        }
+        else
+        {
+            if(red_ftruncate(iFd, ulNewSize) != 0)
+            {
+                iRet = Fail(pTask, "ftruncate");
+            }
+            else
+            {
+                pFile->ulSize = ulNewSize;
+            }
+
+            if((red_close(iFd) != 0) && (iRet == 0))
+            {
+                iRet = Fail(pTask, "close");
+            }
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Rename an existing file to a free slot.
+*/
+static int OpRename(
+    FSMTTASK   *pTask)
+{
+    int32_t     iOldSlot = PickFile(pTask, true);
+    int32_t     iNewSlot = PickFile(pTask, false);
+    int         iRet = 0;
+
+    if((iOldSlot >= 0) && (iNewSlot >= 0))
+    {
+        char    szOldName[FSMT_NAME_LEN];
+        char    szNewName[FSMT_NAME_LEN];
+
+        FileName(pTask, (uint32_t)iOldSlot, szOldName);
+        FileName(pTask, (uint32_t)iNewSlot, szNewName);
+        if(red_rename(szOldName, szNewName) != 0)
+        {
+            iRet = Fail(pTask, "rename");
+        }
+        else
+        {
+            pTask->aFile[iNewSlot] = pTask->aFile[iOldSlot];
+            pTask->aFile[iOldSlot].fExists = false;
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Delete an existing file.
+*/
+static int OpUnlink(
+    FSMTTASK   *pTask)
+{
+    int32_t     iSlot = PickFile(pTask, true);
+    int         iRet = 0;
+
+    if(iSlot >= 0)
+    {
+        char szName[FSMT_NAME_LEN];
+
+        FileName(pTask, (uint32_t)iSlot, szName);
+        if(red_unlink(szName) != 0)
+        {
+            iRet = Fail(pTask, "unlink");
+        }
+        else
+        {
+            pTask->aFile[iSlot].fExists = false;
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Check the size of an existing file, and the end-of-file offset.
+*/
+static int OpStat(
+    FSMTTASK   *pTask)
+{
+    int32_t     iSlot = PickFile(pTask, true);
+    int         iRet = 0;
+
+    if(iSlot >= 0)
+    {
+        const FSMTFILE *pFile = &pTask->aFile[iSlot];
+        char            szName[FSMT_NAME_LEN];
+        int32_t         iFd;
+
+        FileName(pTask, (uint32_t)iSlot, szName);
+        iFd = red_open(szName, RED_O_RDONLY);
+        if(iFd < 0)
+        {
+            iRet = Fail(pTask, "open for stat");
+        }
+        else
+        {
+            REDSTAT st;
+
+            if(red_fstat(iFd, &st) != 0)
+            {
+                iRet = Fail(pTask, "fstat");
+            }
+            else if(st.st_size != pFile->ulSize)
+            {
+                iRet = Fail(pTask, "fstat size mismatch");
+            }
+            else if(red_lseek(iFd, 0, RED_SEEK_END) != (int64_t)pFile->ulSize)
+            {
+                iRet = Fail(pTask, "lseek to end-of-file");
+            }
+            else
+            {
+                /*  Size is as expected.
+                */
+            }
+
+            if((red_close(iFd) != 0) && (iRet == 0))
+            {
+                iRet = Fail(pTask, "close");
+            }
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Check that the directory of the task lists exactly the files which
+           are expected to exist.
+*/
+static int OpGetdents(
+    FSMTTASK   *pTask)
+{
+    char        szName[FSMT_NAME_LEN];
+    REDDIR     *pDir;
+    int         iRet = 0;
+
+    (void)RedSNPrintf(szName, sizeof(szName), "%s/mt%lu", pTask->pParam->pszVolume, (unsigned long)pTask->ulTaskNum);
+    pDir = red_opendir(szName);
+    if(pDir == NULL)
+    {
+        iRet = Fail(pTask, "opendir");
+    }
+    else
+    {
+        uint32_t    ulExpected = 0U;
+        uint32_t    ulFound = 0U;
+        uint32_t    ulSlot;
+        REDDIRENT  *pDirent;
+
+        for(ulSlot = 0U; ulSlot < FSMT_FILES; ulSlot++)
+        {
+            if(pTask->aFile[ulSlot].fExists)
+            {
+                ulExpected++;
+            }
+        }
+
+        red_errno = 0;
+        pDirent = red_readdir(pDir);
+        while((iRet == 0) && (pDirent != NULL))
+        {
+            ulSlot = (uint32_t)RedAtoI(&pDirent->d_name[1U]);
+            if((pDirent->d_name[0U] != 'f') || (ulSlot >= FSMT_FILES) || !pTask->aFile[ulSlot].fExists)
+            {
+                iRet = Fail(pTask, "readdir found unexpected name");
+            }
+            else if(pDirent->d_stat.st_size != pTask->aFile[ulSlot].ulSize)
+            {
+                iRet = Fail(pTask, "readdir size mismatch");
+            }
+            else
+            {
+                ulFound++;
+                pDirent = red_readdir(pDir);
+            }
+        }
+
+        if((iRet == 0) && (red_errno != 0))
+        {
+            iRet = Fail(pTask, "readdir");
+        }
+        else if((iRet == 0) && (ulFound != ulExpected))
+        {
+            iRet = Fail(pTask, "readdir entry count mismatch");
+        }
+        else
+        {
+            /*  Directory contents are as expected, or failure already
+                reported.
+            */
+        }
+
+        if((red_closedir(pDir) != 0) && (iRet == 0))
+        {
+            iRet = Fail(pTask, "closedir");
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Commit a transaction point while other tasks are mid-operation.
+*/
+static int OpTransact(
+    FSMTTASK   *pTask)
+{
+    int         iRet = 0;
+
+    if(red_transact(pTask->pParam->pszVolume) != 0)
+    {
+        iRet = Fail(pTask, "transact");
+    }
+
+    return iRet;
+}
+
+
+/** @brief Read and verify a random range of the shared file, through the
+           file descriptor which the task keeps open.
+*/
+static int OpSharedRead(
+    FSMTTASK   *pTask)
+{
+    return VerifyRead(pTask, pTask->iSharedFd, FSMT_SHARED_ID, FSMT_SHARED_SIZE,
+        Random(pTask, FSMT_SHARED_SIZE), Random(pTask, FSMT_MAX_IO) + 1U);
+}
+
+
+/** @brief Read from a file and verify the data.
+
+    @param pTask        Task state.
+    @param iFd          File descriptor to read from.
+    @param ulId         Pattern identifier of the file contents.
+    @param ulFileSize   Expected size of the file.
+    @param ulOffset     Offset to read from.
+    @param ulLen        Number of bytes to read, at most FSMT_MAX_IO.
+
+    @return Zero on success, otherwise nonzero.
+*/
+static int VerifyRead(
+    FSMTTASK   *pTask,
+    int32_t     iFd,
+    uint32_t    ulId,
+    uint32_t    ulFileSize,
+    uint32_t    ulOffset,
+    uint32_t    ulLen)
+{
+    uint32_t    ulExpected = (ulOffset >= ulFileSize) ? 0U : REDMIN(ulLen, ulFileSize - ulOffset);
+    int32_t     iRead;
+    int         iRet = 0;
+
+    REDASSERT(ulLen <= FSMT_MAX_IO);
+
+    if(red_lseek(iFd, (int64_t)ulOffset, RED_SEEK_SET) != (int64_t)ulOffset)
+    {
+        iRet = Fail(pTask, "lseek");
+    }
+    else
+    {
+        iRead = red_read(iFd, pTask->pbBuffer, ulLen);
+        if(iRead < 0)
+        {
+            iRet = Fail(pTask, "read");
+        }
+        else if((uint32_t)iRead != ulExpected)
+        {
+            iRet = Fail(pTask, "read length mismatch");
+        }
+        else
+        {
+            uint32_t ulIdx;
+
+            for(ulIdx = 0U; ulIdx < ulExpected; ulIdx++)
+            {
+                if(pTask->pbBuffer[ulIdx] != PatternByte(ulId, ulOffset + ulIdx))
+                {
+                    RedPrintf("fsmtstress: task %lu: miscompare at offset %lu of pattern %lx\n",
+                        (unsigned long)pTask->ulTaskNum, (unsigned long)(ulOffset + ulIdx), (unsigned long)ulId);
+                    iRet = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    return iRet;
+}
+
+
+/** @brief Pick a random file slot.
+
+    @param pTask    Task state.
+    @param fExists  Whether to pick a slot with an existing file, rather than
+                    a free slot.
+
+    @return The slot number, or -1 if there is no suitable slot.
+*/
+static int32_t PickFile(
+    FSMTTASK   *pTask,
+    bool        fExists)
+{
+    uint32_t    ulStart = Random(pTask, FSMT_FILES);
+    uint32_t    ulIdx;
+    int32_t     iSlot = -1;
+
+    for(ulIdx = 0U; ulIdx < FSMT_FILES; ulIdx++)
+    {
+        uint32_t ulSlot = (ulStart + ulIdx) % FSMT_FILES;
+
+        if(pTask->aFile[ulSlot].fExists == fExists)
+        {
+            iSlot = (int32_t)ulSlot;
+            break;
+        }
+    }
+
+    return iSlot;
+}
+
+
+/** @brief Generate a random number in the range [0, @p ulLimit).
+*/
+static uint32_t Random(
+    FSMTTASK   *pTask,
+    uint32_t    ulLimit)
+{
+    return (ulLimit == 0U) ? 0U : (uint32_t)(RedRand64(&pTask->ullSeed) % ulLimit);
+}
+
+
+/** @brief Build the path of a file slot of a task.
+*/
+static void FileName(
+    const FSMTTASK *pTask,
+    uint32_t        ulSlot,
+    char           *pszName)
+{
+    (void)RedSNPrintf(pszName, FSMT_NAME_LEN, "%s/mt%lu/f%lu", pTask->pParam->pszVolume,
+        (unsigned long)pTask->ulTaskNum, (unsigned long)ulSlot);
+}
+
+
+/** @brief Fill a buffer with the expected contents of a range of a file.
+*/
+static void FillPattern(
+    uint8_t    *pbBuffer,
+    uint32_t    ulId,
+    uint32_t    ulOffset,
+    uint32_t    ulLen)
+{
+    uint32_t    ulIdx;
+
+    for(ulIdx = 0U; ulIdx < ulLen; ulIdx++)
+    {
+        pbBuffer[ulIdx] = PatternByte(ulId, ulOffset + ulIdx);
+    }
+}
+
+
+/** @brief Compute the expected value of one byte of a file.
+
+    The value depends on the block number as well as the offset within the
+    block, so that data written to or read from the wrong block is detected.
+*/
+static uint8_t PatternByte(
+    uint32_t    ulId,
+    uint32_t    ulOffset)
+{
+    uint32_t    ulHash = (ulId * 0x9E3779B1U) ^ ((ulOffset / REDCONF_BLOCK_SIZE) * 0x85EBCA6BU);
+
+    return (uint8_t)((ulHash >> 24U) + ulOffset);
+}
+
+
+/** @brief Report a failed operation.
+
+    @return Nonzero, for the caller to return.
+*/
+static int Fail(
+    const FSMTTASK *pTask,
+    const char     *pszWhat)
+{
+    RedPrintf("fsmtstress: task %lu: %s failed, errno %d\n", (unsigned long)pTask->ulTaskNum, pszWhat, (int)red_errno);
+
+    return 1;
+}
+
+#endif /* FSMTSTRESS_SUPPORTED */
@@ -39,6 +39,7 @@
 #define CRC_BITWISE     (0U)
 #define CRC_SARWATE     (1U)
 #define CRC_SLICEBY8    (2U)
+#define CRC_CLMUL       (3U)
 
 
 #if REDCONF_CRC_ALGORITHM == CRC_BITWISE
@@ -183,7 +184,63 @@ uint32_t RedCrc32Update(
     return ulCrc32;
 }
 
-#elif REDCONF_CRC_ALGORITHM == CRC_SLICEBY8
+#elif (REDCONF_CRC_ALGORITHM == CRC_SLICEBY8) || (REDCONF_CRC_ALGORITHM == CRC_CLMUL)
+
+/*  CRC_CLMUL is slice-by-8 with the bulk of each buffer folded using
+    carry-less multiplication: PCLMULQDQ on x86 or PMULL on ARMv8.  Whether the
+    instructions exist is checked at run time, and if they do not, or the
+    compiler or target is not supported, slice-by-8 does all of the work.  The
+    intrinsics and inline assembly used are outside of MISRA C, so projects
+    which must comply should use CRC_SLICEBY8.
+*/
+#define CLMUL_ARCH_NONE (0U)
+#define CLMUL_ARCH_X86  (1U)
+#define CLMUL_ARCH_ARM  (2U)
+
+#if (REDCONF_CRC_ALGORITHM == CRC_CLMUL) && (REDCONF_ENDIAN_BIG == 0) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CLMUL_ARCH      CLMUL_ARCH_X86
+#elif (REDCONF_CRC_ALGORITHM == CRC_CLMUL) && (REDCONF_ENDIAN_BIG == 0) && defined(__GNUC__) && defined(__aarch64__)
+#define CLMUL_ARCH      CLMUL_ARCH_ARM
+#else
+#define CLMUL_ARCH      CLMUL_ARCH_NONE
+#endif
+
+#if CLMUL_ARCH == CLMUL_ARCH_X86
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#elif CLMUL_ARCH == CLMUL_ARCH_ARM
+#include <arm_neon.h>
+#endif
+
+#if CLMUL_ARCH != CLMUL_ARCH_NONE
+
+/*  Shortest remaining length which is folded.  Folding works on four 16-byte
+    lanes, so it needs at least 64 bytes, and it has a fixed cost to combine
+    the lanes and to checksum the remainder, so it does not pay for buffers
+    much shorter than this.
+*/
+#define CLMUL_MIN_LENGTH    (128U)
+
+/*  Folding constants for the reflected CCITT-32 polynomial: x^(4*128+32),
+    x^(4*128-32), x^(128+32), and x^(128-32), each modulo the polynomial, bit
+    reflected and shifted left one bit.  These are the constants from Intel's
+    paper, "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+    Instruction".
+*/
+#define CLMUL_K1    UINT64_SUFFIX(0x0154442BD4)
+#define CLMUL_K2    UINT64_SUFFIX(0x01C6E41596)
+#define CLMUL_K3    UINT64_SUFFIX(0x01751997D0)
+#define CLMUL_K4    UINT64_SUFFIX(0x00CCAA009E)
+
+#define CLMUL_SUPPORT_UNKNOWN   (0U)
+#define CLMUL_SUPPORT_NO        (1U)
+#define CLMUL_SUPPORT_YES       (2U)
+
+static bool Crc32ClmulIsSupported(void);
+static void Crc32ClmulFold(uint32_t ulCrc32, const uint8_t *pbBuffer, uint32_t ulLength, uint8_t *pbRemainder);
+
+#endif /* CLMUL_ARCH != CLMUL_ARCH_NONE */
 
 
 /** @brief Compute a CRC32 for the given data buffer.
@@ -513,6 +570,27 @@ uint32_t RedCrc32Update(
             ulIdx++;
         }
 
+      #if CLMUL_ARCH != CLMUL_ARCH_NONE
+        if(((ulLength - ulIdx) >= CLMUL_MIN_LENGTH) && Crc32ClmulIsSupported())
+        {
+            uint8_t     abRemainder[16U];
+            uint32_t    ulFoldLen = (ulLength - ulIdx) & ~(uint32_t)(sizeof(abRemainder) - 1U);
+            uint32_t    ulRemIdx;
+
+            /*  Folding reduces the data to a 16-byte remainder whose CRC,
+                starting from zero, is the CRC of the data.
+            */
+            Crc32ClmulFold(ulCrc32, &pbBuffer[ulIdx], ulFoldLen, abRemainder);
+            ulIdx += ulFoldLen;
+
+            ulCrc32 = 0U;
+            for(ulRemIdx = 0U; ulRemIdx < sizeof(abRemainder); ulRemIdx++)
+            {
+                ulCrc32 = (ulCrc32 >> 8U) ^ aulCrc32Table[((ulCrc32 ^ abRemainder[ulRemIdx]) & 0xFFU) << 3U];
+            }
+        }
+      #endif
+
         /*  Round down the length to the nearest multiple of eight.
         */
         ulSliceLen = (((ulLength - ulIdx) >> 3U) << 3U) + ulIdx;
@@ -558,9 +636,235 @@ uint32_t RedCrc32Update(
     return ulCrc32;
 }
 
+
+
+#if CLMUL_ARCH != CLMUL_ARCH_NONE
+
+/** @brief Determine whether the CPU has a carry-less multiply instruction.
+
+    The answer is cached after the first call.  Concurrent first calls are
+    harmless, since they store the same answer.
+
+    @return Whether Crc32ClmulFold() can be used.
+*/
+static bool Crc32ClmulIsSupported(void)
+{
+    static volatile uint8_t bSupport = CLMUL_SUPPORT_UNKNOWN;
+
+    if(bSupport == CLMUL_SUPPORT_UNKNOWN)
+    {
+      #if CLMUL_ARCH == CLMUL_ARCH_X86
+        unsigned int uEax;
+        unsigned int uEbx;
+        unsigned int uEcx;
+        unsigned int uEdx;
+
+        if(    (__get_cpuid(1U, &uEax, &uEbx, &uEcx, &uEdx) != 0)
+            && ((uEcx & bit_PCLMUL) != 0U)
+            && ((uEdx & bit_SSE2) != 0U))
+        {
+            bSupport = CLMUL_SUPPORT_YES;
+        }
+      #else
+        uint64_t ullIsar0;
+
+        /*  PMULL is implemented if the AES field (bits 7:4) of
+            ID_AA64ISAR0_EL1 is 2.  The register is readable at EL1, and Linux
+            emulates the read at EL0.
+        */
+        __asm__ volatile("mrs %0, ID_AA64ISAR0_EL1" : "=r" (ullIsar0));
+
+        if(((ullIsar0 >> 4U) & 0xFU) >= 2U)
+        {
+            bSupport = CLMUL_SUPPORT_YES;
+        }
+      #endif
+
+        if(bSupport != CLMUL_SUPPORT_YES)
+        {
+            bSupport = CLMUL_SUPPORT_NO;
+        }
+    }
+
+    return bSupport == CLMUL_SUPPORT_YES;
+}
+
+
+#if CLMUL_ARCH == CLMUL_ARCH_X86
+
+/** @brief Fold a buffer with PCLMULQDQ.
+
+    @param ulCrc32      The CRC of the preceding data, before the final
+                        inversion.
+    @param pbBuffer     The data to fold.
+    @param ulLength     The length of @p pbBuffer; a multiple of 16 which is at
+                        least CLMUL_MIN_LENGTH.
+    @param pbRemainder  Populated with 16 bytes whose CRC, starting from zero
+                        and before the final inversion, is the CRC of the
+                        preceding data and @p pbBuffer.
+*/
+__attribute__((target("sse2,pclmul")))
+static void Crc32ClmulFold(
+    uint32_t        ulCrc32,
+    const uint8_t  *pbBuffer,
+    uint32_t        ulLength,
+    uint8_t        *pbRemainder)
+{
+    const __m128i   xK1K2 = _mm_set_epi64x((long long)CLMUL_K2, (long long)CLMUL_K1);
+    const __m128i   xK3K4 = _mm_set_epi64x((long long)CLMUL_K4, (long long)CLMUL_K3);
+    __m128i         x0 = _mm_loadu_si128((const __m128i *)&pbBuffer[0U]);
+    __m128i         x1 = _mm_loadu_si128((const __m128i *)&pbBuffer[16U]);
+    __m128i         x2 = _mm_loadu_si128((const __m128i *)&pbBuffer[32U]);
+    __m128i         x3 = _mm_loadu_si128((const __m128i *)&pbBuffer[48U]);
+    uint32_t        ulIdx;
+
+    REDASSERT((ulLength >= CLMUL_MIN_LENGTH) && ((ulLength % 16U) == 0U));
+
+    x0 = _mm_xor_si128(x0, _mm_cvtsi32_si128((int)ulCrc32));
+
+    /*  Fold four lanes at a time, each lane 64 bytes ahead of the last.
+    */
+    for(ulIdx = 64U; (ulLength - ulIdx) >= 64U; ulIdx += 64U)
+    {
+        x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, xK1K2, 0x00), _mm_clmulepi64_si128(x0, xK1K2, 0x11)),
+                           _mm_loadu_si128((const __m128i *)&pbBuffer[ulIdx]));
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, xK1K2, 0x00), _mm_clmulepi64_si128(x1, xK1K2, 0x11)),
+                           _mm_loadu_si128((const __m128i *)&pbBuffer[ulIdx + 16U]));
+        x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, xK1K2, 0x00), _mm_clmulepi64_si128(x2, xK1K2, 0x11)),
+                           _mm_loadu_si128((const __m128i *)&pbBuffer[ulIdx + 32U]));
+        x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, xK1K2, 0x00), _mm_clmulepi64_si128(x3, xK1K2, 0x11)),
+                           _mm_loadu_si128((const __m128i *)&pbBuffer[ulIdx + 48U]));
+    }
+
+    /*  Fold the four lanes into one.
+    */
+    x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, xK3K4, 0x00), _mm_clmulepi64_si128(x0, xK3K4, 0x11)), x1);
+    x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, xK3K4, 0x00), _mm_clmulepi64_si128(x0, xK3K4, 0x11)), x2);
+    x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, xK3K4, 0x00), _mm_clmulepi64_si128(x0, xK3K4, 0x11)), x3);
+
+    /*  Fold any remaining 16-byte blocks.
+    */
+    for( ; ulIdx < ulLength; ulIdx += 16U)
+    {
+        x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, xK3K4, 0x00), _mm_clmulepi64_si128(x0, xK3K4, 0x11)),
+                           _mm_loadu_si128((const __m128i *)&pbBuffer[ulIdx]));
+    }
+
+    _mm_storeu_si128((__m128i *)pbRemainder, x0);
+}
+
+#else
+
+/** @brief Carry-less multiply the low or high halves of two vectors.
+
+    @param x        The first vector.
+    @param k        The second vector.
+    @param fHigh    Whether to multiply the high halves, rather than the low.
+
+    @return The 128-bit product.
+*/
+__attribute__((target("+crypto")))
+static inline uint64x2_t Clmul(
+    uint64x2_t  x,
+    uint64x2_t  k,
+    bool        fHigh)
+{
+    uint64x2_t  xProduct;
+
+    if(fHigh)
+    {
+        xProduct = vreinterpretq_u64_p128(vmull_high_p64(vreinterpretq_p64_u64(x), vreinterpretq_p64_u64(k)));
+    }
+    else
+    {
+        xProduct = vreinterpretq_u64_p128(vmull_p64((poly64_t)vgetq_lane_u64(x, 0), (poly64_t)vgetq_lane_u64(k, 0)));
+    }
+
+    return xProduct;
+}
+
+
+/** @brief Fold one 16-byte lane into the next block of data.
+
+    @param x        The lane.
+    @param k        The folding constants.
+    @param pbData   The 16 bytes of data.
+
+    @return The folded lane.
+*/
+__attribute__((target("+crypto")))
+static inline uint64x2_t ClmulFoldLane(
+    uint64x2_t      x,
+    uint64x2_t      k,
+    const uint8_t  *pbData)
+{
+    return veorq_u64(veorq_u64(Clmul(x, k, false), Clmul(x, k, true)), vreinterpretq_u64_u8(vld1q_u8(pbData)));
+}
+
+
+/** @brief Fold a buffer with PMULL.
+
+    @param ulCrc32      The CRC of the preceding data, before the final
+                        inversion.
+    @param pbBuffer     The data to fold.
+    @param ulLength     The length of @p pbBuffer; a multiple of 16 which is at
+                        least CLMUL_MIN_LENGTH.
+    @param pbRemainder  Populated with 16 bytes whose CRC, starting from zero
+                        and before the final inversion, is the CRC of the
+                        preceding data and @p pbBuffer.
+*/
+__attribute__((target("+crypto")))
+static void Crc32ClmulFold(
+    uint32_t        ulCrc32,
+    const uint8_t  *pbBuffer,
+    uint32_t        ulLength,
+    uint8_t        *pbRemainder)
+{
+    const uint64x2_t    xK1K2 = vcombine_u64(vcreate_u64(CLMUL_K1), vcreate_u64(CLMUL_K2));
+    const uint64x2_t    xK3K4 = vcombine_u64(vcreate_u64(CLMUL_K3), vcreate_u64(CLMUL_K4));
+    uint64x2_t          x0 = vreinterpretq_u64_u8(vld1q_u8(&pbBuffer[0U]));
+    uint64x2_t          x1 = vreinterpretq_u64_u8(vld1q_u8(&pbBuffer[16U]));
+    uint64x2_t          x2 = vreinterpretq_u64_u8(vld1q_u8(&pbBuffer[32U]));
+    uint64x2_t          x3 = vreinterpretq_u64_u8(vld1q_u8(&pbBuffer[48U]));
+    uint32_t            ulIdx;
+
+    REDASSERT((ulLength >= CLMUL_MIN_LENGTH) && ((ulLength % 16U) == 0U));
+
+    x0 = veorq_u64(x0, vcombine_u64(vcreate_u64(ulCrc32), vcreate_u64(0U)));
+
+    /*  Fold four lanes at a time, each lane 64 bytes ahead of the last.
+    */
+    for(ulIdx = 64U; (ulLength - ulIdx) >= 64U; ulIdx += 64U)
+    {
+        x0 = ClmulFoldLane(x0, xK1K2, &pbBuffer[ulIdx]);
+        x1 = ClmulFoldLane(x1, xK1K2, &pbBuffer[ulIdx + 16U]);
+        x2 = ClmulFoldLane(x2, xK1K2, &pbBuffer[ulIdx + 32U]);
+        x3 = ClmulFoldLane(x3, xK1K2, &pbBuffer[ulIdx + 48U]);
+    }
+
+    /*  Fold the four lanes into one.
+    */
+    x0 = veorq_u64(veorq_u64(Clmul(x0, xK3K4, false), Clmul(x0, xK3K4, true)), x1);
+    x0 = veorq_u64(veorq_u64(Clmul(x0, xK3K4, false), Clmul(x0, xK3K4, true)), x2);
+    x0 = veorq_u64(veorq_u64(Clmul(x0, xK3K4, false), Clmul(x0, xK3K4, true)), x3);
+
+    /*  Fold any remaining 16-byte blocks.
+    */
+    for( ; ulIdx < ulLength; ulIdx += 16U)
+    {
+        x0 = ClmulFoldLane(x0, xK3K4, &pbBuffer[ulIdx]);
+    }
+
+    vst1q_u8(pbRemainder, vreinterpretq_u8_u64(x0));
+}
+
+#endif /* CLMUL_ARCH == CLMUL_ARCH_X86 */
+
+#endif /* CLMUL_ARCH != CLMUL_ARCH_NONE */
+
 #else
 
-#error "REDCONF_CRC_ALGORITHM must be set to CRC_BITWISE, CRC_SARWATE, or CRC_SLICEBY8"
+#error "REDCONF_CRC_ALGORITHM must be set to CRC_BITWISE, CRC_SARWATE, CRC_SLICEBY8, or CRC_CLMUL"
 
 #endif
 
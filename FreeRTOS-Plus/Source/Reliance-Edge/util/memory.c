@@ -25,10 +25,23 @@
 /** @file
     @brief Default implementations of memory manipulation functions.
 
-    These implementations are intended to be small and simple, and thus forego
-    all optimizations.  If the C library is available, or if there are better
-    third-party implementations available in the system, those can be used
-    instead by defining the appropriate macros in redconf.h.
+    By default, these implementations are intended to be small and simple, and
+    thus forego all optimizations.  REDCONF_MEM_ALGORITHM selects faster
+    implementations of RedMemCpy(), RedMemSet(), and RedMemCmp():
+
+    - MEM_BYTEWISE: one byte at a time.  The default.
+    - MEM_WORDWISE: 32-bit words, where the buffers are aligned alike.
+    - MEM_UNROLLED: like MEM_WORDWISE, with four words per loop iteration.
+    - MEM_SIMD: 16-byte SSE2 or NEON vectors, four per loop iteration.  Falls
+      back to MEM_UNROLLED if the compiler does not target either.
+
+    MEM_BYTEWISE is MISRA C compliant.  MEM_WORDWISE and MEM_UNROLLED access
+    byte buffers as words, via the deviations in reddeviations.h; MEM_SIMD
+    uses compiler intrinsics, which are outside of MISRA C altogether.
+
+    If the C library is available, or if there are better third-party
+    implementations available in the system, those can be used instead by
+    defining the appropriate macros in redconf.h.
 
     These functions are not intended to be completely 100% ANSI C compatible
     implementations, but rather are designed to meet the needs of Reliance Edge.
@@ -38,6 +51,43 @@
 #include <redfs.h>
 
 
+#define MEM_BYTEWISE    (0U)
+#define MEM_WORDWISE    (1U)
+#define MEM_UNROLLED    (2U)
+#define MEM_SIMD        (3U)
+
+#if (REDCONF_MEM_ALGORITHM != MEM_BYTEWISE) && (REDCONF_MEM_ALGORITHM != MEM_WORDWISE) && (REDCONF_MEM_ALGORITHM != MEM_UNROLLED) && (REDCONF_MEM_ALGORITHM != MEM_SIMD)
+#error "REDCONF_MEM_ALGORITHM must be set to MEM_BYTEWISE, MEM_WORDWISE, MEM_UNROLLED, or MEM_SIMD"
+#endif
+
+#if (REDCONF_MEM_ALGORITHM == MEM_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define MEM_VECTOR_SSE2 1
+#elif (REDCONF_MEM_ALGORITHM == MEM_SIMD) && defined(__GNUC__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MEM_VECTOR_NEON 1
+#endif
+
+#if defined(MEM_VECTOR_SSE2) || defined(MEM_VECTOR_NEON)
+#define MEM_VECTOR_SIZE (16U)
+#endif
+
+/*  The number of words handled by each iteration of the word loops.
+*/
+#if (REDCONF_MEM_ALGORITHM == MEM_UNROLLED) || (REDCONF_MEM_ALGORITHM == MEM_SIMD)
+#define MEM_WORDS_PER_LOOP  (4U)
+#else
+#define MEM_WORDS_PER_LOOP  (1U)
+#endif
+
+#define MEM_WORD_SIZE       ((uint32_t)sizeof(uint32_t))
+
+/*  Shorter buffers are handled a byte at a time, since aligning them costs
+    more than words save.
+*/
+#define MEM_MIN_WORD_LEN    (MEM_WORD_SIZE * 4U)
+
+
 #ifndef RedMemCpyUnchecked
 static void RedMemCpyUnchecked(void *pDest, const void *pSrc, uint32_t ulLen);
 #endif
@@ -93,11 +143,93 @@ static void RedMemCpyUnchecked(
 {
     uint8_t        *pbDest = CAST_VOID_PTR_TO_UINT8_PTR(pDest);
     const uint8_t  *pbSrc = CAST_VOID_PTR_TO_CONST_UINT8_PTR(pSrc);
-    uint32_t        ulIdx;
+    uint32_t        ulIdx = 0U;
 
-    for(ulIdx = 0U; ulIdx < ulLen; ulIdx++)
+  #if defined(MEM_VECTOR_SIZE)
+    /*  Vector loads and stores need no alignment.
+    */
+    while((ulLen - ulIdx) >= (MEM_VECTOR_SIZE * 4U))
+    {
+      #if defined(MEM_VECTOR_SSE2)
+        __m128i x0 = _mm_loadu_si128((const __m128i *)&pbSrc[ulIdx]);
+        __m128i x1 = _mm_loadu_si128((const __m128i *)&pbSrc[ulIdx + 16U]);
+        __m128i x2 = _mm_loadu_si128((const __m128i *)&pbSrc[ulIdx + 32U]);
+        __m128i x3 = _mm_loadu_si128((const __m128i *)&pbSrc[ulIdx + 48U]);
+
+        _mm_storeu_si128((__m128i *)&pbDest[ulIdx], x0);
+        _mm_storeu_si128((__m128i *)&pbDest[ulIdx + 16U], x1);
+        _mm_storeu_si128((__m128i *)&pbDest[ulIdx + 32U], x2);
+        _mm_storeu_si128((__m128i *)&pbDest[ulIdx + 48U], x3);
+      #else
+        uint8x16_t x0 = vld1q_u8(&pbSrc[ulIdx]);
+        uint8x16_t x1 = vld1q_u8(&pbSrc[ulIdx + 16U]);
+        uint8x16_t x2 = vld1q_u8(&pbSrc[ulIdx + 32U]);
+        uint8x16_t x3 = vld1q_u8(&pbSrc[ulIdx + 48U]);
+
+        vst1q_u8(&pbDest[ulIdx], x0);
+        vst1q_u8(&pbDest[ulIdx + 16U], x1);
+        vst1q_u8(&pbDest[ulIdx + 32U], x2);
+        vst1q_u8(&pbDest[ulIdx + 48U], x3);
+      #endif
+
+        ulIdx += MEM_VECTOR_SIZE * 4U;
+    }
+
+    while((ulLen - ulIdx) >= MEM_VECTOR_SIZE)
+    {
+      #if defined(MEM_VECTOR_SSE2)
+        _mm_storeu_si128((__m128i *)&pbDest[ulIdx], _mm_loadu_si128((const __m128i *)&pbSrc[ulIdx]));
+      #else
+        vst1q_u8(&pbDest[ulIdx], vld1q_u8(&pbSrc[ulIdx]));
+      #endif
+
+        ulIdx += MEM_VECTOR_SIZE;
+    }
+  #elif REDCONF_MEM_ALGORITHM != MEM_BYTEWISE
+    if(ulLen >= MEM_MIN_WORD_LEN)
+    {
+        /*  Copy bytes until the destination is aligned.  If the source is then
+            aligned too, the bulk of the copy can be done with words.
+        */
+        while(!IS_UINT32_ALIGNED_PTR(&pbDest[ulIdx]))
+        {
+            pbDest[ulIdx] = pbSrc[ulIdx];
+            ulIdx++;
+        }
+
+        if(IS_UINT32_ALIGNED_PTR(&pbSrc[ulIdx]))
+        {
+            uint32_t       *pulDest = CAST_UINT32_PTR(&pbDest[ulIdx]);
+            const uint32_t *pulSrc = CAST_CONST_UINT32_PTR(&pbSrc[ulIdx]);
+            uint32_t        ulWords = (ulLen - ulIdx) / (MEM_WORD_SIZE * MEM_WORDS_PER_LOOP);
+            uint32_t        ulWordIdx;
+
+            for(ulWordIdx = 0U; ulWordIdx < (ulWords * MEM_WORDS_PER_LOOP); ulWordIdx += MEM_WORDS_PER_LOOP)
+            {
+              #if MEM_WORDS_PER_LOOP == 4U
+                uint32_t ulWord0 = pulSrc[ulWordIdx];
+                uint32_t ulWord1 = pulSrc[ulWordIdx + 1U];
+                uint32_t ulWord2 = pulSrc[ulWordIdx + 2U];
+                uint32_t ulWord3 = pulSrc[ulWordIdx + 3U];
+
+                pulDest[ulWordIdx] = ulWord0;
+                pulDest[ulWordIdx + 1U] = ulWord1;
+                pulDest[ulWordIdx + 2U] = ulWord2;
+                pulDest[ulWordIdx + 3U] = ulWord3;
+              #else
+                pulDest[ulWordIdx] = pulSrc[ulWordIdx];
+              #endif
+            }
+
+            ulIdx += ulWords * MEM_WORDS_PER_LOOP * MEM_WORD_SIZE;
+        }
+    }
+  #endif
+
+    while(ulIdx < ulLen)
     {
         pbDest[ulIdx] = pbSrc[ulIdx];
+        ulIdx++;
     }
 }
 #endif
@@ -213,11 +345,80 @@ static void RedMemSetUnchecked(
     uint32_t    ulLen)
 {
     uint8_t    *pbDest = CAST_VOID_PTR_TO_UINT8_PTR(pDest);
-    uint32_t    ulIdx;
+    uint32_t    ulIdx = 0U;
+
+  #if defined(MEM_VECTOR_SIZE)
+    if(ulLen >= MEM_VECTOR_SIZE)
+    {
+      #if defined(MEM_VECTOR_SSE2)
+        __m128i x = _mm_set1_epi8((char)bVal);
+      #else
+        uint8x16_t x = vdupq_n_u8(bVal);
+      #endif
+
+        while((ulLen - ulIdx) >= (MEM_VECTOR_SIZE * 4U))
+        {
+          #if defined(MEM_VECTOR_SSE2)
+            _mm_storeu_si128((__m128i *)&pbDest[ulIdx], x);
+            _mm_storeu_si128((__m128i *)&pbDest[ulIdx + 16U], x);
+            _mm_storeu_si128((__m128i *)&pbDest[ulIdx + 32U], x);
+            _mm_storeu_si128((__m128i *)&pbDest[ulIdx + 48U], x);
+          #else
+            vst1q_u8(&pbDest[ulIdx], x);
+            vst1q_u8(&pbDest[ulIdx + 16U], x);
+            vst1q_u8(&pbDest[ulIdx + 32U], x);
+            vst1q_u8(&pbDest[ulIdx + 48U], x);
+          #endif
+
+            ulIdx += MEM_VECTOR_SIZE * 4U;
+        }
+
+        while((ulLen - ulIdx) >= MEM_VECTOR_SIZE)
+        {
+          #if defined(MEM_VECTOR_SSE2)
+            _mm_storeu_si128((__m128i *)&pbDest[ulIdx], x);
+          #else
+            vst1q_u8(&pbDest[ulIdx], x);
+          #endif
+
+            ulIdx += MEM_VECTOR_SIZE;
+        }
+    }
+  #elif REDCONF_MEM_ALGORITHM != MEM_BYTEWISE
+    if(ulLen >= MEM_MIN_WORD_LEN)
+    {
+        uint32_t   *pulDest;
+        uint32_t    ulWord = (uint32_t)bVal * 0x01010101U;
+        uint32_t    ulWords;
+        uint32_t    ulWordIdx;
+
+        while(!IS_UINT32_ALIGNED_PTR(&pbDest[ulIdx]))
+        {
+            pbDest[ulIdx] = bVal;
+            ulIdx++;
+        }
+
+        pulDest = CAST_UINT32_PTR(&pbDest[ulIdx]);
+        ulWords = (ulLen - ulIdx) / (MEM_WORD_SIZE * MEM_WORDS_PER_LOOP);
+
+        for(ulWordIdx = 0U; ulWordIdx < (ulWords * MEM_WORDS_PER_LOOP); ulWordIdx += MEM_WORDS_PER_LOOP)
+        {
+            pulDest[ulWordIdx] = ulWord;
+          #if MEM_WORDS_PER_LOOP == 4U
+            pulDest[ulWordIdx + 1U] = ulWord;
+            pulDest[ulWordIdx + 2U] = ulWord;
+            pulDest[ulWordIdx + 3U] = ulWord;
+          #endif
+        }
+
+        ulIdx += ulWords * MEM_WORDS_PER_LOOP * MEM_WORD_SIZE;
+    }
+  #endif
 
-    for(ulIdx = 0U; ulIdx < ulLen; ulIdx++)
+    while(ulIdx < ulLen)
     {
         pbDest[ulIdx] = bVal;
+        ulIdx++;
     }
 }
 #endif
@@ -277,6 +478,67 @@ static int32_t RedMemCmpUnchecked(
     uint32_t        ulIdx = 0U;
     int32_t         lResult;
 
+  #if defined(MEM_VECTOR_SIZE)
+    /*  Skip the equal vectors.  The first difference, if any, is then found
+        by comparing bytes.
+    */
+    while((ulLen - ulIdx) >= MEM_VECTOR_SIZE)
+    {
+      #if defined(MEM_VECTOR_SSE2)
+        __m128i xEq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&pbMem1[ulIdx]), _mm_loadu_si128((const __m128i *)&pbMem2[ulIdx]));
+
+        if(_mm_movemask_epi8(xEq) != 0xFFFF)
+        {
+            break;
+        }
+      #else
+        uint64x2_t xEq = vreinterpretq_u64_u8(vceqq_u8(vld1q_u8(&pbMem1[ulIdx]), vld1q_u8(&pbMem2[ulIdx])));
+
+        if((vgetq_lane_u64(xEq, 0) & vgetq_lane_u64(xEq, 1)) != UINT64_MAX)
+        {
+            break;
+        }
+      #endif
+
+        ulIdx += MEM_VECTOR_SIZE;
+    }
+  #elif REDCONF_MEM_ALGORITHM != MEM_BYTEWISE
+    if(ulLen >= MEM_MIN_WORD_LEN)
+    {
+        while(!IS_UINT32_ALIGNED_PTR(&pbMem1[ulIdx]) && (pbMem1[ulIdx] == pbMem2[ulIdx]))
+        {
+            ulIdx++;
+        }
+
+        if(IS_UINT32_ALIGNED_PTR(&pbMem1[ulIdx]) && IS_UINT32_ALIGNED_PTR(&pbMem2[ulIdx]))
+        {
+            const uint32_t *pulMem1 = CAST_CONST_UINT32_PTR(&pbMem1[ulIdx]);
+            const uint32_t *pulMem2 = CAST_CONST_UINT32_PTR(&pbMem2[ulIdx]);
+            uint32_t        ulWords = (ulLen - ulIdx) / MEM_WORD_SIZE;
+            uint32_t        ulWordIdx = 0U;
+
+            /*  Skip the equal words.  The first difference, if any, is then
+                found by comparing bytes.
+            */
+          #if MEM_WORDS_PER_LOOP == 4U
+            while(    ((ulWords - ulWordIdx) >= 4U)
+                   && (((pulMem1[ulWordIdx] ^ pulMem2[ulWordIdx]) | (pulMem1[ulWordIdx + 1U] ^ pulMem2[ulWordIdx + 1U])
+                      | (pulMem1[ulWordIdx + 2U] ^ pulMem2[ulWordIdx + 2U]) | (pulMem1[ulWordIdx + 3U] ^ pulMem2[ulWordIdx + 3U])) == 0U))
+            {
+                ulWordIdx += 4U;
+            }
+          #endif
+
+            while((ulWordIdx < ulWords) && (pulMem1[ulWordIdx] == pulMem2[ulWordIdx]))
+            {
+                ulWordIdx++;
+            }
+
+            ulIdx += ulWordIdx * MEM_WORD_SIZE;
+        }
+    }
+  #endif
+
     while((ulIdx < ulLen) && (pbMem1[ulIdx] == pbMem2[ulIdx]))
     {
         ulIdx++;
@@ -0,0 +1,534 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the memory pool API.
+ *
+ * prvSingleTaskTests() checks blocks are distinct, aligned and reused in LIFO
+ * order, that allocating from an empty pool fails (after the block time if one
+ * is specified), and that the statistics are maintained.
+ *
+ * The "holder" task allocates every block from a pool, then gives a higher
+ * priority "waiter" task a notification.  The waiter blocks trying to allocate
+ * from the empty pool, and must be given the next block the holder frees.
+ *
+ * vMemoryPoolPeriodicISR() allocates blocks from an interrupt and passes them
+ * to the "ISR receiver" task through a queue.  The task checks each block then
+ * passes it back to the interrupt through a second queue, and the interrupt
+ * frees it.  The ISR pool is created using statically allocated memory if
+ * configSUPPORT_STATIC_ALLOCATION is 1.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "mempool.h"
+
+/* Demo program include files. */
+#include "MemoryPoolDemo.h"
+
+/* A block time of 0 just means "don't block". */
+#define mpDONT_BLOCK				0
+
+/* The block time used when an allocation is expected to fail. */
+#define mpSHORT_DELAY				pdMS_TO_TICKS( ( TickType_t ) 5 )
+
+/* The number of blocks in the pool shared by the holder and waiter tasks. */
+#define mpSHARED_POOL_BLOCKS		4
+
+/* The number of blocks in the pool used from the interrupt, and the number of
+tick interrupts between each allocation. */
+#define mpISR_POOL_BLOCKS			3
+#define mpISR_TICKS_BETWEEN_ALLOCS	4
+
+/* The size of the blocks allocated by the tasks.  Deliberately not a multiple
+of portBYTE_ALIGNMENT so the rounding is tested. */
+#define mpBLOCK_SIZE				13
+
+/* The item held in the blocks allocated from the interrupt. */
+typedef struct ISR_BLOCK
+{
+	uint32_t ulSequence;
+	uint32_t ulCheck;
+} ISRBlock_t;
+
+/*
+ * Tests performed on a pool that no other task is using.
+ */
+static void prvSingleTaskTests( void );
+
+/*
+ * The tasks that demonstrate blocking on an empty pool.
+ */
+static void prvHolderTask( void *pvParameters );
+static void prvWaiterTask( void *pvParameters );
+
+/*
+ * The task that receives the blocks allocated by vMemoryPoolPeriodicISR().
+ */
+static void prvISRReceiverTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The pool shared by the holder and waiter tasks. */
+static MemoryPoolHandle_t xSharedPool = NULL;
+
+/* The pool used by the interrupt, and the queues used to pass blocks from the
+interrupt to the ISR receiver task and back again. */
+static MemoryPoolHandle_t xISRPool = NULL;
+static QueueHandle_t xISRToTaskQueue = NULL, xTaskToISRQueue = NULL;
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* The storage area must be aligned to portBYTE_ALIGNMENT.  The union
+	achieves that on ports where portBYTE_ALIGNMENT is 8 or less. */
+	static StaticMemoryPool_t xStaticISRPool;
+	static union
+	{
+		uint8_t ucBytes[ mempoolSTORAGE_SIZE_BYTES( mpISR_POOL_BLOCKS, sizeof( ISRBlock_t ) ) ];
+		uint64_t ullAlignment;
+		void *pvAlignment;
+	} xISRPoolStorage;
+#endif
+
+/* The waiter task is notified by the holder task. */
+static TaskHandle_t xWaiterTask = NULL;
+
+/* The block the holder task frees while the waiter task is blocked, and the
+block the waiter task obtained. */
+static void * volatile pvBlockFreedByHolder = NULL;
+static void * volatile pvBlockObtainedByWaiter = NULL;
+
+/* Incremented on each successful cycle so the check task knows the tasks are
+still running. */
+static volatile uint32_t ulHolderCycles = 0, ulWaiterCycles = 0, ulISRReceiverCycles = 0;
+
+/* Latched to pdFAIL if an error is found. */
+static volatile BaseType_t xErrorStatus = pdPASS;
+
+/*-----------------------------------------------------------*/
+
+void vStartMemoryPoolTasks( UBaseType_t uxPriority )
+{
+	xSharedPool = xMemoryPoolCreate( mpSHARED_POOL_BLOCKS, mpBLOCK_SIZE );
+	configASSERT( xSharedPool );
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		xISRPool = xMemoryPoolCreateStatic( mpISR_POOL_BLOCKS, sizeof( ISRBlock_t ), xISRPoolStorage.ucBytes, &xStaticISRPool );
+	}
+	#else
+	{
+		xISRPool = xMemoryPoolCreate( mpISR_POOL_BLOCKS, sizeof( ISRBlock_t ) );
+	}
+	#endif
+	configASSERT( xISRPool );
+
+	/* The queues can hold every block in the pool, so sending to them never
+	fails. */
+	xISRToTaskQueue = xQueueCreate( mpISR_POOL_BLOCKS, sizeof( ISRBlock_t * ) );
+	xTaskToISRQueue = xQueueCreate( mpISR_POOL_BLOCKS, sizeof( ISRBlock_t * ) );
+	configASSERT( xISRToTaskQueue );
+	configASSERT( xTaskToISRQueue );
+
+	vQueueAddToRegistry( xISRToTaskQueue, "MPool_ISR_Tx" );
+	vQueueAddToRegistry( xTaskToISRQueue, "MPool_ISR_Rx" );
+
+	/* The waiter has the higher priority so it is given a freed block as soon
+	as the holder frees it. */
+	xTaskCreate( prvHolderTask, "MPHld", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvWaiterTask, "MPWt", configMINIMAL_STACK_SIZE, NULL, uxPriority + 1, &xWaiterTask );
+	xTaskCreate( prvISRReceiverTask, "MPISR", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSingleTaskTests( void )
+{
+MemoryPoolHandle_t xPool;
+MemoryPoolStats_t xStats;
+uint8_t *pucBlocks[ mpSHARED_POOL_BLOCKS ];
+void *pvBlock;
+BaseType_t x, y;
+TickType_t xTimeBefore;
+
+	xPool = xMemoryPoolCreate( mpSHARED_POOL_BLOCKS, mpBLOCK_SIZE );
+	configASSERT( xPool );
+
+	/* Allocate every block.  The blocks must be distinct, aligned, and large
+	enough not to overlap. */
+	for( x = 0; x < mpSHARED_POOL_BLOCKS; x++ )
+	{
+		pucBlocks[ x ] = ( uint8_t * ) pvMemoryPoolAllocate( xPool, mpDONT_BLOCK );
+
+		if( pucBlocks[ x ] == NULL )
+		{
+			xErrorStatus = pdFAIL;
+			return;
+		}
+
+		if( ( ( ( size_t ) pucBlocks[ x ] ) & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		for( y = 0; y < mpBLOCK_SIZE; y++ )
+		{
+			pucBlocks[ x ][ y ] = ( uint8_t ) x;
+		}
+	}
+
+	for( x = 0; x < mpSHARED_POOL_BLOCKS; x++ )
+	{
+		for( y = 0; y < mpBLOCK_SIZE; y++ )
+		{
+			if( pucBlocks[ x ][ y ] != ( uint8_t ) x )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+	}
+
+	/* The pool is empty, so allocating without blocking fails at once, and
+	allocating with a block time fails after the block time. */
+	if( pvMemoryPoolAllocate( xPool, mpDONT_BLOCK ) != NULL )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	xTimeBefore = xTaskGetTickCount();
+
+	if( pvMemoryPoolAllocate( xPool, mpSHORT_DELAY ) != NULL )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	if( ( xTaskGetTickCount() - xTimeBefore ) < mpSHORT_DELAY )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	if( uxMemoryPoolGetFreeBlockCount( xPool ) != 0 )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	/* Free the blocks in order.  Blocks are reused LIFO, so the last block
+	freed is the next block allocated. */
+	for( x = 0; x < mpSHARED_POOL_BLOCKS; x++ )
+	{
+		vMemoryPoolFree( xPool, pucBlocks[ x ] );
+	}
+
+	pvBlock = pvMemoryPoolAllocate( xPool, mpDONT_BLOCK );
+
+	if( pvBlock != ( void * ) pucBlocks[ mpSHARED_POOL_BLOCKS - 1 ] )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	vMemoryPoolFree( xPool, pvBlock );
+
+	/* Check the statistics. */
+	vMemoryPoolGetStats( xPool, &xStats );
+
+	if( ( xStats.uxBlockCount != mpSHARED_POOL_BLOCKS ) ||
+		( xStats.uxFreeBlocks != mpSHARED_POOL_BLOCKS ) ||
+		( xStats.uxMaximumBlocksInUse != mpSHARED_POOL_BLOCKS ) ||
+		( xStats.ulAllocations != ( mpSHARED_POOL_BLOCKS + 1 ) ) ||
+		( xStats.ulAllocationFailures != 2 ) ||
+		( xStats.xBlockSize < mpBLOCK_SIZE ) ||
+		( ( xStats.xBlockSize & portBYTE_ALIGNMENT_MASK ) != 0 ) )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	vMemoryPoolDelete( xPool );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHolderTask( void *pvParameters )
+{
+void *pvBlocks[ mpSHARED_POOL_BLOCKS ];
+BaseType_t x;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	prvSingleTaskTests();
+
+	for( ;; )
+	{
+		/* Take every block in the pool.  The waiter task has returned the
+		block it had the last time around. */
+		for( x = 0; x < mpSHARED_POOL_BLOCKS; x++ )
+		{
+			pvBlocks[ x ] = pvMemoryPoolAllocate( xSharedPool, mpDONT_BLOCK );
+
+			if( pvBlocks[ x ] == NULL )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+
+		/* Let the waiter run.  It has the higher priority so it runs straight
+		away, and blocks on the empty pool. */
+		xTaskNotifyGive( xWaiterTask );
+
+		#if( configUSE_PREEMPTION == 0 )
+			taskYIELD();
+		#endif
+
+		if( eTaskGetState( xWaiterTask ) != eBlocked )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		/* Freeing a block unblocks the waiter, which must be given the block
+		that was freed, and which frees the block again before this task runs
+		again. */
+		pvBlockFreedByHolder = pvBlocks[ 0 ];
+		vMemoryPoolFree( xSharedPool, pvBlocks[ 0 ] );
+
+		#if( configUSE_PREEMPTION == 0 )
+			taskYIELD();
+		#endif
+
+		if( pvBlockObtainedByWaiter != pvBlockFreedByHolder )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( uxMemoryPoolGetFreeBlockCount( xSharedPool ) != 1 )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		pvBlockObtainedByWaiter = NULL;
+
+		for( x = 1; x < mpSHARED_POOL_BLOCKS; x++ )
+		{
+			vMemoryPoolFree( xSharedPool, pvBlocks[ x ] );
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulHolderCycles++;
+		}
+
+		#if( configUSE_PREEMPTION == 0 )
+			taskYIELD();
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+void *pvBlock;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Wait for the holder task to empty the pool. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		/* Block until the holder task frees a block. */
+		pvBlock = pvMemoryPoolAllocate( xSharedPool, portMAX_DELAY );
+
+		if( pvBlock == NULL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+		else
+		{
+			pvBlockObtainedByWaiter = pvBlock;
+			vMemoryPoolFree( xSharedPool, pvBlock );
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulWaiterCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvISRReceiverTask( void *pvParameters )
+{
+ISRBlock_t *pxBlock;
+uint32_t ulExpectedSequence = 0;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xQueueReceive( xISRToTaskQueue, &pxBlock, portMAX_DELAY );
+
+		if( ( pxBlock->ulSequence != ulExpectedSequence ) || ( pxBlock->ulCheck != ~( pxBlock->ulSequence ) ) )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		ulExpectedSequence = pxBlock->ulSequence + 1;
+
+		/* Pass the block back to the interrupt to be freed. */
+		if( xQueueSend( xTaskToISRQueue, &pxBlock, mpDONT_BLOCK ) != pdPASS )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulISRReceiverCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolPeriodicISR( void )
+{
+static uint32_t ulCallCount = 0, ulSequence = 0;
+ISRBlock_t *pxBlock;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook().  The last parameter of the FromISR
+	functions is not used because the tick hook cannot request a context
+	switch. */
+
+	if( xISRPool == NULL )
+	{
+		return;
+	}
+
+	/* Free any blocks the task has finished with. */
+	while( xQueueReceiveFromISR( xTaskToISRQueue, &pxBlock, NULL ) != pdFALSE )
+	{
+		vMemoryPoolFreeFromISR( xISRPool, pxBlock, NULL );
+	}
+
+	ulCallCount++;
+
+	if( ( ulCallCount % mpISR_TICKS_BETWEEN_ALLOCS ) == 0 )
+	{
+		pxBlock = ( ISRBlock_t * ) pvMemoryPoolAllocateFromISR( xISRPool );
+
+		/* pxBlock is NULL if the task has not kept up, in which case nothing
+		is sent. */
+		if( pxBlock != NULL )
+		{
+			pxBlock->ulSequence = ulSequence;
+			pxBlock->ulCheck = ~ulSequence;
+			ulSequence++;
+
+			if( xQueueSendFromISR( xISRToTaskQueue, &pxBlock, NULL ) != pdPASS )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreMemoryPoolTasksStillRunning( void )
+{
+static uint32_t ulLastHolderCycles = 0, ulLastWaiterCycles = 0, ulLastISRReceiverCycles = 0;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorStatus != pdPASS )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Each task must have completed at least one cycle since the last time
+	this function was called. */
+	if( ulHolderCycles == ulLastHolderCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulWaiterCycles == ulLastWaiterCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulISRReceiverCycles == ulLastISRReceiverCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastHolderCycles = ulHolderCycles;
+	ulLastWaiterCycles = ulWaiterCycles;
+	ulLastISRReceiverCycles = ulISRReceiverCycles;
+
+	return xReturn;
+}
+
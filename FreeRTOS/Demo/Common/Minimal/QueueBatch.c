@@ -0,0 +1,454 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the batch queue functions xQueueSendMultiple(),
+ * xQueueReceiveMultiple(), xQueueSendMultipleFromISR() and
+ * xQueueReceiveMultipleFromISR().
+ *
+ * A sender task posts batches of incrementing numbers to a queue, and a
+ * receiver task reads them back in batches of a different size, so the items
+ * wrap around the end of the queue storage area at a different point in each
+ * batch.  The receiver checks no numbers are lost, duplicated or reordered.
+ *
+ * vQueueBatchPeriodicISR() posts batches of numbers to a second queue from an
+ * interrupt.  A third task receives them, checks them, then posts them to a
+ * third queue, from which the interrupt receives them and checks them again.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "QueueBatch.h"
+
+/* A block time of 0 just means "don't block". */
+#define qbDONT_BLOCK				0
+
+/* The time the ISR loop back task waits for space in the queue read by the
+interrupt. */
+#define qbBLOCK_TIME				pdMS_TO_TICKS( 100 )
+
+/* The length of the queue used by the sender and receiver tasks.  The batch
+sizes are chosen so they do not divide into the queue length. */
+#define qbQUEUE_LENGTH				10
+#define qbSEND_BATCH_SIZE			7
+#define qbRECEIVE_BATCH_SIZE		4
+
+/* The length of the queues used with the interrupt, the number of items the
+interrupt sends in each batch, and the number of tick interrupts between each
+batch. */
+#define qbISR_QUEUE_LENGTH			8
+#define qbISR_BATCH_SIZE			3
+#define qbISR_TICKS_BETWEEN_SENDS	3
+
+/*
+ * The task that posts batches of numbers to xTaskQueue.
+ */
+static void prvBatchSenderTask( void *pvParameters );
+
+/*
+ * The task that receives batches of numbers from xTaskQueue.
+ */
+static void prvBatchReceiverTask( void *pvParameters );
+
+/*
+ * The task that receives the numbers sent by vQueueBatchPeriodicISR() and
+ * sends them back to the interrupt.
+ */
+static void prvBatchISRLoopBackTask( void *pvParameters );
+
+/*
+ * Tests performed on a queue that no other task is using.
+ */
+static void prvSingleTaskTests( void );
+
+/*-----------------------------------------------------------*/
+
+/* The queue used by the sender and receiver tasks. */
+static QueueHandle_t xTaskQueue = NULL;
+
+/* The queues sent to and received from by the interrupt respectively. */
+static QueueHandle_t xISRTxQueue = NULL, xISRRxQueue = NULL;
+
+/* Incremented on each successful cycle so the check task knows the tasks and
+the interrupt are still running. */
+static volatile uint32_t ulSenderCycles = 0, ulReceiverCycles = 0, ulLoopBackCycles = 0, ulISRCycles = 0;
+
+/* Latched to pdFAIL if an error is found. */
+static volatile BaseType_t xErrorStatus = pdPASS;
+
+/*-----------------------------------------------------------*/
+
+void vStartQueueBatchTasks( UBaseType_t uxPriority )
+{
+	xTaskQueue = xQueueCreate( qbQUEUE_LENGTH, ( UBaseType_t ) sizeof( uint32_t ) );
+	xISRTxQueue = xQueueCreate( qbISR_QUEUE_LENGTH, ( UBaseType_t ) sizeof( uint32_t ) );
+	xISRRxQueue = xQueueCreate( qbISR_QUEUE_LENGTH, ( UBaseType_t ) sizeof( uint32_t ) );
+	configASSERT( xTaskQueue );
+	configASSERT( xISRTxQueue );
+	configASSERT( xISRRxQueue );
+
+	vQueueAddToRegistry( xTaskQueue, "Batch_Task_Queue" );
+	vQueueAddToRegistry( xISRTxQueue, "Batch_ISR_Tx" );
+	vQueueAddToRegistry( xISRRxQueue, "Batch_ISR_Rx" );
+
+	xTaskCreate( prvBatchSenderTask, "QBTx", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvBatchReceiverTask, "QBRx", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvBatchISRLoopBackTask, "QBISR", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSingleTaskTests( void )
+{
+QueueHandle_t xQueue;
+uint32_t ulItems[ qbQUEUE_LENGTH + 1 ], ul;
+
+	xQueue = xQueueCreate( qbQUEUE_LENGTH, ( UBaseType_t ) sizeof( uint32_t ) );
+	configASSERT( xQueue );
+
+	for( ul = 0; ul < ( qbQUEUE_LENGTH + 1 ); ul++ )
+	{
+		ulItems[ ul ] = ul;
+	}
+
+	/* Nothing can be received from an empty queue. */
+	if( xQueueReceiveMultiple( xQueue, ulItems, qbQUEUE_LENGTH, qbDONT_BLOCK ) != 0 )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	/* Only as many items as there is space for are sent. */
+	if( xQueueSendMultiple( xQueue, ulItems, qbQUEUE_LENGTH + 1, qbDONT_BLOCK ) != qbQUEUE_LENGTH )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	/* Nothing can be sent to a full queue. */
+	if( xQueueSendMultiple( xQueue, ulItems, 1, qbDONT_BLOCK ) != 0 )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	/* Items sent in a batch can be received one at a time, and items sent
+	one at a time can be received in a batch. */
+	if( xQueueReceive( xQueue, &ul, qbDONT_BLOCK ) != pdPASS )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	if( ul != 0 )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	ul = qbQUEUE_LENGTH;
+	if( xQueueSend( xQueue, &ul, qbDONT_BLOCK ) != pdPASS )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	/* Receive everything, which wraps around the end of the storage area. */
+	if( xQueueReceiveMultiple( xQueue, ulItems, qbQUEUE_LENGTH + 1, qbDONT_BLOCK ) != qbQUEUE_LENGTH )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	for( ul = 0; ul < qbQUEUE_LENGTH; ul++ )
+	{
+		if( ulItems[ ul ] != ( ul + 1 ) )
+		{
+			xErrorStatus = pdFAIL;
+		}
+	}
+
+	if( uxQueueMessagesWaiting( xQueue ) != 0 )
+	{
+		xErrorStatus = pdFAIL;
+	}
+
+	vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchSenderTask( void *pvParameters )
+{
+uint32_t ulItems[ qbSEND_BATCH_SIZE ], ulNext = 0;
+UBaseType_t uxSent, ux;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	prvSingleTaskTests();
+
+	for( ;; )
+	{
+		for( ux = 0; ux < qbSEND_BATCH_SIZE; ux++ )
+		{
+			ulItems[ ux ] = ulNext;
+			ulNext++;
+		}
+
+		/* Fewer items than requested may be sent if there is not enough space
+		in the queue, so keep going until the whole batch has been sent. */
+		uxSent = 0;
+		while( uxSent < qbSEND_BATCH_SIZE )
+		{
+			uxSent += ( UBaseType_t ) xQueueSendMultiple( xTaskQueue, &( ulItems[ uxSent ] ), qbSEND_BATCH_SIZE - uxSent, portMAX_DELAY );
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulSenderCycles++;
+		}
+
+		#if( configUSE_PREEMPTION == 0 )
+			taskYIELD();
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchReceiverTask( void *pvParameters )
+{
+uint32_t ulItems[ qbRECEIVE_BATCH_SIZE ], ulExpected = 0;
+UBaseType_t uxReceived, ux;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		uxReceived = ( UBaseType_t ) xQueueReceiveMultiple( xTaskQueue, ulItems, qbRECEIVE_BATCH_SIZE, portMAX_DELAY );
+
+		if( ( uxReceived == 0 ) || ( uxReceived > qbRECEIVE_BATCH_SIZE ) )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		for( ux = 0; ux < uxReceived; ux++ )
+		{
+			if( ulItems[ ux ] != ulExpected )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			ulExpected = ulItems[ ux ] + 1;
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulReceiverCycles++;
+		}
+
+		#if( configUSE_PREEMPTION == 0 )
+			taskYIELD();
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchISRLoopBackTask( void *pvParameters )
+{
+uint32_t ulItems[ qbISR_QUEUE_LENGTH ], ulExpected = 0;
+UBaseType_t uxReceived, uxSent, ux;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		uxReceived = ( UBaseType_t ) xQueueReceiveMultiple( xISRTxQueue, ulItems, qbISR_QUEUE_LENGTH, portMAX_DELAY );
+
+		for( ux = 0; ux < uxReceived; ux++ )
+		{
+			if( ulItems[ ux ] != ulExpected )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			ulExpected = ulItems[ ux ] + 1;
+		}
+
+		/* Send the items back to the interrupt, which drains the queue each
+		tick so the block time should not be reached. */
+		uxSent = 0;
+		while( uxSent < uxReceived )
+		{
+			ux = ( UBaseType_t ) xQueueSendMultiple( xISRRxQueue, &( ulItems[ uxSent ] ), uxReceived - uxSent, qbBLOCK_TIME );
+
+			if( ux == 0 )
+			{
+				xErrorStatus = pdFAIL;
+				break;
+			}
+
+			uxSent += ux;
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulLoopBackCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vQueueBatchPeriodicISR( void )
+{
+static uint32_t ulCallCount = 0, ulNextToSend = 0, ulExpected = 0;
+uint32_t ulItems[ qbISR_BATCH_SIZE ];
+UBaseType_t uxReceived, ux;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook().  The last parameter of the FromISR
+	functions is not used because the tick hook cannot request a context
+	switch. */
+
+	if( xISRTxQueue == NULL )
+	{
+		return;
+	}
+
+	/* Receive anything the loop back task has sent back. */
+	uxReceived = ( UBaseType_t ) xQueueReceiveMultipleFromISR( xISRRxQueue, ulItems, qbISR_BATCH_SIZE, NULL );
+
+	for( ux = 0; ux < uxReceived; ux++ )
+	{
+		if( ulItems[ ux ] != ulExpected )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		ulExpected = ulItems[ ux ] + 1;
+	}
+
+	if( ( uxReceived != 0 ) && ( xErrorStatus == pdPASS ) )
+	{
+		ulISRCycles++;
+	}
+
+	ulCallCount++;
+
+	if( ( ulCallCount % qbISR_TICKS_BETWEEN_SENDS ) == 0 )
+	{
+		for( ux = 0; ux < qbISR_BATCH_SIZE; ux++ )
+		{
+			ulItems[ ux ] = ulNextToSend + ( uint32_t ) ux;
+		}
+
+		/* Items that do not fit are simply not sent, so only advance the
+		sequence by the number of items actually sent. */
+		ulNextToSend += ( uint32_t ) xQueueSendMultipleFromISR( xISRTxQueue, ulItems, qbISR_BATCH_SIZE, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreQueueBatchTasksStillRunning( void )
+{
+static uint32_t ulLastSenderCycles = 0, ulLastReceiverCycles = 0, ulLastLoopBackCycles = 0, ulLastISRCycles = 0;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorStatus != pdPASS )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* The tasks and the interrupt must each have completed at least one cycle
+	since the last time this function was called. */
+	if( ulSenderCycles == ulLastSenderCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulReceiverCycles == ulLastReceiverCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulLoopBackCycles == ulLastLoopBackCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulISRCycles == ulLastISRCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastSenderCycles = ulSenderCycles;
+	ulLastReceiverCycles = ulReceiverCycles;
+	ulLastLoopBackCycles = ulLoopBackCycles;
+	ulLastISRCycles = ulISRCycles;
+
+	return xReturn;
+}
+
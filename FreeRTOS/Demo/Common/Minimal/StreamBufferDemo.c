@@ -0,0 +1,496 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the stream buffer and message buffer API defined in sbuffer.h.
+ *
+ * vStreamBufferPeriodicISR() writes an incrementing byte sequence to a stream
+ * buffer from the tick interrupt.  The "SBRx" task reads the stream with a
+ * trigger level greater than one, and checks no bytes are lost, duplicated or
+ * reordered.
+ *
+ * The "MBTx" task sends variable length messages to a message buffer, and the
+ * "MBRx" task receives them.  MBTx has the higher priority so it fills the
+ * message buffer and blocks until MBRx makes space.  Each cycle MBTx also runs
+ * a set of single task tests on a separate buffer to check the behaviour when
+ * a buffer is full, empty, or too small for the next message.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sbuffer.h"
+
+/* Demo program include files. */
+#include "StreamBufferDemo.h"
+
+/* A block time of 0 just means "don't block". */
+#define sbDONT_BLOCK				0
+
+/* The size of the buffer written to from the interrupt, and the number of
+bytes that must be in it before the reading task is unblocked. */
+#define sbISR_BUFFER_SIZE			32
+#define sbISR_TRIGGER_LEVEL			6
+
+/* The number of bytes written to the stream buffer on each tick. */
+#define sbBYTES_PER_TICK			3
+
+/* The size of the message buffer used by MBTx and MBRx, and the longest
+message sent through it. */
+#define sbMESSAGE_BUFFER_SIZE		64
+#define sbMAX_MESSAGE_LENGTH		20
+
+/* The number of messages MBTx sends between each run of the single task
+tests. */
+#define sbMESSAGES_PER_CYCLE		50
+
+/* The size of the buffer used by the single task tests. */
+#define sbTEST_BUFFER_SIZE			16
+
+/* Block time used when a timeout is expected. */
+#define sbSHORT_DELAY				pdMS_TO_TICKS( 10 )
+
+/*
+ * The tasks described at the top of this file.
+ */
+static void prvStreamReceiverTask( void *pvParameters );
+static void prvMessageSenderTask( void *pvParameters );
+static void prvMessageReceiverTask( void *pvParameters );
+
+/*
+ * Tests performed by a single task on a buffer no other task uses.  Returns
+ * pdPASS if all the tests pass.
+ */
+static BaseType_t prvSingleTaskTests( void );
+
+/*-----------------------------------------------------------*/
+
+/* The buffers used by the tasks. */
+static StreamBufferHandle_t xISRStreamBuffer = NULL, xMessageBuffer = NULL;
+
+/* Incremented by each task on each successful cycle so the check task knows
+the tasks are still running. */
+static volatile uint32_t ulStreamReceiverCycles = 0, ulMessageSenderCycles = 0, ulMessageReceiverCycles = 0;
+
+/* Latched to pdFAIL if an error is found. */
+static volatile BaseType_t xErrorStatus = pdPASS;
+
+/*-----------------------------------------------------------*/
+
+void vStartStreamBufferTasks( UBaseType_t uxPriority )
+{
+	xISRStreamBuffer = xStreamBufferCreate( sbISR_BUFFER_SIZE, sbISR_TRIGGER_LEVEL );
+	xMessageBuffer = xMessageBufferCreate( sbMESSAGE_BUFFER_SIZE );
+	configASSERT( xISRStreamBuffer );
+	configASSERT( xMessageBuffer );
+
+	xTaskCreate( prvStreamReceiverTask, "SBRx", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvMessageSenderTask, "MBTx", configMINIMAL_STACK_SIZE, NULL, uxPriority + 1, NULL );
+	xTaskCreate( prvMessageReceiverTask, "MBRx", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamReceiverTask( void *pvParameters )
+{
+uint8_t ucRxData[ sbISR_BUFFER_SIZE ], ucExpected = 0;
+size_t xReceived, x;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Wait for at least the trigger level number of bytes. */
+		xReceived = xStreamBufferReceive( xISRStreamBuffer, ucRxData, sizeof( ucRxData ), portMAX_DELAY );
+
+		if( xReceived < sbISR_TRIGGER_LEVEL )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		for( x = 0; x < xReceived; x++ )
+		{
+			if( ucRxData[ x ] != ucExpected )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			/* Resynchronise with the stream so one error is reported once. */
+			ucExpected = ucRxData[ x ] + 1;
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulStreamReceiverCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferPeriodicISR( void )
+{
+static uint8_t ucNextByte = 0;
+uint8_t ucTxData[ sbBYTES_PER_TICK ];
+size_t x, xSent;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook(). */
+
+	if( xISRStreamBuffer == NULL )
+	{
+		return;
+	}
+
+	for( x = 0; x < sbBYTES_PER_TICK; x++ )
+	{
+		ucTxData[ x ] = ( uint8_t ) ( ucNextByte + x );
+	}
+
+	/* If the receiving task has not kept up then only part, or none, of the
+	data is written.  Only move on by the number of bytes actually written so
+	the stream seen by the receiver remains continuous.  In this demo the last
+	parameter is not used because the tick hook cannot request a context
+	switch. */
+	xSent = xStreamBufferSendFromISR( xISRStreamBuffer, ucTxData, sizeof( ucTxData ), NULL );
+	ucNextByte += ( uint8_t ) xSent;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageSenderTask( void *pvParameters )
+{
+uint8_t ucTxData[ sbMAX_MESSAGE_LENGTH ];
+uint32_t ulMessage = 0;
+size_t xLength, x;
+BaseType_t xMessages;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( prvSingleTaskTests() != pdPASS )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		for( xMessages = 0; xMessages < sbMESSAGES_PER_CYCLE; xMessages++ )
+		{
+			/* Messages are between 1 and sbMAX_MESSAGE_LENGTH bytes long.
+			The first byte is the message number, and the remaining bytes are
+			derived from it. */
+			xLength = ( size_t ) ( ulMessage % sbMAX_MESSAGE_LENGTH ) + 1;
+
+			for( x = 0; x < xLength; x++ )
+			{
+				ucTxData[ x ] = ( uint8_t ) ( ulMessage + x );
+			}
+
+			/* This task has the higher priority so it blocks here each time
+			the message buffer fills. */
+			if( xStreamBufferSend( xMessageBuffer, ucTxData, xLength, portMAX_DELAY ) != xLength )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			ulMessage++;
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulMessageSenderCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageReceiverTask( void *pvParameters )
+{
+uint8_t ucRxData[ sbMAX_MESSAGE_LENGTH ];
+uint32_t ulExpectedMessage = 0;
+size_t xReceived, x;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xReceived = xStreamBufferReceive( xMessageBuffer, ucRxData, sizeof( ucRxData ), portMAX_DELAY );
+
+		/* A whole message is always received, and messages are never merged
+		or split. */
+		if( xReceived != ( ( size_t ) ( ulExpectedMessage % sbMAX_MESSAGE_LENGTH ) + 1 ) )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		for( x = 0; x < xReceived; x++ )
+		{
+			if( ucRxData[ x ] != ( uint8_t ) ( ulExpectedMessage + x ) )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+
+		ulExpectedMessage++;
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulMessageReceiverCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSingleTaskTests( void )
+{
+StreamBufferHandle_t xStreamBuffer;
+uint8_t ucTxData[ sbTEST_BUFFER_SIZE + 4 ], ucRxData[ sbTEST_BUFFER_SIZE + 4 ];
+BaseType_t xReturn = pdPASS;
+TickType_t xTimeBefore;
+size_t x;
+
+	for( x = 0; x < sizeof( ucTxData ); x++ )
+	{
+		ucTxData[ x ] = ( uint8_t ) x;
+	}
+
+	/* Stream buffer tests. */
+	xStreamBuffer = xStreamBufferCreate( sbTEST_BUFFER_SIZE, 1 );
+
+	if( xStreamBuffer == NULL )
+	{
+		return pdFAIL;
+	}
+
+	if( ( xStreamBufferIsEmpty( xStreamBuffer ) != pdTRUE ) || ( xStreamBufferSpacesAvailable( xStreamBuffer ) != sbTEST_BUFFER_SIZE ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Reading from an empty buffer times out and returns nothing. */
+	xTimeBefore = xTaskGetTickCount();
+
+	if( xStreamBufferReceive( xStreamBuffer, ucRxData, sizeof( ucRxData ), sbSHORT_DELAY ) != 0 )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( xTaskGetTickCount() - xTimeBefore ) < sbSHORT_DELAY )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Writing more than the buffer holds writes as much as fits. */
+	if( xStreamBufferSend( xStreamBuffer, ucTxData, sizeof( ucTxData ), sbDONT_BLOCK ) != sbTEST_BUFFER_SIZE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( xStreamBufferIsFull( xStreamBuffer ) != pdTRUE ) || ( xStreamBufferBytesAvailable( xStreamBuffer ) != sbTEST_BUFFER_SIZE ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Writing to a full buffer times out and writes nothing. */
+	xTimeBefore = xTaskGetTickCount();
+
+	if( xStreamBufferSend( xStreamBuffer, ucTxData, 1, sbSHORT_DELAY ) != 0 )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( xTaskGetTickCount() - xTimeBefore ) < sbSHORT_DELAY )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Read part of the data, then write more so the data wraps around the end
+	of the storage area. */
+	if( xStreamBufferReceive( xStreamBuffer, ucRxData, sbTEST_BUFFER_SIZE / 2, sbDONT_BLOCK ) != ( sbTEST_BUFFER_SIZE / 2 ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( memcmp( ucRxData, ucTxData, sbTEST_BUFFER_SIZE / 2 ) != 0 )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xStreamBufferSend( xStreamBuffer, ucTxData, sbTEST_BUFFER_SIZE / 2, sbDONT_BLOCK ) != ( sbTEST_BUFFER_SIZE / 2 ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xStreamBufferReceive( xStreamBuffer, ucRxData, sizeof( ucRxData ), sbDONT_BLOCK ) != sbTEST_BUFFER_SIZE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( memcmp( ucRxData, &( ucTxData[ sbTEST_BUFFER_SIZE / 2 ] ), sbTEST_BUFFER_SIZE / 2 ) != 0 ) ||
+		( memcmp( &( ucRxData[ sbTEST_BUFFER_SIZE / 2 ] ), ucTxData, sbTEST_BUFFER_SIZE / 2 ) != 0 ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Reset discards any data. */
+	( void ) xStreamBufferSend( xStreamBuffer, ucTxData, 5, sbDONT_BLOCK );
+
+	if( ( xStreamBufferReset( xStreamBuffer ) != pdPASS ) || ( xStreamBufferIsEmpty( xStreamBuffer ) != pdTRUE ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	vStreamBufferDelete( xStreamBuffer );
+
+	/* Message buffer tests. */
+	xStreamBuffer = xMessageBufferCreate( sbTEST_BUFFER_SIZE );
+
+	if( xStreamBuffer == NULL )
+	{
+		return pdFAIL;
+	}
+
+	/* A message that does not fit is not written at all. */
+	if( xStreamBufferSend( xStreamBuffer, ucTxData, sbTEST_BUFFER_SIZE, sbDONT_BLOCK ) != 0 )
+	{
+		xReturn = pdFAIL;
+	}
+
+	x = sbTEST_BUFFER_SIZE - sizeof( size_t );
+
+	if( xStreamBufferSend( xStreamBuffer, ucTxData, x, sbDONT_BLOCK ) != x )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xStreamBufferIsFull( xStreamBuffer ) != pdTRUE )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* A message that does not fit in the receive buffer is left in the
+	message buffer. */
+	if( xStreamBufferReceive( xStreamBuffer, ucRxData, x - 1, sbDONT_BLOCK ) != 0 )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xStreamBufferReceive( xStreamBuffer, ucRxData, x, sbDONT_BLOCK ) != x )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ( memcmp( ucRxData, ucTxData, x ) != 0 ) || ( xStreamBufferIsEmpty( xStreamBuffer ) != pdTRUE ) )
+	{
+		xReturn = pdFAIL;
+	}
+
+	vStreamBufferDelete( xStreamBuffer );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreStreamBufferTasksStillRunning( void )
+{
+static uint32_t ulLastStreamReceiverCycles = 0, ulLastMessageSenderCycles = 0, ulLastMessageReceiverCycles = 0;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorStatus != pdPASS )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Each task must have completed at least one cycle since the last time
+	this function was called. */
+	if( ulStreamReceiverCycles == ulLastStreamReceiverCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulMessageSenderCycles == ulLastMessageSenderCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulMessageReceiverCycles == ulLastMessageReceiverCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastStreamReceiverCycles = ulStreamReceiverCycles;
+	ulLastMessageSenderCycles = ulMessageSenderCycles;
+	ulLastMessageReceiverCycles = ulMessageReceiverCycles;
+
+	return xReturn;
+}
+
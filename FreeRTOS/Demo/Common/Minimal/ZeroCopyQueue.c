@@ -0,0 +1,485 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Tests the zero copy queue functions pvQueueReserve(), xQueueCommit(),
+ * pvQueueBorrow() and xQueueRelease(), and their FromISR() equivalents.
+ *
+ * A producer task reserves every slot in a queue, writes a sequence number
+ * into each slot in place, then commits the slots in the reverse order to that
+ * in which they were reserved.  A consumer task that has a higher priority
+ * than the producer borrows the slots, checks the sequence numbers are
+ * received in the order in which the slots were reserved (not the order in
+ * which they were committed), then releases the slots, again out of order.
+ *
+ * vZeroCopyQueuePeriodicISR() writes to a second zero copy queue from an
+ * interrupt.  That queue is a member of a queue set, and a third task blocks
+ * on the queue set to receive from it.
+ */
+
+/* Scheduler include files. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo program include files. */
+#include "ZeroCopyQueue.h"
+
+/* A block time of 0 just means "don't block". */
+#define zcDONT_BLOCK			0
+
+/* The time the producer waits for the consumer to release slots. */
+#define zcBLOCK_TIME			pdMS_TO_TICKS( 100 )
+
+/* The number of slots in the queue used by the tasks. */
+#define zcQUEUE_LENGTH			4
+
+/* The number of slots in the queue written to from the interrupt. */
+#define zcISR_QUEUE_LENGTH		3
+
+/* The number of tick interrupts between each write to the ISR queue. */
+#define zcISR_TICKS_BETWEEN_WRITES	5
+
+/* The number of words of payload in each item.  The items are deliberately
+larger than is sensible to copy into and out of a queue. */
+#define zcPAYLOAD_WORDS			8
+
+/* The item sent through the zero copy queues. */
+typedef struct ZERO_COPY_ITEM
+{
+	uint32_t ulSequence;
+	uint32_t ulPayload[ zcPAYLOAD_WORDS ];
+} ZeroCopyItem_t;
+
+/*
+ * The task that reserves and commits slots.
+ */
+static void prvZeroCopyProducerTask( void *pvParameters );
+
+/*
+ * The task that borrows and releases slots.
+ */
+static void prvZeroCopyConsumerTask( void *pvParameters );
+
+/*
+ * The task that receives the items written by vZeroCopyQueuePeriodicISR().
+ */
+static void prvZeroCopyISRReceiverTask( void *pvParameters );
+
+/*
+ * Returns pdPASS if every payload word in pxItem is derived from the item's
+ * sequence number, otherwise returns pdFAIL.
+ */
+static BaseType_t prvCheckItem( const ZeroCopyItem_t *pxItem );
+
+/*
+ * Fill the payload of pxItem with values derived from ulSequence.
+ */
+static void prvFillItem( ZeroCopyItem_t *pxItem, uint32_t ulSequence );
+
+/*-----------------------------------------------------------*/
+
+/* The queue used by the producer and consumer tasks. */
+static QueueHandle_t xTaskQueue = NULL;
+
+/* The queue written to from the interrupt, and the set it is a member of. */
+static QueueHandle_t xISRQueue = NULL;
+static QueueSetHandle_t xISRQueueSet = NULL;
+
+/* Incremented by each task on each successful cycle so the check task knows
+the tasks are still running. */
+static volatile uint32_t ulProducerCycles = 0, ulConsumerCycles = 0, ulISRReceiverCycles = 0;
+
+/* Latched to pdFAIL if an error is found. */
+static volatile BaseType_t xErrorStatus = pdPASS;
+
+/*-----------------------------------------------------------*/
+
+void vStartZeroCopyQueueTasks( UBaseType_t uxPriority )
+{
+	xTaskQueue = xQueueCreateZeroCopy( zcQUEUE_LENGTH, ( UBaseType_t ) sizeof( ZeroCopyItem_t ) );
+	configASSERT( xTaskQueue );
+
+	/* The queue set must be large enough to hold an event for every slot in
+	the queue that is added to it. */
+	xISRQueue = xQueueCreateZeroCopy( zcISR_QUEUE_LENGTH, ( UBaseType_t ) sizeof( ZeroCopyItem_t ) );
+	xISRQueueSet = xQueueCreateSet( zcISR_QUEUE_LENGTH );
+	configASSERT( xISRQueue );
+	configASSERT( xISRQueueSet );
+	xQueueAddToSet( xISRQueue, xISRQueueSet );
+
+	vQueueAddToRegistry( xTaskQueue, "ZCopy_Task_Queue" );
+	vQueueAddToRegistry( xISRQueue, "ZCopy_ISR_Queue" );
+
+	/* The consumer has the higher priority so it preempts the producer as
+	soon as the oldest slot is committed. */
+	xTaskCreate( prvZeroCopyProducerTask, "ZCPrd", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	xTaskCreate( prvZeroCopyConsumerTask, "ZCCon", configMINIMAL_STACK_SIZE, NULL, uxPriority + 1, NULL );
+	xTaskCreate( prvZeroCopyISRReceiverTask, "ZCISR", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillItem( ZeroCopyItem_t *pxItem, uint32_t ulSequence )
+{
+uint32_t ul;
+
+	pxItem->ulSequence = ulSequence;
+
+	for( ul = 0; ul < zcPAYLOAD_WORDS; ul++ )
+	{
+		pxItem->ulPayload[ ul ] = ulSequence + ul;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckItem( const ZeroCopyItem_t *pxItem )
+{
+uint32_t ul;
+BaseType_t xReturn = pdPASS;
+
+	for( ul = 0; ul < zcPAYLOAD_WORDS; ul++ )
+	{
+		if( pxItem->ulPayload[ ul ] != ( pxItem->ulSequence + ul ) )
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyProducerTask( void *pvParameters )
+{
+ZeroCopyItem_t *pxSlots[ zcQUEUE_LENGTH ];
+uint32_t ulSequence = 0;
+BaseType_t x;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Reserve every slot in the queue, filling each slot in place. */
+		for( x = 0; x < zcQUEUE_LENGTH; x++ )
+		{
+			pxSlots[ x ] = ( ZeroCopyItem_t * ) pvQueueReserve( xTaskQueue, zcBLOCK_TIME );
+
+			if( pxSlots[ x ] == NULL )
+			{
+				/* The consumer did not release the slots in time. */
+				xErrorStatus = pdFAIL;
+				break;
+			}
+
+			prvFillItem( pxSlots[ x ], ulSequence );
+			ulSequence++;
+		}
+
+		if( x == zcQUEUE_LENGTH )
+		{
+			/* All the slots are reserved, so no more can be obtained. */
+			if( pvQueueReserve( xTaskQueue, zcDONT_BLOCK ) != NULL )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			if( uxQueueSpacesAvailable( xTaskQueue ) != 0 )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			/* Commit the slots newest first.  None of the slots are visible
+			to the consumer until the oldest slot is committed, so the
+			consumer does not run until the last call to xQueueCommit(). */
+			for( x = zcQUEUE_LENGTH - 1; x >= 0; x-- )
+			{
+				#if( configUSE_PREEMPTION != 0 )
+				{
+					if( uxQueueMessagesWaiting( xTaskQueue ) != 0 )
+					{
+						xErrorStatus = pdFAIL;
+					}
+				}
+				#endif
+
+				if( xQueueCommit( xTaskQueue, pxSlots[ x ] ) != pdPASS )
+				{
+					xErrorStatus = pdFAIL;
+				}
+			}
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulProducerCycles++;
+		}
+
+		#if( configUSE_PREEMPTION == 0 )
+			taskYIELD();
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyConsumerTask( void *pvParameters )
+{
+ZeroCopyItem_t *pxSlots[ zcQUEUE_LENGTH ];
+uint32_t ulExpectedSequence = 0;
+BaseType_t x, xBorrowed;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Wait for the oldest slot, then take whatever else is ready. */
+		pxSlots[ 0 ] = ( ZeroCopyItem_t * ) pvQueueBorrow( xTaskQueue, portMAX_DELAY );
+		configASSERT( pxSlots[ 0 ] );
+
+		for( xBorrowed = 1; xBorrowed < zcQUEUE_LENGTH; xBorrowed++ )
+		{
+			pxSlots[ xBorrowed ] = ( ZeroCopyItem_t * ) pvQueueBorrow( xTaskQueue, zcDONT_BLOCK );
+
+			if( pxSlots[ xBorrowed ] == NULL )
+			{
+				break;
+			}
+		}
+
+		/* The items must be received in the order the slots were reserved,
+		and must not have been copied. */
+		for( x = 0; x < xBorrowed; x++ )
+		{
+			if( pxSlots[ x ]->ulSequence != ulExpectedSequence )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			if( prvCheckItem( pxSlots[ x ] ) != pdPASS )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			ulExpectedSequence = pxSlots[ x ]->ulSequence + 1;
+		}
+
+		/* Release the newest slot first.  It cannot be reused until the
+		older slots are also released. */
+		if( xBorrowed > 1 )
+		{
+			if( xQueueRelease( xTaskQueue, pxSlots[ xBorrowed - 1 ] ) != pdPASS )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			if( uxQueueSpacesAvailable( xTaskQueue ) != 0 )
+			{
+				xErrorStatus = pdFAIL;
+			}
+
+			xBorrowed--;
+		}
+
+		for( x = 0; x < xBorrowed; x++ )
+		{
+			if( xQueueRelease( xTaskQueue, pxSlots[ x ] ) != pdPASS )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulConsumerCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyISRReceiverTask( void *pvParameters )
+{
+ZeroCopyItem_t *pxItem;
+QueueSetMemberHandle_t xActivatedMember;
+uint32_t ulExpectedSequence = 0;
+
+	/* The parameter is not used. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xActivatedMember = xQueueSelectFromSet( xISRQueueSet, portMAX_DELAY );
+
+		if( xActivatedMember != xISRQueue )
+		{
+			xErrorStatus = pdFAIL;
+			continue;
+		}
+
+		/* The queue set said a slot was ready, so borrowing without blocking
+		must succeed. */
+		pxItem = ( ZeroCopyItem_t * ) pvQueueBorrow( xISRQueue, zcDONT_BLOCK );
+
+		if( pxItem == NULL )
+		{
+			xErrorStatus = pdFAIL;
+			continue;
+		}
+
+		if( ( pxItem->ulSequence != ulExpectedSequence ) || ( prvCheckItem( pxItem ) != pdPASS ) )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		ulExpectedSequence = pxItem->ulSequence + 1;
+
+		if( xQueueRelease( xISRQueue, pxItem ) != pdPASS )
+		{
+			xErrorStatus = pdFAIL;
+		}
+
+		if( xErrorStatus == pdPASS )
+		{
+			ulISRReceiverCycles++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vZeroCopyQueuePeriodicISR( void )
+{
+static uint32_t ulCallCount = 0, ulSequence = 0;
+ZeroCopyItem_t *pxItem;
+
+	/* This function should be called from an interrupt, such as the tick hook
+	function vApplicationTickHook(). */
+
+	if( xISRQueue == NULL )
+	{
+		return;
+	}
+
+	ulCallCount++;
+
+	if( ( ulCallCount % zcISR_TICKS_BETWEEN_WRITES ) == 0 )
+	{
+		pxItem = ( ZeroCopyItem_t * ) pvQueueReserveFromISR( xISRQueue );
+
+		/* pxItem is NULL if the receiver task has not kept up, in which case
+		the item is simply not sent. */
+		if( pxItem != NULL )
+		{
+			prvFillItem( pxItem, ulSequence );
+			ulSequence++;
+
+			/* In this demo the last parameter is not used because the tick
+			hook cannot request a context switch. */
+			if( xQueueCommitFromISR( xISRQueue, pxItem, NULL ) != pdPASS )
+			{
+				xErrorStatus = pdFAIL;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xAreZeroCopyQueueTasksStillRunning( void )
+{
+static uint32_t ulLastProducerCycles = 0, ulLastConsumerCycles = 0, ulLastISRReceiverCycles = 0;
+BaseType_t xReturn = pdPASS;
+
+	if( xErrorStatus != pdPASS )
+	{
+		xReturn = pdFAIL;
+	}
+
+	/* Each task must have completed at least one cycle since the last time
+	this function was called. */
+	if( ulProducerCycles == ulLastProducerCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulConsumerCycles == ulLastConsumerCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( ulISRReceiverCycles == ulLastISRReceiverCycles )
+	{
+		xReturn = pdFAIL;
+	}
+
+	ulLastProducerCycles = ulProducerCycles;
+	ulLastConsumerCycles = ulConsumerCycles;
+	ulLastISRReceiverCycles = ulISRReceiverCycles;
+
+	return xReturn;
+}
+
@@ -0,0 +1,237 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/******************************************************************************
+ * This project runs the comprehensive test and demo application, implemented
+ * and described in main_full.c, on the POSIX (Linux) simulator port.
+ *
+ * This file implements the code that is not demo specific, including the
+ * FreeRTOS hook functions.
+ *
+ *******************************************************************************
+ * -NOTE- The POSIX port is a simulation only!  Do not expect to get real time
+ * behaviour from the POSIX port or this demo application.  It is provided as a
+ * convenient development and test bed, in particular so the kernel can be run
+ * under host tools such as perf, valgrind and the compiler sanitizers.
+ *******************************************************************************
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Set to 1 by the makefile when the heap implementation being built needs its
+memory to be defined by vPortDefineHeapRegions(). */
+#ifndef mainDEFINE_HEAP_REGIONS
+	#define mainDEFINE_HEAP_REGIONS		0
+#endif
+
+/*
+ * main_full() creates the demo tasks then starts the scheduler.  It returns
+ * pdPASS if the scheduler was ended with no errors having been detected.
+ */
+extern BaseType_t main_full( void );
+
+/*
+ * Some of the RTOS hook (callback) functions need special processing when the
+ * full demo is being used.  These functions are called from the hook functions
+ * defined in this file, but are defined in main_full.c.
+ */
+void vFullDemoTickHookFunction( void );
+void vFullDemoIdleFunction( void );
+
+/*
+ * Prototypes for the standard FreeRTOS callback/hook functions implemented
+ * within this file.
+ */
+void vApplicationMallocFailedHook( void );
+void vApplicationIdleHook( void );
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName );
+void vApplicationTickHook( void );
+
+/*
+ * heap_5 and heap_6 must be told which memory to use before anything is
+ * allocated.
+ */
+#if( mainDEFINE_HEAP_REGIONS == 1 )
+	static void prvInitialiseHeap( void );
+#endif
+
+/* The number of unused bytes between the two heap regions. */
+#define mainHEAP_REGION_GAP		64
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	#if( mainDEFINE_HEAP_REGIONS == 1 )
+	{
+		prvInitialiseHeap();
+	}
+	#endif
+
+	if( main_full() != pdPASS )
+	{
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+#if( mainDEFINE_HEAP_REGIONS == 1 )
+
+	static void prvInitialiseHeap( void )
+	{
+	/* The heap is split into two regions that are separated by a gap, so the
+	code that manages more than one region is exercised.  The second region
+	deliberately starts on a misaligned address. */
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE + mainHEAP_REGION_GAP ];
+	const HeapRegion_t xHeapRegions[] =
+	{
+		{ ucHeap, configTOTAL_HEAP_SIZE / 2 },
+		{ &( ucHeap[ ( configTOTAL_HEAP_SIZE / 2 ) + mainHEAP_REGION_GAP + 1 ] ), ( configTOTAL_HEAP_SIZE / 2 ) - 1 },
+		{ NULL, 0 }
+	};
+
+		vPortDefineHeapRegions( xHeapRegions );
+	}
+
+#endif /* mainDEFINE_HEAP_REGIONS */
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	/* vApplicationMallocFailedHook() will only be called if
+	configUSE_MALLOC_FAILED_HOOK is set to 1 in FreeRTOSConfig.h.  It is a hook
+	function that will get called if a call to pvPortMalloc() fails.
+	pvPortMalloc() is called internally by the kernel whenever a task, queue,
+	timer or semaphore is created.  It is also called by various parts of the
+	demo application. */
+	vAssertCalled( __LINE__, __FILE__ );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	/* vApplicationIdleHook() will only be called if configUSE_IDLE_HOOK is set
+	to 1 in FreeRTOSConfig.h.  It will be called on each iteration of the idle
+	task.  It is essential that code added to this hook function never attempts
+	to block in any way (for example, call xQueueReceive() with a block time
+	specified, or call vTaskDelay()).  If the application makes use of the
+	vTaskDelete() API function (as this demo application does) then it is also
+	important that vApplicationIdleHook() is permitted to return to its calling
+	function, because it is the responsibility of the idle task to clean up
+	memory allocated by the kernel to any task that has since been deleted. */
+	vFullDemoIdleFunction();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName )
+{
+	( void ) pcTaskName;
+	( void ) pxTask;
+
+	/* Run time stack overflow checking is performed if
+	configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
+	function is called if a stack overflow is detected. */
+	vAssertCalled( __LINE__, __FILE__ );
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	/* This function will be called by each tick interrupt if
+	configUSE_TICK_HOOK is set to 1 in FreeRTOSConfig.h.  User code can be
+	added here, but the tick hook is called from an interrupt context, so
+	code must not attempt to block, and only the interrupt safe FreeRTOS API
+	functions can be used (those that end in FromISR()). */
+	vFullDemoTickHookFunction();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( unsigned long ulLine, const char * const pcFileName )
+{
+	taskENTER_CRITICAL();
+	{
+		/* Unlike on a real target there is a console to report to, and an
+		abort() is more useful than a spin loop when running under a debugger,
+		valgrind or a sanitizer. */
+		fprintf( stderr, "ASSERT! Line %lu, file %s\r\n", ulLine, pcFileName );
+		fflush( stderr );
+		abort();
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
@@ -498,6 +498,22 @@ extern "C" {
 	#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )
 #endif
 
+#ifndef traceQUEUE_SEND_MULTIPLE
+	#define traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_SEND_MULTIPLE_FROM_ISR
+	#define traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE
+	#define traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemCount )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR
+	#define traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxItemCount )
+#endif
+
 #ifndef traceQUEUE_PEEK_FROM_ISR_FAILED
 	#define traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue )
 #endif
@@ -658,6 +674,98 @@ extern "C" {
 	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
 #endif
 
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE_STATIC_FAILED
+	#define traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RESET
+	#define traceSTREAM_BUFFER_RESET( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FAILED
+	#define traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FAILED
+	#define traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE
+	#define traceMEMORY_POOL_CREATE( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_FAILED
+	#define traceMEMORY_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_STATIC_FAILED
+	#define traceMEMORY_POOL_CREATE_STATIC_FAILED( xReturn )
+#endif
+
+#ifndef traceMEMORY_POOL_DELETE
+	#define traceMEMORY_POOL_DELETE( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE
+	#define traceMEMORY_POOL_ALLOCATE( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE_FAILED
+	#define traceMEMORY_POOL_ALLOCATE_FAILED( pxMemoryPool )
+#endif
+
+#ifndef traceBLOCKING_ON_MEMORY_POOL_ALLOCATE
+	#define traceBLOCKING_ON_MEMORY_POOL_ALLOCATE( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOCATE_FROM_ISR
+	#define traceMEMORY_POOL_ALLOCATE_FROM_ISR( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE
+	#define traceMEMORY_POOL_FREE( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE_FROM_ISR
+	#define traceMEMORY_POOL_FREE_FROM_ISR( pxMemoryPool, pvBlock )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
@@ -768,6 +876,55 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configUSE_INDEXED_DELAYED_LISTS
+	#define configUSE_INDEXED_DELAYED_LISTS 0
+#endif
+
+#ifndef configUSE_ZERO_COPY_QUEUES
+	#define configUSE_ZERO_COPY_QUEUES 0
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+	#define configTIMER_WHEEL_SLOT_BITS 5
+#endif
+
+#if( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+	#error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5 (2 to 32 slots per timer wheel level).
+#endif
+
+#ifndef configUSE_HEAP_INSTRUMENTATION
+	#define configUSE_HEAP_INSTRUMENTATION 0
+#endif
+
+#ifndef portGET_HEAP_CYCLE_COUNTER_VALUE
+	/* The time spent in pvPortMalloc() and vPortFree() is measured using the
+	run time stats counter unless the port or application provides a higher
+	resolution counter, such as a CPU cycle counter. */
+	#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+		#define portGET_HEAP_CYCLE_COUNTER_VALUE() ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+	#else
+		#define portGET_HEAP_CYCLE_COUNTER_VALUE() ( ( uint32_t ) 0UL )
+	#endif
+#endif
+
+#ifndef portMEMORY_BARRIER
+	/* portMEMORY_BARRIER() is used by the stream buffer implementation to order
+	the copying of data with respect to the update of the head and tail indexes.
+	On a single core that does not reorder its own memory accesses a compiler
+	barrier is sufficient, which is the default provided here for GCC
+	compatible compilers.  Ports for multi-core or weakly ordered hardware must
+	define portMEMORY_BARRIER() in portmacro.h to be a hardware memory barrier,
+	and ports that use other compilers must define it to be at least a compiler
+	barrier. */
+	#ifdef __GNUC__
+		#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+	#endif
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -875,6 +1032,10 @@ struct xSTATIC_LIST_ITEM
 {
 	TickType_t xDummy1;
 	void *pvDummy2[ 4 ];
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+		void *pvDummy3[ 3 ];
+		UBaseType_t uxDummy4;
+	#endif
 };
 typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
 
@@ -892,6 +1053,10 @@ typedef struct xSTATIC_LIST
 	UBaseType_t uxDummy1;
 	void *pvDummy2;
 	StaticMiniListItem_t xDummy3;
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+		void *pvDummy4;
+		BaseType_t xDummy5;
+	#endif
 } StaticList_t;
 
 /*
@@ -938,6 +1103,9 @@ typedef struct xSTATIC_TCB
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		uint32_t		ulDummy16;
 	#endif
+	#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+		uint32_t		ulDummy21[ 4 ];
+	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
@@ -992,6 +1160,11 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		void *pvDummy10;
+		UBaseType_t uxDummy11[ 4 ];
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1024,6 +1197,61 @@ typedef struct xSTATIC_EVENT_GROUP
 
 } StaticEventGroup_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the stream buffer structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create a stream buffer then the size of the stream buffer object needs to be
+ * known.  The StaticStreamBuffer_t structure below is provided for this
+ * purpose.  Its size and alignment requirements are guaranteed to match those
+ * of the genuine structure, no matter which architecture is being used, and no
+ * matter how the values in FreeRTOSConfig.h are set.  Its contents are somewhat
+ * obfuscated in the hope users will recognise that it would be unwise to make
+ * direct use of the structure members.
+ */
+typedef struct xSTATIC_STREAM_BUFFER
+{
+	size_t uxDummy1[ 4 ];
+	void * pvDummy2[ 3 ];
+	uint8_t ucDummy3;
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t uxDummy4;
+	#endif
+
+} StaticStreamBuffer_t;
+
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the memory pool structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create a memory pool then the size of the memory pool object needs to be
+ * known.  The StaticMemoryPool_t structure below is provided for this purpose.
+ * Its size and alignment requirements are guaranteed to match those of the
+ * genuine structure, no matter which architecture is being used, and no matter
+ * how the values in FreeRTOSConfig.h are set.  Its contents are somewhat
+ * obfuscated in the hope users will recognise that it would be unwise to make
+ * direct use of the structure members.
+ */
+typedef struct xSTATIC_MEMORY_POOL
+{
+	void *pvDummy1[ 2 ];
+	size_t xDummy2;
+	UBaseType_t uxDummy3[ 3 ];
+	uint32_t ulDummy4[ 2 ];
+	StaticList_t xDummy5;
+	uint8_t ucDummy6;
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t uxDummy7;
+	#endif
+
+} StaticMemoryPool_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
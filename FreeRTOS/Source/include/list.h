@@ -186,6 +186,12 @@ struct xLIST_ITEM
 	struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;	/*< Pointer to the previous ListItem_t in the list. */
 	void * pvOwner;										/*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
 	void * configLIST_VOLATILE pvContainer;				/*< Pointer to the list in which this list item is placed (if any). */
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+		struct xLIST_ITEM * configLIST_VOLATILE pxTreeParent;	/*< Parent of the item in the tree that indexes an indexed list.  Only used while the item is in an indexed list. */
+		struct xLIST_ITEM * configLIST_VOLATILE pxTreeLeft;		/*< Left child (lower item values) of the item in the index tree. */
+		struct xLIST_ITEM * configLIST_VOLATILE pxTreeRight;	/*< Right child (equal or higher item values) of the item in the index tree. */
+		UBaseType_t uxTreeColour;								/*< Red or black, used to keep the index tree balanced. */
+	#endif
 	listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 };
 typedef struct xLIST_ITEM ListItem_t;					/* For some reason lint wants this as two separate definitions. */
@@ -208,6 +214,10 @@ typedef struct xLIST
 	configLIST_VOLATILE UBaseType_t uxNumberOfItems;
 	ListItem_t * configLIST_VOLATILE pxIndex;			/*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
 	MiniListItem_t xListEnd;							/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+		ListItem_t * configLIST_VOLATILE pxTreeRoot;	/*< Root of the tree that indexes the list items in item value order, NULL if the list is empty or not indexed. */
+		BaseType_t xIsIndexed;							/*< pdTRUE if the list was initialised with vListInitialiseIndexed(). */
+	#endif
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -385,6 +395,33 @@ List_t * const pxConstList = ( pxList );													\
  */
 void vListInitialise( List_t * const pxList ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise a list that is only ever used with vListInsert() and
+ * uxListRemove(), such as the delayed task lists and the active timer lists.
+ *
+ * When configUSE_INDEXED_DELAYED_LISTS is set to 1 in FreeRTOSConfig.h the
+ * items in such a list are, in addition to being linked in item value order,
+ * held in a red-black tree keyed on the item value.  That bounds the time taken
+ * by vListInsert() and uxListRemove() to O(log n) in the number of items in the
+ * list, rather than the O(n) walk required to find the insertion point in a
+ * plain list.  The list remains a normal sorted list in all other respects, so
+ * the list access macros - including listGET_OWNER_OF_HEAD_ENTRY() - can still
+ * be used.  vListInsertEnd() must not be used on an indexed list.
+ *
+ * When configUSE_INDEXED_DELAYED_LISTS is 0 this is the same as
+ * vListInitialise().
+ *
+ * @param pxList Pointer to the list being initialised.
+ *
+ * \page vListInitialiseIndexed vListInitialiseIndexed
+ * \ingroup LinkedList
+ */
+#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+	void vListInitialiseIndexed( List_t * const pxList ) PRIVILEGED_FUNCTION;
+#else
+	#define vListInitialiseIndexed( pxList ) vListInitialise( pxList )
+#endif
+
 /*
  * Must be called before a list item is used.  This sets the list container to
  * null so the item does not think that it is already contained in a list.
@@ -0,0 +1,370 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Memory pools provide fixed size blocks of memory.  Allocating a block from,
+ * and freeing a block to, a memory pool take a constant time and only require
+ * a short critical section, so memory pools are suitable for objects that are
+ * allocated and freed at a high rate, and can be used from interrupts.
+ *
+ * Free blocks are reused in LIFO order, so the block returned by an allocation
+ * is the block that was most recently freed, which is the block most likely to
+ * still be in the cache.  Each pool keeps a count of allocations, a count of
+ * allocations that failed, and the maximum number of blocks that have been in
+ * use at any one time, so pools can be sized from measurements.
+ *
+ * mempool.c must be included in the build to use memory pools.
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include mempool.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemoryPoolCreate() returns a MemoryPoolHandle_t variable that can then be
+ * used as a parameter to pvMemoryPoolAllocate(), vMemoryPoolFree(), etc.
+ */
+typedef void * MemoryPoolHandle_t;
+
+/**
+ * Used with vMemoryPoolGetStats() to obtain information about a memory pool.
+ */
+typedef struct xMEMORY_POOL_STATS
+{
+	size_t xBlockSize;					/* The size of each block, which may have been rounded up from the size requested when the pool was created. */
+	UBaseType_t uxBlockCount;			/* The number of blocks in the pool. */
+	UBaseType_t uxFreeBlocks;			/* The number of blocks not currently allocated. */
+	UBaseType_t uxMaximumBlocksInUse;	/* The maximum number of blocks that have been allocated at any one time since the pool was created. */
+	uint32_t ulAllocations;				/* The number of allocations that returned a block. */
+	uint32_t ulAllocationFailures;		/* The number of allocations that returned NULL because no block became free in time. */
+} MemoryPoolStats_t;
+
+/**
+ * The size to which each block is rounded up.  Blocks are a multiple of
+ * portBYTE_ALIGNMENT bytes, and are large enough to hold a pointer (which is
+ * used to link free blocks together).
+ */
+#define mempoolALIGNED_BLOCK_SIZE( xBlockSize ) ( ( ( ( ( size_t ) ( xBlockSize ) < sizeof( void * ) ) ? sizeof( void * ) : ( size_t ) ( xBlockSize ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * The size, in bytes, of the storage area that must be provided to
+ * xMemoryPoolCreateStatic() to create a pool of uxBlockCount blocks that are
+ * each at least xBlockSize bytes.
+ */
+#define mempoolSTORAGE_SIZE_BYTES( uxBlockCount, xBlockSize ) ( ( size_t ) ( uxBlockCount ) * mempoolALIGNED_BLOCK_SIZE( xBlockSize ) )
+
+/**
+ * mempool.h
+ *<pre>
+ MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxBlockCount, size_t xBlockSize );
+ </pre>
+ *
+ * Creates a new memory pool using dynamically allocated memory.  The pool
+ * structure and all the blocks are allocated in a single call to
+ * pvPortMalloc(), after which blocks are allocated from and freed to the pool
+ * without using the heap.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @param xBlockSize The minimum size of each block, in bytes.
+ *
+ * @return If NULL is returned then the pool cannot be created because there is
+ * insufficient heap memory available.  A non-NULL value being returned indicates
+ * the pool has been created successfully.
+ *
+ * Example usage:
+   <pre>
+	struct APacket
+	{
+		uint8_t ucHeader[ 8 ];
+		uint8_t ucPayload[ 56 ];
+	};
+
+	MemoryPoolHandle_t xPacketPool;
+
+	void vAFunction( void )
+	{
+	struct APacket *pxPacket;
+
+		// Create a pool of 20 packets.
+		xPacketPool = xMemoryPoolCreate( 20, sizeof( struct APacket ) );
+
+		if( xPacketPool != NULL )
+		{
+			// Obtain a packet, waiting up to 10 ticks for one to be freed if
+			// they are all in use.
+			pxPacket = ( struct APacket * ) pvMemoryPoolAllocate( xPacketPool, 10 );
+
+			if( pxPacket != NULL )
+			{
+				// ... Use the packet ...
+
+				// Return the packet to the pool.
+				vMemoryPoolFree( xPacketPool, pxPacket );
+			}
+		}
+	}
+   </pre>
+ * \defgroup xMemoryPoolCreate xMemoryPoolCreate
+ * \ingroup MemoryPoolManagement
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxBlockCount, size_t xBlockSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mempool.h
+ *<pre>
+ MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxBlockCount,
+                                             size_t xBlockSize,
+                                             uint8_t *pucPoolStorage,
+                                             StaticMemoryPool_t *pxStaticMemoryPool );
+ </pre>
+ *
+ * Creates a new memory pool using statically allocated memory.  See
+ * xMemoryPoolCreate() for a description of the uxBlockCount and xBlockSize
+ * parameters.
+ *
+ * @param pucPoolStorage Must point to a portBYTE_ALIGNMENT aligned array that is
+ * at least mempoolSTORAGE_SIZE_BYTES( uxBlockCount, xBlockSize ) bytes big.
+ * The blocks are carved from this array.
+ *
+ * @param pxStaticMemoryPool Must point to a variable of type
+ * StaticMemoryPool_t, which will be used to hold the pool's data structure.
+ *
+ * @return If the pool is created successfully then a handle to the created
+ * pool is returned.  If either pucPoolStorage or pxStaticMemoryPool are NULL
+ * then NULL is returned.
+ *
+ * \defgroup xMemoryPoolCreateStatic xMemoryPoolCreateStatic
+ * \ingroup MemoryPoolManagement
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxBlockCount, size_t xBlockSize, uint8_t * const pucPoolStorage, StaticMemoryPool_t * const pxStaticMemoryPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * mempool.h
+ *<pre>
+ void *pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Allocate a block from a memory pool.  If every block is in use the calling
+ * task can optionally block to wait for a block to be freed.  If more than one
+ * task is blocked on the same pool then the task with the highest priority is
+ * the first to be given a freed block.
+ *
+ * Use pvMemoryPoolAllocate() to allocate from a task.  Use
+ * pvMemoryPoolAllocateFromISR() to allocate from an interrupt service routine
+ * (ISR).
+ *
+ * @param xMemoryPool The handle of the pool from which to allocate.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state to wait for a block to be freed, should every block be
+ * in use.  The block time is specified in tick periods, so the absolute time it
+ * represents is dependent on the tick frequency.  The macro pdMS_TO_TICKS() can
+ * be used to convert a time specified in milliseconds into a time specified in
+ * ticks.  Setting xTicksToWait to portMAX_DELAY will cause the task to wait
+ * indefinitely (without timing out), provided INCLUDE_vTaskSuspend is set to 1
+ * in FreeRTOSConfig.h.
+ *
+ * @return A pointer to the allocated block, or NULL if no block became free
+ * before the block time expired.
+ *
+ * \defgroup pvMemoryPoolAllocate pvMemoryPoolAllocate
+ * \ingroup MemoryPoolManagement
+ */
+void *pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void *pvMemoryPoolAllocateFromISR( MemoryPoolHandle_t xMemoryPool );
+ </pre>
+ *
+ * A version of pvMemoryPoolAllocate() that can be called from an interrupt
+ * service routine (ISR).  It never blocks.
+ *
+ * @param xMemoryPool The handle of the pool from which to allocate.
+ *
+ * @return A pointer to the allocated block, or NULL if every block is in use.
+ *
+ * \defgroup pvMemoryPoolAllocateFromISR pvMemoryPoolAllocateFromISR
+ * \ingroup MemoryPoolManagement
+ */
+void *pvMemoryPoolAllocateFromISR( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock );
+ </pre>
+ *
+ * Return a block to the pool from which it was allocated.  If tasks are
+ * blocked waiting for a block then the highest priority waiting task is
+ * unblocked.
+ *
+ * Use vMemoryPoolFree() to free from a task.  Use vMemoryPoolFreeFromISR() to
+ * free from an interrupt service routine (ISR).
+ *
+ * @param xMemoryPool The handle of the pool from which pvBlock was allocated.
+ *
+ * @param pvBlock The block being freed.  The block must not be used after it
+ * has been freed, and must not be freed twice.
+ *
+ * \defgroup vMemoryPoolFree vMemoryPoolFree
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+                              void *pvBlock,
+                              BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of vMemoryPoolFree() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * @param xMemoryPool The handle of the pool from which pvBlock was allocated.
+ *
+ * @param pvBlock The block being freed.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if freeing the block unblocked a task that has a priority above the priority
+ * of the currently running task, in which case a context switch should be
+ * requested before the interrupt is exited.
+ *
+ * \defgroup vMemoryPoolFreeFromISR vMemoryPoolFreeFromISR
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool, void *pvBlock, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool );
+ </pre>
+ *
+ * Deletes a memory pool that was previously created using a call to
+ * xMemoryPoolCreate() or xMemoryPoolCreateStatic().  If the pool was created
+ * using dynamic memory then the memory is freed.  Blocks allocated from the
+ * pool must not be used after the pool has been deleted, and the pool must not
+ * be deleted while tasks are blocked on it.
+ *
+ * \defgroup vMemoryPoolDelete vMemoryPoolDelete
+ * \ingroup MemoryPoolManagement
+ */
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ *<pre>
+ UBaseType_t uxMemoryPoolGetFreeBlockCount( MemoryPoolHandle_t xMemoryPool );
+ void vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxMemoryPoolStats );
+ </pre>
+ *
+ * uxMemoryPoolGetFreeBlockCount() returns the number of blocks that are not
+ * currently allocated, and can be called from tasks and interrupts.
+ *
+ * vMemoryPoolGetStats() fills *pxMemoryPoolStats with a consistent snapshot of
+ * the pool's size, usage and counters.  See the definition of
+ * MemoryPoolStats_t for a description of each member.  vMemoryPoolGetStats()
+ * must only be called from a task.
+ *
+ * \defgroup vMemoryPoolGetStats vMemoryPoolGetStats
+ * \ingroup MemoryPoolManagement
+ */
+UBaseType_t uxMemoryPoolGetFreeBlockCount( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+void vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxMemoryPoolStats ) PRIVILEGED_FUNCTION;
+
+/* Functions beyond this part are not part of the public API and are intended
+for use by the kernel only. */
+#if( configUSE_TRACE_FACILITY == 1 )
+	UBaseType_t uxMemoryPoolGetMemoryPoolNumber( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+	void vMemoryPoolSetMemoryPoolNumber( MemoryPoolHandle_t xMemoryPool, UBaseType_t uxMemoryPoolNumber ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined( MEMORY_POOL_H ) */
+
@@ -125,6 +125,8 @@ BaseType_t MPU_xTaskGetSchedulerState( void );
 /* MPU versions of queue.h API function. */
 BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition );
 BaseType_t MPU_xQueueGenericReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait, const BaseType_t xJustPeek );
+BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, TickType_t xTicksToWait );
+BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait );
 UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t xQueue );
 UBaseType_t MPU_uxQueueSpacesAvailable( const QueueHandle_t xQueue );
 void MPU_vQueueDelete( QueueHandle_t xQueue );
@@ -145,6 +147,10 @@ BaseType_t MPU_xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore, QueueSe
 BaseType_t MPU_xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet );
 QueueSetMemberHandle_t MPU_xQueueSelectFromSet( QueueSetHandle_t xQueueSet, const TickType_t xTicksToWait );
 BaseType_t MPU_xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue );
+void *MPU_pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait );
+BaseType_t MPU_xQueueCommit( QueueHandle_t xQueue, void * const pvSlot );
+void *MPU_pvQueueBorrow( QueueHandle_t xQueue, TickType_t xTicksToWait );
+BaseType_t MPU_xQueueRelease( QueueHandle_t xQueue, void * const pvSlot );
 void MPU_vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber );
 UBaseType_t MPU_uxQueueGetQueueNumber( QueueHandle_t xQueue );
 uint8_t MPU_ucQueueGetQueueType( QueueHandle_t xQueue );
@@ -173,5 +179,26 @@ EventBits_t MPU_xEventGroupSync( EventGroupHandle_t xEventGroup, const EventBits
 void MPU_vEventGroupDelete( EventGroupHandle_t xEventGroup );
 UBaseType_t MPU_uxEventGroupGetNumber( void* xEventGroup );
 
+/* MPU versions of sbuffer.h API functions. */
+StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer );
+StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer );
+size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait );
+size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait );
+void MPU_vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer );
+BaseType_t MPU_xStreamBufferReset( StreamBufferHandle_t xStreamBuffer );
+BaseType_t MPU_xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer );
+BaseType_t MPU_xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer );
+size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer );
+size_t MPU_xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer );
+
+/* MPU versions of mempool.h API functions. */
+MemoryPoolHandle_t MPU_xMemoryPoolCreate( UBaseType_t uxBlockCount, size_t xBlockSize );
+MemoryPoolHandle_t MPU_xMemoryPoolCreateStatic( UBaseType_t uxBlockCount, size_t xBlockSize, uint8_t * const pucPoolStorage, StaticMemoryPool_t * const pxStaticMemoryPool );
+void *MPU_pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait );
+void MPU_vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock );
+void MPU_vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool );
+UBaseType_t MPU_uxMemoryPoolGetFreeBlockCount( MemoryPoolHandle_t xMemoryPool );
+void MPU_vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxMemoryPoolStats );
+
 #endif /* MPU_PROTOTYPES_H */
 
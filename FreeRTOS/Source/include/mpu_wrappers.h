@@ -131,6 +131,8 @@ only for ports that are using the MPU. */
 		/* Map standard queue.h API functions to the MPU equivalents. */
 		#define xQueueGenericSend						MPU_xQueueGenericSend
 		#define xQueueGenericReceive					MPU_xQueueGenericReceive
+		#define xQueueSendMultiple						MPU_xQueueSendMultiple
+		#define xQueueReceiveMultiple					MPU_xQueueReceiveMultiple
 		#define uxQueueMessagesWaiting					MPU_uxQueueMessagesWaiting
 		#define uxQueueSpacesAvailable					MPU_uxQueueSpacesAvailable
 		#define vQueueDelete							MPU_vQueueDelete
@@ -148,6 +150,10 @@ only for ports that are using the MPU. */
 		#define xQueueRemoveFromSet						MPU_xQueueRemoveFromSet
 		#define xQueueSelectFromSet						MPU_xQueueSelectFromSet
 		#define xQueueGenericReset						MPU_xQueueGenericReset
+		#define pvQueueReserve							MPU_pvQueueReserve
+		#define xQueueCommit							MPU_xQueueCommit
+		#define pvQueueBorrow							MPU_pvQueueBorrow
+		#define xQueueRelease							MPU_xQueueRelease
 
 		#if( configQUEUE_REGISTRY_SIZE > 0 )
 			#define vQueueAddToRegistry						MPU_vQueueAddToRegistry
@@ -177,6 +183,27 @@ only for ports that are using the MPU. */
 		#define xEventGroupSync							MPU_xEventGroupSync
 		#define vEventGroupDelete						MPU_vEventGroupDelete
 
+		/* Map standard sbuffer.h API functions to the MPU equivalents. */
+		#define xStreamBufferGenericCreate				MPU_xStreamBufferGenericCreate
+		#define xStreamBufferGenericCreateStatic		MPU_xStreamBufferGenericCreateStatic
+		#define xStreamBufferSend						MPU_xStreamBufferSend
+		#define xStreamBufferReceive					MPU_xStreamBufferReceive
+		#define vStreamBufferDelete						MPU_vStreamBufferDelete
+		#define xStreamBufferReset						MPU_xStreamBufferReset
+		#define xStreamBufferIsEmpty					MPU_xStreamBufferIsEmpty
+		#define xStreamBufferIsFull						MPU_xStreamBufferIsFull
+		#define xStreamBufferBytesAvailable				MPU_xStreamBufferBytesAvailable
+		#define xStreamBufferSpacesAvailable			MPU_xStreamBufferSpacesAvailable
+
+		/* Map standard mempool.h API functions to the MPU equivalents. */
+		#define xMemoryPoolCreate						MPU_xMemoryPoolCreate
+		#define xMemoryPoolCreateStatic					MPU_xMemoryPoolCreateStatic
+		#define pvMemoryPoolAllocate					MPU_pvMemoryPoolAllocate
+		#define vMemoryPoolFree							MPU_vMemoryPoolFree
+		#define vMemoryPoolDelete						MPU_vMemoryPoolDelete
+		#define uxMemoryPoolGetFreeBlockCount			MPU_uxMemoryPoolGetFreeBlockCount
+		#define vMemoryPoolGetStats						MPU_vMemoryPoolGetStats
+
 		/* Remove the privileged function macro. */
 		#define PRIVILEGED_FUNCTION
 
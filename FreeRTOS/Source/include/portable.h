@@ -164,6 +164,46 @@ typedef struct HeapRegion
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+#ifndef configHEAP_STATS_HISTOGRAM_BUCKETS
+	#define configHEAP_STATS_HISTOGRAM_BUCKETS 8
+#endif
+
+/* Used by vPortGetHeapStats().  Sizes include the block header the heap
+places in front of each block.  Element 0 of uxFreeBlockSizeHistogram[]
+counts the free blocks smaller than 32 bytes, element n counts the free blocks
+of at least ( 16 << n ) and less than ( 32 << n ) bytes, and the last element
+also counts every free block that is larger still. */
+typedef struct xHEAP_STATS
+{
+	size_t xAvailableHeapSpaceInBytes;		/* The total free heap space, the same as returned by xPortGetFreeHeapSize(). */
+	size_t xSizeOfLargestFreeBlockInBytes;	/* The largest allocation that could currently succeed is a little smaller than this. */
+	size_t xSizeOfSmallestFreeBlockInBytes;
+	size_t xNumberOfFreeBlocks;
+	size_t xMinimumEverFreeBytesRemaining;	/* The same as returned by xPortGetMinimumEverFreeHeapSize(). */
+	UBaseType_t uxFreeBlockSizeHistogram[ configHEAP_STATS_HISTOGRAM_BUCKETS ];
+} HeapStats_t;
+
+/*
+ * Used by heap_4.c when configUSE_HEAP_INSTRUMENTATION is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * vPortGetHeapStats() walks the list of free blocks to give a snapshot of
+ * how fragmented the heap is.  The scheduler is suspended while the list is
+ * walked, so the time taken is proportional to the number of free blocks.
+ *
+ * Each allocated block is tagged with the handle of the task that allocated
+ * it (NULL if it was allocated before any tasks were created).
+ * xPortGetHeapBytesOwnedBy() walks every block in the heap and returns the
+ * number of bytes currently allocated by the task pvOwner, which makes it
+ * possible to see which task is leaking memory.  If pxNumberOfBlocks is not
+ * NULL the number of blocks allocated by pvOwner is written to
+ * *pxNumberOfBlocks.  The handle of a deleted task can be reused by a task
+ * created later, so blocks leaked by a deleted task are then counted as
+ * belonging to the new task.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+size_t xPortGetHeapBytesOwnedBy( void *pvOwner, size_t *pxNumberOfBlocks ) PRIVILEGED_FUNCTION;
+
 
 /*
  * Map to the memory management routines required for the port.
@@ -113,6 +113,7 @@ typedef void * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_ZERO_COPY			( ( uint8_t ) 5U )
 
 /**
  * queue. h
@@ -1529,6 +1530,145 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultiple(
+								QueueHandle_t xQueue,
+								const void * const pvItemsToQueue,
+								UBaseType_t uxItemCount,
+								TickType_t xTicksToWait
+							);
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue.  The items are copied
+ * into the queue in a single critical section, tasks waiting to receive from
+ * the queue are unblocked once for the whole batch, and at most one context
+ * switch results - rather than one of each per item as would be the case if
+ * xQueueSend() were called uxItemCount times.
+ *
+ * If the queue is full the calling task blocks for up to xTicksToWait ticks
+ * for at least one space to become available.  Once there is space as many
+ * items as will fit are sent, so fewer than uxItemCount items may be sent.
+ * Items are never split across the call, and the items that are sent are
+ * always the first items in pvItemsToQueue.
+ *
+ * Batch functions cannot be used with semaphores, mutexes or zero copy queues.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each of the
+ * size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items in pvItemsToQueue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it be full.
+ *
+ * @return The number of items that were posted, which is 0 if the queue
+ * remained full for the entire block time.
+ *
+ * Example usage:
+   <pre>
+ #define BATCH_SIZE 8
+
+ void vATask( void *pvParameters )
+ {
+ uint32_t ulSamples[ BATCH_SIZE ];
+ UBaseType_t uxSent = 0;
+
+	// Create a queue capable of containing 32 uint32_t values.
+	xQueue = xQueueCreate( 32, sizeof( uint32_t ) );
+
+	// ... Fill ulSamples ...
+
+	// Post all the samples, blocking as necessary.
+	while( uxSent < BATCH_SIZE )
+	{
+		uxSent += ( UBaseType_t ) xQueueSendMultiple( xQueue, &( ulSamples[ uxSent ] ), BATCH_SIZE - uxSent, portMAX_DELAY );
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultiple(
+								QueueHandle_t xQueue,
+								void * const pvBuffer,
+								UBaseType_t uxMaxItems,
+								TickType_t xTicksToWait
+							);
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from the front of a queue.  The items are
+ * copied out of the queue in a single critical section, tasks waiting to send
+ * to the queue are unblocked once for the whole batch, and at most one context
+ * switch results.
+ *
+ * If the queue is empty the calling task blocks for up to xTicksToWait ticks
+ * for at least one item to become available.  Once the queue is not empty as
+ * many items as are available (up to uxMaxItems) are received.
+ *
+ * Batch functions cannot be used with semaphores, mutexes or zero copy queues.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty.
+ *
+ * @return The number of items received into pvBuffer, which is 0 if the queue
+ * remained empty for the entire block time.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultipleFromISR(
+									QueueHandle_t xQueue,
+									const void * const pvItemsToQueue,
+									UBaseType_t uxItemCount,
+									BaseType_t *pxHigherPriorityTaskWoken
+								);
+ </pre>
+ * <pre>
+ BaseType_t xQueueReceiveMultipleFromISR(
+									QueueHandle_t xQueue,
+									void * const pvBuffer,
+									UBaseType_t uxMaxItems,
+									BaseType_t *pxHigherPriorityTaskWoken
+								);
+ </pre>
+ *
+ * Versions of xQueueSendMultiple() and xQueueReceiveMultiple() that can be
+ * used from an interrupt service routine.  Neither function blocks, so each
+ * transfers as many items as possible and returns the number transferred.
+ *
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if the transfer unblocked a task
+ * with a priority higher than the currently running task.  The decision is
+ * made once for the whole batch, so a single context switch should be
+ * requested before the interrupt exits, exactly as when using
+ * xQueueSendFromISR() or xQueueReceiveFromISR().
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1537,6 +1677,229 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FU
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateZeroCopy(
+									 UBaseType_t uxQueueLength,
+									 UBaseType_t uxItemSize
+								 );
+ * </pre>
+ *
+ * Creates a zero copy queue.  Items are not copied into or out of a zero copy
+ * queue.  Instead a producer reserves a slot in the queue storage area using
+ * pvQueueReserve(), writes the item directly into the slot, then passes the
+ * slot to the queue using xQueueCommit().  A consumer obtains the oldest
+ * committed slot using pvQueueBorrow(), uses the item in place, then hands the
+ * slot back using xQueueRelease(), after which the slot can be reserved again.
+ *
+ * Items are borrowed in the order in which their slots were reserved.  If a
+ * slot is committed before a slot that was reserved ahead of it then it does
+ * not become available until the earlier slot is also committed.  Likewise a
+ * released slot does not return to the free pool until the slots borrowed
+ * ahead of it have also been released.
+ *
+ * A zero copy queue can be added to a queue set.  The queue set receives one
+ * event for each slot that becomes available to borrow.
+ *
+ * Zero copy queues must only be accessed using the reserve, commit, borrow and
+ * release functions, and their FromISR() equivalents.  configUSE_ZERO_COPY_QUEUES
+ * must be set to 1 in FreeRTOSConfig.h for zero copy queues to be available.
+ *
+ * @param uxQueueLength The number of slots in the queue.
+ *
+ * @param uxItemSize The size of each slot in bytes.  Slots are uxItemSize bytes
+ * apart in the storage area, so uxItemSize should be a multiple of
+ * portBYTE_ALIGNMENT if slots are to hold structures.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+ struct AFrame
+ {
+	uint32_t ulLength;
+	uint8_t ucData[ 1500 ];
+ };
+
+ QueueHandle_t xFrameQueue;
+
+ void vProducerTask( void *pvParameters )
+ {
+ struct AFrame *pxFrame;
+
+	xFrameQueue = xQueueCreateZeroCopy( 4, sizeof( struct AFrame ) );
+
+	for( ;; )
+	{
+		// Wait for a free slot, then fill it in place.
+		pxFrame = ( struct AFrame * ) pvQueueReserve( xFrameQueue, portMAX_DELAY );
+		pxFrame->ulLength = ulReceiveFrame( pxFrame->ucData );
+
+		// Make the frame available to the consumer.
+		xQueueCommit( xFrameQueue, pxFrame );
+	}
+ }
+
+ void vConsumerTask( void *pvParameters )
+ {
+ struct AFrame *pxFrame;
+
+	for( ;; )
+	{
+		// Wait for a frame, and process it where it is.
+		pxFrame = ( struct AFrame * ) pvQueueBorrow( xFrameQueue, portMAX_DELAY );
+		vProcessFrame( pxFrame->ucData, pxFrame->ulLength );
+
+		// Return the slot so it can be reserved again.
+		xQueueRelease( xFrameQueue, pxFrame );
+	}
+ }
+ </pre>
+ * \defgroup xQueueCreateZeroCopy xQueueCreateZeroCopy
+ * \ingroup QueueManagement
+ */
+#if( ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	#define xQueueCreateZeroCopy( uxQueueLength, uxItemSize ) xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_ZERO_COPY ) )
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateZeroCopyStatic(
+										   UBaseType_t uxQueueLength,
+										   UBaseType_t uxItemSize,
+										   uint8_t *pucQueueStorageBuffer,
+										   StaticQueue_t *pxQueueBuffer
+									   );
+ * </pre>
+ *
+ * Creates a zero copy queue using memory provided by the application writer.
+ * See xQueueCreateZeroCopy() for a description of zero copy queues.
+ *
+ * @param pucQueueStorageBuffer Must point to a uint8_t array that is at least
+ * queueZERO_COPY_STORAGE_SIZE( uxQueueLength, uxItemSize ) bytes long.  A zero
+ * copy queue needs a state byte for each slot in addition to the slots
+ * themselves.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * \defgroup xQueueCreateZeroCopyStatic xQueueCreateZeroCopyStatic
+ * \ingroup QueueManagement
+ */
+#define queueZERO_COPY_STORAGE_SIZE( uxQueueLength, uxItemSize ) ( ( ( uxQueueLength ) * ( uxItemSize ) ) + ( uxQueueLength ) )
+
+#if( ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	#define xQueueCreateZeroCopyStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_ZERO_COPY ) )
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Reserve a slot in a zero copy queue.  The slot belongs to the caller until
+ * it is passed to xQueueCommit(), and its contents are not visible to
+ * consumers until then.
+ *
+ * @param xQueue The handle of a queue created using xQueueCreateZeroCopy() or
+ * xQueueCreateZeroCopyStatic().
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a slot to become free, should none be free at the time of the call.
+ *
+ * @return The address of the reserved slot, or NULL if no slot became free
+ * before the block time expired.
+ *
+ * \defgroup pvQueueReserve pvQueueReserve
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueCommit( QueueHandle_t xQueue, void * const pvSlot );
+ * </pre>
+ *
+ * Pass a slot obtained from pvQueueReserve() or pvQueueReserveFromISR() to the
+ * queue.  The caller must not access the slot after it has been committed.
+ *
+ * @param xQueue The handle of the queue the slot was reserved from.
+ *
+ * @param pvSlot The address returned when the slot was reserved.
+ *
+ * @return pdPASS if the slot was committed, or pdFAIL if pvSlot was not a
+ * reserved slot of xQueue.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueCommit( QueueHandle_t xQueue, void * const pvSlot ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueBorrow( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Obtain the oldest committed slot from a zero copy queue.  The slot belongs to
+ * the caller until it is passed to xQueueRelease().
+ *
+ * @param xQueue The handle of the queue to borrow from.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a slot to be committed, should none be available at the time of the
+ * call.
+ *
+ * @return The address of the borrowed slot, or NULL if no slot became
+ * available before the block time expired.
+ *
+ * \defgroup pvQueueBorrow pvQueueBorrow
+ * \ingroup QueueManagement
+ */
+void *pvQueueBorrow( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueRelease( QueueHandle_t xQueue, void * const pvSlot );
+ * </pre>
+ *
+ * Hand a slot obtained from pvQueueBorrow() or pvQueueBorrowFromISR() back to
+ * the queue so it can be reserved again.  The caller must not access the slot
+ * after it has been released.
+ *
+ * @param xQueue The handle of the queue the slot was borrowed from.
+ *
+ * @param pvSlot The address returned when the slot was borrowed.
+ *
+ * @return pdPASS if the slot was released, or pdFAIL if pvSlot was not a
+ * borrowed slot of xQueue.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueRelease( QueueHandle_t xQueue, void * const pvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Versions of the zero copy queue functions that can be called from an ISR.
+ * Reserving and borrowing never unblock a task so pvQueueReserveFromISR() and
+ * pvQueueBorrowFromISR() do not have a pxHigherPriorityTaskWoken parameter.
+ * xQueueCommitFromISR() and xQueueReleaseFromISR() set
+ * *pxHigherPriorityTaskWoken to pdTRUE if committing or releasing the slot
+ * unblocked a task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ */
+void *pvQueueReserveFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, void * const pvSlot, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void *pvQueueBorrowFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, void * const pvSlot, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * The functions defined above are for passing data to and from tasks.  The
  * functions below are the equivalents for passing data to and from
@@ -0,0 +1,453 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Stream buffers are used to send a continuous stream of bytes from a single
+ * writer (a task or an interrupt) to a single reader (a task or an interrupt).
+ * Message buffers are stream buffers in which each write is stored as a
+ * discrete message that is read back in one piece.
+ *
+ * Only the writer ever updates the buffer's head index, and only the reader
+ * ever updates the buffer's tail index, so data is written and read without
+ * entering a critical section.  A task that blocks on a stream buffer waits
+ * on its own direct to task notification, and is woken by the other side only
+ * when it is actually blocked.
+ *
+ * IMPORTANT NOTE:  As the implementation does not use a critical section on
+ * the read or write paths it is only safe to use a stream buffer if there is
+ * only one writer and one reader.  If there are multiple writers then each
+ * call to a writing API function (such as xStreamBufferSend()) must be placed
+ * inside a critical section, or otherwise serialised, and the same applies to
+ * multiple readers.
+ *
+ * A task blocked on a stream buffer waits on its direct to task notification.
+ * The notification value is not changed, and a notification sent to the task
+ * for another purpose while it is blocked is sent on again when the stream
+ * buffer function returns, so it is delayed rather than lost.  If the other
+ * side of the buffer notifies the task just as its block time expires, the
+ * task can be left with a notification pending that no other task sent, so a
+ * task that also waits on its notification with xTaskNotifyWait() should check
+ * the condition it is waiting for when it is woken.  ulTaskNotifyTake() is not
+ * affected, as it only uses the notification value.
+ *
+ * sbuffer.c must be included in the build to use stream buffers.
+ */
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include sbuffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns a StreamBufferHandle_t variable that can then
+ * be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ * Message buffers are referenced using the same type.
+ */
+typedef void * StreamBufferHandle_t;
+
+/**
+ * sbuffer.h
+ *<pre>
+ StreamBufferHandle_t xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ </pre>
+ *
+ * Creates a new stream buffer using dynamically allocated memory.
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the stream
+ * buffer before a task that is blocked on the stream buffer to wait for data is
+ * moved out of the blocked state.  For example, if a task is blocked on a read
+ * of an empty stream buffer that has a trigger level of 1 then the task will be
+ * unblocked when a single byte is written to the buffer or the task's block
+ * time expires.  As another example, if a task is blocked on a read of an empty
+ * stream buffer that has a trigger level of 10 then the task will not be
+ * unblocked until the stream buffer contains at least 10 bytes or the task's
+ * block time expires.  A trigger level of 0 is treated as a trigger level of 1.
+ *
+ * @return If NULL is returned then the stream buffer cannot be created because
+ * there is insufficient heap memory available.  A non-NULL value being returned
+ * indicates the stream buffer has been created successfully.
+ *
+ * Example usage:
+   <pre>
+	StreamBufferHandle_t xStreamBuffer;
+
+	// Create a stream buffer that can hold 100 bytes, and unblock a reading
+	// task when at least 10 bytes are available.
+	xStreamBuffer = xStreamBufferCreate( 100, 10 );
+
+	if( xStreamBuffer == NULL )
+	{
+		// There was not enough heap memory space available to create the
+		// stream buffer.
+	}
+   </pre>
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+#endif
+
+/**
+ * sbuffer.h
+ *<pre>
+ StreamBufferHandle_t xMessageBufferCreate( size_t xBufferSizeBytes );
+ </pre>
+ *
+ * Creates a new message buffer using dynamically allocated memory.  Each
+ * message written to a message buffer is stored with a sizeof( size_t ) byte
+ * length prefix, so writing a 10 byte message consumes 10 + sizeof( size_t )
+ * bytes of the buffer's capacity.
+ *
+ * A message buffer is read and written using the same functions as a stream
+ * buffer, but a write either writes the whole message or nothing, and a read
+ * returns exactly one message.
+ *
+ * @param xBufferSizeBytes The total number of bytes (not messages) the message
+ * buffer will be able to hold at any one time, including the length prefixes.
+ *
+ * @return If NULL is returned then the message buffer cannot be created because
+ * there is insufficient heap memory available.  A non-NULL value being returned
+ * indicates the message buffer has been created successfully.
+ *
+ * \defgroup xMessageBufferCreate xMessageBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xMessageBufferCreate( xBufferSizeBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE )
+#endif
+
+/**
+ * sbuffer.h
+ *<pre>
+ StreamBufferHandle_t xStreamBufferCreateStatic( size_t xBufferSizeBytes,
+                                                 size_t xTriggerLevelBytes,
+                                                 uint8_t *pucStreamBufferStorageArea,
+                                                 StaticStreamBuffer_t *pxStaticStreamBuffer );
+ </pre>
+ *
+ * Creates a new stream buffer using statically allocated memory.  See
+ * xStreamBufferCreate() for a description of the xBufferSizeBytes and
+ * xTriggerLevelBytes parameters.
+ *
+ * @param pucStreamBufferStorageArea Must point to a uint8_t array that is at
+ * least xBufferSizeBytes + 1 bytes big.  This is the array to which streams are
+ * copied when they are written to the stream buffer.
+ *
+ * @param pxStaticStreamBuffer Must point to a variable of type
+ * StaticStreamBuffer_t, which will be used to hold the stream buffer's data
+ * structure.
+ *
+ * @return If the stream buffer is created successfully then a handle to the
+ * created stream buffer is returned.  If either pucStreamBufferStorageArea or
+ * pxStaticStreamBuffer are NULL then NULL is returned.
+ *
+ * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
+ * \ingroup StreamBufferManagement
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ) )
+	#define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ) )
+#endif
+
+/**
+ * sbuffer.h
+ *<pre>
+ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+                           const void *pvTxData,
+                           size_t xDataLengthBytes,
+                           TickType_t xTicksToWait );
+ </pre>
+ *
+ * Sends bytes to a stream buffer, or a message to a message buffer.  The data
+ * is copied into the buffer.
+ *
+ * Use xStreamBufferSend() to write from a task.  Use xStreamBufferSendFromISR()
+ * to write from an interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the buffer to which data is being sent.
+ *
+ * @param pvTxData A pointer to the data that is to be copied into the buffer.
+ *
+ * @param xDataLengthBytes The maximum number of bytes to copy from pvTxData
+ * into the buffer.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for enough space to become available in the buffer,
+ * should the buffer contain too little space to hold another xDataLengthBytes
+ * bytes.  If a stream buffer still does not have enough space when the block
+ * time expires then as many bytes as will fit are written.  If a message buffer
+ * does not have enough space then nothing is written.
+ *
+ * @return The number of bytes written to the buffer.  For a message buffer
+ * this is either xDataLengthBytes or 0.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * sbuffer.h
+ *<pre>
+ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
+                                  const void *pvTxData,
+                                  size_t xDataLengthBytes,
+                                  BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Interrupt safe version of xStreamBufferSend().  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing to the buffer
+ * unblocked a task that has a priority above that of the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.  Can be NULL.
+ *
+ * @return The number of bytes written to the buffer.
+ *
+ * Example usage:
+   <pre>
+	// A stream buffer that has already been created.
+	StreamBufferHandle_t xStreamBuffer;
+
+	void vAnInterruptServiceRoutine( void )
+	{
+	uint8_t ucRxByte;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		ucRxByte = UART_RX_REGISTER;
+
+		// Pass the byte to the task that processes the received data.  No
+		// critical section is entered unless the task is blocked on the
+		// buffer.
+		xStreamBufferSendFromISR( xStreamBuffer, &ucRxByte, sizeof( ucRxByte ), &xHigherPriorityTaskWoken );
+
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+	}
+   </pre>
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * sbuffer.h
+ *<pre>
+ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+                              void *pvRxData,
+                              size_t xBufferLengthBytes,
+                              TickType_t xTicksToWait );
+ </pre>
+ *
+ * Receives bytes from a stream buffer, or a message from a message buffer.
+ *
+ * Use xStreamBufferReceive() to read from a task.  Use
+ * xStreamBufferReceiveFromISR() to read from an interrupt service routine.
+ *
+ * @param xStreamBuffer The handle of the buffer from which data is received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received data is
+ * copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ * This sets the maximum number of bytes to receive in one call.  If the next
+ * message in a message buffer is longer than xBufferLengthBytes then the
+ * message is left in the message buffer and 0 is returned.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data (a stream buffer's trigger level number of
+ * bytes, or one message) to become available.
+ *
+ * @return The number of bytes read from the buffer.  Can be less than the
+ * trigger level if the block time expired.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * sbuffer.h
+ *<pre>
+ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                     void *pvRxData,
+                                     size_t xBufferLengthBytes,
+                                     BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * Interrupt safe version of xStreamBufferReceive().  Never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if reading from the buffer
+ * unblocked a task that has a priority above that of the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.  Can be NULL.
+ *
+ * @return The number of bytes read from the buffer.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * sbuffer.h
+ *<pre>
+ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer );
+ </pre>
+ *
+ * Deletes a stream buffer that was previously created using a call to
+ * xStreamBufferCreate() or xStreamBufferCreateStatic().  If the stream buffer
+ * was created using dynamic memory then the memory is freed.
+ *
+ * A stream buffer handle must not be used after the stream buffer has been
+ * deleted.
+ *
+ * \defgroup vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * sbuffer.h
+ *<pre>
+ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer );
+ </pre>
+ *
+ * Resets a stream buffer to its initial, empty, state.  Any data in the
+ * stream buffer is discarded.  A stream buffer can only be reset if there are
+ * no tasks blocked waiting to either send to or receive from the stream
+ * buffer.
+ *
+ * @return If the stream buffer is reset then pdPASS is returned.  If there was
+ * a task blocked waiting to send to or read from the stream buffer then the
+ * stream buffer is not reset and pdFAIL is returned.
+ *
+ * \defgroup xStreamBufferReset xStreamBufferReset
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * sbuffer.h
+ *<pre>
+ BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer );
+ BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer );
+ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer );
+ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer );
+ </pre>
+ *
+ * Query the number of bytes held in, and the space remaining in, a stream
+ * buffer.  These functions can be called from tasks and interrupts.  The
+ * values returned are only guaranteed to be accurate when called by the reader
+ * (for xStreamBufferBytesAvailable() and xStreamBufferIsEmpty()) or the writer
+ * (for xStreamBufferSpacesAvailable() and xStreamBufferIsFull()), as the other
+ * side can change the buffer at any time.
+ *
+ * A message buffer is considered full when there is no longer space for the
+ * length prefix of another message.
+ *
+ * \defgroup xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/* Functions beyond this part are not part of the public API and are intended
+for use by the kernel only. */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configUSE_TRACE_FACILITY == 1 )
+	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+	void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer, UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !defined( STREAM_BUFFER_H ) */
+
@@ -175,6 +175,10 @@ typedef struct xTASK_STATUS
 	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	uint16_t usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	uint32_t ulHeapMallocCount;		/* The number of times the task has called pvPortMalloc().  Only valid if configUSE_HEAP_INSTRUMENTATION is defined as 1 in FreeRTOSConfig.h and the heap implementation supports it. */
+	uint32_t ulHeapFreeCount;		/* The number of times the task has called vPortFree().  Only valid if configUSE_HEAP_INSTRUMENTATION is defined as 1 in FreeRTOSConfig.h and the heap implementation supports it. */
+	uint32_t ulHeapMallocCycles;	/* The total time the task has spent in pvPortMalloc(), as measured by portGET_HEAP_CYCLE_COUNTER_VALUE().  Only valid if configUSE_HEAP_INSTRUMENTATION is defined as 1 in FreeRTOSConfig.h. */
+	uint32_t ulHeapFreeCycles;		/* The total time the task has spent in vPortFree(), as measured by portGET_HEAP_CYCLE_COUNTER_VALUE().  Only valid if configUSE_HEAP_INSTRUMENTATION is defined as 1 in FreeRTOSConfig.h. */
 } TaskStatus_t;
 
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
@@ -2258,6 +2262,16 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 void *pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Called by the heap implementation, with the
+ * scheduler suspended, at the end of each pvPortMalloc() (xIsAllocation set to
+ * pdTRUE) or vPortFree() (xIsAllocation set to pdFALSE) call when
+ * configUSE_HEAP_INSTRUMENTATION is 1.  Charges the operation, and the
+ * ulCycles it took, to the calling task and returns the handle of that task so
+ * the heap can tag the allocated block with its owner.
+ */
+void *pvTaskRecordHeapOperation( BaseType_t xIsAllocation, uint32_t ulCycles ) PRIVILEGED_FUNCTION;
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,43 @@
 #include "FreeRTOS.h"
 #include "list.h"
 
+#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+
+	/* Colours of the nodes in the red-black tree used to index a list. */
+	#define listTREE_RED		( ( UBaseType_t ) 0U )
+	#define listTREE_BLACK		( ( UBaseType_t ) 1U )
+
+	#define listTREE_IS_RED( pxItem ) ( ( ( pxItem ) != NULL ) && ( ( pxItem )->uxTreeColour == listTREE_RED ) )
+
+	/*
+	 * Rotate the index tree of pxList left or right around pxItem.
+	 */
+	static void prvTreeRotateLeft( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+	static void prvTreeRotateRight( List_t * const pxList, ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Replace pxOld in the index tree of pxList with pxNew, which is either one
+	 * of the subtrees of pxOld or NULL.
+	 */
+	static void prvTreeTransplant( List_t * const pxList, ListItem_t * const pxOld, ListItem_t * const pxNew ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Add pxNewListItem to the index tree of pxList.  Returns the item after
+	 * which pxNewListItem must be linked into the list to keep the list in item
+	 * value order - which is the last item that has an item value less than or
+	 * equal to that of pxNewListItem - or NULL if pxNewListItem belongs at the
+	 * head of the list.
+	 */
+	static ListItem_t *prvTreeInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove pxItemToRemove from the index tree of pxList.  Must be called while
+	 * pxItemToRemove is still linked into the list.
+	 */
+	static void prvTreeRemove( List_t * const pxList, ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_INDEXED_DELAYED_LISTS */
+
 /*-----------------------------------------------------------
  * PUBLIC LIST API documented in list.h
  *----------------------------------------------------------*/
@@ -94,6 +131,14 @@ void vListInitialise( List_t * const pxList )
 
 	pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+	{
+		/* Lists are not indexed unless vListInitialiseIndexed() is used. */
+		pxList->pxTreeRoot = NULL;
+		pxList->xIsIndexed = pdFALSE;
+	}
+	#endif
+
 	/* Write known values into the list if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -101,6 +146,17 @@ void vListInitialise( List_t * const pxList )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+
+	void vListInitialiseIndexed( List_t * const pxList )
+	{
+		vListInitialise( pxList );
+		pxList->xIsIndexed = pdTRUE;
+	}
+
+#endif /* configUSE_INDEXED_DELAYED_LISTS */
+/*-----------------------------------------------------------*/
+
 void vListInitialiseItem( ListItem_t * const pxItem )
 {
 	/* Make sure the list item is not recorded as being on a list. */
@@ -123,6 +179,13 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 	listTEST_LIST_INTEGRITY( pxList );
 	listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
 
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+	{
+		/* Indexed lists must remain sorted. */
+		configASSERT( pxList->xIsIndexed == pdFALSE );
+	}
+	#endif
+
 	/* Insert a new list item into pxList, but rather than sort the list,
 	makes the new list item the last item to be removed by a call to
 	listGET_OWNER_OF_NEXT_ENTRY(). */
@@ -161,7 +224,28 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	share of the CPU.  However, if the xItemValue is the same as the back marker
 	the iteration loop below will not end.  Therefore the value is checked
 	first, and the algorithm slightly modified if necessary. */
-	if( xValueOfInsertion == portMAX_DELAY )
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+		if( pxList->xIsIndexed != pdFALSE )
+		{
+			/* The insertion point is found by descending the index tree, rather
+			than by walking the list.  Items with equal values are placed to the
+			right of (after) each other in the tree, so the same ordering rule
+			applies. */
+			pxIterator = prvTreeInsert( pxList, pxNewListItem );
+
+			if( pxIterator == NULL )
+			{
+				pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+	#endif /* configUSE_INDEXED_DELAYED_LISTS */
+
+	if( xValueOfInsertion == portMAX_DELAY ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
 	}
@@ -215,6 +299,19 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 item. */
 List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 
+	#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+	{
+		if( pxList->xIsIndexed != pdFALSE )
+		{
+			prvTreeRemove( pxList, pxItemToRemove );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_INDEXED_DELAYED_LISTS */
+
 	pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
 	pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
@@ -238,3 +335,339 @@ List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_INDEXED_DELAYED_LISTS == 1 )
+
+	static void prvTreeRotateLeft( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t * const pxPivot = pxItem->pxTreeRight;
+
+		pxItem->pxTreeRight = pxPivot->pxTreeLeft;
+		if( pxPivot->pxTreeLeft != NULL )
+		{
+			pxPivot->pxTreeLeft->pxTreeParent = pxItem;
+		}
+
+		pxPivot->pxTreeParent = pxItem->pxTreeParent;
+		if( pxItem->pxTreeParent == NULL )
+		{
+			pxList->pxTreeRoot = pxPivot;
+		}
+		else if( pxItem == pxItem->pxTreeParent->pxTreeLeft )
+		{
+			pxItem->pxTreeParent->pxTreeLeft = pxPivot;
+		}
+		else
+		{
+			pxItem->pxTreeParent->pxTreeRight = pxPivot;
+		}
+
+		pxPivot->pxTreeLeft = pxItem;
+		pxItem->pxTreeParent = pxPivot;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeRotateRight( List_t * const pxList, ListItem_t * const pxItem )
+	{
+	ListItem_t * const pxPivot = pxItem->pxTreeLeft;
+
+		pxItem->pxTreeLeft = pxPivot->pxTreeRight;
+		if( pxPivot->pxTreeRight != NULL )
+		{
+			pxPivot->pxTreeRight->pxTreeParent = pxItem;
+		}
+
+		pxPivot->pxTreeParent = pxItem->pxTreeParent;
+		if( pxItem->pxTreeParent == NULL )
+		{
+			pxList->pxTreeRoot = pxPivot;
+		}
+		else if( pxItem == pxItem->pxTreeParent->pxTreeRight )
+		{
+			pxItem->pxTreeParent->pxTreeRight = pxPivot;
+		}
+		else
+		{
+			pxItem->pxTreeParent->pxTreeLeft = pxPivot;
+		}
+
+		pxPivot->pxTreeRight = pxItem;
+		pxItem->pxTreeParent = pxPivot;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeTransplant( List_t * const pxList, ListItem_t * const pxOld, ListItem_t * const pxNew )
+	{
+		if( pxOld->pxTreeParent == NULL )
+		{
+			pxList->pxTreeRoot = pxNew;
+		}
+		else if( pxOld == pxOld->pxTreeParent->pxTreeLeft )
+		{
+			pxOld->pxTreeParent->pxTreeLeft = pxNew;
+		}
+		else
+		{
+			pxOld->pxTreeParent->pxTreeRight = pxNew;
+		}
+
+		if( pxNew != NULL )
+		{
+			pxNew->pxTreeParent = pxOld->pxTreeParent;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static ListItem_t *prvTreeInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
+	{
+	ListItem_t *pxItem, *pxParent = NULL, *pxPredecessor = NULL, *pxGrandparent, *pxUncle;
+	const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+
+		/* Descend the tree to find the leaf position of the new item,
+		remembering the last item passed on the left as that is the item the new
+		item will follow in the list. */
+		pxItem = pxList->pxTreeRoot;
+		while( pxItem != NULL )
+		{
+			pxParent = pxItem;
+
+			if( xValueOfInsertion < pxItem->xItemValue )
+			{
+				pxItem = pxItem->pxTreeLeft;
+			}
+			else
+			{
+				pxPredecessor = pxItem;
+				pxItem = pxItem->pxTreeRight;
+			}
+		}
+
+		pxNewListItem->pxTreeParent = pxParent;
+		pxNewListItem->pxTreeLeft = NULL;
+		pxNewListItem->pxTreeRight = NULL;
+		pxNewListItem->uxTreeColour = listTREE_RED;
+
+		if( pxParent == NULL )
+		{
+			pxList->pxTreeRoot = pxNewListItem;
+		}
+		else if( xValueOfInsertion < pxParent->xItemValue )
+		{
+			pxParent->pxTreeLeft = pxNewListItem;
+		}
+		else
+		{
+			pxParent->pxTreeRight = pxNewListItem;
+		}
+
+		/* Restore the red-black properties.  At most two rotations are
+		performed, and the recolouring loop moves two levels up the tree on each
+		iteration. */
+		pxItem = pxNewListItem;
+		while( listTREE_IS_RED( pxItem->pxTreeParent ) )
+		{
+			pxParent = pxItem->pxTreeParent;
+
+			/* The parent is red so cannot be the root, so the grandparent
+			exists. */
+			pxGrandparent = pxParent->pxTreeParent;
+
+			if( pxParent == pxGrandparent->pxTreeLeft )
+			{
+				pxUncle = pxGrandparent->pxTreeRight;
+
+				if( listTREE_IS_RED( pxUncle ) )
+				{
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxUncle->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					pxItem = pxGrandparent;
+				}
+				else
+				{
+					if( pxItem == pxParent->pxTreeRight )
+					{
+						pxItem = pxParent;
+						prvTreeRotateLeft( pxList, pxItem );
+						pxParent = pxItem->pxTreeParent;
+					}
+
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					prvTreeRotateRight( pxList, pxGrandparent );
+				}
+			}
+			else
+			{
+				pxUncle = pxGrandparent->pxTreeLeft;
+
+				if( listTREE_IS_RED( pxUncle ) )
+				{
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxUncle->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					pxItem = pxGrandparent;
+				}
+				else
+				{
+					if( pxItem == pxParent->pxTreeLeft )
+					{
+						pxItem = pxParent;
+						prvTreeRotateRight( pxList, pxItem );
+						pxParent = pxItem->pxTreeParent;
+					}
+
+					pxParent->uxTreeColour = listTREE_BLACK;
+					pxGrandparent->uxTreeColour = listTREE_RED;
+					prvTreeRotateLeft( pxList, pxGrandparent );
+				}
+			}
+		}
+
+		pxList->pxTreeRoot->uxTreeColour = listTREE_BLACK;
+
+		return pxPredecessor;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTreeRemove( List_t * const pxList, ListItem_t * const pxItemToRemove )
+	{
+	ListItem_t *pxReplacement, *pxChild, *pxChildParent, *pxSibling;
+	UBaseType_t uxRemovedColour;
+
+		uxRemovedColour = pxItemToRemove->uxTreeColour;
+
+		if( pxItemToRemove->pxTreeLeft == NULL )
+		{
+			pxChild = pxItemToRemove->pxTreeRight;
+			pxChildParent = pxItemToRemove->pxTreeParent;
+			prvTreeTransplant( pxList, pxItemToRemove, pxChild );
+		}
+		else if( pxItemToRemove->pxTreeRight == NULL )
+		{
+			pxChild = pxItemToRemove->pxTreeLeft;
+			pxChildParent = pxItemToRemove->pxTreeParent;
+			prvTreeTransplant( pxList, pxItemToRemove, pxChild );
+		}
+		else
+		{
+			/* The item has two children so is replaced by its in-order
+			successor, which is the leftmost item of its right subtree and is
+			also the next item in the list - so no search is required. */
+			pxReplacement = pxItemToRemove->pxNext;
+			uxRemovedColour = pxReplacement->uxTreeColour;
+			pxChild = pxReplacement->pxTreeRight;
+
+			if( pxReplacement->pxTreeParent == pxItemToRemove )
+			{
+				pxChildParent = pxReplacement;
+			}
+			else
+			{
+				pxChildParent = pxReplacement->pxTreeParent;
+				prvTreeTransplant( pxList, pxReplacement, pxChild );
+				pxReplacement->pxTreeRight = pxItemToRemove->pxTreeRight;
+				pxReplacement->pxTreeRight->pxTreeParent = pxReplacement;
+			}
+
+			prvTreeTransplant( pxList, pxItemToRemove, pxReplacement );
+			pxReplacement->pxTreeLeft = pxItemToRemove->pxTreeLeft;
+			pxReplacement->pxTreeLeft->pxTreeParent = pxReplacement;
+			pxReplacement->uxTreeColour = pxItemToRemove->uxTreeColour;
+		}
+
+		/* Removing a black item leaves one path short of a black item, which
+		is corrected by recolouring up the tree and at most three rotations. */
+		if( uxRemovedColour == listTREE_BLACK )
+		{
+			while( ( pxChild != pxList->pxTreeRoot ) && ( listTREE_IS_RED( pxChild ) == pdFALSE ) )
+			{
+				if( pxChild == pxChildParent->pxTreeLeft )
+				{
+					pxSibling = pxChildParent->pxTreeRight;
+
+					if( listTREE_IS_RED( pxSibling ) )
+					{
+						pxSibling->uxTreeColour = listTREE_BLACK;
+						pxChildParent->uxTreeColour = listTREE_RED;
+						prvTreeRotateLeft( pxList, pxChildParent );
+						pxSibling = pxChildParent->pxTreeRight;
+					}
+
+					if( ( listTREE_IS_RED( pxSibling->pxTreeLeft ) == pdFALSE ) && ( listTREE_IS_RED( pxSibling->pxTreeRight ) == pdFALSE ) )
+					{
+						pxSibling->uxTreeColour = listTREE_RED;
+						pxChild = pxChildParent;
+						pxChildParent = pxChild->pxTreeParent;
+					}
+					else
+					{
+						if( listTREE_IS_RED( pxSibling->pxTreeRight ) == pdFALSE )
+						{
+							pxSibling->pxTreeLeft->uxTreeColour = listTREE_BLACK;
+							pxSibling->uxTreeColour = listTREE_RED;
+							prvTreeRotateRight( pxList, pxSibling );
+							pxSibling = pxChildParent->pxTreeRight;
+						}
+
+						pxSibling->uxTreeColour = pxChildParent->uxTreeColour;
+						pxChildParent->uxTreeColour = listTREE_BLACK;
+						pxSibling->pxTreeRight->uxTreeColour = listTREE_BLACK;
+						prvTreeRotateLeft( pxList, pxChildParent );
+						pxChild = pxList->pxTreeRoot;
+					}
+				}
+				else
+				{
+					pxSibling = pxChildParent->pxTreeLeft;
+
+					if( listTREE_IS_RED( pxSibling ) )
+					{
+						pxSibling->uxTreeColour = listTREE_BLACK;
+						pxChildParent->uxTreeColour = listTREE_RED;
+						prvTreeRotateRight( pxList, pxChildParent );
+						pxSibling = pxChildParent->pxTreeLeft;
+					}
+
+					if( ( listTREE_IS_RED( pxSibling->pxTreeLeft ) == pdFALSE ) && ( listTREE_IS_RED( pxSibling->pxTreeRight ) == pdFALSE ) )
+					{
+						pxSibling->uxTreeColour = listTREE_RED;
+						pxChild = pxChildParent;
+						pxChildParent = pxChild->pxTreeParent;
+					}
+					else
+					{
+						if( listTREE_IS_RED( pxSibling->pxTreeLeft ) == pdFALSE )
+						{
+							pxSibling->pxTreeRight->uxTreeColour = listTREE_BLACK;
+							pxSibling->uxTreeColour = listTREE_RED;
+							prvTreeRotateLeft( pxList, pxSibling );
+							pxSibling = pxChildParent->pxTreeLeft;
+						}
+
+						pxSibling->uxTreeColour = pxChildParent->uxTreeColour;
+						pxChildParent->uxTreeColour = listTREE_BLACK;
+						pxSibling->pxTreeLeft->uxTreeColour = listTREE_BLACK;
+						prvTreeRotateRight( pxList, pxChildParent );
+						pxChild = pxList->pxTreeRoot;
+					}
+				}
+			}
+
+			if( pxChild != NULL )
+			{
+				pxChild->uxTreeColour = listTREE_BLACK;
+			}
+		}
+
+		pxItemToRemove->pxTreeParent = NULL;
+		pxItemToRemove->pxTreeLeft = NULL;
+		pxItemToRemove->pxTreeRight = NULL;
+	}
+
+#endif /* configUSE_INDEXED_DELAYED_LISTS */
+/*-----------------------------------------------------------*/
+
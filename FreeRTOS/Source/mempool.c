@@ -0,0 +1,645 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mempool.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if( configUSE_PREEMPTION == 0 )
+	/* If the cooperative scheduler is being used then a yield should not be
+	performed just because a higher priority task has been woken. */
+	#define mempoolYIELD_IF_USING_PREEMPTION()
+#else
+	#define mempoolYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
+#endif
+
+/* Each free block holds a pointer to the next free block in its first bytes,
+so free blocks form a singly linked list that needs no extra memory. */
+typedef struct xMEMORY_POOL_FREE_BLOCK
+{
+	struct xMEMORY_POOL_FREE_BLOCK *pxNextFreeBlock;
+} MemoryPoolFreeBlock_t;
+
+/*
+ * Free blocks are held on a LIFO list, so the most recently freed block, which
+ * is the block most likely to still be in the cache, is the next to be
+ * allocated.  Taking a block from, or returning a block to, the pool is
+ * therefore O(1), and only needs a short critical section.
+ */
+typedef struct xMEMORY_POOL /*lint !e9058 Style convention uses tag. */
+{
+	MemoryPoolFreeBlock_t *pxFreeList;		/*< The most recently freed block, or NULL if all the blocks are in use. */
+	uint8_t *pucStorage;					/*< Points to the first block. */
+	size_t xBlockSize;						/*< The size of each block, rounded up as described by mempoolALIGNED_BLOCK_SIZE(). */
+	UBaseType_t uxBlockCount;				/*< The number of blocks in the pool. */
+	UBaseType_t uxFreeBlocks;				/*< The number of blocks on the free list. */
+	UBaseType_t uxMinimumEverFreeBlocks;	/*< The lowest value uxFreeBlocks has had, from which the high water mark is derived. */
+	uint32_t ulAllocations;					/*< The number of successful allocations. */
+	uint32_t ulAllocationFailures;			/*< The number of allocations that returned NULL. */
+	List_t xTasksWaitingForBlock;			/*< List of tasks blocked waiting for a block to be freed.  Stored in priority order. */
+	uint8_t ucStaticallyAllocated;			/*< Set to pdTRUE if the pool was created using statically allocated memory, so no attempt is made to free it. */
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t uxMemoryPoolNumber;		/*< Used for tracing purposes. */
+	#endif
+} MemoryPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Take the block at the front of the free list, updating the statistics.
+ * Returns NULL if there are no free blocks.  Must be called from a critical
+ * section.
+ */
+static void *prvTakeBlock( MemoryPool_t * const pxMemoryPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return pvBlock to the front of the free list.  Must be called from a
+ * critical section.
+ */
+static void prvReturnBlock( MemoryPool_t * const pxMemoryPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pvBlock is the start of one of the pool's blocks,
+ * otherwise pdFALSE.  Used to catch blocks being freed to the wrong pool.
+ */
+#if( configASSERT_DEFINED == 1 )
+	static BaseType_t prvIsBlockInPool( const MemoryPool_t * const pxMemoryPool, const void * const pvBlock ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Called by xMemoryPoolCreate() and xMemoryPoolCreateStatic() to fill in the
+ * pool structure and link every block onto the free list.
+ */
+static void prvInitialiseNewMemoryPool( MemoryPool_t * const pxMemoryPool, uint8_t * const pucStorage, UBaseType_t uxBlockCount, size_t xBlockSize, uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	MemoryPoolHandle_t xMemoryPoolCreate( UBaseType_t uxBlockCount, size_t xBlockSize )
+	{
+	uint8_t *pucAllocatedMemory;
+	size_t xStructSize;
+
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+		configASSERT( xBlockSize > ( size_t ) 0 );
+
+		/* The blocks are allocated in the same block of memory as the
+		structure.  The structure size is rounded up so the first block is
+		correctly aligned. */
+		xStructSize = ( sizeof( MemoryPool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xStructSize + mempoolSTORAGE_SIZE_BYTES( uxBlockCount, xBlockSize ) );
+
+		if( pucAllocatedMemory != NULL )
+		{
+			prvInitialiseNewMemoryPool( ( MemoryPool_t * ) pucAllocatedMemory, pucAllocatedMemory + xStructSize, uxBlockCount, xBlockSize, pdFALSE ); /*lint !e826 Area is not too small and alignment is guaranteed provided malloc() behaves as expected and returns aligned buffer. */
+
+			traceMEMORY_POOL_CREATE( ( ( MemoryPool_t * ) pucAllocatedMemory ) );
+		}
+		else
+		{
+			traceMEMORY_POOL_CREATE_FAILED();
+		}
+
+		return ( MemoryPoolHandle_t ) pucAllocatedMemory;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	MemoryPoolHandle_t xMemoryPoolCreateStatic( UBaseType_t uxBlockCount, size_t xBlockSize, uint8_t * const pucPoolStorage, StaticMemoryPool_t * const pxStaticMemoryPool )
+	{
+	MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) pxStaticMemoryPool; /*lint !e740 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+	MemoryPoolHandle_t xReturn;
+
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+		configASSERT( xBlockSize > ( size_t ) 0 );
+		configASSERT( pucPoolStorage );
+		configASSERT( pxStaticMemoryPool );
+
+		/* The blocks are carved directly out of the storage area, so it must
+		be suitably aligned. */
+		configASSERT( ( ( ( size_t ) pucPoolStorage ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticMemoryPool_t equals the size of the real
+			memory pool structure. */
+			volatile size_t xSize = sizeof( StaticMemoryPool_t );
+			configASSERT( xSize == sizeof( MemoryPool_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucPoolStorage != NULL ) && ( pxStaticMemoryPool != NULL ) )
+		{
+			prvInitialiseNewMemoryPool( pxMemoryPool, pucPoolStorage, uxBlockCount, xBlockSize, pdTRUE );
+
+			traceMEMORY_POOL_CREATE( pxMemoryPool );
+
+			xReturn = ( MemoryPoolHandle_t ) pxStaticMemoryPool;
+		}
+		else
+		{
+			xReturn = NULL;
+			traceMEMORY_POOL_CREATE_STATIC_FAILED( xReturn );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool )
+{
+MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) xMemoryPool;
+
+	configASSERT( pxMemoryPool );
+
+	/* A pool must not be deleted while tasks are blocked on it. */
+	configASSERT( listLIST_IS_EMPTY( &( pxMemoryPool->xTasksWaitingForBlock ) ) != pdFALSE );
+
+	traceMEMORY_POOL_DELETE( pxMemoryPool );
+
+	if( pxMemoryPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the blocks were allocated in a single
+			block of memory. */
+			vPortFree( ( void * ) pxMemoryPool );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucStaticallyAllocated must
+			be corrupt. */
+			configASSERT( xMemoryPool == ( MemoryPoolHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and storage area were provided by the application, so
+		just wipe the structure. */
+		( void ) memset( ( void * ) pxMemoryPool, 0x00, sizeof( MemoryPool_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait )
+{
+MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) xMemoryPool;
+void *pvReturn;
+BaseType_t xEntryTimeSet = pdFALSE, xPlacedOnEventList;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxMemoryPool );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	for( ;; )
+	{
+		/* The fast path is a single short critical section. */
+		taskENTER_CRITICAL();
+		{
+			pvReturn = prvTakeBlock( pxMemoryPool );
+
+			if( pvReturn != NULL )
+			{
+				traceMEMORY_POOL_ALLOCATE( pxMemoryPool, pvReturn );
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* No block is free and either no block time was specified or
+				the block time has expired. */
+				( pxMemoryPool->ulAllocationFailures )++;
+				traceMEMORY_POOL_ALLOCATE_FAILED( pxMemoryPool );
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( pvReturn != NULL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+
+		/* Checking the free list and placing the task on the event list are
+		performed in one critical section so a block freed from an interrupt
+		cannot be missed.  The scheduler is suspended so the task does not
+		leave the Blocked state before xTaskResumeAll() is called. */
+		xPlacedOnEventList = pdFALSE;
+		vTaskSuspendAll();
+		taskENTER_CRITICAL();
+		{
+			/* If the block time has expired xTicksToWait is cleared, in which
+			case the next iteration of the loop makes a final attempt to obtain
+			a block, then returns. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( pxMemoryPool->pxFreeList == NULL )
+				{
+					traceBLOCKING_ON_MEMORY_POOL_ALLOCATE( pxMemoryPool );
+					vTaskPlaceOnEventList( &( pxMemoryPool->xTasksWaitingForBlock ), xTicksToWait );
+					xPlacedOnEventList = pdTRUE;
+				}
+				else
+				{
+					/* A block was freed since the last attempt.  Try again. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xTicksToWait = ( TickType_t ) 0;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xTaskResumeAll() == pdFALSE )
+		{
+			if( xPlacedOnEventList != pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemoryPoolAllocateFromISR( MemoryPoolHandle_t xMemoryPool )
+{
+MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) xMemoryPool;
+void *pvReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxMemoryPool );
+
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pvReturn = prvTakeBlock( pxMemoryPool );
+
+		if( pvReturn == NULL )
+		{
+			( pxMemoryPool->ulAllocationFailures )++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMEMORY_POOL_ALLOCATE_FROM_ISR( pxMemoryPool, pvReturn );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock )
+{
+MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) xMemoryPool;
+
+	configASSERT( pxMemoryPool );
+	configASSERT( prvIsBlockInPool( pxMemoryPool, pvBlock ) != pdFALSE );
+
+	taskENTER_CRITICAL();
+	{
+		traceMEMORY_POOL_FREE( pxMemoryPool, pvBlock );
+		prvReturnBlock( pxMemoryPool, pvBlock );
+
+		/* Only one block was freed, so only the highest priority task waiting
+		for a block is unblocked. */
+		if( listLIST_IS_EMPTY( &( pxMemoryPool->xTasksWaitingForBlock ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxMemoryPool->xTasksWaitingForBlock ) ) != pdFALSE )
+			{
+				/* The unblocked task has a priority higher than our own so
+				yield immediately.  Yes it is ok to do this from within the
+				critical section - the kernel takes care of that. */
+				mempoolYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool, void *pvBlock, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) xMemoryPool;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxMemoryPool );
+	configASSERT( prvIsBlockInPool( pxMemoryPool, pvBlock ) != pdFALSE );
+
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		traceMEMORY_POOL_FREE_FROM_ISR( pxMemoryPool, pvBlock );
+		prvReturnBlock( pxMemoryPool, pvBlock );
+
+		/* A task cannot be in the middle of being placed on the event list
+		because that is done inside a critical section.  If the scheduler is
+		suspended xTaskRemoveFromEventList() holds the unblocked task in the
+		pending ready list until the scheduler is resumed. */
+		if( listLIST_IS_EMPTY( &( pxMemoryPool->xTasksWaitingForBlock ) ) == pdFALSE )
+		{
+			if( xTaskRemoveFromEventList( &( pxMemoryPool->xTasksWaitingForBlock ) ) != pdFALSE )
+			{
+				if( pxHigherPriorityTaskWoken != NULL )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemoryPoolGetFreeBlockCount( MemoryPoolHandle_t xMemoryPool )
+{
+	configASSERT( xMemoryPool );
+
+	/* A single UBaseType_t is read, so no critical section is needed. */
+	return ( ( MemoryPool_t * ) xMemoryPool )->uxFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxMemoryPoolStats )
+{
+MemoryPool_t * const pxMemoryPool = ( MemoryPool_t * ) xMemoryPool;
+
+	configASSERT( pxMemoryPool );
+	configASSERT( pxMemoryPoolStats );
+
+	/* Take a consistent snapshot. */
+	taskENTER_CRITICAL();
+	{
+		pxMemoryPoolStats->xBlockSize = pxMemoryPool->xBlockSize;
+		pxMemoryPoolStats->uxBlockCount = pxMemoryPool->uxBlockCount;
+		pxMemoryPoolStats->uxFreeBlocks = pxMemoryPool->uxFreeBlocks;
+		pxMemoryPoolStats->uxMaximumBlocksInUse = pxMemoryPool->uxBlockCount - pxMemoryPool->uxMinimumEverFreeBlocks;
+		pxMemoryPoolStats->ulAllocations = pxMemoryPool->ulAllocations;
+		pxMemoryPoolStats->ulAllocationFailures = pxMemoryPool->ulAllocationFailures;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTakeBlock( MemoryPool_t * const pxMemoryPool )
+{
+MemoryPoolFreeBlock_t *pxBlock;
+
+	pxBlock = pxMemoryPool->pxFreeList;
+
+	if( pxBlock != NULL )
+	{
+		pxMemoryPool->pxFreeList = pxBlock->pxNextFreeBlock;
+		( pxMemoryPool->uxFreeBlocks )--;
+		( pxMemoryPool->ulAllocations )++;
+
+		if( pxMemoryPool->uxFreeBlocks < pxMemoryPool->uxMinimumEverFreeBlocks )
+		{
+			pxMemoryPool->uxMinimumEverFreeBlocks = pxMemoryPool->uxFreeBlocks;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReturnBlock( MemoryPool_t * const pxMemoryPool, void *pvBlock )
+{
+MemoryPoolFreeBlock_t * const pxBlock = ( MemoryPoolFreeBlock_t * ) pvBlock;
+
+	/* More blocks cannot be freed than were allocated. */
+	configASSERT( pxMemoryPool->uxFreeBlocks < pxMemoryPool->uxBlockCount );
+
+	pxBlock->pxNextFreeBlock = pxMemoryPool->pxFreeList;
+	pxMemoryPool->pxFreeList = pxBlock;
+	( pxMemoryPool->uxFreeBlocks )++;
+}
+/*-----------------------------------------------------------*/
+
+#if( configASSERT_DEFINED == 1 )
+
+	static BaseType_t prvIsBlockInPool( const MemoryPool_t * const pxMemoryPool, const void * const pvBlock )
+	{
+	const uint8_t * const pucBlock = ( const uint8_t * ) pvBlock;
+	size_t xOffset;
+	BaseType_t xReturn = pdFALSE;
+
+		if( pucBlock >= pxMemoryPool->pucStorage ) /*lint !e946 Comparison of pointers is the cleanest solution. */
+		{
+			xOffset = ( size_t ) ( pucBlock - pxMemoryPool->pucStorage );
+
+			if( ( xOffset < ( ( size_t ) pxMemoryPool->uxBlockCount * pxMemoryPool->xBlockSize ) ) && ( ( xOffset % pxMemoryPool->xBlockSize ) == ( size_t ) 0 ) )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configASSERT_DEFINED */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewMemoryPool( MemoryPool_t * const pxMemoryPool, uint8_t * const pucStorage, UBaseType_t uxBlockCount, size_t xBlockSize, uint8_t ucStaticallyAllocated )
+{
+UBaseType_t ux;
+uint8_t *pucBlock;
+
+	( void ) memset( ( void * ) pxMemoryPool, 0x00, sizeof( MemoryPool_t ) ); /*lint !e9087 memset() requires void *. */
+
+	pxMemoryPool->pucStorage = pucStorage;
+	pxMemoryPool->xBlockSize = mempoolALIGNED_BLOCK_SIZE( xBlockSize );
+	pxMemoryPool->uxBlockCount = uxBlockCount;
+	pxMemoryPool->uxFreeBlocks = uxBlockCount;
+	pxMemoryPool->uxMinimumEverFreeBlocks = uxBlockCount;
+	pxMemoryPool->ucStaticallyAllocated = ucStaticallyAllocated;
+	vListInitialise( &( pxMemoryPool->xTasksWaitingForBlock ) );
+
+	/* Link the blocks, last block first, so the first block in the storage
+	area is the first to be allocated. */
+	for( ux = uxBlockCount; ux > ( UBaseType_t ) 0; ux-- )
+	{
+		pucBlock = pucStorage + ( ( size_t ) ( ux - ( UBaseType_t ) 1 ) * pxMemoryPool->xBlockSize );
+		( ( MemoryPoolFreeBlock_t * ) pucBlock )->pxNextFreeBlock = pxMemoryPool->pxFreeList; /*lint !e826 The block size is at least the size of a pointer. */
+		pxMemoryPool->pxFreeList = ( MemoryPoolFreeBlock_t * ) pucBlock;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxMemoryPoolGetMemoryPoolNumber( MemoryPoolHandle_t xMemoryPool )
+	{
+		return ( ( MemoryPool_t * ) xMemoryPool )->uxMemoryPoolNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vMemoryPoolSetMemoryPoolNumber( MemoryPoolHandle_t xMemoryPool, UBaseType_t uxMemoryPoolNumber )
+	{
+		( ( MemoryPool_t * ) xMemoryPool )->uxMemoryPoolNumber = uxMemoryPoolNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
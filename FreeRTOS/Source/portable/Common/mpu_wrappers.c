@@ -83,6 +83,8 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 #include "event_groups.h"
+#include "sbuffer.h"
+#include "mempool.h"
 #include "mpu_prototypes.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -625,6 +627,28 @@ BaseType_t xReturn;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, TickType_t xTicksToWait )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+BaseType_t xReturn;
+
+	xReturn = xQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+BaseType_t xReturn;
+
+	xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t MPU_xQueuePeekFromISR( QueueHandle_t pxQueue, void * const pvBuffer )
 {
 BaseType_t xRunningPrivileged = xPortRaisePrivilege();
@@ -778,6 +802,58 @@ void * xReturn;
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	void *MPU_pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	void *pvReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		pvReturn = pvQueueReserve( xQueue, xTicksToWait );
+		vPortResetPrivilege( xRunningPrivileged );
+		return pvReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	BaseType_t MPU_xQueueCommit( QueueHandle_t xQueue, void * const pvSlot )
+	{
+	BaseType_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xQueueCommit( xQueue, pvSlot );
+		vPortResetPrivilege( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	void *MPU_pvQueueBorrow( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	void *pvReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		pvReturn = pvQueueBorrow( xQueue, xTicksToWait );
+		vPortResetPrivilege( xRunningPrivileged );
+		return pvReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	BaseType_t MPU_xQueueRelease( QueueHandle_t xQueue, void * const pvSlot )
+	{
+	BaseType_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xQueueRelease( xQueue, pvSlot );
+		vPortResetPrivilege( xRunningPrivileged );
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
 #if configQUEUE_REGISTRY_SIZE > 0
 	void MPU_vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcName )
 	{
@@ -1116,6 +1192,206 @@ BaseType_t xRunningPrivileged = xPortRaisePrivilege();
 }
 /*-----------------------------------------------------------*/
 
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	{
+	StreamBufferHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, xIsMessageBuffer );
+		vPortResetPrivilege( xRunningPrivileged );
+
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer )
+	{
+	StreamBufferHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, xIsMessageBuffer, pucStreamBufferStorageArea, pxStaticStreamBuffer );
+		vPortResetPrivilege( xRunningPrivileged );
+
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void MPU_vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	vStreamBufferDelete( xStreamBuffer );
+	vPortResetPrivilege( xRunningPrivileged );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferReset( xStreamBuffer );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferIsEmpty( xStreamBuffer );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t MPU_xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+{
+BaseType_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferIsFull( xStreamBuffer );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferBytesAvailable( xStreamBuffer );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t MPU_xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+size_t xReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	xReturn = xStreamBufferSpacesAvailable( xStreamBuffer );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	MemoryPoolHandle_t MPU_xMemoryPoolCreate( UBaseType_t uxBlockCount, size_t xBlockSize )
+	{
+	MemoryPoolHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xMemoryPoolCreate( uxBlockCount, xBlockSize );
+		vPortResetPrivilege( xRunningPrivileged );
+
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	MemoryPoolHandle_t MPU_xMemoryPoolCreateStatic( UBaseType_t uxBlockCount, size_t xBlockSize, uint8_t * const pucPoolStorage, StaticMemoryPool_t * const pxStaticMemoryPool )
+	{
+	MemoryPoolHandle_t xReturn;
+	BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+		xReturn = xMemoryPoolCreateStatic( uxBlockCount, xBlockSize, pucPoolStorage, pxStaticMemoryPool );
+		vPortResetPrivilege( xRunningPrivileged );
+
+		return xReturn;
+	}
+#endif
+/*-----------------------------------------------------------*/
+
+void *MPU_pvMemoryPoolAllocate( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait )
+{
+void *pvReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	pvReturn = pvMemoryPoolAllocate( xMemoryPool, xTicksToWait );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void MPU_vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	vMemoryPoolFree( xMemoryPool, pvBlock );
+	vPortResetPrivilege( xRunningPrivileged );
+}
+/*-----------------------------------------------------------*/
+
+void MPU_vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	vMemoryPoolDelete( xMemoryPool );
+	vPortResetPrivilege( xRunningPrivileged );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t MPU_uxMemoryPoolGetFreeBlockCount( MemoryPoolHandle_t xMemoryPool )
+{
+UBaseType_t uxReturn;
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	uxReturn = uxMemoryPoolGetFreeBlockCount( xMemoryPool );
+	vPortResetPrivilege( xRunningPrivileged );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void MPU_vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxMemoryPoolStats )
+{
+BaseType_t xRunningPrivileged = xPortRaisePrivilege();
+
+	vMemoryPoolGetStats( xMemoryPool, pxMemoryPoolStats );
+	vPortResetPrivilege( xRunningPrivileged );
+}
+/*-----------------------------------------------------------*/
+
 
 
 
@@ -82,6 +82,8 @@ task.h is included from an application file. */
 #include "queue.h"
 #include "timers.h"
 #include "event_groups.h"
+#include "sbuffer.h"
+#include "mempool.h"
 #include "mpu_prototypes.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
@@ -0,0 +1,623 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the POSIX (Linux)
+ * simulator.
+ *
+ * Each task is mapped onto a host pthread.  Only the thread of the task that
+ * is in the Running state is ever allowed to execute - every other task thread
+ * is parked on its own condition variable.  A context switch therefore wakes
+ * exactly one thread and parks exactly one thread, so no broadcast or polling
+ * is involved and the wakeup latency is that of a single futex wake.
+ *
+ * The tick interrupt is simulated by a POSIX interval timer that raises
+ * SIGALRM.  The signal is blocked in every thread other than the thread of the
+ * Running task, so the signal handler always executes in the context of the
+ * task being interrupted - just as an interrupt would on real hardware.
+ * Entering a critical section masks the signal in the calling thread.
+ *
+ * -NOTE- As with the Win32 port this is a simulation only.  Host system calls
+ * made by tasks (printf(), for example) are not interrupt safe, so should only
+ * be used from one task or from inside a critical section.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The host signal used to simulate the tick interrupt. */
+#define portTICK_SIGNAL					SIGALRM
+
+#define portNO_CRITICAL_NESTING 		( ( UBaseType_t ) 0 )
+#define portNANO_SECONDS_PER_SECOND		( 1000000000ULL )
+#define portNANO_SECONDS_PER_TICK		( portNANO_SECONDS_PER_SECOND / ( unsigned long long ) configTICK_RATE_HZ )
+
+/* The POSIX simulator runs each task in a thread.  As in the Win32 port the
+task stack is not used as a stack - the real stack belongs to the host thread.
+The task stack is instead used to hold an xThreadState structure, which maps the
+task handle to the host thread and holds the objects used to park and wake the
+thread. */
+typedef struct
+{
+	/* Handle of the thread that executes the task. */
+	pthread_t xThread;
+
+	/* The task function and its parameter, used when the thread first runs. */
+	TaskFunction_t pxCode;
+	void *pvParameters;
+
+	/* Used to park the thread while the task is not in the Running state, and
+	to wake it again when the task is selected to run. */
+	pthread_mutex_t xResumeMutex;
+	pthread_cond_t xResumeCondition;
+	BaseType_t xResumePending;
+
+	/* Set when the task is deleted, at which point the thread exits instead of
+	waiting to be resumed. */
+	BaseType_t xDying;
+
+} xThreadState;
+
+/*
+ * Entry point of every task thread.  Waits until the task is first selected to
+ * run, then calls the task function.
+ */
+static void *prvThreadEntry( void *pvParameters );
+
+/*
+ * Wake the thread associated with pxThreadState.
+ */
+static void prvResumeThread( xThreadState *pxThreadState );
+
+/*
+ * Park the calling thread until it is resumed by prvResumeThread(), or exit the
+ * thread if its task has been deleted.  Must be called with the tick signal
+ * masked.
+ */
+static void prvSuspendSelf( xThreadState *pxThreadState );
+
+/*
+ * Hand the processor from the thread of pxThreadToSuspend (the calling thread)
+ * to the thread of pxThreadToResume.  Returns when the calling thread is next
+ * resumed.
+ */
+static void prvSwitchThread( xThreadState *pxThreadToResume, xThreadState *pxThreadToSuspend );
+
+/*
+ * Initialise xTickSignalSet, the set used to mask and unmask the simulated tick
+ * interrupt.
+ */
+static void prvInitialiseTickSignalSet( void );
+
+/*
+ * The simulated tick interrupt handler.
+ */
+static void prvTickSignalHandler( int iSignal );
+
+/*
+ * Create, arm and disarm the host interval timer that generates the simulated
+ * tick interrupt.
+ */
+static BaseType_t prvSetupTimerInterrupt( void );
+static void prvStopTimerInterrupt( void );
+
+/*-----------------------------------------------------------*/
+
+/* Pointer to the TCB of the currently executing task.  The first member of the
+TCB is the top of stack pointer, which in this port points to the task's
+xThreadState structure. */
+extern void * volatile pxCurrentTCB;
+
+#define prvGetThreadStateFromTCB( pxTCB ) ( ( xThreadState * ) *( ( size_t * ) ( pxTCB ) ) )
+
+/* The critical nesting count for the currently executing task.  Only one task
+thread executes at any one time, so a single variable is used that is saved and
+restored each time a thread is switched out and back in.  This is initialised to
+a non-zero value so interrupts do not become enabled during the initialisation
+phase. */
+static volatile UBaseType_t uxCriticalNesting = 9999UL;
+
+/* The set containing just the tick signal. */
+static sigset_t xTickSignalSet;
+
+/* The host timer that generates the tick signal. */
+static timer_t xTickTimer;
+
+/* Used to block the thread that called vTaskStartScheduler() until
+vTaskEndScheduler() is called. */
+static pthread_mutex_t xSchedulerEndMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xSchedulerEndCondition = PTHREAD_COND_INITIALIZER;
+static BaseType_t xSchedulerEnd = pdFALSE;
+
+/* Used to ensure nothing is processed during the startup sequence. */
+static BaseType_t xPortRunning = pdFALSE;
+
+/* Time at which the scheduler was started, used by the run time counter. */
+static struct timespec xStartTime;
+
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+xThreadState *pxThreadState;
+sigset_t xOldSignals;
+pthread_attr_t xThreadAttributes;
+int iReturned;
+
+	/* In this simulated case a stack is not initialised, but instead a thread
+	is created that will execute the task being created.  The xThreadState
+	object is placed onto the stack that was created for the task - so the
+	stack buffer is still used, just not in the conventional way.  It will not
+	be used for anything other than holding this structure. */
+	pxThreadState = ( xThreadState * ) ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack - sizeof( xThreadState ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+	memset( ( void * ) pxThreadState, 0x00, sizeof( xThreadState ) );
+
+	pxThreadState->pxCode = pxCode;
+	pxThreadState->pvParameters = pvParameters;
+	pxThreadState->xResumePending = pdFALSE;
+	pxThreadState->xDying = pdFALSE;
+	pthread_mutex_init( &( pxThreadState->xResumeMutex ), NULL );
+	pthread_cond_init( &( pxThreadState->xResumeCondition ), NULL );
+
+	/* The tick signal is masked while the thread is created so the new thread
+	inherits a mask that prevents it handling the tick before its task runs.
+	This also prevents the calling task being switched out while the host
+	library is holding its own internal locks. */
+	prvInitialiseTickSignalSet();
+	pthread_sigmask( SIG_BLOCK, &xTickSignalSet, &xOldSignals );
+
+	pthread_attr_init( &xThreadAttributes );
+	pthread_attr_setdetachstate( &xThreadAttributes, PTHREAD_CREATE_JOINABLE );
+	iReturned = pthread_create( &( pxThreadState->xThread ), &xThreadAttributes, prvThreadEntry, pxThreadState );
+	pthread_attr_destroy( &xThreadAttributes );
+
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+
+	configASSERT( iReturned == 0 );
+	( void ) iReturned;
+
+	return ( StackType_t * ) pxThreadState;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadEntry( void *pvParameters )
+{
+xThreadState *pxThreadState = ( xThreadState * ) pvParameters;
+
+	/* Wait until the scheduler selects this task to run for the first time. */
+	prvSuspendSelf( pxThreadState );
+
+	/* A task always starts with interrupts enabled. */
+	uxCriticalNesting = portNO_CRITICAL_NESTING;
+	vPortEnableInterrupts();
+
+	pxThreadState->pxCode( pxThreadState->pvParameters );
+
+	/* Tasks must not attempt to return from their implementing function.  If
+	one does then delete it rather than letting the thread run on with the task
+	still in the Running state. */
+	#if( INCLUDE_vTaskDelete == 1 )
+	{
+		vTaskDelete( NULL );
+	}
+	#else
+	{
+		configASSERT( pxThreadState == NULL );
+	}
+	#endif
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeThread( xThreadState *pxThreadState )
+{
+	pthread_mutex_lock( &( pxThreadState->xResumeMutex ) );
+	pxThreadState->xResumePending = pdTRUE;
+	pthread_cond_signal( &( pxThreadState->xResumeCondition ) );
+	pthread_mutex_unlock( &( pxThreadState->xResumeMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendSelf( xThreadState *pxThreadState )
+{
+BaseType_t xDying;
+
+	pthread_mutex_lock( &( pxThreadState->xResumeMutex ) );
+	{
+		while( ( pxThreadState->xResumePending == pdFALSE ) && ( pxThreadState->xDying == pdFALSE ) )
+		{
+			pthread_cond_wait( &( pxThreadState->xResumeCondition ), &( pxThreadState->xResumeMutex ) );
+		}
+
+		pxThreadState->xResumePending = pdFALSE;
+		xDying = pxThreadState->xDying;
+	}
+	pthread_mutex_unlock( &( pxThreadState->xResumeMutex ) );
+
+	if( xDying != pdFALSE )
+	{
+		/* The task has been deleted.  vPortCancelThread() joins the thread
+		before the memory holding pxThreadState is freed. */
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( xThreadState *pxThreadToResume, xThreadState *pxThreadToSuspend )
+{
+UBaseType_t uxSavedCriticalNesting;
+
+	if( pxThreadToResume != pxThreadToSuspend )
+	{
+		/* Each task has its own critical nesting value, which must be saved
+		before the next task is allowed to run as that task will overwrite
+		it. */
+		uxSavedCriticalNesting = uxCriticalNesting;
+
+		prvResumeThread( pxThreadToResume );
+		prvSuspendSelf( pxThreadToSuspend );
+
+		uxCriticalNesting = uxSavedCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTickSignalSet( void )
+{
+	sigemptyset( &xTickSignalSet );
+	sigaddset( &xTickSignalSet, portTICK_SIGNAL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickSignalHandler( int iSignal )
+{
+xThreadState *pxThreadToSuspend;
+int iSavedErrno;
+
+	( void ) iSignal;
+
+	/* The interrupted task might be about to inspect errno. */
+	iSavedErrno = errno;
+
+	/* The tick signal (and all other signals) are masked by the host while
+	this handler executes, so this is effectively a critical section. */
+	uxCriticalNesting++;
+
+	if( xPortRunning != pdFALSE )
+	{
+		pxThreadToSuspend = prvGetThreadStateFromTCB( pxCurrentTCB );
+
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			/* Select the next task to run, and if it is not the task that is
+			already running hand the processor to its thread. */
+			vTaskSwitchContext();
+			prvSwitchThread( prvGetThreadStateFromTCB( pxCurrentTCB ), pxThreadToSuspend );
+		}
+	}
+
+	uxCriticalNesting--;
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetupTimerInterrupt( void )
+{
+struct sigaction xSigTick;
+struct sigevent xSigEvent;
+struct itimerspec xTimerPeriod;
+BaseType_t xReturn = pdPASS;
+
+	/* Install the simulated tick interrupt handler.  All signals are masked
+	while the handler runs, and interrupted system calls are restarted so
+	tasks blocked in the host do not see spurious EINTR errors. */
+	memset( &xSigTick, 0x00, sizeof( xSigTick ) );
+	xSigTick.sa_handler = prvTickSignalHandler;
+	xSigTick.sa_flags = SA_RESTART;
+	sigfillset( &xSigTick.sa_mask );
+
+	if( sigaction( portTICK_SIGNAL, &xSigTick, NULL ) != 0 )
+	{
+		xReturn = pdFAIL;
+	}
+
+	if( xReturn == pdPASS )
+	{
+		/* The monotonic clock is used so changes to the host wall clock time
+		do not affect the tick. */
+		memset( &xSigEvent, 0x00, sizeof( xSigEvent ) );
+		xSigEvent.sigev_notify = SIGEV_SIGNAL;
+		xSigEvent.sigev_signo = portTICK_SIGNAL;
+
+		if( timer_create( CLOCK_MONOTONIC, &xSigEvent, &xTickTimer ) != 0 )
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	if( xReturn == pdPASS )
+	{
+		xTimerPeriod.it_value.tv_sec = ( time_t ) ( portNANO_SECONDS_PER_TICK / portNANO_SECONDS_PER_SECOND );
+		xTimerPeriod.it_value.tv_nsec = ( long ) ( portNANO_SECONDS_PER_TICK % portNANO_SECONDS_PER_SECOND );
+		xTimerPeriod.it_interval = xTimerPeriod.it_value;
+
+		if( timer_settime( xTickTimer, 0, &xTimerPeriod, NULL ) != 0 )
+		{
+			xReturn = pdFAIL;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimerInterrupt( void )
+{
+struct itimerspec xTimerPeriod;
+
+	memset( &xTimerPeriod, 0x00, sizeof( xTimerPeriod ) );
+	timer_settime( xTickTimer, 0, &xTimerPeriod, NULL );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+	/* The thread that starts the scheduler is not a task thread, so must never
+	handle the tick signal. */
+	prvInitialiseTickSignalSet();
+	pthread_sigmask( SIG_BLOCK, &xTickSignalSet, NULL );
+
+	clock_gettime( CLOCK_MONOTONIC, &xStartTime );
+
+	if( prvSetupTimerInterrupt() != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	xPortRunning = pdTRUE;
+
+	/* Start the highest priority task by waking the thread associated with
+	it.  The thread handles the context switching itself from then on. */
+	prvResumeThread( prvGetThreadStateFromTCB( pxCurrentTCB ) );
+
+	/* Wait here until vPortEndScheduler() is called. */
+	pthread_mutex_lock( &xSchedulerEndMutex );
+	while( xSchedulerEnd == pdFALSE )
+	{
+		pthread_cond_wait( &xSchedulerEndCondition, &xSchedulerEndMutex );
+	}
+	pthread_mutex_unlock( &xSchedulerEndMutex );
+
+	timer_delete( xTickTimer );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	prvStopTimerInterrupt();
+	xPortRunning = pdFALSE;
+
+	/* Let the thread that started the scheduler return from
+	vTaskStartScheduler(). */
+	pthread_mutex_lock( &xSchedulerEndMutex );
+	xSchedulerEnd = pdTRUE;
+	pthread_cond_signal( &xSchedulerEndCondition );
+	pthread_mutex_unlock( &xSchedulerEndMutex );
+
+	/* No task can run once the scheduler has ended, including the one that
+	ended it. */
+	pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+xThreadState *pxThreadToSuspend;
+
+	vPortEnterCritical();
+	{
+		pxThreadToSuspend = prvGetThreadStateFromTCB( pxCurrentTCB );
+
+		/* Select the next task to run, and if it is not the calling task hand
+		the processor to its thread.  This only returns when the calling task
+		is selected to run again. */
+		vTaskSwitchContext();
+		prvSwitchThread( prvGetThreadStateFromTCB( pxCurrentTCB ), pxThreadToSuspend );
+	}
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	pthread_sigmask( SIG_BLOCK, &xTickSignalSet, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	pthread_sigmask( SIG_UNBLOCK, &xTickSignalSet, NULL );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+sigset_t xOldSignals;
+
+	/* Returns pdTRUE if the tick signal was already masked on entry, in which
+	case vPortClearInterruptMask() must leave it masked. */
+	pthread_sigmask( SIG_BLOCK, &xTickSignalSet, &xOldSignals );
+	return ( UBaseType_t ) ( sigismember( &xOldSignals, portTICK_SIGNAL ) == 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	if( uxMask == ( UBaseType_t ) pdFALSE )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+	{
+		vPortDisableInterrupts();
+	}
+
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( uxCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		uxCriticalNesting--;
+
+		/* If the nesting level has reached zero then the tick signal can be
+		unmasked again.  A tick that became pending while it was masked is
+		delivered as soon as it is unmasked. */
+		if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			vPortEnableInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortMarkThreadDying( void *pvTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+xThreadState *pxThreadState;
+
+	/* A task is deleting itself.  The thread cannot exit yet as its task is
+	still in the Running state, so instead it is marked as dying and exits the
+	next time it is switched out, which will be imminently. */
+	pxThreadState = prvGetThreadStateFromTCB( pvTaskToDelete );
+
+	pthread_mutex_lock( &( pxThreadState->xResumeMutex ) );
+	pxThreadState->xDying = pdTRUE;
+	pthread_mutex_unlock( &( pxThreadState->xResumeMutex ) );
+
+	*pxPendYield = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pvTaskToDelete )
+{
+xThreadState *pxThreadState;
+
+	/* Called before the task stack, which holds pxThreadState, is freed.  The
+	thread of the deleted task is parked (or, if the task deleted itself, has
+	already exited), so wake it with the dying flag set and wait for it to
+	exit. */
+	pxThreadState = prvGetThreadStateFromTCB( pvTaskToDelete );
+
+	pthread_mutex_lock( &( pxThreadState->xResumeMutex ) );
+	pxThreadState->xDying = pdTRUE;
+	pthread_cond_signal( &( pxThreadState->xResumeCondition ) );
+	pthread_mutex_unlock( &( pxThreadState->xResumeMutex ) );
+
+	pthread_join( pxThreadState->xThread, NULL );
+
+	pthread_cond_destroy( &( pxThreadState->xResumeCondition ) );
+	pthread_mutex_destroy( &( pxThreadState->xResumeMutex ) );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetRunTimeCounterValue( void )
+{
+struct timespec xNow;
+uint64_t ullMicroSeconds;
+
+	/* Microseconds since the scheduler started.  The counter is allowed to
+	wrap as it would on a real target. */
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	ullMicroSeconds = ( ( uint64_t ) ( xNow.tv_sec - xStartTime.tv_sec ) * 1000000ULL );
+	ullMicroSeconds += ( uint64_t ) ( ( xNow.tv_nsec - xStartTime.tv_nsec ) / 1000L );
+
+	return ( uint32_t ) ullMicroSeconds;
+}
+/*-----------------------------------------------------------*/
+
@@ -97,6 +97,11 @@ task.h is included from an application file. */
 /* Assumes 8bit bytes! */
 #define heapBITS_PER_BYTE		( ( size_t ) 8 )
 
+/* Free blocks smaller than this are counted in the first element of the
+histogram returned by vPortGetHeapStats().  Each subsequent element covers
+sizes up to double that of the element before it. */
+#define heapFIRST_HISTOGRAM_BUCKET_LIMIT	( ( size_t ) 32 )
+
 /* Allocate the memory for the heap. */
 #if( configAPPLICATION_ALLOCATED_HEAP == 1 )
 	/* The application writer has already defined the array used for the RTOS
@@ -112,6 +117,10 @@ typedef struct A_BLOCK_LINK
 {
 	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
 	size_t xBlockSize;						/*<< The size of the free block. */
+
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		void *pvOwner;						/*<< The handle of the task that allocated the block. */
+	#endif
 } BlockLink_t;
 
 /*-----------------------------------------------------------*/
@@ -139,6 +148,12 @@ static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( p
 /* Create a couple of list links to mark the start and end of the list. */
 static BlockLink_t xStart, *pxEnd = NULL;
 
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	/* The first block in the heap.  Blocks, allocated or free, are contiguous
+	from here up to pxEnd, which allows every allocated block to be visited. */
+	static BlockLink_t *pxHeapStart = NULL;
+#endif
+
 /* Keeps track of the number of free bytes remaining, but says nothing about
 fragmentation. */
 static size_t xFreeBytesRemaining = 0U;
@@ -156,6 +171,10 @@ void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	const uint32_t ulStartCycles = portGET_HEAP_CYCLE_COUNTER_VALUE();
+	void *pvOwner;
+#endif
 
 	vTaskSuspendAll();
 	{
@@ -279,6 +298,24 @@ void *pvReturn = NULL;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			/* Charge the allocation to the calling task, and tag the block
+			with the task so leaks can be traced back to it. */
+			pvOwner = pvTaskRecordHeapOperation( pdTRUE, portGET_HEAP_CYCLE_COUNTER_VALUE() - ulStartCycles );
+
+			if( pvReturn != NULL )
+			{
+				pxBlock = ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize );
+				pxBlock->pvOwner = pvOwner;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 		traceMALLOC( pvReturn, xWantedSize );
 	}
 	( void ) xTaskResumeAll();
@@ -306,6 +343,9 @@ void vPortFree( void *pv )
 {
 uint8_t *puc = ( uint8_t * ) pv;
 BlockLink_t *pxLink;
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	const uint32_t ulStartCycles = portGET_HEAP_CYCLE_COUNTER_VALUE();
+#endif
 
 	if( pv != NULL )
 	{
@@ -334,6 +374,12 @@ BlockLink_t *pxLink;
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE( pv, pxLink->xBlockSize );
 					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+
+					#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+					{
+						( void ) pvTaskRecordHeapOperation( pdFALSE, portGET_HEAP_CYCLE_COUNTER_VALUE() - ulStartCycles );
+					}
+					#endif
 				}
 				( void ) xTaskResumeAll();
 			}
@@ -368,6 +414,124 @@ void vPortInitialiseBlocks( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+	{
+	BlockLink_t *pxBlock;
+	size_t xBucketLimit;
+	UBaseType_t uxBucket;
+
+		configASSERT( pxHeapStats );
+
+		for( uxBucket = 0; uxBucket < ( UBaseType_t ) configHEAP_STATS_HISTOGRAM_BUCKETS; uxBucket++ )
+		{
+			pxHeapStats->uxFreeBlockSizeHistogram[ uxBucket ] = 0;
+		}
+
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+		pxHeapStats->xNumberOfFreeBlocks = 0;
+
+		vTaskSuspendAll();
+		{
+			/* The heap is not initialised until the first call to
+			pvPortMalloc(), in which case there are no free blocks. */
+			if( pxEnd != NULL )
+			{
+				for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+				{
+					( pxHeapStats->xNumberOfFreeBlocks )++;
+
+					if( pxBlock->xBlockSize > pxHeapStats->xSizeOfLargestFreeBlockInBytes )
+					{
+						pxHeapStats->xSizeOfLargestFreeBlockInBytes = pxBlock->xBlockSize;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					if( ( pxHeapStats->xSizeOfSmallestFreeBlockInBytes == 0 ) || ( pxBlock->xBlockSize < pxHeapStats->xSizeOfSmallestFreeBlockInBytes ) )
+					{
+						pxHeapStats->xSizeOfSmallestFreeBlockInBytes = pxBlock->xBlockSize;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Find the histogram bucket, the last bucket also counts
+					blocks that are larger than its limit. */
+					xBucketLimit = heapFIRST_HISTOGRAM_BUCKET_LIMIT;
+					for( uxBucket = 0; ( uxBucket < ( ( UBaseType_t ) configHEAP_STATS_HISTOGRAM_BUCKETS - 1 ) ) && ( pxBlock->xBlockSize >= xBucketLimit ); uxBucket++ )
+					{
+						xBucketLimit <<= 1;
+					}
+
+					( pxHeapStats->uxFreeBlockSizeHistogram[ uxBucket ] )++;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+			pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		}
+		( void ) xTaskResumeAll();
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	size_t xPortGetHeapBytesOwnedBy( void *pvOwner, size_t *pxNumberOfBlocks )
+	{
+	BlockLink_t *pxBlock;
+	size_t xBlockSize, xBytes = 0, xBlocks = 0;
+
+		vTaskSuspendAll();
+		{
+			if( pxEnd != NULL )
+			{
+				/* Step over every block, allocated or free, by its size. */
+				for( pxBlock = pxHeapStart; pxBlock < pxEnd; pxBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize ) )
+				{
+					xBlockSize = pxBlock->xBlockSize & ~xBlockAllocatedBit;
+					configASSERT( xBlockSize >= xHeapStructSize );
+
+					if( ( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 ) && ( pxBlock->pvOwner == pvOwner ) )
+					{
+						xBytes += xBlockSize - xHeapStructSize;
+						xBlocks++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( pxNumberOfBlocks != NULL )
+		{
+			*pxNumberOfBlocks = xBlocks;
+		}
+
+		return xBytes;
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
+
 static void prvHeapInit( void )
 {
 BlockLink_t *pxFirstFreeBlock;
@@ -407,6 +571,12 @@ size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
 	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
 	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
 
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+	{
+		pxHeapStart = pxFirstFreeBlock;
+	}
+	#endif
+
 	/* Only one block exists - and it covers the entire usable heap space. */
 	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
 	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
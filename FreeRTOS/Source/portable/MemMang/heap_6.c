@@ -0,0 +1,767 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that, like heap_5,
+ * allows the heap to be defined across multiple non-contiguous blocks and
+ * combines (coalescences) adjacent memory blocks as they are freed, but that
+ * uses a two level segregated fit (TLSF) algorithm so both pvPortMalloc() and
+ * vPortFree() execute in a bounded time that does not depend on the number of
+ * free blocks or on how fragmented the heap has become.
+ *
+ * Free blocks are held in an array of lists.  The first level index of a list
+ * is the position of the most significant bit of the block size, and the
+ * second level index divides that power of two range into
+ * heapSL_INDEX_COUNT equal sub-ranges.  A bitmap records which lists contain
+ * blocks, so a list containing a block that is large enough to satisfy a
+ * request can be found using a fixed number of bit operations.  Each block
+ * also records the block immediately below it in memory so a freed block can
+ * be merged with its neighbours without walking any list.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of http://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * vPortDefineHeapRegions() ***must*** be called before pvPortMalloc(), exactly
+ * as when using heap_5.c.  See the comments at the top of heap_5.c for
+ * information on defining the array of HeapRegion_t structures passed into
+ * vPortDefineHeapRegions().  Unlike heap_5.c the regions do not need to appear
+ * in address order.
+ *
+ * configHEAP_MAX_BLOCK_SIZE_BITS can be defined in FreeRTOSConfig.h to set the
+ * size of the largest block the heap can manage to
+ * ( 2 ^ configHEAP_MAX_BLOCK_SIZE_BITS ) bytes (less the block overhead).  It
+ * defaults to 24 (16MB).  Regions larger than that are divided into multiple
+ * blocks, so only the size of the largest single allocation is limited.  Each
+ * increment of configHEAP_MAX_BLOCK_SIZE_BITS adds heapSL_INDEX_COUNT pointers
+ * to the RAM used by the heap's free list array.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_MAX_BLOCK_SIZE_BITS
+	#define configHEAP_MAX_BLOCK_SIZE_BITS	24
+#endif
+
+#if( configHEAP_MAX_BLOCK_SIZE_BITS > 31 )
+	#error configHEAP_MAX_BLOCK_SIZE_BITS must not be greater than 31
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* log2 of portBYTE_ALIGNMENT.  Block sizes are always a multiple of
+portBYTE_ALIGNMENT so there is no need to distinguish between sizes that differ
+by less than that. */
+#if portBYTE_ALIGNMENT == 32
+	#define heapALIGNMENT_LOG2	( 5 )
+#elif portBYTE_ALIGNMENT == 16
+	#define heapALIGNMENT_LOG2	( 4 )
+#elif portBYTE_ALIGNMENT == 8
+	#define heapALIGNMENT_LOG2	( 3 )
+#elif portBYTE_ALIGNMENT == 4
+	#define heapALIGNMENT_LOG2	( 2 )
+#elif portBYTE_ALIGNMENT == 2
+	#define heapALIGNMENT_LOG2	( 1 )
+#else
+	#define heapALIGNMENT_LOG2	( 0 )
+#endif
+
+/* Each power of two size range is split into heapSL_INDEX_COUNT second level
+lists. */
+#define heapSL_INDEX_COUNT_LOG2	( 4 )
+#define heapSL_INDEX_COUNT		( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all held in the lowest first
+level list, which is split into second level lists that are each
+portBYTE_ALIGNMENT bytes wide.  Larger blocks are indexed by the position of the
+most significant bit of their size. */
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+#define heapFL_INDEX_COUNT		( configHEAP_MAX_BLOCK_SIZE_BITS - heapFL_INDEX_SHIFT + 1 )
+
+/* Every block, including the header, is smaller than this. */
+#define heapMAXIMUM_BLOCK_SIZE	( ( size_t ) 1 << configHEAP_MAX_BLOCK_SIZE_BITS )
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( ( sizeof( BlockHeader_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) )
+
+/* The header placed at the start of every block.  Only the first two members
+are valid while the block is allocated - the free list pointers occupy the
+same space as the start of the memory returned to the application. */
+typedef struct A_BLOCK_HEADER
+{
+	struct A_BLOCK_HEADER *pxPreviousPhysicalBlock;	/*<< The block immediately below this block in memory, or NULL if this is the first block in its region. */
+	size_t xBlockSize;								/*<< The size of the block, including the header.  The top bit is set while the block is allocated. */
+	struct A_BLOCK_HEADER *pxNextFreeBlock;			/*<< The next block in the same free list.  Only valid while the block is free. */
+	struct A_BLOCK_HEADER *pxPreviousFreeBlock;		/*<< The previous block in the same free list.  Only valid while the block is free. */
+} BlockHeader_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the position of the most significant set bit in ulValue, which must
+ * not be zero.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue );
+
+/*
+ * Calculate the first and second level index of the free list that holds
+ * blocks of xBlockSize bytes.
+ */
+static void prvMapBlockSize( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Returns a free block that is at least xWantedSize bytes, or NULL if there is
+ * no such block.  The block is not removed from its free list.
+ */
+static BlockHeader_t *prvFindSuitableBlock( size_t xWantedSize );
+
+/*
+ * Insert a free block into, or remove a free block from, the free list that
+ * corresponds to its size, keeping the bitmaps up to date.
+ */
+static void prvInsertBlockIntoFreeList( BlockHeader_t *pxBlockToInsert );
+static void prvRemoveBlockFromFreeList( BlockHeader_t *pxBlockToRemove );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the part of the block header that remains in use while a block
+is allocated, rounded up so the memory returned to the application is
+correctly byte aligned. */
+static const size_t xHeapStructSize	= ( sizeof( BlockHeader_t * ) + sizeof( size_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists, and the bitmaps that record which free lists are not empty.
+Bit n of uxFirstLevelBitmap is set if any bit in ulSecondLevelBitmaps[ n ] is
+set, and bit m of ulSecondLevelBitmaps[ n ] is set if pxFreeLists[ n ][ m ] is
+not empty. */
+static BlockHeader_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockHeader_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+BlockHeader_t *pxBlock, *pxNewBlock;
+void *pvReturn = NULL;
+
+	/* The heap must be initialised before the first call to
+	prvPortMalloc(). */
+	configASSERT( xBlockAllocatedBit );
+
+	vTaskSuspendAll();
+	{
+		/* Check the requested block size is not so large that it cannot be
+		held in a single block.  This also ensures the top bit, which is used to
+		mark a block as allocated, is not set. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAXIMUM_BLOCK_SIZE ) )
+		{
+			/* The wanted size is increased so it can contain the part of the
+			block header that remains in use while the block is allocated. */
+			xWantedSize += xHeapStructSize;
+
+			/* Ensure that blocks are always aligned to the required number of
+			bytes. */
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The block must be large enough to hold the free list pointers
+			once it is freed again. */
+			if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+			{
+				xWantedSize = heapMINIMUM_BLOCK_SIZE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize <= xFreeBytesRemaining )
+			{
+				pxBlock = prvFindSuitableBlock( xWantedSize );
+
+				if( pxBlock != NULL )
+				{
+					/* This block is being returned for use so must be taken out
+					of its free list. */
+					prvRemoveBlockFromFreeList( pxBlock );
+
+					/* If the block is larger than required it can be split into
+					two. */
+					if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+					{
+						/* This block is to be split into two.  Create a new
+						block following the number of bytes requested.  The void
+						cast is used to prevent byte alignment warnings from the
+						compiler. */
+						pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+						pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+						pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+						pxBlock->xBlockSize = xWantedSize;
+
+						/* The block above the new block is never free, otherwise
+						it would already have been merged with the block being
+						split, so the new block just has to be linked into the
+						physical order then added to the free lists. */
+						( ( BlockHeader_t * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xBlockSize ) )->pxPreviousPhysicalBlock = pxNewBlock;
+						prvInsertBlockIntoFreeList( pxNewBlock );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+					{
+						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The block is being returned - it is allocated and owned
+					by the application.  Return the memory space pointed to -
+					jumping over the part of the header that remains in use. */
+					pxBlock->xBlockSize |= xBlockAllocatedBit;
+					pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockHeader_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have part of a BlockHeader_t structure
+		immediately before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxBlock = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+		if( ( pxBlock->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			/* The block is being returned to the heap - it is no longer
+			allocated. */
+			pxBlock->xBlockSize &= ~xBlockAllocatedBit;
+
+			vTaskSuspendAll();
+			{
+				xFreeBytesRemaining += pxBlock->xBlockSize;
+				traceFREE( pv, pxBlock->xBlockSize );
+
+				/* Is the block below this block in memory also free?  If so
+				merge the two, provided the result is not too big to index. */
+				pxNeighbour = pxBlock->pxPreviousPhysicalBlock;
+
+				if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) && ( ( pxNeighbour->xBlockSize + pxBlock->xBlockSize ) < heapMAXIMUM_BLOCK_SIZE ) )
+				{
+					prvRemoveBlockFromFreeList( pxNeighbour );
+					pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Is the block above this block in memory also free?  The
+				marker at the end of each region is always marked as
+				allocated, so this never looks past the end of a region. */
+				pxNeighbour = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+
+				if( ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) && ( ( pxNeighbour->xBlockSize + pxBlock->xBlockSize ) < heapMAXIMUM_BLOCK_SIZE ) )
+				{
+					prvRemoveBlockFromFreeList( pxNeighbour );
+					pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+					pxNeighbour = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + pxBlock->xBlockSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block above the (possibly merged) block must know where
+				the merged block starts. */
+				pxNeighbour->pxPreviousPhysicalBlock = pxBlock;
+
+				prvInsertBlockIntoFreeList( pxBlock );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue )
+{
+UBaseType_t uxBit = 0;
+
+	/* A binary search, so the execution time is fixed. */
+	if( ( ulValue & 0xffff0000UL ) != 0 )
+	{
+		ulValue >>= 16;
+		uxBit += 16;
+	}
+
+	if( ( ulValue & 0xff00UL ) != 0 )
+	{
+		ulValue >>= 8;
+		uxBit += 8;
+	}
+
+	if( ( ulValue & 0xf0UL ) != 0 )
+	{
+		ulValue >>= 4;
+		uxBit += 4;
+	}
+
+	if( ( ulValue & 0x0cUL ) != 0 )
+	{
+		ulValue >>= 2;
+		uxBit += 2;
+	}
+
+	if( ( ulValue & 0x02UL ) != 0 )
+	{
+		uxBit += 1;
+	}
+
+	return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMapBlockSize( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxMostSignificantBit;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are held in the lowest first level list, in second
+		level lists that are each portBYTE_ALIGNMENT bytes wide. */
+		*puxFirstLevel = 0;
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		/* The bits below the most significant bit select the second level
+		list. */
+		uxMostSignificantBit = prvFindLastSet( ( uint32_t ) xBlockSize );
+		*puxSecondLevel = ( UBaseType_t ) ( ( xBlockSize >> ( uxMostSignificantBit - heapSL_INDEX_COUNT_LOG2 ) ) ^ ( size_t ) heapSL_INDEX_COUNT );
+		*puxFirstLevel = uxMostSignificantBit - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t *prvFindSuitableBlock( size_t xWantedSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+BlockHeader_t *pxReturn = NULL;
+
+	/* Round the wanted size up to the start of the next second level range,
+	so any block in the list that is found is large enough without having to
+	search the list itself. */
+	if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xWantedSize += ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xWantedSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xWantedSize < heapMAXIMUM_BLOCK_SIZE )
+	{
+		prvMapBlockSize( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+		/* Is there a block in this first level range that is in the same or
+		a larger second level range? */
+		ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~( uint32_t ) 0U << uxSecondLevel );
+
+		if( ulBitmap == 0U )
+		{
+			/* No, so use the smallest block in the smallest larger first level
+			range that contains any blocks at all. */
+			if( ( uxFirstLevel + 1U ) < ( UBaseType_t ) heapFL_INDEX_COUNT )
+			{
+				ulBitmap = ulFirstLevelBitmap & ( ~( uint32_t ) 0U << ( uxFirstLevel + 1U ) );
+			}
+			else
+			{
+				ulBitmap = 0U;
+			}
+
+			if( ulBitmap != 0U )
+			{
+				/* x & -x isolates the least significant set bit. */
+				uxFirstLevel = prvFindLastSet( ulBitmap & ( ~ulBitmap + 1U ) );
+				ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ];
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ulBitmap != 0U )
+		{
+			uxSecondLevel = prvFindLastSet( ulBitmap & ( ~ulBitmap + 1U ) );
+			pxReturn = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockHeader_t *pxBlockToInsert )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapBlockSize( pxBlockToInsert->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	/* Blocks are added to the front of their list. */
+	pxBlockToInsert->pxPreviousFreeBlock = NULL;
+	pxBlockToInsert->pxNextFreeBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+	if( pxBlockToInsert->pxNextFreeBlock != NULL )
+	{
+		pxBlockToInsert->pxNextFreeBlock->pxPreviousFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToInsert;
+	ulFirstLevelBitmap |= ( uint32_t ) 1U << uxFirstLevel;
+	ulSecondLevelBitmaps[ uxFirstLevel ] |= ( uint32_t ) 1U << uxSecondLevel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( BlockHeader_t *pxBlockToRemove )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMapBlockSize( pxBlockToRemove->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlockToRemove->pxNextFreeBlock != NULL )
+	{
+		pxBlockToRemove->pxNextFreeBlock->pxPreviousFreeBlock = pxBlockToRemove->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlockToRemove->pxPreviousFreeBlock != NULL )
+	{
+		pxBlockToRemove->pxPreviousFreeBlock->pxNextFreeBlock = pxBlockToRemove->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the front of its list. */
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlockToRemove->pxNextFreeBlock;
+
+		/* Clear the bitmaps if the list is now empty. */
+		if( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == NULL )
+		{
+			ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( ( uint32_t ) 1U << uxSecondLevel );
+
+			if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0U )
+			{
+				ulFirstLevelBitmap &= ~( ( uint32_t ) 1U << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+BlockHeader_t *pxBlock, *pxPreviousBlock, *pxEnd;
+size_t xTotalRegionSize, xTotalHeapSize = 0, xBlockSize;
+BaseType_t xDefinedRegions = 0;
+size_t xAddress, xAlignedHeap;
+const HeapRegion_t *pxHeapRegion;
+
+	/* Can only call once! */
+	configASSERT( xBlockAllocatedBit == 0 );
+
+	/* The largest block must be representable in a size_t with the top bit
+	left clear. */
+	configASSERT( ( size_t ) configHEAP_MAX_BLOCK_SIZE_BITS < ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) );
+
+	/* Work out the position of the top bit in a size_t variable.  This must
+	be done first as the end of region markers are marked as allocated. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+	while( pxHeapRegion->xSizeInBytes > 0 )
+	{
+		xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+		/* Ensure the heap region starts on a correctly aligned boundary. */
+		xAddress = ( size_t ) pxHeapRegion->pucStartAddress;
+		if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			xAddress += ( portBYTE_ALIGNMENT - 1 );
+			xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+			/* Adjust the size for the bytes lost to alignment. */
+			xTotalRegionSize -= xAddress - ( size_t ) pxHeapRegion->pucStartAddress;
+		}
+
+		xAlignedHeap = xAddress;
+
+		/* pxEnd marks the end of the region.  It looks like an allocated
+		block of zero size so a block being freed is never merged with it. */
+		xAddress = xAlignedHeap + xTotalRegionSize;
+		xAddress -= xHeapStructSize;
+		xAddress &= ~portBYTE_ALIGNMENT_MASK;
+		pxEnd = ( BlockHeader_t * ) xAddress;
+
+		if( ( xAddress > xAlignedHeap ) && ( ( xAddress - xAlignedHeap ) >= heapMINIMUM_BLOCK_SIZE ) )
+		{
+			/* To start with the region is a single free block, or, if the
+			region is too large to be held in one block, as few free blocks
+			as possible. */
+			pxPreviousBlock = NULL;
+			pxBlock = ( BlockHeader_t * ) xAlignedHeap;
+
+			while( pxBlock < pxEnd )
+			{
+				xBlockSize = ( size_t ) ( ( uint8_t * ) pxEnd - ( uint8_t * ) pxBlock );
+
+				if( xBlockSize >= heapMAXIMUM_BLOCK_SIZE )
+				{
+					xBlockSize = heapMAXIMUM_BLOCK_SIZE - portBYTE_ALIGNMENT;
+
+					/* Don't leave a remainder that is too small to be a
+					block. */
+					if( ( size_t ) ( ( uint8_t * ) pxEnd - ( uint8_t * ) pxBlock ) - xBlockSize < heapMINIMUM_BLOCK_SIZE )
+					{
+						xBlockSize -= heapMINIMUM_BLOCK_SIZE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxBlock->xBlockSize = xBlockSize;
+				pxBlock->pxPreviousPhysicalBlock = pxPreviousBlock;
+				prvInsertBlockIntoFreeList( pxBlock );
+				xTotalHeapSize += xBlockSize;
+
+				pxPreviousBlock = pxBlock;
+				pxBlock = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+			}
+
+			pxEnd->xBlockSize = xBlockAllocatedBit;
+			pxEnd->pxPreviousPhysicalBlock = pxPreviousBlock;
+		}
+		else
+		{
+			/* The region is too small to hold a block. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Move onto the next HeapRegion_t structure. */
+		xDefinedRegions++;
+		pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+	}
+
+	xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+	xFreeBytesRemaining = xTotalHeapSize;
+
+	/* Check something was actually defined before it is accessed. */
+	configASSERT( xTotalHeapSize );
+}
+
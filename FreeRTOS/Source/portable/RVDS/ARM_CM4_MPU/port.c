@@ -80,6 +80,8 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "event_groups.h"
+#include "sbuffer.h"
+#include "mempool.h"
 #include "mpu_prototypes.h"
 
 #ifndef __TARGET_FPU_VFP
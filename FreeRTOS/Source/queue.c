@@ -93,6 +93,7 @@ privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueMAX_LOCK_COUNT				( ( int8_t ) 127 )
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -114,6 +115,18 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+/* The states a slot in a zero copy queue moves through.  A slot is reserved
+by a producer, filled in place, then committed.  Committed slots become ready
+(visible to consumers) in the order in which they were reserved.  A ready slot
+is borrowed by a consumer, then released.  Released slots return to the free
+pool in the order in which they were borrowed. */
+#define queueSLOT_FREE					( ( uint8_t ) 0U )
+#define queueSLOT_RESERVED				( ( uint8_t ) 1U )
+#define queueSLOT_COMMITTED				( ( uint8_t ) 2U )
+#define queueSLOT_READY					( ( uint8_t ) 3U )
+#define queueSLOT_BORROWED				( ( uint8_t ) 4U )
+#define queueSLOT_RELEASED				( ( uint8_t ) 5U )
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -162,6 +175,14 @@ typedef struct QueueDefinition
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		uint8_t *pucSlotState;		/*< One state byte per slot if the queue is a zero copy queue, otherwise NULL.  Zero copy queues use the index members below in place of pcWriteTo and pcReadFrom. */
+		UBaseType_t uxSlotsFree;	/*< The number of slots that can be reserved. */
+		UBaseType_t uxReserveIndex;	/*< The next slot to be reserved. */
+		UBaseType_t uxBorrowIndex;	/*< The next slot to be borrowed. */
+		UBaseType_t uxReleaseIndex;	/*< The oldest borrowed slot that has not yet been returned to the free pool. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -240,6 +261,72 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	/*
+	 * Returns the index of the zero copy queue slot that starts at pvSlot, or
+	 * uxLength if pvSlot is not the start of a slot in the queue.
+	 */
+	static UBaseType_t prvGetSlotIndex( const Queue_t * const pxQueue, const void * const pvSlot ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Marks the next free slot as reserved and returns its address.  Must be
+	 * called with interrupts masked and only if uxSlotsFree is not zero.
+	 */
+	static void *prvReserveSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Marks the next ready slot as borrowed and returns its address.  Must be
+	 * called with interrupts masked and only if uxMessagesWaiting is not zero.
+	 */
+	static void *prvBorrowSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Marks a reserved slot as committed, then makes ready as many committed
+	 * slots as are now in order.  Returns the number of slots made ready, or
+	 * -1 if pvSlot was not a reserved slot.  Must be called with interrupts
+	 * masked.
+	 */
+	static BaseType_t prvCommitSlot( Queue_t * const pxQueue, const void * const pvSlot ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Marks a borrowed slot as released, then returns to the free pool as many
+	 * released slots as are now in order.  Returns the number of slots freed,
+	 * or -1 if pvSlot was not a borrowed slot.  Must be called with interrupts
+	 * masked.
+	 */
+	static BaseType_t prvReleaseSlot( Queue_t * const pxQueue, const void * const pvSlot ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Copies uxCount items to the back of the queue, or out of the front of the
+ * queue, using at most two calls to memcpy().  Must be called with interrupts
+ * masked, and only when the queue has enough space or holds enough items.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxItemsAdded tasks waiting to receive from the queue, or
+ * notifies the queue set the queue is a member of once for each item added.
+ * Must be called with interrupts masked and the queue unlocked.  Returns
+ * pdTRUE if a task with a priority above the calling task was unblocked.
+ */
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue, UBaseType_t uxItemsAdded ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxSpacesFreed tasks waiting to send to the queue.  Must be
+ * called with interrupts masked and the queue unlocked.  Returns pdTRUE if a
+ * task with a priority above the calling task was unblocked.
+ */
+static BaseType_t prvUnblockTasksWaitingToSend( Queue_t * const pxQueue, UBaseType_t uxSpacesFreed ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds uxCount to a queue lock count, saturating at the largest value an
+ * int8_t can hold.  The lock count only needs to be large enough to unblock
+ * every task that could be waiting on the queue when it is unlocked.
+ */
+static int8_t prvAddToLockCount( const int8_t cLockCount, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -291,6 +378,25 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
 
+		#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		{
+			if( pxQueue->pucSlotState != NULL )
+			{
+				/* Any slots that were reserved or borrowed are lost, so the
+				queue must not be reset while slots are in use. */
+				( void ) memset( ( void * ) pxQueue->pucSlotState, ( int ) queueSLOT_FREE, ( size_t ) pxQueue->uxLength );
+				pxQueue->uxSlotsFree = pxQueue->uxLength;
+				pxQueue->uxReserveIndex = ( UBaseType_t ) 0U;
+				pxQueue->uxBorrowIndex = ( UBaseType_t ) 0U;
+				pxQueue->uxReleaseIndex = ( UBaseType_t ) 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_ZERO_COPY_QUEUES */
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -346,6 +452,14 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		configASSERT( !( ( pucQueueStorage != NULL ) && ( uxItemSize == 0 ) ) );
 		configASSERT( !( ( pucQueueStorage == NULL ) && ( uxItemSize != 0 ) ) );
 
+		#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		{
+			/* Zero copy queues pass slots of the storage area around, so
+			must have one. */
+			configASSERT( !( ( ucQueueType == queueQUEUE_TYPE_ZERO_COPY ) && ( uxItemSize == 0 ) ) );
+		}
+		#endif
+
 		#if( configASSERT_DEFINED == 1 )
 		{
 			/* Sanity check that the size of the structure used to declare a
@@ -403,6 +517,24 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 
+		#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		{
+			configASSERT( !( ( ucQueueType == queueQUEUE_TYPE_ZERO_COPY ) && ( uxItemSize == 0 ) ) );
+
+			if( ucQueueType == queueQUEUE_TYPE_ZERO_COPY )
+			{
+				/* A zero copy queue also needs a state byte for each slot,
+				which is placed after the slots so the slots keep the
+				alignment of the storage area. */
+				xQueueSizeInBytes += ( size_t ) uxQueueLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_ZERO_COPY_QUEUES */
+
 		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
 
 		if( pxNewQueue != NULL )
@@ -449,6 +581,19 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		pxNewQueue->pcHead = ( int8_t * ) pucQueueStorage;
 	}
 
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		if( ucQueueType == queueQUEUE_TYPE_ZERO_COPY )
+		{
+			pxNewQueue->pucSlotState = pucQueueStorage + ( uxQueueLength * uxItemSize );
+		}
+		else
+		{
+			pxNewQueue->pucSlotState = NULL;
+		}
+	}
+	#endif /* configUSE_ZERO_COPY_QUEUES */
+
 	/* Initialise the queue members as described where the queue type is
 	defined. */
 	pxNewQueue->uxLength = uxQueueLength;
@@ -735,6 +880,12 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	}
 	#endif
 
+	/* Zero copy queues are accessed through their own API functions. */
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
 
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
@@ -928,6 +1079,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
 
+	/* Zero copy queues are accessed through their own API functions. */
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
+
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
 	above the maximum system call priority are kept permanently enabled, even
@@ -1249,6 +1407,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	}
 	#endif
 
+	/* Zero copy queues are accessed through their own API functions. */
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
+
 	/* This function relaxes the coding standard somewhat to allow return
 	statements within the function itself.  This is done in the interest
 	of execution time efficiency. */
@@ -1440,6 +1605,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 
+	/* Zero copy queues are accessed through their own API functions. */
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
+
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
 	above the maximum system call priority are kept permanently enabled, even
@@ -1533,6 +1705,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
 
+	/* Zero copy queues are accessed through their own API functions. */
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
+
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
 	above the maximum system call priority are kept permanently enabled, even
@@ -1576,122 +1755,1042 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, TickType_t xTicksToWait )
 {
-UBaseType_t uxReturn;
+BaseType_t xEntryTimeSet = pdFALSE;
+UBaseType_t uxItemsSent;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
-	configASSERT( xQueue );
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
 
-	taskENTER_CRITICAL();
+	/* Semaphores and mutexes do not hold items that can be copied. */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+		configASSERT( pxQueue->pucSlotState == NULL );
 	}
-	taskEXIT_CRITICAL();
+	#endif
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
-Queue_t *pxQueue;
+	/* This function follows the same pattern as xQueueGenericSend(), but
+	copies as many items as will fit in one critical section, then unblocks
+	the tasks waiting to receive and makes the yield decision once for the
+	whole batch. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Is there room for at least one item? */
+			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( uxItemCount == ( UBaseType_t ) 0 ) )
+			{
+				uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-	pxQueue = ( Queue_t * ) xQueue;
-	configASSERT( pxQueue );
+				if( uxItemsSent > uxItemCount )
+				{
+					uxItemsSent = uxItemCount;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
+				traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemsSent );
+				prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxItemsSent );
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+				if( prvUnblockTasksWaitingToReceive( pxQueue, uxItemsSent ) != pdFALSE )
+				{
+					/* An unblocked task has a priority higher than our own
+					so yield immediately.  Yes it is ok to do this from
+					within the critical section - the kernel takes care of
+					that. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxItemsSent;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was full and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
 
-	configASSERT( xQueue );
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-	uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return 0;
+		}
+	}
+}
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItemsToQueue, UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
 {
+UBaseType_t uxItemsSent;
+UBaseType_t uxSavedInterruptStatus;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 	configASSERT( pxQueue );
-	traceQUEUE_DELETE( pxQueue );
+	configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 	{
-		vQueueUnregisterQueue( pxQueue );
+		configASSERT( pxQueue->pucSlotState == NULL );
 	}
 	#endif
 
-	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-	{
-		/* The queue can only have been allocated dynamically - free it
-		again. */
-		vPortFree( pxQueue );
-	}
-	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		/* The queue could have been allocated statically or dynamically, so
-		check before attempting to free the memory. */
-		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+		if( uxItemsSent > uxItemCount )
 		{
-			vPortFree( pxQueue );
+			uxItemsSent = uxItemCount;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-	}
-	#else
-	{
-		/* The queue must have been statically allocated, so is not going to be
-		deleted.  Avoid compiler warnings about the unused parameter. */
-		( void ) pxQueue;
-	}
-	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-	{
-		return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-	}
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
 
-	void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber )
-	{
-		( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-	}
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
+		if( uxItemsSent > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
 
-	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-	{
-		return ( ( Queue_t * ) xQueue )->ucQueueType;
-	}
+			traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxItemsSent );
+			prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxItemsSent );
 
-#endif /* configUSE_TRACE_FACILITY */
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasksWaitingToReceive( pxQueue, uxItemsSent ) != pdFALSE )
+				{
+					/* The task waiting has a higher priority so record that a
+					context switch is required. */
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Increment the lock count by the number of items sent so the
+				task that unlocks the queue knows that data was posted while it
+				was locked. */
+				pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxItemsSent );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( BaseType_t ) uxItemsSent;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+UBaseType_t uxItemsReceived;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
+
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* This function follows the same pattern as xQueueGenericReceive(), but
+	copies out as many items as are available (up to uxMaxItems) in one
+	critical section, then unblocks the tasks waiting to send and makes the
+	yield decision once for the whole batch. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Is there data in the queue now? */
+			if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) || ( uxMaxItems == ( UBaseType_t ) 0 ) )
+			{
+				uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+				if( uxItemsReceived > uxMaxItems )
+				{
+					uxItemsReceived = uxMaxItems;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemsReceived );
+				prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsReceived );
+
+				if( prvUnblockTasksWaitingToSend( pxQueue, uxItemsReceived ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxItemsReceived;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxItemsReceived;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+	{
+		configASSERT( pxQueue->pucSlotState == NULL );
+	}
+	#endif
+
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+		if( uxItemsReceived > uxMaxItems )
+		{
+			uxItemsReceived = uxMaxItems;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxItemsReceived > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxItemsReceived );
+			prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsReceived );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead update the lock count so the task that unlocks the queue
+			will know that ISRs have removed data while the queue was
+			locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasksWaitingToSend( pxQueue, uxItemsReceived ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxItemsReceived );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( BaseType_t ) uxItemsReceived;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	void *pvSlot;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* This function follows the same pattern as xQueueGenericSend(),
+		except that a slot is handed out rather than data being copied in.
+		Reserving a slot does not make anything visible to the tasks waiting
+		to borrow from the queue, so no task is unblocked. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxQueue->uxSlotsFree > ( UBaseType_t ) 0 )
+				{
+					pvSlot = prvReserveSlot( pxQueue );
+					taskEXIT_CRITICAL();
+					return pvSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* No slot is free and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_SEND_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return NULL;
+			}
+		}
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueReserveFromISR( QueueHandle_t xQueue )
+	{
+	void *pvSlot;
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+
+		/* See the comment on portASSERT_IF_INTERRUPT_PRIORITY_INVALID() in
+		xQueueGenericSendFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxQueue->uxSlotsFree > ( UBaseType_t ) 0 )
+			{
+				pvSlot = prvReserveSlot( pxQueue );
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+				pvSlot = NULL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvSlot;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	BaseType_t xQueueCommit( QueueHandle_t xQueue, void * const pvSlot )
+	{
+	BaseType_t xReady, xReturn;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+
+		taskENTER_CRITICAL();
+		{
+			xReady = prvCommitSlot( pxQueue, pvSlot );
+
+			if( xReady >= ( BaseType_t ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				if( prvUnblockTasksWaitingToReceive( pxQueue, ( UBaseType_t ) xReady ) != pdFALSE )
+				{
+					/* The unblocked task has a priority higher than our own
+					so yield immediately.  Yes it is ok to do this from
+					within the critical section - the kernel takes care of
+					that. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				traceQUEUE_SEND_FAILED( pxQueue );
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	BaseType_t xQueueCommitFromISR( QueueHandle_t xQueue, void * const pvSlot, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	BaseType_t xReady, xReturn;
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReady = prvCommitSlot( pxQueue, pvSlot );
+
+			if( xReady >= ( BaseType_t ) 0 )
+			{
+				const int8_t cTxLock = pxQueue->cTxLock;
+
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+				/* The event list is not altered if the queue is locked.  This
+				will be done when the queue is unlocked later. */
+				if( cTxLock == queueUNLOCKED )
+				{
+					if( prvUnblockTasksWaitingToReceive( pxQueue, ( UBaseType_t ) xReady ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Increment the lock count by the number of slots made
+					ready so the task that unlocks the queue knows that data
+					was posted while it was locked. */
+					pxQueue->cTxLock = prvAddToLockCount( cTxLock, ( UBaseType_t ) xReady );
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+				xReturn = pdFAIL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueBorrow( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	void *pvSlot;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* This function follows the same pattern as xQueueGenericReceive().
+		Borrowing a slot does not free it, so no task waiting to reserve a
+		slot is unblocked until the slot is released. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+				{
+					traceQUEUE_RECEIVE( pxQueue );
+					pvSlot = prvBorrowSlot( pxQueue );
+					taskEXIT_CRITICAL();
+					return pvSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified
+						(or the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	void *pvQueueBorrowFromISR( QueueHandle_t xQueue )
+	{
+	void *pvSlot;
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+				pvSlot = prvBorrowSlot( pxQueue );
+			}
+			else
+			{
+				traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+				pvSlot = NULL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvSlot;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	BaseType_t xQueueRelease( QueueHandle_t xQueue, void * const pvSlot )
+	{
+	BaseType_t xFreed, xReturn;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+
+		taskENTER_CRITICAL();
+		{
+			xFreed = prvReleaseSlot( pxQueue, pvSlot );
+
+			if( xFreed >= ( BaseType_t ) 0 )
+			{
+				if( prvUnblockTasksWaitingToSend( pxQueue, ( UBaseType_t ) xFreed ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	BaseType_t xQueueReleaseFromISR( QueueHandle_t xQueue, void * const pvSlot, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	BaseType_t xFreed, xReturn;
+	UBaseType_t uxSavedInterruptStatus;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pucSlotState != NULL );
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xFreed = prvReleaseSlot( pxQueue, pvSlot );
+
+			if( xFreed >= ( BaseType_t ) 0 )
+			{
+				const int8_t cRxLock = pxQueue->cRxLock;
+
+				/* If the queue is locked the event list will not be modified.
+				Instead update the lock count so the task that unlocks the
+				queue will know that slots were freed while the queue was
+				locked. */
+				if( cRxLock == queueUNLOCKED )
+				{
+					if( prvUnblockTasksWaitingToSend( pxQueue, ( UBaseType_t ) xFreed ) != pdFALSE )
+					{
+						if( pxHigherPriorityTaskWoken != NULL )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					pxQueue->cRxLock = prvAddToLockCount( cRxLock, ( UBaseType_t ) xFreed );
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t *pxQueue;
+
+	pxQueue = ( Queue_t * ) xQueue;
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+		{
+			if( pxQueue->pucSlotState != NULL )
+			{
+				/* Reserved and borrowed slots are not available either. */
+				uxReturn = pxQueue->uxSlotsFree;
+			}
+			else
+			{
+				uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+			}
+		}
+		#else
+		{
+			uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		}
+		#endif /* configUSE_ZERO_COPY_QUEUES */
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	traceQUEUE_DELETE( pxQueue );
+
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( pxQueue );
+	}
+	#endif
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The queue can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The queue could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The queue must have been statically allocated, so is not going to be
+		deleted.  Avoid compiler warnings about the unused parameter. */
+		( void ) pxQueue;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber )
+	{
+		( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->ucQueueType;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
@@ -1726,68 +2825,190 @@ UBaseType_t uxMessagesWaiting;
 		pxQueue->pcWriteTo += pxQueue->uxItemSize;
 		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
-			pxQueue->pcWriteTo = pxQueue->pcHead;
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
+		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->u.pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xPosition == queueOVERWRITE )
+		{
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				/* An item is not being added but overwritten, so subtract
+				one from the recorded number of items in the queue so when
+				one is added again below the number of recorded items remains
+				correct. */
+				--uxMessagesWaiting;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxQueue->uxMessagesWaiting = uxMessagesWaiting + 1;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+{
+	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+	{
+		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
+		if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pxQueue->u.pcReadFrom = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, UBaseType_t uxCount )
+{
+size_t xBytes, xFirstBytes;
+
+	/* This function is called from a critical section. */
+
+	xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+
+	/* Copy as many items as fit before the end of the storage area, then the
+	remainder (if any) to the start of the storage area. */
+	xFirstBytes = ( size_t ) ( pxQueue->pcTail - pxQueue->pcWriteTo );
+
+	if( xFirstBytes > xBytes )
+	{
+		xFirstBytes = xBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirstBytes ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+	if( xBytes > xFirstBytes )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pcItems[ xFirstBytes ] ), xBytes - xFirstBytes ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirstBytes );
+	}
+	else
+	{
+		pxQueue->pcWriteTo += xFirstBytes;
+
+		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		{
+			pxQueue->pcWriteTo = pxQueue->pcHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxQueue->uxMessagesWaiting += uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, UBaseType_t uxCount )
+{
+size_t xBytes, xFirstBytes;
+int8_t *pcNextItem;
+
+	/* This function is called from a critical section. */
+
+	if( uxCount > ( UBaseType_t ) 0 )
+	{
+		xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+
+		/* pcReadFrom points to the last item that was read, so the first item
+		to read follows it. */
+		pcNextItem = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+
+		if( pcNextItem >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+		{
+			pcNextItem = pxQueue->pcHead;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-	}
-	else
-	{
-		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
-		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+
+		xFirstBytes = ( size_t ) ( pxQueue->pcTail - pcNextItem );
+
+		if( xFirstBytes > xBytes )
 		{
-			pxQueue->u.pcReadFrom = ( pxQueue->pcTail - pxQueue->uxItemSize );
+			xFirstBytes = xBytes;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		if( xPosition == queueOVERWRITE )
+		( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcNextItem, xFirstBytes ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+		/* Leave pcReadFrom pointing at the last item read. */
+		if( xBytes > xFirstBytes )
 		{
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
-			{
-				/* An item is not being added but overwritten, so subtract
-				one from the recorded number of items in the queue so when
-				one is added again below the number of recorded items remains
-				correct. */
-				--uxMessagesWaiting;
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			( void ) memcpy( ( void * ) &( pcBuffer[ xFirstBytes ] ), ( const void * ) pxQueue->pcHead, xBytes - xFirstBytes ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			pxQueue->u.pcReadFrom = pxQueue->pcHead + ( xBytes - xFirstBytes ) - pxQueue->uxItemSize;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			pxQueue->u.pcReadFrom = pcNextItem + xFirstBytes - pxQueue->uxItemSize;
 		}
-	}
-
-	pxQueue->uxMessagesWaiting = uxMessagesWaiting + 1;
 
-	return xReturn;
+		pxQueue->uxMessagesWaiting -= uxCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
+static int8_t prvAddToLockCount( const int8_t cLockCount, UBaseType_t uxCount )
 {
-	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+int8_t cReturn;
+
+	/* The lock count is at least queueLOCKED_UNMODIFIED when this function is
+	called. */
+	if( uxCount >= ( UBaseType_t ) ( queueMAX_LOCK_COUNT - cLockCount ) )
 	{
-		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
-		if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
-		{
-			pxQueue->u.pcReadFrom = pxQueue->pcHead;
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+		cReturn = queueMAX_LOCK_COUNT;
+	}
+	else
+	{
+		cReturn = ( int8_t ) ( cLockCount + ( int8_t ) uxCount );
 	}
+
+	return cReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -1911,6 +3132,267 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static UBaseType_t prvGetSlotIndex( const Queue_t * const pxQueue, const void * const pvSlot )
+	{
+	const int8_t * const pcSlot = ( const int8_t * ) pvSlot;
+	UBaseType_t uxIndex = pxQueue->uxLength;
+
+		if( ( pcSlot >= pxQueue->pcHead ) && ( pcSlot < pxQueue->pcTail ) )
+		{
+			if( ( ( UBaseType_t ) ( pcSlot - pxQueue->pcHead ) % pxQueue->uxItemSize ) == ( UBaseType_t ) 0 )
+			{
+				uxIndex = ( UBaseType_t ) ( pcSlot - pxQueue->pcHead ) / pxQueue->uxItemSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxIndex;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static void *prvReserveSlot( Queue_t * const pxQueue )
+	{
+	const UBaseType_t uxIndex = pxQueue->uxReserveIndex;
+
+		/* Free slots are always contiguous, starting at uxReserveIndex. */
+		configASSERT( pxQueue->pucSlotState[ uxIndex ] == queueSLOT_FREE );
+
+		pxQueue->pucSlotState[ uxIndex ] = queueSLOT_RESERVED;
+		pxQueue->uxSlotsFree--;
+
+		if( ( uxIndex + ( UBaseType_t ) 1 ) < pxQueue->uxLength )
+		{
+			pxQueue->uxReserveIndex = uxIndex + ( UBaseType_t ) 1;
+		}
+		else
+		{
+			pxQueue->uxReserveIndex = ( UBaseType_t ) 0;
+		}
+
+		return ( void * ) ( pxQueue->pcHead + ( uxIndex * pxQueue->uxItemSize ) );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static void *prvBorrowSlot( Queue_t * const pxQueue )
+	{
+	const UBaseType_t uxIndex = pxQueue->uxBorrowIndex;
+
+		configASSERT( pxQueue->pucSlotState[ uxIndex ] == queueSLOT_READY );
+
+		pxQueue->pucSlotState[ uxIndex ] = queueSLOT_BORROWED;
+		pxQueue->uxMessagesWaiting--;
+
+		if( ( uxIndex + ( UBaseType_t ) 1 ) < pxQueue->uxLength )
+		{
+			pxQueue->uxBorrowIndex = uxIndex + ( UBaseType_t ) 1;
+		}
+		else
+		{
+			pxQueue->uxBorrowIndex = ( UBaseType_t ) 0;
+		}
+
+		return ( void * ) ( pxQueue->pcHead + ( uxIndex * pxQueue->uxItemSize ) );
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static BaseType_t prvCommitSlot( Queue_t * const pxQueue, const void * const pvSlot )
+	{
+	UBaseType_t uxIndex = prvGetSlotIndex( pxQueue, pvSlot );
+	BaseType_t xReady = 0;
+
+		if( ( uxIndex < pxQueue->uxLength ) && ( pxQueue->pucSlotState[ uxIndex ] == queueSLOT_RESERVED ) )
+		{
+			pxQueue->pucSlotState[ uxIndex ] = queueSLOT_COMMITTED;
+
+			/* Slots are made ready in the order in which they were reserved,
+			so a slot committed ahead of an earlier reservation waits for that
+			reservation to be committed too.  The first slot that is not yet
+			ready follows the ready slots that have not yet been borrowed. */
+			uxIndex = ( pxQueue->uxBorrowIndex + pxQueue->uxMessagesWaiting ) % pxQueue->uxLength;
+
+			while( pxQueue->pucSlotState[ uxIndex ] == queueSLOT_COMMITTED )
+			{
+				pxQueue->pucSlotState[ uxIndex ] = queueSLOT_READY;
+				pxQueue->uxMessagesWaiting++;
+				xReady++;
+
+				if( ( uxIndex + ( UBaseType_t ) 1 ) < pxQueue->uxLength )
+				{
+					uxIndex++;
+				}
+				else
+				{
+					uxIndex = ( UBaseType_t ) 0;
+				}
+			}
+		}
+		else
+		{
+			/* pvSlot was not returned by a reserve function, or has already
+			been committed. */
+			configASSERT( pdFALSE );
+			xReady = -1;
+		}
+
+		return xReady;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+	static BaseType_t prvReleaseSlot( Queue_t * const pxQueue, const void * const pvSlot )
+	{
+	UBaseType_t uxIndex = prvGetSlotIndex( pxQueue, pvSlot );
+	BaseType_t xFreed = 0;
+
+		if( ( uxIndex < pxQueue->uxLength ) && ( pxQueue->pucSlotState[ uxIndex ] == queueSLOT_BORROWED ) )
+		{
+			pxQueue->pucSlotState[ uxIndex ] = queueSLOT_RELEASED;
+
+			/* Slots return to the free pool in the order in which they were
+			borrowed, so the free slots remain contiguous. */
+			uxIndex = pxQueue->uxReleaseIndex;
+
+			while( pxQueue->pucSlotState[ uxIndex ] == queueSLOT_RELEASED )
+			{
+				pxQueue->pucSlotState[ uxIndex ] = queueSLOT_FREE;
+				pxQueue->uxSlotsFree++;
+				xFreed++;
+
+				if( ( uxIndex + ( UBaseType_t ) 1 ) < pxQueue->uxLength )
+				{
+					uxIndex++;
+				}
+				else
+				{
+					uxIndex = ( UBaseType_t ) 0;
+				}
+			}
+
+			pxQueue->uxReleaseIndex = uxIndex;
+		}
+		else
+		{
+			/* pvSlot was not returned by a borrow function, or has already
+			been released. */
+			configASSERT( pdFALSE );
+			xFreed = -1;
+		}
+
+		return xFreed;
+	}
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue, UBaseType_t uxItemsAdded )
+{
+BaseType_t xReturn = pdFALSE;
+
+	while( uxItemsAdded > ( UBaseType_t ) 0 )
+	{
+		#if ( configUSE_QUEUE_SETS == 1 )
+		{
+			if( pxQueue->pxQueueSetContainer != NULL )
+			{
+				/* The queue set holds one entry per item in the queue. */
+				if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				break;
+			}
+		}
+		#else /* configUSE_QUEUE_SETS */
+		{
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				break;
+			}
+		}
+		#endif /* configUSE_QUEUE_SETS */
+
+		uxItemsAdded--;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingToSend( Queue_t * const pxQueue, UBaseType_t uxSpacesFreed )
+{
+BaseType_t xReturn = pdFALSE;
+
+	while( ( uxSpacesFreed > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		uxSpacesFreed--;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvIsQueueEmpty( const Queue_t *pxQueue )
 {
 BaseType_t xReturn;
@@ -1956,14 +3438,34 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 		{
-			xReturn = pdTRUE;
+			/* A zero copy queue is full when no slot can be reserved. */
+			if( ( pxQueue->pucSlotState != NULL ) && ( pxQueue->uxSlotsFree == ( UBaseType_t ) 0 ) )
+			{
+				xReturn = pdTRUE;
+			}
+			else if( ( pxQueue->pucSlotState == NULL ) && ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
 		}
-		else
+		#else
 		{
-			xReturn = pdFALSE;
+			if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
 		}
+		#endif /* configUSE_ZERO_COPY_QUEUES */
 	}
 	taskEXIT_CRITICAL();
 
@@ -1976,14 +3478,41 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 BaseType_t xReturn;
 
 	configASSERT( xQueue );
-	if( ( ( Queue_t * ) xQueue )->uxMessagesWaiting == ( ( Queue_t * ) xQueue )->uxLength )
+
+	#if ( configUSE_ZERO_COPY_QUEUES == 1 )
 	{
-		xReturn = pdTRUE;
+		if( ( ( Queue_t * ) xQueue )->pucSlotState != NULL )
+		{
+			if( ( ( Queue_t * ) xQueue )->uxSlotsFree == ( UBaseType_t ) 0 )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+		}
+		else if( ( ( Queue_t * ) xQueue )->uxMessagesWaiting == ( ( Queue_t * ) xQueue )->uxLength )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
 	}
-	else
+	#else
 	{
-		xReturn = pdFALSE;
+		if( ( ( Queue_t * ) xQueue )->uxMessagesWaiting == ( ( Queue_t * ) xQueue )->uxLength )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
 	}
+	#endif /* configUSE_ZERO_COPY_QUEUES */
 
 	return xReturn;
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
@@ -0,0 +1,1043 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sbuffer.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* A task blocked on a stream buffer waits on its direct to task notification,
+and the task that unblocks it needs the blocked task's handle. */
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build sbuffer.c
+#endif
+
+#ifndef portMEMORY_BARRIER
+	#error portMEMORY_BARRIER() must be defined in portmacro.h to use stream buffers.  See the comment in FreeRTOS.h.
+#endif
+
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build sbuffer.c
+#endif
+
+/* Bits that can be set in ucFlags. */
+#define sbFLAGS_IS_MESSAGE_BUFFER			( ( uint8_t ) 1 )
+#define sbFLAGS_IS_STATICALLY_ALLOCATED		( ( uint8_t ) 2 )
+
+/* Each message in a message buffer is preceded by its length. */
+#define sbBYTES_TO_STORE_MESSAGE_LENGTH		( sizeof( size_t ) )
+
+/*
+ * The head and tail indexes are each only ever written by one side - the head
+ * by the writer and the tail by the reader - so neither side needs to enter a
+ * critical section to move data.  The storage area is one byte longer than the
+ * buffer's capacity so a full buffer (head one behind tail) can be told apart
+ * from an empty buffer (head equal to tail).
+ */
+typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
+{
+	volatile size_t xTail;							/*< Index of the next byte to read.  Only updated by the reader. */
+	volatile size_t xHead;							/*< Index of the next byte to write.  Only updated by the writer. */
+	size_t xLength;									/*< Length of the storage area, in bytes. */
+	size_t xTriggerLevelBytes;						/*< The number of bytes that must be in the buffer before a blocked reader is unblocked. */
+	volatile TaskHandle_t xTaskWaitingToReceive;	/*< Holds the handle of a task waiting for data, or NULL if no tasks are waiting. */
+	volatile TaskHandle_t xTaskWaitingToSend;		/*< Holds the handle of a task waiting to send data to a full buffer, or NULL if no tasks are waiting. */
+	uint8_t *pucBuffer;								/*< Points to the storage area. */
+	uint8_t ucFlags;
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t uxStreamBufferNumber;			/*< Used for tracing purposes. */
+	#endif
+} StreamBuffer_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the number of bytes held in the buffer.
+ */
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of bytes that can be written to the buffer.
+ */
+static size_t prvSpacesAvailable( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes from pucData into the storage area starting at index
+ * xHead, wrapping at the end of the storage area if necessary.  Returns the
+ * index that follows the last byte written.  Does not update the buffer's head
+ * index, so the bytes are not yet visible to the reader.
+ */
+static size_t prvWriteBytes( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes from the storage area, starting at index xTail, into
+ * pucData.  Returns the index that follows the last byte read.  Does not
+ * update the buffer's tail index, so the space is not yet returned to the
+ * writer.
+ */
+static size_t prvReadBytes( const StreamBuffer_t * const pxStreamBuffer, uint8_t *pucData, size_t xCount, size_t xTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write as much of pvTxData as xSpace allows (or, for a message buffer, all of
+ * it or none of it) and then publish the new head index.  Returns the number of
+ * bytes of pvTxData written.
+ */
+static size_t prvWriteToBuffer( StreamBuffer_t * const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, size_t xSpace ) PRIVILEGED_FUNCTION;
+
+/*
+ * Read up to xBufferLengthBytes bytes (or, for a message buffer, the next
+ * message if it fits) and then publish the new tail index.  Returns the number
+ * of bytes copied to pvRxData.
+ */
+static size_t prvReadFromBuffer( StreamBuffer_t * const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+/*
+ * If a task is recorded in *pxWaitingTask then notify it and clear the record.
+ * The critical section is only entered when a task is actually waiting.
+ */
+static void prvNotifyWaitingTask( volatile TaskHandle_t * const pxWaitingTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task, which has recorded its handle in *pxWaitingTask, on
+ * its direct to task notification for up to xTicksToWait ticks.  Returns pdTRUE
+ * if the task was woken by a notification that was not sent by the stream
+ * buffer, in which case the caller must send the notification on again before
+ * it returns so the notification is not lost.
+ */
+static BaseType_t prvWaitForNotification( volatile TaskHandle_t * const pxWaitingTask, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+static void prvNotifyWaitingTaskFromISR( volatile TaskHandle_t * const pxWaitingTask, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xStreamBufferGenericCreate() and xStreamBufferGenericCreateStatic()
+ * to fill in the stream buffer structure.
+ */
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer, uint8_t * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	{
+	uint8_t *pucAllocatedMemory;
+	uint8_t ucFlags;
+
+		if( xIsMessageBuffer != pdFALSE )
+		{
+			/* There must be room for at least one byte of message. */
+			configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
+		}
+		else
+		{
+			configASSERT( xBufferSizeBytes > 0 );
+			ucFlags = 0;
+		}
+
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		/* The storage area is allocated in the same block as the structure,
+		and is one byte longer than the requested capacity. */
+		pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( StreamBuffer_t ) + xBufferSizeBytes + ( size_t ) 1 );
+
+		if( pucAllocatedMemory != NULL )
+		{
+			prvInitialiseNewStreamBuffer( ( StreamBuffer_t * ) pucAllocatedMemory, pucAllocatedMemory + sizeof( StreamBuffer_t ), xBufferSizeBytes, xTriggerLevelBytes, ucFlags ); /*lint !e826 Area is not too small and alignment is guaranteed provided malloc() behaves as expected and returns aligned buffer. */
+
+			traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xIsMessageBuffer );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+		}
+
+		return ( StreamBufferHandle_t ) pucAllocatedMemory;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+	StreamBufferHandle_t xReturn;
+	uint8_t ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
+
+		configASSERT( pucStreamBufferStorageArea );
+		configASSERT( pxStaticStreamBuffer );
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		if( xIsMessageBuffer != pdFALSE )
+		{
+			configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticStreamBuffer_t equals the size of the real
+			stream buffer structure. */
+			volatile size_t xSize = sizeof( StaticStreamBuffer_t );
+			configASSERT( xSize == sizeof( StreamBuffer_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		if( ( pucStreamBufferStorageArea != NULL ) && ( pxStaticStreamBuffer != NULL ) )
+		{
+			prvInitialiseNewStreamBuffer( pxStreamBuffer, pucStreamBufferStorageArea, xBufferSizeBytes, xTriggerLevelBytes, ucFlags );
+
+			traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+
+			xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer;
+		}
+		else
+		{
+			xReturn = NULL;
+			traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both the structure and the storage area were allocated in a
+			single block. */
+			vPortFree( ( void * ) pxStreamBuffer );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucFlags must be corrupt. */
+			configASSERT( xStreamBuffer == ( StreamBufferHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and storage area were provided by the application, so
+		just wipe the structure. */
+		( void ) memset( pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxStreamBuffer );
+
+	/* Can only reset a stream buffer if there are no tasks blocked on it. */
+	taskENTER_CRITICAL();
+	{
+		if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+		{
+			pxStreamBuffer->xHead = ( size_t ) 0;
+			pxStreamBuffer->xTail = ( size_t ) 0;
+			xReturn = pdPASS;
+
+			traceSTREAM_BUFFER_RESET( xStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xReturn, xSpace, xRequiredSpace = xDataLengthBytes;
+BaseType_t xShouldBlock, xOtherNotification = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pvTxData );
+	configASSERT( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* The message and its length must fit in the buffer at once.  There
+		is no point waiting for space for a message that can never fit. */
+		xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+		if( xRequiredSpace >= pxStreamBuffer->xLength )
+		{
+			xTicksToWait = ( TickType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else if( xRequiredSpace >= pxStreamBuffer->xLength )
+	{
+		/* A stream larger than the buffer is written in parts, so only wait
+		until the buffer is empty. */
+		xRequiredSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xSpace = prvSpacesAvailable( pxStreamBuffer );
+
+	if( ( xSpace < xRequiredSpace ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* The critical section is only entered on this, the slow, path.
+			Inside it the reader cannot run, so either the reader has already
+			freed enough space or it will see this task's handle when it next
+			frees space. */
+			taskENTER_CRITICAL();
+			{
+				xSpace = prvSpacesAvailable( pxStreamBuffer );
+
+				if( xSpace < xRequiredSpace )
+				{
+					/* Only one writer is permitted. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					xShouldBlock = pdTRUE;
+				}
+				else
+				{
+					xShouldBlock = pdFALSE;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xShouldBlock == pdFALSE )
+			{
+				break;
+			}
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			if( prvWaitForNotification( &( pxStreamBuffer->xTaskWaitingToSend ), xTicksToWait ) != pdFALSE )
+			{
+				xOtherNotification = pdTRUE;
+			}
+
+			xSpace = prvSpacesAvailable( pxStreamBuffer );
+
+		} while( ( xSpace < xRequiredSpace ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+
+		if( xOtherNotification != pdFALSE )
+		{
+			/* Pass on the notification that was consumed while waiting. */
+			( void ) xTaskNotify( xTaskGetCurrentTaskHandle(), ( uint32_t ) 0, eNoAction );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xReturn = prvWriteToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			prvNotifyWaitingTask( &( pxStreamBuffer->xTaskWaitingToReceive ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pvTxData );
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvWriteToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, prvSpacesAvailable( pxStreamBuffer ) );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xReceivedLength, xBytesAvailable;
+BaseType_t xShouldBlock, xOtherNotification = pdFALSE;
+TimeOut_t xTimeOut;
+
+	configASSERT( pvRxData );
+	configASSERT( pxStreamBuffer );
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( ( xBytesAvailable < pxStreamBuffer->xTriggerLevelBytes ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* As in xStreamBufferSend(), the critical section is only entered
+			when this task might have to block. */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable < pxStreamBuffer->xTriggerLevelBytes )
+				{
+					/* Only one reader is permitted. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+					xShouldBlock = pdTRUE;
+				}
+				else
+				{
+					xShouldBlock = pdFALSE;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xShouldBlock == pdFALSE )
+			{
+				break;
+			}
+
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			if( prvWaitForNotification( &( pxStreamBuffer->xTaskWaitingToReceive ), xTicksToWait ) != pdFALSE )
+			{
+				xOtherNotification = pdTRUE;
+			}
+
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+		} while( ( xBytesAvailable < pxStreamBuffer->xTriggerLevelBytes ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+
+		if( xOtherNotification != pdFALSE )
+		{
+			/* Pass on the notification that was consumed while waiting. */
+			( void ) xTaskNotify( xTaskGetCurrentTaskHandle(), ( uint32_t ) 0, eNoAction );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xReceivedLength = prvReadFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+
+	if( xReceivedLength > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+
+		/* Space was freed, so unblock the writer if it was waiting. */
+		prvNotifyWaitingTask( &( pxStreamBuffer->xTaskWaitingToSend ) );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+	}
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xReceivedLength;
+
+	configASSERT( pvRxData );
+	configASSERT( pxStreamBuffer );
+
+	xReceivedLength = prvReadFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, prvBytesInBuffer( pxStreamBuffer ) );
+
+	if( xReceivedLength > ( size_t ) 0 )
+	{
+		prvNotifyWaitingTaskFromISR( &( pxStreamBuffer->xTaskWaitingToSend ), pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+BaseType_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	if( pxStreamBuffer->xHead == pxStreamBuffer->xTail )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+BaseType_t xReturn;
+size_t xBytesToStoreMessageLength;
+
+	configASSERT( pxStreamBuffer );
+
+	/* A message buffer that cannot hold another length prefix is full. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	if( prvSpacesAvailable( pxStreamBuffer ) <= xBytesToStoreMessageLength )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvBytesInBuffer( ( const StreamBuffer_t * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+	configASSERT( xStreamBuffer );
+	return prvSpacesAvailable( ( const StreamBuffer_t * ) xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+size_t xCount;
+
+	/* The index belonging to the other side may be stale, but a stale index
+	only ever under-reports the data (to the reader) or the space (to the
+	writer). */
+	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+	xCount -= pxStreamBuffer->xTail;
+
+	if( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSpacesAvailable( const StreamBuffer_t * const pxStreamBuffer )
+{
+	return ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead )
+{
+size_t xFirstLength;
+
+	/* Write as many bytes as fit before the end of the storage area, then the
+	remainder (if any) at the start of the storage area. */
+	xFirstLength = pxStreamBuffer->xLength - xHead;
+
+	if( xFirstLength > xCount )
+	{
+		xFirstLength = xCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	if( xCount > xFirstLength )
+	{
+		( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xHead += xCount;
+
+	if( xHead >= pxStreamBuffer->xLength )
+	{
+		xHead -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes( const StreamBuffer_t * const pxStreamBuffer, uint8_t *pucData, size_t xCount, size_t xTail )
+{
+size_t xFirstLength;
+
+	xFirstLength = pxStreamBuffer->xLength - xTail;
+
+	if( xFirstLength > xCount )
+	{
+		xFirstLength = xCount;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	if( xCount > xFirstLength )
+	{
+		( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xTail += xCount;
+
+	if( xTail >= pxStreamBuffer->xLength )
+	{
+		xTail -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteToBuffer( StreamBuffer_t * const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, size_t xSpace )
+{
+size_t xHead = pxStreamBuffer->xHead;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* A message is written in its entirety or not at all.  Zero length
+		messages are not written as they could not be told apart from a failed
+		read. */
+		if( ( xDataLengthBytes > ( size_t ) 0 ) && ( xSpace >= ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) ) )
+		{
+			xHead = prvWriteBytes( pxStreamBuffer, ( const uint8_t * ) &xDataLengthBytes, sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+		}
+		else
+		{
+			xDataLengthBytes = 0;
+		}
+	}
+	else if( xDataLengthBytes > xSpace )
+	{
+		xDataLengthBytes = xSpace;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		xHead = prvWriteBytes( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xHead ); /*lint !e9079 Storage buffer contains bytes. */
+
+		/* The data must be in the storage area before the reader can see the
+		new head index. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xHead = xHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadFromBuffer( StreamBuffer_t * const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, size_t xBytesAvailable )
+{
+size_t xTail = pxStreamBuffer->xTail, xCount, xNextMessageLength;
+
+	/* The head index was read before the data it covers. */
+	portMEMORY_BARRIER();
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* A message and its length are published together, so if the length
+		is present so is the whole message. */
+		if( xBytesAvailable >= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			xTail = prvReadBytes( pxStreamBuffer, ( uint8_t * ) &xNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+
+			if( xNextMessageLength <= xBufferLengthBytes )
+			{
+				xCount = xNextMessageLength;
+			}
+			else
+			{
+				/* The message does not fit in the caller's buffer, so leave it
+				in the message buffer. */
+				xCount = 0;
+				xTail = pxStreamBuffer->xTail;
+			}
+		}
+		else
+		{
+			xCount = 0;
+		}
+	}
+	else if( xBufferLengthBytes < xBytesAvailable )
+	{
+		xCount = xBufferLengthBytes;
+	}
+	else
+	{
+		xCount = xBytesAvailable;
+	}
+
+	if( xCount > ( size_t ) 0 )
+	{
+		xTail = prvReadBytes( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xTail ); /*lint !e9079 Data is read as bytes. */
+
+		/* The data must be copied out before the writer can reuse the space. */
+		portMEMORY_BARRIER();
+		pxStreamBuffer->xTail = xTail;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTask( volatile TaskHandle_t * const pxWaitingTask )
+{
+TaskHandle_t xTaskToNotify;
+
+	/* Reading the handle outside of a critical section keeps the common, no
+	task waiting, path free of critical sections.  A task only records its
+	handle from within a critical section after checking the buffer again, so
+	a task that is about to block cannot miss this update. */
+	if( *pxWaitingTask != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( *pxWaitingTask != NULL )
+			{
+				/* Clear the record before the notification is sent, as the
+				notified task may run, and wait on the buffer again, before
+				xTaskNotify() returns. */
+				xTaskToNotify = *pxWaitingTask;
+				*pxWaitingTask = NULL;
+				( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWaitForNotification( volatile TaskHandle_t * const pxWaitingTask, TickType_t xTicksToWait )
+{
+BaseType_t xNotified, xReturn = pdFALSE;
+
+	/* The notification value is neither read nor changed, so tasks that use
+	their notification value for another purpose are not affected.  Nor is
+	the notification state cleared before blocking, so a notification that
+	was already pending just causes the caller to check the buffer again. */
+	xNotified = xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+
+	taskENTER_CRITICAL();
+	{
+		/* The other side of the buffer clears the record before it sends its
+		notification, so if the record is still set the notification, if any,
+		came from somewhere else. */
+		if( *pxWaitingTask != NULL )
+		{
+			*pxWaitingTask = NULL;
+
+			if( xNotified != pdFALSE )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaitingTaskFromISR( volatile TaskHandle_t * const pxWaitingTask, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSavedInterruptStatus;
+TaskHandle_t xTaskToNotify;
+
+	if( *pxWaitingTask != NULL )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( *pxWaitingTask != NULL )
+			{
+				xTaskToNotify = *pxWaitingTask;
+				*pxWaitingTask = NULL;
+				( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer, uint8_t * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, uint8_t ucFlags )
+{
+	( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
+
+	/* A message buffer unblocks its reader as soon as a message arrives, and
+	a trigger level of 0 would unblock a reader when there is no data. */
+	if( ( xTriggerLevelBytes == ( size_t ) 0 ) || ( ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) )
+	{
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxStreamBuffer->pucBuffer = pucBuffer;
+	pxStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	pxStreamBuffer->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer )
+	{
+		return ( ( StreamBuffer_t * ) xStreamBuffer )->uxStreamBufferNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer, UBaseType_t uxStreamBufferNumber )
+	{
+		( ( StreamBuffer_t * ) xStreamBuffer )->uxStreamBufferNumber = uxStreamBufferNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
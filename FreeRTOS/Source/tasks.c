@@ -334,6 +334,13 @@ typedef struct tskTaskControlBlock
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if( configUSE_HEAP_INSTRUMENTATION == 1 )
+		uint32_t		ulHeapMallocCount;	/*< The number of times the task has called pvPortMalloc(). */
+		uint32_t		ulHeapFreeCount;	/*< The number of times the task has called vPortFree(). */
+		uint32_t		ulHeapMallocCycles;	/*< The total time the task has spent in pvPortMalloc(), as measured by portGET_HEAP_CYCLE_COUNTER_VALUE(). */
+		uint32_t		ulHeapFreeCycles;	/*< The total time the task has spent in vPortFree(), as measured by portGET_HEAP_CYCLE_COUNTER_VALUE(). */
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -893,6 +900,15 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+	{
+		pxNewTCB->ulHeapMallocCount = 0UL;
+		pxNewTCB->ulHeapFreeCount = 0UL;
+		pxNewTCB->ulHeapMallocCycles = 0UL;
+		pxNewTCB->ulHeapFreeCycles = 0UL;
+	}
+	#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -3339,8 +3355,8 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	vListInitialiseIndexed( &xDelayedTaskList1 );
+	vListInitialiseIndexed( &xDelayedTaskList2 );
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3460,6 +3476,22 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif
 
+		#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+		{
+			pxTaskStatus->ulHeapMallocCount = pxTCB->ulHeapMallocCount;
+			pxTaskStatus->ulHeapFreeCount = pxTCB->ulHeapFreeCount;
+			pxTaskStatus->ulHeapMallocCycles = pxTCB->ulHeapMallocCycles;
+			pxTaskStatus->ulHeapFreeCycles = pxTCB->ulHeapFreeCycles;
+		}
+		#else
+		{
+			pxTaskStatus->ulHeapMallocCount = 0;
+			pxTaskStatus->ulHeapFreeCount = 0;
+			pxTaskStatus->ulHeapMallocCycles = 0;
+			pxTaskStatus->ulHeapFreeCycles = 0;
+		}
+		#endif
+
 		/* Obtaining the task state is a little fiddly, so is only done if the value
 		of eState passed into this function is eInvalid - otherwise the state is
 		just set to whatever is passed in. */
@@ -4190,6 +4222,39 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+	void *pvTaskRecordHeapOperation( BaseType_t xIsAllocation, uint32_t ulCycles )
+	{
+		/* The heap calls this function with the scheduler suspended, so the
+		counters cannot be updated by another task at the same time.  If
+		pvPortMalloc() is called before any tasks have been created then
+		pxCurrentTCB will be NULL and the operation is not charged to any
+		task. */
+		if( pxCurrentTCB != NULL )
+		{
+			if( xIsAllocation != pdFALSE )
+			{
+				( pxCurrentTCB->ulHeapMallocCount )++;
+				pxCurrentTCB->ulHeapMallocCycles += ulCycles;
+			}
+			else
+			{
+				( pxCurrentTCB->ulHeapFreeCount )++;
+				pxCurrentTCB->ulHeapFreeCycles += ulCycles;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxCurrentTCB;
+	}
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
 	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
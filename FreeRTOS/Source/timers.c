@@ -100,6 +100,27 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* Geometry of the hierarchical timing wheel.  Each level has
+	tmrWHEEL_SLOTS slots, and each slot on level n covers 2^(n * bits) ticks,
+	so enough levels are used to cover the whole range of TickType_t. */
+	#define tmrWHEEL_SLOT_BITS		( ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOTS			( ( UBaseType_t ) 1U << tmrWHEEL_SLOT_BITS )
+	#define tmrWHEEL_TICK_BITS		( ( UBaseType_t ) ( sizeof( TickType_t ) * ( size_t ) 8 ) )
+	#define tmrWHEEL_LEVELS			( ( tmrWHEEL_TICK_BITS + tmrWHEEL_SLOT_BITS - ( UBaseType_t ) 1U ) / tmrWHEEL_SLOT_BITS )
+
+	/* Commands sent by the timer service task to itself (normally from within
+	a timer callback) can be applied directly, without being copied through
+	the timer queue, if the kernel can report which task is running. */
+	#if( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+		#define tmrAPPLY_DAEMON_COMMANDS_DIRECTLY	1
+	#else
+		#define tmrAPPLY_DAEMON_COMMANDS_DIRECTLY	0
+	#endif
+
+#endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl
 {
@@ -161,13 +182,40 @@ typedef struct tmrTimerQueueMessage
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* The timing wheel in which active timers are stored.  Each slot holds,
+	in no particular order, the timers that expire within the range of ticks
+	covered by the slot.  ulWheelOccupied holds a bit per slot that is set
+	while the slot is not empty, and xWheelTime is the tick count up to which
+	the wheel has been processed.  Only the timer service task is allowed to
+	access the wheel. */
+	PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint32_t ulWheelOccupied[ tmrWHEEL_LEVELS ];
+	PRIVILEGED_DATA static TickType_t xWheelTime = ( TickType_t ) 0U;
+
+	/* Gives the number of trailing zeros in a 32-bit value from the top five
+	bits of the value's lowest set bit multiplied by the de Bruijn sequence
+	tmrDE_BRUIJN_SEQUENCE, so the next occupied slot is found without testing
+	the slots one at a time. */
+	#define tmrDE_BRUIJN_SEQUENCE	( ( uint32_t ) 0x077CB531UL )
+	static const uint8_t ucWheelTrailingZeros[ 32 ] =
+	{
+		0U, 1U, 28U, 2U, 29U, 14U, 24U, 3U, 30U, 22U, 20U, 15U, 25U, 17U, 4U, 8U,
+		31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U, 26U, 12U, 18U, 6U, 11U, 5U, 10U, 9U
+	};
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in expire
+	time order, with the nearest expiry time at the front of the list.  Only the
+	timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -207,22 +255,18 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * Carry out a single start, reset, stop, change period or delete command on
+ * the timer referenced by pxMessage.
  */
-static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+static void prvProcessTimerCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
- */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
-
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
+ * depending on if the expire time causes a timer counter overflow.  When
+ * configUSE_TIMER_WHEEL is 1 the timer is instead inserted into the timing
+ * wheel slot that covers its expiry time.
  */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -230,19 +274,69 @@ static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
  */
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
-/*
- * If the timer list contains any active timers then return the expire time of
- * the timer that will expire first and set *pxListWasEmpty to false.  If the
- * timer list does not contain any timers then return 0 and set *pxListWasEmpty
- * to pdTRUE.
- */
-static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
-
-/*
- * If a timer has expired, process it.  Otherwise, block the timer service task
- * until either a timer does expire or a command is received.
- */
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Place an active timer in the wheel slot that covers the expiry time held
+	 * in its list item, relative to xWheelTime.  The expiry time must not be
+	 * before xWheelTime.
+	 */
+	static void prvWheelInsert( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove a timer from the wheel slot it is held in, if any.
+	 */
+	static void prvWheelRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the number of ticks from xWheelTime until the wheel next needs
+	 * attention - either because the timers in a level 0 slot expire, or
+	 * because the timers in a higher level slot must be moved down to a lower
+	 * level.  *pxWheelWasEmpty is set to pdTRUE if the wheel holds no timers.
+	 */
+	static TickType_t prvWheelTicksToNextEvent( BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Advance xWheelTime up to xTimeNow, cascading higher level slots and
+	 * expiring all the timers due on each tick as a batch.
+	 */
+	static void prvWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Block the timer service task until either the wheel next needs attention
+	 * or a command is received.
+	 */
+	static void prvWheelBlockTask( void ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is an
+	 * auto reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If the timer list contains any active timers then return the expire time of
+	 * the timer that will expire first and set *pxListWasEmpty to false.  If the
+	 * timer list does not contain any timers then return 0 and set *pxListWasEmpty
+	 * to pdTRUE.
+	 */
+	static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If a timer has expired, process it.  Otherwise, block the timer service task
+	 * until either a timer does expire or a command is received.
+	 */
+	static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Called after a Timer_t structure has been allocated either statically or
@@ -432,6 +526,26 @@ DaemonTaskMessage_t xMessage;
 
 		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
 		{
+			#if( ( configUSE_TIMER_WHEEL == 1 ) && ( tmrAPPLY_DAEMON_COMMANDS_DIRECTLY == 1 ) )
+				/* A command issued by the timer service task itself, typically
+				a timer callback re-arming a timer, does not need to be sent
+				through the queue as the daemon owns the wheel.  Delete commands
+				are still queued so a timer is not freed while its callback is
+				executing, as are the daemon's own internal reload commands.  The
+				direct path is only taken when the queue is empty, otherwise the
+				command would overtake commands that other tasks have already
+				queued for the same timer. */
+				if( ( xCommandID != tmrCOMMAND_DELETE ) &&
+					( xCommandID != tmrCOMMAND_START_DONT_TRACE ) &&
+					( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) &&
+					( xTaskGetCurrentTaskHandle() == xTimerTaskHandle ) &&
+					( uxQueueMessagesWaiting( xTimerQueue ) == ( UBaseType_t ) 0 ) )
+				{
+					prvProcessTimerCommand( &xMessage );
+					xReturn = pdPASS;
+				}
+				else
+			#endif /* configUSE_TIMER_WHEEL */
 			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
 			{
 				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
@@ -495,6 +609,8 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
 BaseType_t xResult;
@@ -533,12 +649,16 @@ Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTi
 	/* Call the timer callback. */
 	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvTimerTask( void *pvParameters )
 {
-TickType_t xNextExpireTime;
-BaseType_t xListWasEmpty;
+#if( configUSE_TIMER_WHEEL == 0 )
+	TickType_t xNextExpireTime;
+	BaseType_t xListWasEmpty;
+#endif
 
 	/* Just to avoid compiler warnings. */
 	( void ) pvParameters;
@@ -557,13 +677,27 @@ BaseType_t xListWasEmpty;
 
 	for( ;; )
 	{
-		/* Query the timers list to see if it contains any timers, and if so,
-		obtain the time at which the next timer will expire. */
-		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		#if( configUSE_TIMER_WHEEL == 1 )
+		{
+			/* Block until either the wheel needs attention or a command is
+			received. */
+			prvWheelBlockTask();
+
+			/* Bring the wheel up to date, expiring any timers that are due,
+			so commands are always applied relative to the current time. */
+			prvWheelAdvance( xTaskGetTickCount() );
+		}
+		#else
+		{
+			/* Query the timers list to see if it contains any timers, and if so,
+			obtain the time at which the next timer will expire. */
+			xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
 
-		/* If a timer has expired, process it.  Otherwise, block this task
-		until either a timer does expire, or a command is received. */
-		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+			/* If a timer has expired, process it.  Otherwise, block this task
+			until either a timer does expire, or a command is received. */
+			prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+		}
+		#endif /* configUSE_TIMER_WHEEL */
 
 		/* Empty the command queue. */
 		prvProcessReceivedCommands();
@@ -571,6 +705,8 @@ BaseType_t xListWasEmpty;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
@@ -655,26 +791,40 @@ TickType_t xNextExpireTime;
 
 	return xNextExpireTime;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+#if( configUSE_TIMER_WHEEL == 0 )
+	PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+#endif
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
+		/* The wheel slots are indexed modulo the range of the tick count, so
+		there are no lists to switch when the tick count overflows. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
+	#else
+	{
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists();
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
 
-	xLastTime = xTimeNow;
+		xLastTime = xTimeNow;
+	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xTimeNow;
 }
@@ -699,7 +849,18 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				/* The expiry time has wrapped past the tick count overflow.
+				The wheel works modulo the tick range so this needs no special
+				treatment. */
+				prvWheelInsert( pxTimer );
+			}
+			#else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 	else
@@ -713,7 +874,15 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				prvWheelInsert( pxTimer );
+			}
+			#else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 
@@ -724,9 +893,6 @@ BaseType_t xProcessTimerNow = pdFALSE;
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
-Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
-TickType_t xTimeNow;
 
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
@@ -756,118 +922,142 @@ TickType_t xTimeNow;
 		function calls. */
 		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
 		{
-			/* The messages uses the xTimerParameters member to work on a
-			software timer. */
-			pxTimer = xMessage.u.xTimerParameters.pxTimer;
+			prvProcessTimerCommand( &xMessage );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTimerCommand( const DaemonTaskMessage_t * const pxMessage )
+{
+Timer_t *pxTimer;
+BaseType_t xTimerListsWereSwitched, xResult;
+TickType_t xTimeNow;
+
+	/* The messages uses the xTimerParameters member to work on a
+	software timer. */
+	pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+	if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+	{
+		/* The timer is in a list, remove it. */
+		#if( configUSE_TIMER_WHEEL == 1 )
+		{
+			prvWheelRemove( pxTimer );
+		}
+		#else
+		{
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		}
+		#endif /* configUSE_TIMER_WHEEL */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
+
+	/* In this case the xTimerListsWereSwitched parameter is not used, but
+	it must be present in the function call.  prvSampleTimeNow() must be
+	called after the message is received from xTimerQueue so there is no
+	possibility of a higher priority task adding a message to the message
+	queue with a time that is ahead of the timer daemon task (because it
+	pre-empted the timer daemon task after the xTimeNow value was set). */
+	xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+	switch( pxMessage->xMessageID )
+	{
+		case tmrCOMMAND_START :
+	    case tmrCOMMAND_START_FROM_ISR :
+	    case tmrCOMMAND_RESET :
+	    case tmrCOMMAND_RESET_FROM_ISR :
+		case tmrCOMMAND_START_DONT_TRACE :
+			/* Start or restart a timer. */
+			if( prvInsertTimerInActiveList( pxTimer,  pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue ) != pdFALSE )
 			{
-				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				/* The timer expired before it was added to the active
+				timer list.  Process it now. */
+				pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+				traceTIMER_EXPIRED( pxTimer );
+
+				if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
-
-			traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
-
-			/* In this case the xTimerListsWereSwitched parameter is not used, but
-			it must be present in the function call.  prvSampleTimeNow() must be
-			called after the message is received from xTimerQueue so there is no
-			possibility of a higher priority task adding a message to the message
-			queue with a time that is ahead of the timer daemon task (because it
-			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
-			switch( xMessage.xMessageID )
+			break;
+
+		case tmrCOMMAND_STOP :
+		case tmrCOMMAND_STOP_FROM_ISR :
+			/* The timer has already been removed from the active list.
+			There is nothing to do here. */
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+		case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+			pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+			configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+			/* The new period does not really have a reference, and can
+			be longer or shorter than the old one.  The command time is
+			therefore set to the current time, and as the period cannot
+			be zero the next expiry time can only be in the future,
+			meaning (unlike for the xTimerStart() case above) there is
+			no fail case that needs to be handled here. */
+			( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+			break;
+
+		case tmrCOMMAND_DELETE :
+			/* The timer has already been removed from the active list,
+			just free up the memory if the memory was dynamically
+			allocated. */
+			#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 			{
-				case tmrCOMMAND_START :
-			    case tmrCOMMAND_START_FROM_ISR :
-			    case tmrCOMMAND_RESET :
-			    case tmrCOMMAND_RESET_FROM_ISR :
-				case tmrCOMMAND_START_DONT_TRACE :
-					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-					{
-						/* The timer expired before it was added to the active
-						timer list.  Process it now. */
-						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-						traceTIMER_EXPIRED( pxTimer );
-
-						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-					break;
-
-				case tmrCOMMAND_STOP :
-				case tmrCOMMAND_STOP_FROM_ISR :
-					/* The timer has already been removed from the active list.
-					There is nothing to do here. */
-					break;
-
-				case tmrCOMMAND_CHANGE_PERIOD :
-				case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-					pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-					/* The new period does not really have a reference, and can
-					be longer or shorter than the old one.  The command time is
-					therefore set to the current time, and as the period cannot
-					be zero the next expiry time can only be in the future,
-					meaning (unlike for the xTimerStart() case above) there is
-					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-					break;
-
-				case tmrCOMMAND_DELETE :
-					/* The timer has already been removed from the active list,
-					just free up the memory if the memory was dynamically
-					allocated. */
-					#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-					{
-						/* The timer can only have been allocated dynamically -
-						free it again. */
-						vPortFree( pxTimer );
-					}
-					#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-					{
-						/* The timer could have been allocated statically or
-						dynamically, so check before attempting to free the
-						memory. */
-						if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-						{
-							vPortFree( pxTimer );
-						}
-						else
-						{
-							mtCOVERAGE_TEST_MARKER();
-						}
-					}
-					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-					break;
-
-				default	:
-					/* Don't expect to get here. */
-					break;
+				/* The timer can only have been allocated dynamically -
+				free it again. */
+				vPortFree( pxTimer );
 			}
-		}
+			#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+			{
+				/* The timer could have been allocated statically or
+				dynamically, so check before attempting to free the
+				memory. */
+				if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+				{
+					vPortFree( pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+			break;
+
+		default	:
+			/* Don't expect to get here. */
+			break;
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -927,6 +1117,263 @@ BaseType_t xResult;
 }
 /*-----------------------------------------------------------*/
 
+#else /* configUSE_TIMER_WHEEL */
+
+static void prvWheelInsert( Timer_t * const pxTimer )
+{
+const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+const TickType_t xTicksToExpiry = ( TickType_t ) ( xExpiryTime - xWheelTime );
+UBaseType_t uxLevel = ( UBaseType_t ) 0U, uxSlot;
+
+	/* The timer goes on the lowest level that can represent its distance
+	from the current wheel time, so a timer that is due within
+	tmrWHEEL_SLOTS ticks goes on level 0, where each slot holds the timers that
+	expire on a single tick.  Finding the level is bounded by the number of
+	levels, so insertion does not depend on the number of active timers. */
+	while( ( uxLevel < ( tmrWHEEL_LEVELS - ( UBaseType_t ) 1U ) ) &&
+		   ( ( xTicksToExpiry >> ( tmrWHEEL_SLOT_BITS * ( uxLevel + ( UBaseType_t ) 1U ) ) ) != ( TickType_t ) 0U ) )
+	{
+		uxLevel++;
+	}
+
+	uxSlot = ( UBaseType_t ) ( xExpiryTime >> ( tmrWHEEL_SLOT_BITS * uxLevel ) ) & ( tmrWHEEL_SLOTS - ( UBaseType_t ) 1U );
+
+	vListInsertEnd( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+	ulWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelRemove( Timer_t * const pxTimer )
+{
+List_t * const pxSlot = ( List_t * ) listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+UBaseType_t uxIndex;
+
+	if( pxSlot != NULL )
+	{
+		if( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0U )
+		{
+			/* The slot is now empty.  Its position within the wheel gives
+			the bit to clear. */
+			uxIndex = ( UBaseType_t ) ( pxSlot - &( xTimerWheel[ 0 ][ 0 ] ) );
+			ulWheelOccupied[ uxIndex / tmrWHEEL_SLOTS ] &= ~( 1UL << ( uxIndex % tmrWHEEL_SLOTS ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWheelTicksToNextEvent( BaseType_t * const pxWheelWasEmpty )
+{
+TickType_t xTicksToEvent = portMAX_DELAY, xTicksToSlot;
+UBaseType_t uxLevel, uxShift, uxSlots, uxCurrentSlot, uxStep, uxRotate;
+uint32_t ulOccupied;
+
+	*pxWheelWasEmpty = pdTRUE;
+
+	for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		if( ulWheelOccupied[ uxLevel ] != 0UL )
+		{
+			uxShift = tmrWHEEL_SLOT_BITS * uxLevel;
+
+			/* The top level may be only partly used if the number of bits in
+			TickType_t is not a multiple of the number of bits per level. */
+			if( ( tmrWHEEL_TICK_BITS - uxShift ) < tmrWHEEL_SLOT_BITS )
+			{
+				uxSlots = ( UBaseType_t ) 1U << ( tmrWHEEL_TICK_BITS - uxShift );
+			}
+			else
+			{
+				uxSlots = tmrWHEEL_SLOTS;
+			}
+
+			/* Find the first occupied slot after the current slot.  The
+			current slot itself is considered last, as on levels above 0 it
+			can only hold timers that are a whole revolution away.  Rotating
+			the occupancy bits so the slot after the current slot is in bit 0
+			makes the number of slots to step the number of trailing zeros
+			plus one. */
+			uxCurrentSlot = ( UBaseType_t ) ( xWheelTime >> uxShift ) & ( uxSlots - ( UBaseType_t ) 1U );
+			uxRotate = ( uxCurrentSlot + ( UBaseType_t ) 1U ) & ( uxSlots - ( UBaseType_t ) 1U );
+			ulOccupied = ulWheelOccupied[ uxLevel ];
+
+			if( uxRotate != ( UBaseType_t ) 0U )
+			{
+				ulOccupied = ( ulOccupied >> uxRotate ) | ( ulOccupied << ( uxSlots - uxRotate ) );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxSlots < ( UBaseType_t ) 32U )
+			{
+				ulOccupied &= ( ( uint32_t ) 1UL << uxSlots ) - ( uint32_t ) 1UL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Isolate the lowest set bit. */
+			ulOccupied &= ( uint32_t ) 0UL - ulOccupied;
+			uxStep = ( UBaseType_t ) ucWheelTrailingZeros[ ( uint32_t ) ( ulOccupied * tmrDE_BRUIJN_SEQUENCE ) >> 27 ] + ( UBaseType_t ) 1U;
+
+			/* The slot needs attention when the wheel time reaches the start
+			of the range of ticks it covers.  The arithmetic is modulo the
+			range of TickType_t. */
+			xTicksToSlot = ( TickType_t ) ( ( ( TickType_t ) uxStep << uxShift ) - ( xWheelTime & ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) ) );
+
+			if( ( *pxWheelWasEmpty != pdFALSE ) || ( xTicksToSlot < xTicksToEvent ) )
+			{
+				xTicksToEvent = xTicksToSlot;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			*pxWheelWasEmpty = pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xTicksToEvent;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelAdvance( const TickType_t xTimeNow )
+{
+TickType_t xTicksToEvent;
+BaseType_t xWheelWasEmpty;
+UBaseType_t uxLevel, uxShift;
+List_t *pxSlot;
+Timer_t *pxTimer;
+
+	while( xWheelTime != xTimeNow )
+	{
+		xTicksToEvent = prvWheelTicksToNextEvent( &xWheelWasEmpty );
+
+		if( ( xWheelWasEmpty != pdFALSE ) || ( xTicksToEvent > ( TickType_t ) ( xTimeNow - xWheelTime ) ) )
+		{
+			/* Nothing needs attention before xTimeNow, so the wheel can be
+			moved straight there. */
+			xWheelTime = xTimeNow;
+		}
+		else
+		{
+			xWheelTime += xTicksToEvent;
+
+			/* Move the timers held in the slots that start on this tick down
+			to lower levels, highest level first.  A timer that is due on this
+			tick drops all the way to the current level 0 slot. */
+			for( uxLevel = tmrWHEEL_LEVELS - ( UBaseType_t ) 1U; uxLevel > ( UBaseType_t ) 0U; uxLevel-- )
+			{
+				uxShift = tmrWHEEL_SLOT_BITS * uxLevel;
+
+				if( ( xWheelTime & ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+				{
+					pxSlot = &( xTimerWheel[ uxLevel ][ ( UBaseType_t ) ( xWheelTime >> uxShift ) & ( tmrWHEEL_SLOTS - ( UBaseType_t ) 1U ) ] );
+
+					while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+					{
+						pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+						prvWheelRemove( pxTimer );
+						prvWheelInsert( pxTimer );
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* Every timer in the current level 0 slot expires on this tick, so
+			they are processed as a batch without further searching. */
+			pxSlot = &( xTimerWheel[ 0 ][ ( UBaseType_t ) xWheelTime & ( tmrWHEEL_SLOTS - ( UBaseType_t ) 1U ) ] );
+
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+				configASSERT( listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) == xWheelTime );
+				prvWheelRemove( pxTimer );
+				traceTIMER_EXPIRED( pxTimer );
+
+				/* Auto reload timers are re-inserted relative to the tick on
+				which they expired, so they do not drift.  If the wheel is
+				running behind the tick count the reloaded timer is simply
+				expired again as the wheel catches up. */
+				if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), ( xWheelTime + pxTimer->xTimerPeriodInTicks ) );
+					prvWheelInsert( pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Call the timer callback. */
+				pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelBlockTask( void )
+{
+TickType_t xTicksToEvent, xTicksElapsed;
+BaseType_t xWheelWasEmpty;
+
+	xTicksToEvent = prvWheelTicksToNextEvent( &xWheelWasEmpty );
+
+	vTaskSuspendAll();
+	{
+		/* The tick count may have moved on since the wheel was last
+		advanced. */
+		xTicksElapsed = ( TickType_t ) ( xTaskGetTickCount() - xWheelTime );
+
+		if( ( xWheelWasEmpty == pdFALSE ) && ( xTicksElapsed >= xTicksToEvent ) )
+		{
+			/* The wheel needs attention already - don't block. */
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			/* If the wheel is empty xTicksToEvent is portMAX_DELAY and the
+			task blocks indefinitely, if INCLUDE_vTaskSuspend allows it. */
+			vQueueWaitForMessageRestricted( xTimerQueue, ( xTicksToEvent - xTicksElapsed ), xWheelWasEmpty );
+
+			if( xTaskResumeAll() == pdFALSE )
+			{
+				/* Yield to wait for either a command to arrive, or the
+				block time to expire.  If a command arrived between the
+				critical section being exited and this yield then the yield
+				will not cause the task to block. */
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvCheckForValidListAndQueue( void )
 {
 	/* Check that the list from which active timers are referenced, and the
@@ -936,10 +1383,30 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+			UBaseType_t uxLevel, uxSlot;
+
+				for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+				{
+					for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+					{
+						vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+					}
+
+					ulWheelOccupied[ uxLevel ] = 0UL;
+				}
+
+				xWheelTime = xTaskGetTickCount();
+			}
+			#else
+			{
+				vListInitialiseIndexed( &xActiveTimerList1 );
+				vListInitialiseIndexed( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{